@@ -0,0 +1,407 @@
+// bench/bench_core.cpp
+//
+// Microbenchmarks for the core kernels. Run with an optimized build:
+//   cmake -DCMAKE_BUILD_TYPE=Release .. && cmake --build . --target bench_core
+//   ./bench_core --out bench_core.json
+#include "bench_harness.hpp"
+#include "problem_generators.hpp"
+#include "../src/term/term_db.hpp"
+#include "../src/term/unification.hpp"
+#include "../src/term/substitution.hpp"
+#include "../src/term/ordering.hpp"
+#include "../src/term/rewriting.hpp"
+#include "../src/resolution/clause.hpp"
+#include "../src/resolution/indexing.hpp"
+#include "../src/completion/critical_pairs.hpp"
+#include "../src/parser/tptp_parser.hpp"
+#include "../src/resolution/resolution_prover.hpp"
+#include <random>
+
+using namespace theorem_prover;
+using namespace theorem_prover::bench;
+
+namespace
+{
+
+    /**
+     * Balanced binary term f(f(..), f(..)) of the given depth; leaves come from leaf(i)
+     */
+    TermDBPtr balanced_term(const std::string &symbol, std::size_t depth,
+                            const std::function<TermDBPtr(std::size_t)> &leaf,
+                            std::size_t &next_leaf)
+    {
+        if (depth == 0)
+        {
+            return leaf(next_leaf++);
+        }
+        auto left = balanced_term(symbol, depth - 1, leaf, next_leaf);
+        auto right = balanced_term(symbol, depth - 1, leaf, next_leaf);
+        return make_function_application(symbol, {left, right});
+    }
+
+    TermDBPtr balanced_term(const std::string &symbol, std::size_t depth,
+                            const std::function<TermDBPtr(std::size_t)> &leaf)
+    {
+        std::size_t next_leaf = 0;
+        return balanced_term(symbol, depth, leaf, next_leaf);
+    }
+
+    long long term_size_for_depth(std::size_t depth)
+    {
+        return (1LL << (depth + 1)) - 1;
+    }
+
+    TermDBPtr numeral(std::size_t n)
+    {
+        TermDBPtr term = make_constant("0");
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            term = make_function_application("s", {term});
+        }
+        return term;
+    }
+
+    void bench_terms(BenchmarkRunner &runner, const std::vector<std::size_t> &depths)
+    {
+        for (auto depth : depths)
+        {
+            BenchParams params = {{"term_size", term_size_for_depth(depth)}};
+            auto leaf = [](std::size_t i)
+            { return make_constant("c" + std::to_string(i % 8)); };
+
+            runner.run("term/construct", params, [&]()
+                       { do_not_optimize(balanced_term("f", depth, leaf)); });
+
+            auto term = balanced_term("f", depth, leaf);
+            runner.run("term/hash", params, [&]()
+                       { do_not_optimize(term->hash()); });
+            auto copy = term->clone();
+            runner.run("term/equals", params, [&]()
+                       { do_not_optimize(*term == *copy); });
+        }
+    }
+
+    void bench_unify(BenchmarkRunner &runner, const std::vector<std::size_t> &depths)
+    {
+        for (auto depth : depths)
+        {
+            BenchParams params = {{"term_size", term_size_for_depth(depth)}};
+
+            // f-tree over distinct variables against the same shape over constants
+            auto pattern = balanced_term("f", depth, [](std::size_t i)
+                                         { return make_variable(i); });
+            auto ground = balanced_term("f", depth, [](std::size_t i)
+                                        { return make_constant("c" + std::to_string(i % 8)); });
+            runner.run("unify/success", params, [&]()
+                       { do_not_optimize(Unifier::unify(pattern, ground)); });
+
+            // Same, but the last leaf clashes: the whole term is traversed before failing
+            std::size_t leaves = std::size_t(1) << depth;
+            auto clashing = balanced_term("f", depth, [leaves](std::size_t i)
+                                          { return make_constant(i + 1 == leaves ? "z" : "c" + std::to_string(i % 8)); });
+            auto repeated = balanced_term("f", depth, [leaves](std::size_t i)
+                                          { return i + 1 == leaves ? make_constant("c0") : make_variable(i); });
+            runner.run("unify/late_clash", params, [&]()
+                       { do_not_optimize(Unifier::unify(repeated, clashing)); });
+        }
+    }
+
+    void bench_substitute(BenchmarkRunner &runner, const std::vector<std::size_t> &depths)
+    {
+        for (auto depth : depths)
+        {
+            BenchParams params = {{"term_size", term_size_for_depth(depth)}};
+            std::size_t leaves = std::size_t(1) << depth;
+
+            auto term = balanced_term("f", depth, [](std::size_t i)
+                                      { return make_variable(i); });
+            SubstitutionMap subst;
+            for (std::size_t i = 0; i < leaves; ++i)
+            {
+                subst[i] = make_function_application("g", {make_constant("c" + std::to_string(i % 8))});
+            }
+            runner.run("substitute", params, [&]()
+                       { do_not_optimize(SubstitutionEngine::substitute(term, subst)); });
+        }
+    }
+
+    /**
+     * Chain clause P(x0,x1) ∨ P(x1,x2) ∨ ... with k literals, and a shuffled
+     * ground chain of m literals containing an instance of it.
+     */
+    std::pair<ClausePtr, ClausePtr> subsumption_pair(std::size_t k, std::size_t m, std::mt19937 &rng)
+    {
+        std::vector<Literal> general;
+        for (std::size_t i = 0; i < k; ++i)
+        {
+            general.emplace_back(make_function_application("P", {make_variable(i), make_variable(i + 1)}));
+        }
+
+        std::vector<Literal> specific;
+        for (std::size_t i = 0; i < m; ++i)
+        {
+            specific.emplace_back(make_function_application(
+                "P", {make_constant("a" + std::to_string(i)), make_constant("a" + std::to_string(i + 1))}));
+        }
+        std::shuffle(specific.begin(), specific.end(), rng);
+
+        return {std::make_shared<Clause>(general), std::make_shared<Clause>(specific)};
+    }
+
+    void bench_subsumption(BenchmarkRunner &runner, const std::vector<std::size_t> &literal_counts)
+    {
+        std::mt19937 rng(42);
+        for (auto k : literal_counts)
+        {
+            auto [general, specific] = subsumption_pair(k, 2 * k, rng);
+            BenchParams params = {{"literals", static_cast<long long>(k)},
+                                  {"target_literals", static_cast<long long>(2 * k)}};
+            runner.run("subsumes/success", params, [&]()
+                       { do_not_optimize(Clause::subsumes(general, specific)); });
+
+            // Break the chain in the target so the search has to fail
+            std::vector<Literal> broken;
+            for (const auto &lit : specific->literals())
+            {
+                auto func = std::dynamic_pointer_cast<FunctionApplicationDB>(lit.atom());
+                auto first = std::dynamic_pointer_cast<ConstantDB>(func->arguments()[0]);
+                broken.emplace_back(make_function_application(
+                    "P", {func->arguments()[0], make_constant(first->symbol() + "'")}));
+            }
+            auto broken_clause = std::make_shared<Clause>(broken);
+            if (k > 1)
+            {
+                runner.run("subsumes/failure", params, [&]()
+                           { do_not_optimize(Clause::subsumes(general, broken_clause)); });
+            }
+        }
+    }
+
+    void bench_index(BenchmarkRunner &runner, const std::vector<std::size_t> &set_sizes)
+    {
+        const std::size_t predicates = 16;
+        for (auto n : set_sizes)
+        {
+            // 1-3 flat literals over 16 binary predicates, half of the
+            // arguments variables
+            RandomCNFConfig config;
+            config.clauses = n;
+            config.min_literals = 1;
+            config.predicates = predicates;
+            config.functions = 0;
+            config.variables = 8;
+            config.seed = 7;
+            auto clauses = random_cnf(config).refutation_clauses();
+            BenchParams params = {{"set_size", static_cast<long long>(n)},
+                                  {"predicates", static_cast<long long>(predicates)}};
+
+            runner.run("index/insert", params, [&]()
+                       {
+                           LiteralIndex index;
+                           for (const auto &clause : clauses)
+                           {
+                               index.insert_clause(clause);
+                           }
+                           do_not_optimize(index.size()); },
+                       static_cast<double>(n));
+
+            LiteralIndex index;
+            for (const auto &clause : clauses)
+            {
+                index.insert_clause(clause);
+            }
+            Literal query(make_function_application("p0", {make_variable(0), make_constant("c1")}), true);
+            runner.run("index/query", params, [&]()
+                       { do_not_optimize(index.get_resolution_candidates(query)); });
+
+            Clause::LiteralSignature signature = Clause::literal_signature(query);
+            runner.run("index/query_range", params, [&]()
+                       {
+                           std::size_t positions = 0;
+                           for (const auto &entry : index.resolution_candidates(signature))
+                           {
+                               positions += entry.literal;
+                           }
+                           do_not_optimize(positions); });
+        }
+    }
+
+    void bench_normalize(BenchmarkRunner &runner, const std::vector<std::size_t> &numerals)
+    {
+        // Peano addition: plus(0,y) → y, plus(s(x),y) → s(plus(x,y))
+        auto precedence = std::make_shared<Precedence>();
+        precedence->set_greater("plus", "s");
+        auto ordering = make_lpo(precedence);
+
+        RewriteSystem system(ordering);
+        auto x = make_variable(0);
+        auto y = make_variable(1);
+        system.add_rule(TermRewriteRule(make_function_application("plus", {make_constant("0"), y}), y, "plus_zero"));
+        system.add_rule(TermRewriteRule(make_function_application("plus", {make_function_application("s", {x}), y}),
+                                        make_function_application("s", {make_function_application("plus", {x, y})}),
+                                        "plus_succ"));
+
+        for (auto n : numerals)
+        {
+            auto term = make_function_application("plus", {numeral(n), numeral(n)});
+            BenchParams params = {{"term_size", static_cast<long long>(2 * n + 3)},
+                                  {"rewrite_steps", static_cast<long long>(n + 1)}};
+            runner.run("rewrite/normalize", params, [&]()
+                       { do_not_optimize(system.normalize(term)); });
+        }
+    }
+
+    void bench_lpo(BenchmarkRunner &runner, const std::vector<std::size_t> &depths)
+    {
+        auto lpo = make_lpo();
+        for (auto depth : depths)
+        {
+            BenchParams params = {{"term_size", term_size_for_depth(depth)}};
+            auto var_leaf = [](std::size_t i)
+            { return make_variable(i); };
+
+            // Same head symbol: decided by lexicographic comparison of the arguments
+            auto s = balanced_term("f", depth, var_leaf);
+            auto t = make_function_application("f", {balanced_term("f", depth - 1, var_leaf),
+                                                      make_variable(0)});
+            runner.run("lpo/greater", params, [&]()
+                       { do_not_optimize(lpo->greater(s, t)); });
+
+            // Incomparable terms force the full search
+            auto u = balanced_term("g", depth, [](std::size_t i)
+                                   { return make_variable(i + 1); });
+            runner.run("lpo/incomparable", params, [&]()
+                       { do_not_optimize(lpo->greater(s, u)); });
+        }
+    }
+
+    std::vector<TermRewriteRule> group_rules()
+    {
+        // Canonical rewrite system for groups (f = product, i = inverse, e = identity)
+        auto x = make_variable(0);
+        auto y = make_variable(1);
+        auto z = make_variable(2);
+        auto e = make_constant("e");
+        auto f = [](TermDBPtr a, TermDBPtr b)
+        { return make_function_application("f", {a, b}); };
+        auto i = [](TermDBPtr a)
+        { return make_function_application("i", {a}); };
+
+        return {
+            TermRewriteRule(f(e, x), x, "left_identity"),
+            TermRewriteRule(f(i(x), x), e, "left_inverse"),
+            TermRewriteRule(f(f(x, y), z), f(x, f(y, z)), "associativity"),
+            TermRewriteRule(f(i(x), f(x, y)), y, "left_cancel"),
+            TermRewriteRule(f(x, e), x, "right_identity"),
+            TermRewriteRule(i(e), e, "inverse_identity"),
+            TermRewriteRule(i(i(x)), x, "double_inverse"),
+            TermRewriteRule(f(x, i(x)), e, "right_inverse"),
+            TermRewriteRule(f(x, f(i(x), y)), y, "right_cancel"),
+            TermRewriteRule(i(f(x, y)), f(i(y), i(x)), "inverse_product"),
+        };
+    }
+
+    void bench_critical_pairs(BenchmarkRunner &runner, const std::vector<std::size_t> &rule_counts)
+    {
+        auto all_rules = group_rules();
+        for (auto count : rule_counts)
+        {
+            std::vector<TermRewriteRule> rules(all_rules.begin(), all_rules.begin() + count);
+            BenchParams params = {{"set_size", static_cast<long long>(count)}};
+            runner.run("critical_pairs/all", params, [&]()
+                       { do_not_optimize(CriticalPairComputer::compute_all_critical_pairs(rules)); });
+        }
+    }
+
+    /**
+     * Problem text with the given number of quantified FOF axioms over a
+     * pool of 50 predicate and function symbols
+     */
+    std::string tptp_axioms(std::size_t count, std::mt19937 &rng)
+    {
+        std::uniform_int_distribution<int> symbol(0, 49);
+        std::ostringstream text;
+        text << "% Generated axioms\n";
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            text << "fof(ax" << i << ", axiom, ! [X, Y] : (p" << symbol(rng) << "(f" << symbol(rng)
+                 << "(X, c" << symbol(rng) << "), Y) => ? [Z] : (q" << symbol(rng) << "(g"
+                 << symbol(rng) << "(Y), Z) & X != Z))).\n";
+        }
+        return text.str();
+    }
+
+    void bench_parse(BenchmarkRunner &runner, const std::vector<std::size_t> &formula_counts)
+    {
+        for (auto n : formula_counts)
+        {
+            std::mt19937 rng(11);
+            std::string text = tptp_axioms(n, rng);
+            BenchParams params = {{"formulas", static_cast<long long>(n)},
+                                  {"bytes", static_cast<long long>(text.size())}};
+
+            runner.run("parse/tptp", params, [&]()
+                       { do_not_optimize(TPTPParser::parse_string(text).formulas.size()); },
+                       static_cast<double>(text.size()));
+        }
+    }
+
+    /**
+     * Time to refutation on generated problems of growing size
+     */
+    void bench_prove(BenchmarkRunner &runner, const std::vector<std::size_t> &holes,
+                     const std::vector<std::size_t> &chain_lengths)
+    {
+        ResolutionConfig config;
+        config.clause_retention = ResolutionConfig::ClauseRetention::NONE;
+
+        auto run = [&](const std::string &name, const BenchParams &params, const TPTPProblem &problem)
+        {
+            auto clauses = problem.refutation_clauses();
+            runner.run(name, params, [&]()
+                       {
+                           ResolutionProver prover(config);
+                           do_not_optimize(prover.refute(clauses).status); });
+        };
+
+        for (auto n : holes)
+        {
+            auto problem = pigeonhole(n);
+            run("prove/pigeonhole", {{"holes", static_cast<long long>(n)},
+                                     {"clauses", static_cast<long long>(problem.formulas.size())}},
+                problem);
+        }
+        for (auto n : chain_lengths)
+        {
+            auto problem = implication_chain(n, 2, 1);
+            run("prove/implication_chain", {{"length", static_cast<long long>(n)},
+                                            {"clauses", static_cast<long long>(problem.formulas.size())}},
+                problem);
+        }
+    }
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    auto options = BenchOptions::parse(argc, argv);
+    BenchmarkRunner runner("bench_core", options);
+
+    auto pick = [&](std::vector<std::size_t> full)
+    {
+        return options.quick ? std::vector<std::size_t>{full.front()} : full;
+    };
+
+    bench_terms(runner, pick({2, 4, 6, 8}));
+    bench_unify(runner, pick({2, 4, 6, 8}));
+    bench_substitute(runner, pick({2, 4, 6, 8}));
+    bench_subsumption(runner, pick({1, 2, 4, 8, 12}));
+    bench_index(runner, pick({100, 1000, 10000}));
+    bench_normalize(runner, pick({2, 8, 32}));
+    bench_lpo(runner, pick({2, 4, 6}));
+    bench_critical_pairs(runner, pick({3, 6, 10}));
+    bench_parse(runner, pick({100, 1000, 10000}));
+    bench_prove(runner, pick({2, 3, 4}), pick({10, 50, 200}));
+
+    return runner.finish() ? 0 : 1;
+}
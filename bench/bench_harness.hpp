@@ -0,0 +1,370 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace theorem_prover
+{
+    namespace bench
+    {
+
+        /**
+         * Prevent the compiler from optimizing away a computed value
+         */
+        template <typename T>
+        inline void do_not_optimize(const T &value)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            asm volatile("" : : "r,m"(value) : "memory");
+#else
+            static volatile const void *sink;
+            sink = &value;
+#endif
+        }
+
+        /**
+         * Escape a string for inclusion in JSON output
+         */
+        inline std::string json_escape(const std::string &text)
+        {
+            std::ostringstream oss;
+            for (char c : text)
+            {
+                switch (c)
+                {
+                case '"':
+                    oss << "\\\"";
+                    break;
+                case '\\':
+                    oss << "\\\\";
+                    break;
+                case '\n':
+                    oss << "\\n";
+                    break;
+                case '\t':
+                    oss << "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        oss << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                            << static_cast<int>(c) << std::dec << std::setfill(' ');
+                    }
+                    else
+                    {
+                        oss << c;
+                    }
+                }
+            }
+            return oss.str();
+        }
+
+        /**
+         * Named integer parameters of a benchmark case (term_size, set_size, ...)
+         */
+        using BenchParams = std::vector<std::pair<std::string, long long>>;
+
+        /**
+         * Summary statistics over per-operation sample times
+         */
+        struct SampleStats
+        {
+            double min_ns = 0.0;
+            double median_ns = 0.0;
+            double mean_ns = 0.0;
+            double stddev_ns = 0.0;
+            double ci95_ns = 0.0; // Half-width of the 95% confidence interval of the mean
+            double max_ns = 0.0;
+
+            static SampleStats from_samples(std::vector<double> samples)
+            {
+                SampleStats stats;
+                if (samples.empty())
+                {
+                    return stats;
+                }
+
+                std::sort(samples.begin(), samples.end());
+                std::size_t n = samples.size();
+
+                stats.min_ns = samples.front();
+                stats.max_ns = samples.back();
+                stats.median_ns = n % 2 == 1 ? samples[n / 2]
+                                             : (samples[n / 2 - 1] + samples[n / 2]) / 2.0;
+
+                double sum = 0.0;
+                for (double s : samples)
+                {
+                    sum += s;
+                }
+                stats.mean_ns = sum / n;
+
+                if (n > 1)
+                {
+                    double sq = 0.0;
+                    for (double s : samples)
+                    {
+                        sq += (s - stats.mean_ns) * (s - stats.mean_ns);
+                    }
+                    stats.stddev_ns = std::sqrt(sq / (n - 1));
+                    stats.ci95_ns = 1.96 * stats.stddev_ns / std::sqrt(static_cast<double>(n));
+                }
+
+                return stats;
+            }
+        };
+
+        /**
+         * Result of one benchmark case
+         */
+        struct BenchmarkResult
+        {
+            std::string name;
+            BenchParams params;
+            std::size_t iterations_per_sample = 0;
+            std::size_t samples = 0;
+            double items_per_op = 1.0;
+            SampleStats ns_per_op;
+
+            double items_per_second() const
+            {
+                return ns_per_op.median_ns > 0.0 ? items_per_op * 1e9 / ns_per_op.median_ns : 0.0;
+            }
+        };
+
+        /**
+         * Runner options, parsed from the command line
+         */
+        struct BenchOptions
+        {
+            std::size_t samples = 20;      // Timed samples per case
+            double min_sample_ms = 5.0;    // Each sample runs at least this long
+            double warmup_ms = 20.0;       // Untimed warm-up per case
+            std::string filter;            // Substring a case name must contain
+            std::string output_path;       // JSON destination ("" = stdout)
+            bool quick = false;            // Smallest parameters only, few samples
+
+            /**
+             * Parse --samples N, --min-sample-ms X, --warmup-ms X, --filter S,
+             * --out FILE and --quick. Unknown arguments are reported and ignored.
+             */
+            static BenchOptions parse(int argc, char **argv)
+            {
+                BenchOptions options;
+                for (int i = 1; i < argc; ++i)
+                {
+                    std::string arg = argv[i];
+                    auto next = [&]() -> std::string
+                    {
+                        if (i + 1 >= argc)
+                        {
+                            std::cerr << "Missing value for " << arg << std::endl;
+                            std::exit(2);
+                        }
+                        return argv[++i];
+                    };
+
+                    if (arg == "--samples")
+                        options.samples = std::max<std::size_t>(1, std::stoul(next()));
+                    else if (arg == "--min-sample-ms")
+                        options.min_sample_ms = std::stod(next());
+                    else if (arg == "--warmup-ms")
+                        options.warmup_ms = std::stod(next());
+                    else if (arg == "--filter")
+                        options.filter = next();
+                    else if (arg == "--out")
+                        options.output_path = next();
+                    else if (arg == "--quick")
+                    {
+                        options.quick = true;
+                        options.samples = 5;
+                        options.min_sample_ms = 1.0;
+                        options.warmup_ms = 2.0;
+                    }
+                    else
+                        std::cerr << "Ignoring unknown argument: " << arg << std::endl;
+                }
+                return options;
+            }
+        };
+
+        /**
+         * Minimal microbenchmark runner
+         *
+         * Each case is warmed up, then the number of iterations per sample is
+         * calibrated so a sample lasts at least min_sample_ms; the reported
+         * figures are per-operation times over the timed samples. Progress goes
+         * to stderr, results are written as JSON.
+         */
+        class BenchmarkRunner
+        {
+        public:
+            BenchmarkRunner(const std::string &suite, const BenchOptions &options)
+                : suite_(suite), options_(options) {}
+
+            const BenchOptions &options() const { return options_; }
+
+            /**
+             * Run one case
+             *
+             * @param name Case name (used by --filter)
+             * @param params Parameters identifying the case
+             * @param op One operation; called many times
+             * @param items_per_op Work items per call, for throughput figures
+             */
+            void run(const std::string &name, const BenchParams &params,
+                     const std::function<void()> &op, double items_per_op = 1.0)
+            {
+                if (!options_.filter.empty() && name.find(options_.filter) == std::string::npos)
+                {
+                    return;
+                }
+
+                using clock = std::chrono::steady_clock;
+                auto elapsed_ns = [](clock::time_point start)
+                {
+                    return static_cast<double>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+                };
+
+                // Warm up caches and allocator, and get a first cost estimate
+                std::size_t warm_iterations = 0;
+                auto warm_start = clock::now();
+                do
+                {
+                    op();
+                    ++warm_iterations;
+                } while (elapsed_ns(warm_start) < options_.warmup_ms * 1e6);
+                double estimate_ns = elapsed_ns(warm_start) / warm_iterations;
+
+                std::size_t iterations = static_cast<std::size_t>(
+                    std::ceil(options_.min_sample_ms * 1e6 / std::max(estimate_ns, 1.0)));
+                iterations = std::max<std::size_t>(1, iterations);
+
+                std::vector<double> per_op;
+                per_op.reserve(options_.samples);
+                for (std::size_t s = 0; s < options_.samples; ++s)
+                {
+                    auto start = clock::now();
+                    for (std::size_t i = 0; i < iterations; ++i)
+                    {
+                        op();
+                    }
+                    per_op.push_back(elapsed_ns(start) / iterations);
+                }
+
+                BenchmarkResult result;
+                result.name = name;
+                result.params = params;
+                result.iterations_per_sample = iterations;
+                result.samples = per_op.size();
+                result.items_per_op = items_per_op;
+                result.ns_per_op = SampleStats::from_samples(per_op);
+
+                std::cerr << std::left << std::setw(28) << name << std::setw(28) << params_to_string(params)
+                          << std::right << std::fixed << std::setprecision(1)
+                          << std::setw(14) << result.ns_per_op.median_ns << " ns/op  ±"
+                          << std::setprecision(1) << std::setw(5)
+                          << (result.ns_per_op.mean_ns > 0 ? 100.0 * result.ns_per_op.ci95_ns / result.ns_per_op.mean_ns : 0.0)
+                          << "%" << std::endl;
+
+                results_.push_back(result);
+            }
+
+            const std::vector<BenchmarkResult> &results() const { return results_; }
+
+            /**
+             * Write all results as a JSON document
+             */
+            void write_json(std::ostream &out) const
+            {
+                out << "{\n  \"context\": {\n";
+                out << "    \"suite\": \"" << json_escape(suite_) << "\",\n";
+                out << "    \"timestamp\": " << static_cast<long long>(std::time(nullptr)) << ",\n";
+#ifdef __OPTIMIZE__
+                out << "    \"optimized\": true,\n";
+#else
+                out << "    \"optimized\": false,\n";
+#endif
+                out << "    \"samples\": " << options_.samples << ",\n";
+                out << "    \"min_sample_ms\": " << options_.min_sample_ms << "\n";
+                out << "  },\n  \"benchmarks\": [";
+
+                out << std::setprecision(3) << std::fixed;
+                for (std::size_t i = 0; i < results_.size(); ++i)
+                {
+                    const auto &r = results_[i];
+                    out << (i == 0 ? "\n" : ",\n");
+                    out << "    {\"name\": \"" << json_escape(r.name) << "\", \"params\": {";
+                    for (std::size_t p = 0; p < r.params.size(); ++p)
+                    {
+                        out << (p == 0 ? "" : ", ") << "\"" << json_escape(r.params[p].first)
+                            << "\": " << r.params[p].second;
+                    }
+                    out << "}, \"iterations_per_sample\": " << r.iterations_per_sample
+                        << ", \"samples\": " << r.samples
+                        << ", \"ns_per_op\": {\"min\": " << r.ns_per_op.min_ns
+                        << ", \"median\": " << r.ns_per_op.median_ns
+                        << ", \"mean\": " << r.ns_per_op.mean_ns
+                        << ", \"stddev\": " << r.ns_per_op.stddev_ns
+                        << ", \"ci95\": " << r.ns_per_op.ci95_ns
+                        << ", \"max\": " << r.ns_per_op.max_ns
+                        << "}, \"items_per_second\": " << r.items_per_second() << "}";
+                }
+                out << "\n  ]\n}\n";
+            }
+
+            /**
+             * Write JSON to options().output_path, or stdout when unset
+             * @return false if the output file could not be written
+             */
+            bool finish() const
+            {
+#ifndef __OPTIMIZE__
+                std::cerr << "Warning: benchmarks were built without optimization" << std::endl;
+#endif
+                if (options_.output_path.empty())
+                {
+                    write_json(std::cout);
+                    return true;
+                }
+
+                std::ofstream file(options_.output_path);
+                if (!file)
+                {
+                    std::cerr << "Cannot write " << options_.output_path << std::endl;
+                    return false;
+                }
+                write_json(file);
+                return true;
+            }
+
+        private:
+            std::string suite_;
+            BenchOptions options_;
+            std::vector<BenchmarkResult> results_;
+
+            static std::string params_to_string(const BenchParams &params)
+            {
+                std::ostringstream oss;
+                for (std::size_t i = 0; i < params.size(); ++i)
+                {
+                    oss << (i == 0 ? "" : " ") << params[i].first << "=" << params[i].second;
+                }
+                return oss.str();
+            }
+        };
+
+    } // namespace bench
+} // namespace theorem_prover
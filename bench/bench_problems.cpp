@@ -0,0 +1,818 @@
+// Problem-suite benchmark runner
+//
+// Runs every problem of a directory (TPTP FOF/CNF files) under one or more
+// prover configurations. Each (problem, configuration) pair runs in its own
+// forked process, so a runaway search can be killed at its deadline and its
+// peak memory measured in isolation.
+//
+//   bench_problems [options] <directory|file>...
+//     --config NAMES     Comma-separated presets: basic, paramod, kb, model,
+//                        auto (default: all)
+//     --generate SPEC    Add a generated problem, e.g. pigeonhole:holes=5 or
+//                        random_cnf:clauses=100000,k=3,seed=7 (repeatable; see
+//                        problem_generators.hpp)
+//     --dump DIR         Also write the generated problems to DIR as TPTP
+//     --record DIR       Record each run's search as DIR/<problem>.<config>.trace
+//                        for bench_replay
+//     --kb-cache DIR     Share KB preprocessing results between runs through
+//                        DIR (see CompletionCache)
+//     --jobs N           Worker processes (default: number of cores)
+//     --timeout SEC      Per-problem wall-clock limit (default: 30)
+//     --filter S         Only problems whose name contains S
+//     --csv FILE         Write results as CSV
+//     --json FILE        Write results as JSON (usable as a later --baseline)
+//     --baseline FILE    Compare with an earlier --json run; exit 1 on regressions
+//     --tolerance F      Allowed relative slowdown (default: 0.25)
+//     --min-delta-ms X   Ignore slowdowns smaller than this (default: 10)
+//     --verbose          Keep the prover's own output
+//
+// Exit status: 0 if all went well, 1 on regressions or unsound answers,
+// 2 on usage errors.
+
+#include "bench_harness.hpp"
+#include "problem_generators.hpp"
+#include "../src/parser/tptp_parser.hpp"
+#include "../src/resolution/resolution_prover.hpp"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <dirent.h>
+#include <map>
+#include <set>
+#include <thread>
+#include <tuple>
+
+using namespace theorem_prover;
+using namespace theorem_prover::bench;
+
+namespace
+{
+
+    struct NamedConfig
+    {
+        std::string name;
+        ResolutionConfig config;
+    };
+
+    /**
+     * Configurations compared by the suite. Limits match the former
+     * hardcoded challenging-problem benchmark.
+     */
+    std::vector<NamedConfig> config_presets(double timeout_seconds)
+    {
+        ResolutionConfig base;
+        base.max_iterations = 3000;
+        base.max_time_ms = timeout_seconds * 1000.0;
+        base.max_clauses = 50000;
+        base.clause_retention = ResolutionConfig::ClauseRetention::NONE;
+
+        ResolutionConfig basic = base;
+        basic.use_paramodulation = false;
+        basic.use_kb_preprocessing = false;
+
+        ResolutionConfig paramod = base;
+        paramod.use_paramodulation = true;
+        paramod.use_kb_preprocessing = false;
+
+        ResolutionConfig kb = paramod;
+        kb.use_kb_preprocessing = true;
+        kb.kb_preprocessing_timeout = 10.0;
+        kb.kb_max_equations = 25;
+        kb.kb_max_rules = 50;
+
+        ResolutionConfig model = paramod;
+        model.use_model_finder = true;
+
+        ResolutionConfig automatic = base;
+        automatic.use_auto_strategy = true;
+
+        return {{"basic", basic}, {"paramod", paramod}, {"kb", kb}, {"model", model}, {"auto", automatic}};
+    }
+
+    struct Options
+    {
+        std::vector<std::string> inputs;
+        std::vector<std::string> generators;
+        std::string dump_directory;
+        std::string record_directory;
+        std::string kb_cache_directory;
+        std::vector<std::string> configs;
+        std::size_t jobs = std::max(1u, std::thread::hardware_concurrency());
+        double timeout_seconds = 30.0;
+        std::string filter;
+        std::string csv_path;
+        std::string json_path;
+        std::string baseline_path;
+        double tolerance = 0.25;
+        double min_delta_ms = 10.0;
+        bool verbose = false;
+    };
+
+    std::vector<std::string> split(const std::string &text, char separator)
+    {
+        std::vector<std::string> parts;
+        std::stringstream stream(text);
+        std::string part;
+        while (std::getline(stream, part, separator))
+        {
+            if (!part.empty())
+            {
+                parts.push_back(part);
+            }
+        }
+        return parts;
+    }
+
+    Options parse_options(int argc, char **argv)
+    {
+        Options options;
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            auto next = [&]() -> std::string
+            {
+                if (i + 1 >= argc)
+                {
+                    std::cerr << "Missing value for " << arg << std::endl;
+                    std::exit(2);
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--config")
+                options.configs = split(next(), ',');
+            else if (arg == "--generate")
+                options.generators.push_back(next());
+            else if (arg == "--dump")
+                options.dump_directory = next();
+            else if (arg == "--record")
+                options.record_directory = next();
+            else if (arg == "--kb-cache")
+                options.kb_cache_directory = next();
+            else if (arg == "--jobs")
+                options.jobs = std::max<std::size_t>(1, std::stoul(next()));
+            else if (arg == "--timeout")
+                options.timeout_seconds = std::stod(next());
+            else if (arg == "--filter")
+                options.filter = next();
+            else if (arg == "--csv")
+                options.csv_path = next();
+            else if (arg == "--json")
+                options.json_path = next();
+            else if (arg == "--baseline")
+                options.baseline_path = next();
+            else if (arg == "--tolerance")
+                options.tolerance = std::stod(next());
+            else if (arg == "--min-delta-ms")
+                options.min_delta_ms = std::stod(next());
+            else if (arg == "--verbose")
+                options.verbose = true;
+            else if (!arg.empty() && arg[0] == '-')
+            {
+                std::cerr << "Unknown option: " << arg << std::endl;
+                std::exit(2);
+            }
+            else
+                options.inputs.push_back(arg);
+        }
+
+        if (options.inputs.empty() && options.generators.empty())
+        {
+            std::cerr << "Usage: " << argv[0] << " [options] <directory|file>... (or --generate SPEC)" << std::endl;
+            std::exit(2);
+        }
+        return options;
+    }
+
+    /**
+     * Problem files named on the command line, directories expanded to
+     * their *.p files, sorted for a stable run order
+     */
+    std::vector<std::string> collect_problem_files(const std::vector<std::string> &inputs)
+    {
+        std::vector<std::string> files;
+        for (const auto &input : inputs)
+        {
+            DIR *dir = opendir(input.c_str());
+            if (!dir)
+            {
+                files.push_back(input);
+                continue;
+            }
+
+            std::vector<std::string> entries;
+            while (dirent *entry = readdir(dir))
+            {
+                std::string name = entry->d_name;
+                if (name.size() > 2 && name.compare(name.size() - 2, 2, ".p") == 0)
+                {
+                    entries.push_back(input + "/" + name);
+                }
+            }
+            closedir(dir);
+            std::sort(entries.begin(), entries.end());
+            files.insert(files.end(), entries.begin(), entries.end());
+        }
+        return files;
+    }
+
+    std::string status_name(ResolutionProofResult::Status status)
+    {
+        switch (status)
+        {
+        case ResolutionProofResult::Status::PROVED:
+            return "PROVED";
+        case ResolutionProofResult::Status::DISPROVED:
+            return "DISPROVED";
+        case ResolutionProofResult::Status::TIMEOUT:
+            return "TIMEOUT";
+        case ResolutionProofResult::Status::SATURATED:
+            return "SATURATED";
+        default:
+            return "UNKNOWN";
+        }
+    }
+
+    struct RunResult
+    {
+        std::string problem;
+        std::string config;
+        std::string expected; // TPTP status from the problem header
+        std::string status;   // Prover status, or TIMEOUT / CRASHED / ERROR
+        double time_ms = 0.0;
+        std::size_t iterations = 0;
+        std::size_t final_clauses = 0;
+        long max_rss_kb = 0;
+        std::string message;
+
+        bool proved() const { return status == "PROVED"; }
+        bool disproved() const { return status == "DISPROVED"; }
+        bool solved() const { return proved() || disproved(); }
+
+        /**
+         * A refutation was found for a problem known to be satisfiable, or
+         * a countermodel for a problem known to be unsatisfiable
+         */
+        bool unsound() const
+        {
+            return (proved() && (expected == "CounterSatisfiable" || expected == "Satisfiable")) ||
+                   (disproved() && (expected == "Theorem" || expected == "Unsatisfiable"));
+        }
+    };
+
+    /**
+     * Child process body: run the prover and report one line on the pipe
+     */
+    [[noreturn]] void run_child(const TPTPProblem &problem, const ResolutionConfig &config,
+                                int fd, bool verbose)
+    {
+        if (!verbose)
+        {
+            int null_fd = open("/dev/null", O_WRONLY);
+            if (null_fd >= 0)
+            {
+                dup2(null_fd, STDOUT_FILENO);
+                close(null_fd);
+            }
+        }
+
+        std::ostringstream report;
+        try
+        {
+            ResolutionProver prover(config);
+            auto start = std::chrono::steady_clock::now();
+            auto result = problem.is_fof() && problem.conjecture()
+                              ? prover.prove(problem.conjecture(), problem.hypotheses())
+                              : prover.refute(problem.refutation_clauses());
+            double time_ms = std::chrono::duration<double, std::milli>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+
+            report << status_name(result.status) << " " << time_ms << " " << result.iterations
+                   << " " << result.final_clause_count << "\n";
+        }
+        catch (const std::exception &e)
+        {
+            report << "ERROR 0 0 0 " << e.what() << "\n";
+        }
+
+        std::string line = report.str();
+        ssize_t written = write(fd, line.data(), line.size());
+        (void)written;
+        close(fd);
+        std::fflush(stdout);
+        _exit(0);
+    }
+
+    struct RunningJob
+    {
+        pid_t pid;
+        int fd;
+        std::chrono::steady_clock::time_point deadline;
+        RunResult result;
+        std::string output;
+    };
+
+    /**
+     * Collect a finished child: parse its report and resource usage
+     */
+    void finish_job(RunningJob &job, int wait_status, const rusage &usage, bool killed)
+    {
+        char buffer[4096];
+        ssize_t n;
+        while ((n = read(job.fd, buffer, sizeof(buffer))) > 0)
+        {
+            job.output.append(buffer, static_cast<std::size_t>(n));
+        }
+        close(job.fd);
+
+#ifdef __APPLE__
+        job.result.max_rss_kb = usage.ru_maxrss / 1024;
+#else
+        job.result.max_rss_kb = usage.ru_maxrss;
+#endif
+
+        RunResult &result = job.result;
+        if (killed)
+        {
+            result.status = "TIMEOUT";
+            result.message = "killed at the wall-clock limit";
+            return;
+        }
+        if (WIFSIGNALED(wait_status))
+        {
+            result.status = "CRASHED";
+            result.message = "signal " + std::to_string(WTERMSIG(wait_status));
+            return;
+        }
+
+        std::istringstream report(job.output);
+        if (!(report >> result.status >> result.time_ms >> result.iterations >> result.final_clauses))
+        {
+            result.status = "CRASHED";
+            result.message = "no report from worker";
+            return;
+        }
+        std::getline(report >> std::ws, result.message);
+    }
+
+    void print_result(const RunResult &r)
+    {
+        std::cerr << std::left << std::setw(36) << r.problem << std::setw(10) << r.config
+                  << std::setw(11) << r.status << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << r.time_ms << " ms" << std::setw(8) << r.iterations << " it"
+                  << std::setw(8) << r.final_clauses << " cl" << std::setw(8) << r.max_rss_kb / 1024
+                  << " MB";
+        if (!r.message.empty())
+        {
+            std::cerr << "  " << r.message;
+        }
+        if (r.unsound())
+        {
+            std::cerr << "  UNSOUND (expected " << r.expected << ")";
+        }
+        std::cerr << std::endl;
+    }
+
+    struct Job
+    {
+        const TPTPProblem *problem;
+        const NamedConfig *config;
+    };
+
+    /**
+     * Run all jobs with at most options.jobs children at a time
+     */
+    std::vector<RunResult> run_jobs(const std::vector<Job> &jobs, const Options &options)
+    {
+        using clock = std::chrono::steady_clock;
+        // The prover stops itself at the time limit; the kill is a backstop
+        // for phases that do not check it (CNF conversion, KB preprocessing)
+        auto limit = std::chrono::duration_cast<clock::duration>(
+            std::chrono::duration<double>(options.timeout_seconds + 1.0));
+
+        std::vector<RunResult> results;
+        std::map<pid_t, RunningJob> running;
+        std::size_t next = 0;
+
+        while (next < jobs.size() || !running.empty())
+        {
+            while (next < jobs.size() && running.size() < options.jobs)
+            {
+                const Job &job = jobs[next++];
+                int fds[2];
+                if (pipe(fds) != 0)
+                {
+                    perror("pipe");
+                    std::exit(2);
+                }
+
+                std::cout.flush();
+                std::cerr.flush();
+                pid_t pid = fork();
+                if (pid < 0)
+                {
+                    perror("fork");
+                    std::exit(2);
+                }
+                if (pid == 0)
+                {
+                    close(fds[0]);
+                    ResolutionConfig config = job.config->config;
+                    if (!options.record_directory.empty())
+                    {
+                        config.trace_file = options.record_directory + "/" + job.problem->name + "." +
+                                            job.config->name + ".trace";
+                    }
+                    config.kb_cache_directory = options.kb_cache_directory;
+                    run_child(*job.problem, config, fds[1], options.verbose);
+                }
+                close(fds[1]);
+
+                RunningJob entry{pid, fds[0], clock::now() + limit, RunResult(), ""};
+                entry.result.problem = job.problem->name;
+                entry.result.config = job.config->name;
+                entry.result.expected = job.problem->expected_status;
+                running.emplace(pid, std::move(entry));
+            }
+
+            int wait_status = 0;
+            rusage usage{};
+            pid_t pid = wait4(-1, &wait_status, WNOHANG, &usage);
+            if (pid > 0)
+            {
+                auto it = running.find(pid);
+                if (it != running.end())
+                {
+                    finish_job(it->second, wait_status, usage, false);
+                    print_result(it->second.result);
+                    results.push_back(it->second.result);
+                    running.erase(it);
+                }
+                continue;
+            }
+
+            auto now = clock::now();
+            for (auto it = running.begin(); it != running.end();)
+            {
+                if (now < it->second.deadline)
+                {
+                    ++it;
+                    continue;
+                }
+                kill(it->first, SIGKILL);
+                wait4(it->first, &wait_status, 0, &usage);
+                finish_job(it->second, wait_status, usage, true);
+                it->second.result.time_ms =
+                    std::chrono::duration<double, std::milli>(limit).count();
+                print_result(it->second.result);
+                results.push_back(it->second.result);
+                it = running.erase(it);
+            }
+            usleep(1000);
+        }
+
+        std::sort(results.begin(), results.end(), [](const RunResult &a, const RunResult &b)
+                  { return std::tie(a.problem, a.config) < std::tie(b.problem, b.config); });
+        return results;
+    }
+
+    std::string csv_field(const std::string &text)
+    {
+        if (text.find_first_of(",\"\n") == std::string::npos)
+        {
+            return text;
+        }
+        std::string quoted = "\"";
+        for (char c : text)
+        {
+            quoted += c == '"' ? std::string("\"\"") : std::string(1, c);
+        }
+        return quoted + "\"";
+    }
+
+    void write_csv(std::ostream &out, const std::vector<RunResult> &results)
+    {
+        out << "problem,config,expected,status,time_ms,iterations,final_clauses,max_rss_kb,message\n";
+        out << std::fixed << std::setprecision(3);
+        for (const auto &r : results)
+        {
+            out << csv_field(r.problem) << "," << csv_field(r.config) << "," << csv_field(r.expected)
+                << "," << r.status << "," << r.time_ms << "," << r.iterations << ","
+                << r.final_clauses << "," << r.max_rss_kb << "," << csv_field(r.message) << "\n";
+        }
+    }
+
+    /**
+     * One result object per line, so read_baseline can scan it without a
+     * full JSON parser
+     */
+    void write_json(std::ostream &out, const std::vector<RunResult> &results, const Options &options)
+    {
+        out << "{\n  \"context\": {\n";
+        out << "    \"suite\": \"problems\",\n";
+        out << "    \"timestamp\": " << static_cast<long long>(std::time(nullptr)) << ",\n";
+#ifdef __OPTIMIZE__
+        out << "    \"optimized\": true,\n";
+#else
+        out << "    \"optimized\": false,\n";
+#endif
+        out << "    \"timeout_s\": " << options.timeout_seconds << "\n";
+        out << "  },\n  \"results\": [";
+
+        out << std::fixed << std::setprecision(3);
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const auto &r = results[i];
+            out << (i == 0 ? "\n" : ",\n");
+            out << "    {\"problem\": \"" << json_escape(r.problem) << "\", \"config\": \""
+                << json_escape(r.config) << "\", \"expected\": \"" << json_escape(r.expected)
+                << "\", \"status\": \"" << r.status << "\", \"time_ms\": " << r.time_ms
+                << ", \"iterations\": " << r.iterations << ", \"final_clauses\": " << r.final_clauses
+                << ", \"max_rss_kb\": " << r.max_rss_kb << ", \"message\": \""
+                << json_escape(r.message) << "\"}";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    std::string json_string_field(const std::string &line, const std::string &key)
+    {
+        std::string pattern = "\"" + key + "\": \"";
+        std::size_t start = line.find(pattern);
+        if (start == std::string::npos)
+        {
+            return "";
+        }
+        start += pattern.size();
+        std::size_t end = start;
+        while (end < line.size() && line[end] != '"')
+        {
+            end += line[end] == '\\' ? 2 : 1;
+        }
+        return line.substr(start, end - start);
+    }
+
+    double json_number_field(const std::string &line, const std::string &key)
+    {
+        std::string pattern = "\"" + key + "\": ";
+        std::size_t start = line.find(pattern);
+        return start == std::string::npos ? 0.0 : std::atof(line.c_str() + start + pattern.size());
+    }
+
+    /**
+     * Read a file written by --json
+     */
+    std::map<std::pair<std::string, std::string>, RunResult> read_baseline(const std::string &path)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            std::cerr << "Cannot read baseline " << path << std::endl;
+            std::exit(2);
+        }
+
+        std::map<std::pair<std::string, std::string>, RunResult> baseline;
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.find("\"problem\": ") == std::string::npos)
+            {
+                continue;
+            }
+            RunResult r;
+            r.problem = json_string_field(line, "problem");
+            r.config = json_string_field(line, "config");
+            r.status = json_string_field(line, "status");
+            r.time_ms = json_number_field(line, "time_ms");
+            baseline[{r.problem, r.config}] = r;
+        }
+        return baseline;
+    }
+
+    /**
+     * Report lost proofs and slowdowns against the baseline. Baseline runs
+     * within the selected configurations and filter that have no result
+     * now (e.g. their problem no longer parses) count as lost, as do runs
+     * that now end in ERROR.
+     * @return Number of regressions
+     */
+    std::size_t compare_with_baseline(const std::vector<RunResult> &results, const Options &options)
+    {
+        auto baseline = read_baseline(options.baseline_path);
+        std::size_t regressions = 0, improvements = 0, compared = 0;
+
+        std::cerr << "\nComparison with " << options.baseline_path << " (tolerance "
+                  << std::setprecision(0) << options.tolerance * 100 << "%, min delta "
+                  << options.min_delta_ms << " ms)" << std::endl;
+        std::cerr << std::setprecision(1);
+
+        std::set<std::pair<std::string, std::string>> current;
+        for (const auto &r : results)
+        {
+            current.insert({r.problem, r.config});
+            auto it = baseline.find({r.problem, r.config});
+            if (it == baseline.end())
+            {
+                continue;
+            }
+            const RunResult &base = it->second;
+            ++compared;
+
+            if ((base.solved() && !r.solved()) || (r.status == "ERROR" && base.status != "ERROR"))
+            {
+                std::cerr << "  REGRESSION " << r.problem << " [" << r.config << "]: "
+                          << base.status << " -> " << r.status << std::endl;
+                ++regressions;
+            }
+            else if (!base.solved() && r.solved())
+            {
+                std::cerr << "  improved   " << r.problem << " [" << r.config << "]: "
+                          << base.status << " -> " << r.status << std::endl;
+                ++improvements;
+            }
+            else if (base.solved() && r.solved())
+            {
+                double delta = r.time_ms - base.time_ms;
+                if (delta > options.min_delta_ms && r.time_ms > base.time_ms * (1.0 + options.tolerance))
+                {
+                    std::cerr << "  SLOWER     " << r.problem << " [" << r.config << "]: "
+                              << base.time_ms << " -> " << r.time_ms << " ms" << std::endl;
+                    ++regressions;
+                }
+                else if (-delta > options.min_delta_ms &&
+                         base.time_ms > r.time_ms * (1.0 + options.tolerance))
+                {
+                    std::cerr << "  faster     " << r.problem << " [" << r.config << "]: "
+                              << base.time_ms << " -> " << r.time_ms << " ms" << std::endl;
+                    ++improvements;
+                }
+            }
+        }
+
+        for (const auto &[key, base] : baseline)
+        {
+            const auto &[problem, config] = key;
+            bool selected = config == "-" || options.configs.empty() ||
+                            std::find(options.configs.begin(), options.configs.end(), config) != options.configs.end();
+            if (!selected || problem.find(options.filter) == std::string::npos || current.count(key))
+            {
+                continue;
+            }
+            std::cerr << "  MISSING    " << problem << " [" << config << "]: " << base.status
+                      << " -> no result" << std::endl;
+            ++regressions;
+        }
+
+        std::cerr << compared << " compared, " << regressions << " regressions, " << improvements
+                  << " improvements" << std::endl;
+        return regressions;
+    }
+
+    bool write_file(const std::string &path, const std::function<void(std::ostream &)> &writer)
+    {
+        std::ofstream file(path);
+        if (!file)
+        {
+            std::cerr << "Cannot write " << path << std::endl;
+            return false;
+        }
+        writer(file);
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options = parse_options(argc, argv);
+
+    std::vector<NamedConfig> configs;
+    for (const auto &preset : config_presets(options.timeout_seconds))
+    {
+        if (options.configs.empty() ||
+            std::find(options.configs.begin(), options.configs.end(), preset.name) != options.configs.end())
+        {
+            configs.push_back(preset);
+        }
+    }
+    if (configs.empty())
+    {
+        std::cerr << "No configuration selected (available: basic, paramod, kb, model, auto)" << std::endl;
+        return 2;
+    }
+
+    // Parse up front; workers inherit the parsed problems through fork
+    std::vector<TPTPProblem> problems;
+    std::vector<RunResult> results;
+    for (const auto &path : collect_problem_files(options.inputs))
+    {
+        try
+        {
+            TPTPProblem problem = TPTPParser::parse_file(path);
+            if (options.filter.empty() || problem.name.find(options.filter) != std::string::npos)
+            {
+                problems.push_back(std::move(problem));
+            }
+        }
+        catch (const TPTPParseError &e)
+        {
+            RunResult r;
+            r.problem = path;
+            r.config = "-";
+            r.status = "ERROR";
+            r.message = e.what();
+            print_result(r);
+            results.push_back(r);
+        }
+    }
+
+    for (const auto &spec : options.generators)
+    {
+        TPTPProblem problem;
+        try
+        {
+            problem = generate_problem(spec);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "--generate " << spec << ": " << e.what() << std::endl;
+            return 2;
+        }
+
+        if (!options.dump_directory.empty())
+        {
+            std::string path = options.dump_directory + "/" + problem.name + ".p";
+            std::ofstream out(path);
+            write_tptp(out, problem);
+            if (!out)
+            {
+                std::cerr << "Cannot write " << path << std::endl;
+                return 2;
+            }
+        }
+        if (options.filter.empty() || problem.name.find(options.filter) != std::string::npos)
+        {
+            problems.push_back(std::move(problem));
+        }
+    }
+
+    std::vector<Job> jobs;
+    for (const auto &problem : problems)
+    {
+        for (const auto &config : configs)
+        {
+            jobs.push_back({&problem, &config});
+        }
+    }
+
+#ifndef __OPTIMIZE__
+    std::cerr << "Warning: built without optimization" << std::endl;
+#endif
+    std::cerr << problems.size() << " problems x " << configs.size() << " configurations, "
+              << options.jobs << " jobs, " << options.timeout_seconds << " s timeout\n"
+              << std::endl;
+
+    auto run = run_jobs(jobs, options);
+    results.insert(results.end(), run.begin(), run.end());
+
+    std::size_t proved = 0, disproved = 0, unsound = 0;
+    for (const auto &r : results)
+    {
+        proved += r.proved() ? 1 : 0;
+        disproved += r.disproved() ? 1 : 0;
+        unsound += r.unsound() ? 1 : 0;
+    }
+    std::cerr << "\n"
+              << proved << "/" << results.size() << " runs proved";
+    if (disproved > 0)
+    {
+        std::cerr << ", " << disproved << " disproved";
+    }
+    if (unsound > 0)
+    {
+        std::cerr << ", " << unsound << " UNSOUND";
+    }
+    std::cerr << std::endl;
+
+    bool ok = unsound == 0;
+    if (!options.csv_path.empty())
+        ok = write_file(options.csv_path, [&](std::ostream &out)
+                        { write_csv(out, results); }) && ok;
+    if (!options.json_path.empty())
+        ok = write_file(options.json_path, [&](std::ostream &out)
+                        { write_json(out, results, options); }) && ok;
+    if (options.csv_path.empty() && options.json_path.empty())
+        write_csv(std::cout, results);
+
+    if (!options.baseline_path.empty() && compare_with_baseline(results, options) > 0)
+    {
+        ok = false;
+    }
+
+    return ok ? 0 : 1;
+}
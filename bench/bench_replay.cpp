@@ -0,0 +1,107 @@
+// Search trace replay
+//
+// Replays search traces (recorded through ResolutionConfig::trace_file, or
+// bench_problems --record) and times them. A replay repeats the recorded
+// sequence of given clauses, so two builds can be compared, or one
+// profiled, on exactly the same inferences.
+//
+//   bench_replay [options] <trace>...
+//     --repeat N         Replays per trace; the fastest is reported (default: 3)
+//
+// Exit status: 0 if every replay reached the recorded outcome, 1 if one
+// diverged, 2 on usage errors or unreadable traces.
+
+#include "../src/resolution/search_trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+using namespace theorem_prover;
+
+namespace
+{
+
+    std::string status_name(ResolutionProofResult::Status status)
+    {
+        switch (status)
+        {
+        case ResolutionProofResult::Status::PROVED:
+            return "PROVED";
+        case ResolutionProofResult::Status::DISPROVED:
+            return "DISPROVED";
+        case ResolutionProofResult::Status::TIMEOUT:
+            return "TIMEOUT";
+        case ResolutionProofResult::Status::SATURATED:
+            return "SATURATED";
+        default:
+            return "UNKNOWN";
+        }
+    }
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::size_t repeat = 3;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--repeat" && i + 1 < argc)
+            repeat = std::max<std::size_t>(1, std::stoul(argv[++i]));
+        else if (!arg.empty() && arg[0] == '-')
+        {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return 2;
+        }
+        else
+            paths.push_back(arg);
+    }
+    if (paths.empty())
+    {
+        std::cerr << "Usage: " << argv[0] << " [--repeat N] <trace>..." << std::endl;
+        return 2;
+    }
+
+#ifndef __OPTIMIZE__
+    std::cerr << "Warning: built without optimization" << std::endl;
+#endif
+
+    int exit_status = 0;
+    for (const auto &path : paths)
+    {
+        SearchTrace trace;
+        try
+        {
+            trace = SearchTrace::load(path);
+        }
+        catch (const SerializationError &e)
+        {
+            std::cerr << e.what() << std::endl;
+            return 2;
+        }
+
+        double best_ms = std::numeric_limits<double>::infinity();
+        ResolutionProofResult result(ResolutionProofResult::Status::UNKNOWN);
+        for (std::size_t run = 0; run < repeat; ++run)
+        {
+            auto start = std::chrono::steady_clock::now();
+            result = ResolutionProver::replay(trace);
+            best_ms = std::min(best_ms, std::chrono::duration<double, std::milli>(
+                                            std::chrono::steady_clock::now() - start)
+                                            .count());
+        }
+
+        bool reproduced = result.status == trace.status;
+        exit_status = reproduced ? exit_status : 1;
+        std::cout << std::left << std::setw(40) << path << std::right << " " << std::setw(9)
+                  << status_name(result.status) << " " << std::fixed << std::setprecision(1) << std::setw(10)
+                  << best_ms << " ms " << std::setw(8) << trace.selections.size() << " given "
+                  << std::setw(8) << result.final_clause_count << " cl"
+                  << (reproduced ? "" : "  DIVERGED: " + result.explanation) << std::endl;
+    }
+    return exit_status;
+}
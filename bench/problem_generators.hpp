@@ -0,0 +1,519 @@
+#pragma once
+
+// Seeded generators for clause-set workloads of controllable size.
+//
+// Every generator returns a CNF TPTPProblem, so generated problems run
+// through the same paths as problem files (bench_problems --generate) and
+// can be written out as TPTP (write_tptp) for other provers. The same
+// parameters and seed always give the same problem, with any standard
+// library (see detail::Random).
+
+#include "../src/parser/tptp_parser.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace theorem_prover
+{
+    namespace bench
+    {
+
+        /**
+         * Shape of a random first-order clause set
+         *
+         * Literals use predicates p0.. of fixed arity; their arguments are
+         * variables, constants c0.. or applications of functions f0.. nested
+         * up to max_depth. With functions = 0 or max_depth = 0 all atoms are
+         * flat.
+         */
+        struct RandomCNFConfig
+        {
+            std::size_t clauses = 1000;
+            std::size_t min_literals = 3;      // Literals per clause, drawn uniformly
+            std::size_t max_literals = 3;
+            std::size_t predicates = 16;
+            std::size_t predicate_arity = 2;
+            std::size_t functions = 4;         // Function symbols, arity 1 or 2
+            std::size_t constants = 8;
+            std::size_t variables = 4;         // Distinct variables available per clause
+            double variable_ratio = 0.5;       // Probability that a leaf is a variable
+            double function_ratio = 0.3;       // Probability that a non-leaf position nests a function
+            std::size_t max_depth = 1;
+            unsigned seed = 1;
+        };
+
+        namespace detail
+        {
+
+            inline TPTPFormula cnf_formula(std::string name, TPTPFormula::Role role, std::vector<Literal> literals)
+            {
+                TPTPFormula formula;
+                formula.name = std::move(name);
+                formula.language = TPTPFormula::Language::CNF;
+                formula.role = role;
+                formula.clause = std::make_shared<Clause>(std::move(literals));
+                return formula;
+            }
+
+            inline TPTPProblem cnf_problem(std::string name, std::string status)
+            {
+                TPTPProblem problem;
+                problem.name = std::move(name);
+                problem.expected_status = std::move(status);
+                return problem;
+            }
+
+            /**
+             * One shared node per symbol, so millions of clauses stay affordable
+             */
+            inline std::vector<TermDBPtr> constants(const std::string &prefix, std::size_t count)
+            {
+                std::vector<TermDBPtr> nodes;
+                nodes.reserve(count);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    nodes.push_back(make_constant(prefix + std::to_string(i)));
+                }
+                return nodes;
+            }
+
+            inline TermDBPtr eq(const TermDBPtr &left, const TermDBPtr &right)
+            {
+                return make_function_application("=", {left, right});
+            }
+
+            /**
+             * Random choices drawn from the raw mt19937 sequence, which the
+             * standard fixes. The <random> distributions and std::shuffle
+             * may draw differently in each standard library, so they are
+             * not used.
+             */
+            class Random
+            {
+            public:
+                explicit Random(unsigned seed) : engine_(seed) {}
+
+                // Uniform in [0, count), count > 0
+                std::size_t below(std::size_t count)
+                {
+                    // Rejecting the values below 2^64 mod count leaves a
+                    // range that is a multiple of count
+                    std::uint64_t range = count;
+                    std::uint64_t threshold = (0 - range) % range;
+                    std::uint64_t value;
+                    do
+                    {
+                        value = (static_cast<std::uint64_t>(engine_()) << 32) | engine_();
+                    } while (value < threshold);
+                    return static_cast<std::size_t>(value % range);
+                }
+
+                // Uniform in [low, high]
+                std::size_t between(std::size_t low, std::size_t high)
+                {
+                    return low + below(high - low + 1);
+                }
+
+                // True with the given probability
+                bool chance(double probability)
+                {
+                    return static_cast<double>(engine_()) < probability * 4294967296.0;
+                }
+
+                // Fisher-Yates
+                template <typename T>
+                void shuffle(std::vector<T> &items)
+                {
+                    for (std::size_t i = items.size(); i > 1; --i)
+                    {
+                        std::swap(items[i - 1], items[below(i)]);
+                    }
+                }
+
+            private:
+                std::mt19937 engine_;
+            };
+
+        } // namespace detail
+
+        /**
+         * Random clause set; satisfiability is unknown
+         */
+        inline TPTPProblem random_cnf(const RandomCNFConfig &config)
+        {
+            if (config.predicates == 0 || config.min_literals == 0 || config.max_literals < config.min_literals ||
+                (config.constants == 0 && config.variables == 0))
+            {
+                throw std::invalid_argument("random_cnf: empty predicate, literal or leaf range");
+            }
+
+            detail::Random random(config.seed);
+            double variable_ratio = config.constants == 0   ? 1.0
+                                    : config.variables == 0 ? 0.0
+                                                            : config.variable_ratio;
+            double function_ratio = config.functions == 0 ? 0.0 : config.function_ratio;
+
+            auto predicates = std::vector<std::string>();
+            for (std::size_t i = 0; i < config.predicates; ++i)
+            {
+                predicates.push_back("p" + std::to_string(i));
+            }
+            auto constants = detail::constants("c", config.constants);
+            std::vector<TermDBPtr> variables;
+            for (std::size_t i = 0; i < config.variables; ++i)
+            {
+                variables.push_back(make_variable(i));
+            }
+
+            std::function<TermDBPtr(std::size_t)> term = [&](std::size_t depth) -> TermDBPtr
+            {
+                if (depth < config.max_depth && random.chance(function_ratio))
+                {
+                    std::size_t f = random.below(config.functions);
+                    std::vector<TermDBPtr> args(f % 2 + 1);
+                    for (auto &arg : args)
+                    {
+                        arg = term(depth + 1);
+                    }
+                    return make_function_application("f" + std::to_string(f), args);
+                }
+                return random.chance(variable_ratio) ? variables[random.below(config.variables)]
+                                                     : constants[random.below(config.constants)];
+            };
+
+            auto problem = detail::cnf_problem(
+                "random_cnf_" + std::to_string(config.clauses) + "_" + std::to_string(config.max_literals) +
+                    "_s" + std::to_string(config.seed),
+                "Unknown");
+            problem.formulas.reserve(config.clauses);
+            for (std::size_t c = 0; c < config.clauses; ++c)
+            {
+                std::vector<Literal> literals;
+                std::size_t length = random.between(config.min_literals, config.max_literals);
+                for (std::size_t l = 0; l < length; ++l)
+                {
+                    std::vector<TermDBPtr> args(config.predicate_arity);
+                    for (auto &arg : args)
+                    {
+                        arg = term(0);
+                    }
+                    const std::string &name = predicates[random.below(config.predicates)];
+                    TermDBPtr atom = args.empty() ? make_constant(name) : make_function_application(name, args);
+                    literals.emplace_back(atom, random.chance(0.5));
+                }
+                problem.formulas.push_back(detail::cnf_formula("c" + std::to_string(c), TPTPFormula::Role::AXIOM,
+                                                               std::move(literals)));
+            }
+            return problem;
+        }
+
+        /**
+         * Pigeonhole principle: holes + 1 pigeons cannot be placed in `holes`
+         * holes with at most one pigeon per hole. Ground and unsatisfiable;
+         * resolution proofs grow exponentially with the number of holes.
+         */
+        inline TPTPProblem pigeonhole(std::size_t holes)
+        {
+            auto pigeons = detail::constants("pigeon", holes + 1);
+            auto hole_nodes = detail::constants("hole", holes);
+            auto in = [&](std::size_t p, std::size_t h)
+            { return make_function_application("in", {pigeons[p], hole_nodes[h]}); };
+
+            auto problem = detail::cnf_problem("pigeonhole_" + std::to_string(holes), "Unsatisfiable");
+            for (std::size_t p = 0; p <= holes; ++p)
+            {
+                std::vector<Literal> somewhere;
+                for (std::size_t h = 0; h < holes; ++h)
+                {
+                    somewhere.emplace_back(in(p, h), true);
+                }
+                problem.formulas.push_back(detail::cnf_formula("pigeon_" + std::to_string(p),
+                                                               TPTPFormula::Role::AXIOM, std::move(somewhere)));
+            }
+            for (std::size_t h = 0; h < holes; ++h)
+            {
+                for (std::size_t p = 0; p <= holes; ++p)
+                {
+                    for (std::size_t q = p + 1; q <= holes; ++q)
+                    {
+                        problem.formulas.push_back(detail::cnf_formula(
+                            "hole_" + std::to_string(h) + "_" + std::to_string(p) + "_" + std::to_string(q),
+                            TPTPFormula::Role::AXIOM, {Literal(in(p, h), false), Literal(in(q, h), false)}));
+                    }
+                }
+            }
+            return problem;
+        }
+
+        /**
+         * Group word problem: from the equational group axioms, show that a
+         * random word of the given length over generators a0.. times its
+         * inverse word is the identity. Unsatisfiable (a theorem).
+         */
+        inline TPTPProblem group_word_problem(std::size_t generators, std::size_t length, unsigned seed)
+        {
+            if (generators == 0 || length == 0)
+            {
+                throw std::invalid_argument("group_word_problem: need at least one generator and letter");
+            }
+
+            auto x = make_variable(0);
+            auto y = make_variable(1);
+            auto z = make_variable(2);
+            auto e = make_constant("e");
+            auto mult = [](const TermDBPtr &a, const TermDBPtr &b)
+            { return make_function_application("mult", {a, b}); };
+            auto inv = [](const TermDBPtr &a)
+            { return make_function_application("inv", {a}); };
+
+            auto problem = detail::cnf_problem("group_word_" + std::to_string(generators) + "_" +
+                                                   std::to_string(length) + "_s" + std::to_string(seed),
+                                               "Unsatisfiable");
+            auto axiom = [&](const std::string &name, const TermDBPtr &left, const TermDBPtr &right)
+            {
+                problem.formulas.push_back(detail::cnf_formula(name, TPTPFormula::Role::AXIOM,
+                                                               {Literal(detail::eq(left, right), true)}));
+            };
+            axiom("left_identity", mult(e, x), x);
+            axiom("left_inverse", mult(inv(x), x), e);
+            axiom("associativity", mult(mult(x, y), z), mult(x, mult(y, z)));
+
+            // Letters are generators or their inverses; the inverse word
+            // reverses the letters and inverts each one
+            detail::Random random(seed);
+            auto names = detail::constants("a", generators);
+            std::vector<TermDBPtr> word, inverse;
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                std::size_t l = random.below(2 * generators);
+                const TermDBPtr &g = names[l % generators];
+                bool inverted = l >= generators;
+                word.push_back(inverted ? inv(g) : g);
+                inverse.push_back(inverted ? g : inv(g));
+            }
+            std::reverse(inverse.begin(), inverse.end());
+
+            auto product = [&](const std::vector<TermDBPtr> &letters)
+            {
+                TermDBPtr result = letters.back();
+                for (std::size_t i = letters.size() - 1; i-- > 0;)
+                {
+                    result = mult(letters[i], result);
+                }
+                return result;
+            };
+
+            problem.formulas.push_back(detail::cnf_formula(
+                "goal", TPTPFormula::Role::NEGATED_CONJECTURE,
+                {Literal(detail::eq(mult(product(word), product(inverse)), e), false)}));
+            return problem;
+        }
+
+        /**
+         * Chain p0(a), p_i(X) => p_{i+1}(X), ~p_length(a), with `distractors`
+         * dead-end implications p_i(X) => q_i_k(X) per link. The clause order
+         * is shuffled by the seed. Unsatisfiable.
+         */
+        inline TPTPProblem implication_chain(std::size_t length, std::size_t distractors, unsigned seed)
+        {
+            auto a = make_constant("a");
+            auto x = make_variable(0);
+            auto p = [&](std::size_t i, const TermDBPtr &arg)
+            { return make_function_application("p" + std::to_string(i), {arg}); };
+
+            auto problem = detail::cnf_problem("implication_chain_" + std::to_string(length) + "_" +
+                                                   std::to_string(distractors) + "_s" + std::to_string(seed),
+                                               "Unsatisfiable");
+            problem.formulas.push_back(detail::cnf_formula("start", TPTPFormula::Role::AXIOM, {Literal(p(0, a), true)}));
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                problem.formulas.push_back(detail::cnf_formula("link_" + std::to_string(i), TPTPFormula::Role::AXIOM,
+                                                               {Literal(p(i, x), false), Literal(p(i + 1, x), true)}));
+                for (std::size_t k = 0; k < distractors; ++k)
+                {
+                    auto dead_end = make_function_application("q" + std::to_string(i) + "_" + std::to_string(k), {x});
+                    problem.formulas.push_back(detail::cnf_formula(
+                        "dead_end_" + std::to_string(i) + "_" + std::to_string(k), TPTPFormula::Role::AXIOM,
+                        {Literal(p(i, x), false), Literal(dead_end, true)}));
+                }
+            }
+            problem.formulas.push_back(detail::cnf_formula("goal", TPTPFormula::Role::NEGATED_CONJECTURE,
+                                                           {Literal(p(length, a), false)}));
+
+            detail::Random(seed).shuffle(problem.formulas);
+            return problem;
+        }
+
+        /**
+         * Build a problem from a spec "name[:key=value,...]", e.g.
+         * "pigeonhole:holes=4" or "random_cnf:clauses=100000,k=3,seed=7".
+         * Keys: random_cnf clauses, k (or min_literals/max_literals),
+         * predicates, arity, functions, constants, variables, depth, seed;
+         * pigeonhole holes; group_word generators, length, seed;
+         * implication_chain length, distractors, seed.
+         * @throws std::invalid_argument for unknown generators or keys
+         */
+        inline TPTPProblem generate_problem(const std::string &spec)
+        {
+            std::string name = spec.substr(0, spec.find(':'));
+            std::map<std::string, unsigned long> values;
+            if (name.size() < spec.size())
+            {
+                std::stringstream stream(spec.substr(name.size() + 1));
+                std::string item;
+                while (std::getline(stream, item, ','))
+                {
+                    std::size_t equals = item.find('=');
+                    if (equals == std::string::npos)
+                    {
+                        throw std::invalid_argument("expected key=value in '" + spec + "'");
+                    }
+                    values[item.substr(0, equals)] = std::stoul(item.substr(equals + 1));
+                }
+            }
+
+            auto take = [&](const std::string &key, unsigned long fallback)
+            {
+                auto it = values.find(key);
+                if (it == values.end())
+                {
+                    return fallback;
+                }
+                unsigned long value = it->second;
+                values.erase(it);
+                return value;
+            };
+
+            TPTPProblem problem;
+            if (name == "random_cnf")
+            {
+                RandomCNFConfig config;
+                config.clauses = take("clauses", config.clauses);
+                std::size_t k = take("k", config.max_literals);
+                config.min_literals = take("min_literals", k);
+                config.max_literals = take("max_literals", k);
+                config.predicates = take("predicates", config.predicates);
+                config.predicate_arity = take("arity", config.predicate_arity);
+                config.functions = take("functions", config.functions);
+                config.constants = take("constants", config.constants);
+                config.variables = take("variables", config.variables);
+                config.max_depth = take("depth", config.max_depth);
+                config.seed = static_cast<unsigned>(take("seed", config.seed));
+                problem = random_cnf(config);
+            }
+            else if (name == "pigeonhole")
+            {
+                problem = pigeonhole(take("holes", 3));
+            }
+            else if (name == "group_word")
+            {
+                std::size_t generators = take("generators", 2);
+                std::size_t length = take("length", 4);
+                problem = group_word_problem(generators, length, static_cast<unsigned>(take("seed", 1)));
+            }
+            else if (name == "implication_chain")
+            {
+                std::size_t length = take("length", 10);
+                std::size_t distractors = take("distractors", 0);
+                problem = implication_chain(length, distractors, static_cast<unsigned>(take("seed", 1)));
+            }
+            else
+            {
+                throw std::invalid_argument("unknown generator '" + name +
+                                            "' (available: random_cnf, pigeonhole, group_word, implication_chain)");
+            }
+
+            if (!values.empty())
+            {
+                throw std::invalid_argument("unknown parameter '" + values.begin()->first + "' for " + name);
+            }
+            return problem;
+        }
+
+        namespace detail
+        {
+
+            inline void write_term(std::ostream &out, const TermDBPtr &term)
+            {
+                switch (term->kind())
+                {
+                case TermDB::TermKind::VARIABLE:
+                    out << "X" << std::static_pointer_cast<VariableDB>(term)->index();
+                    break;
+                case TermDB::TermKind::CONSTANT:
+                    out << std::static_pointer_cast<ConstantDB>(term)->symbol();
+                    break;
+                case TermDB::TermKind::FUNCTION_APPLICATION:
+                {
+                    auto app = std::static_pointer_cast<FunctionApplicationDB>(term);
+                    out << app->symbol() << "(";
+                    for (std::size_t i = 0; i < app->arguments().size(); ++i)
+                    {
+                        out << (i > 0 ? ", " : "");
+                        write_term(out, app->arguments()[i]);
+                    }
+                    out << ")";
+                    break;
+                }
+                default:
+                    throw std::invalid_argument("write_tptp: clause atom contains a binder or connective");
+                }
+            }
+
+        } // namespace detail
+
+        /**
+         * Write the CNF formulas of a problem in TPTP syntax
+         */
+        inline void write_tptp(std::ostream &out, const TPTPProblem &problem)
+        {
+            out << "% Problem    : " << problem.name << "\n";
+            if (!problem.expected_status.empty())
+            {
+                out << "% Status     : " << problem.expected_status << "\n";
+            }
+
+            const char *roles[] = {"axiom", "conjecture", "negated_conjecture"};
+            for (const auto &formula : problem.formulas)
+            {
+                if (formula.language != TPTPFormula::Language::CNF)
+                {
+                    throw std::invalid_argument("write_tptp: only CNF problems can be written");
+                }
+
+                out << "cnf(" << formula.name << ", " << roles[static_cast<int>(formula.role)] << ", ";
+                if (!formula.clause || formula.clause->literals().empty())
+                {
+                    out << (formula.clause ? "$false" : "$true");
+                }
+                for (std::size_t i = 0; formula.clause && i < formula.clause->size(); ++i)
+                {
+                    const Literal &literal = formula.clause->literals()[i];
+                    out << (i > 0 ? " | " : "");
+
+                    auto atom = literal.atom();
+                    auto app = std::dynamic_pointer_cast<FunctionApplicationDB>(atom);
+                    if (app && app->symbol() == "=" && app->arguments().size() == 2)
+                    {
+                        detail::write_term(out, app->arguments()[0]);
+                        out << (literal.is_positive() ? " = " : " != ");
+                        detail::write_term(out, app->arguments()[1]);
+                        continue;
+                    }
+                    out << (literal.is_positive() ? "" : "~ ");
+                    detail::write_term(out, atom);
+                }
+                out << ").\n";
+            }
+        }
+
+    } // namespace bench
+} // namespace theorem_prover
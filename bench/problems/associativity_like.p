@@ -0,0 +1,7 @@
+% File     : associativity_like.p
+% Problem  : A single ground instance of associativity does not reassociate
+%            a larger sum, so the goal does not follow
+% Status   : CounterSatisfiable
+fof(assoc_instance, axiom, plus(plus(a, b), c) = plus(a, plus(b, c))).
+fof(left_assoc, axiom, p(plus(plus(plus(a, b), c), d))).
+fof(goal, conjecture, p(plus(a, plus(plus(b, c), d)))).
@@ -0,0 +1,8 @@
+% File     : deep_nested_structures.p
+% Problem  : Ground equations between nested subterms
+% Status   : Theorem
+fof(eq1, axiom, f(g(h(a))) = b).
+fof(eq2, axiom, g(h(a)) = c).
+fof(eq3, axiom, h(a) = d).
+fof(complex, axiom, p(f(f(g(h(a)))))).
+fof(goal, conjecture, p(f(b))).
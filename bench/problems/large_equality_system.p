@@ -0,0 +1,19 @@
+% File     : large_equality_system.p
+% Problem  : Twelve constants linked by a chain plus shortcut equalities
+% Status   : Theorem
+fof(chain0, axiom, v0 = v1).
+fof(chain1, axiom, v1 = v2).
+fof(chain2, axiom, v2 = v3).
+fof(chain3, axiom, v3 = v4).
+fof(chain4, axiom, v4 = v5).
+fof(chain5, axiom, v5 = v6).
+fof(chain6, axiom, v6 = v7).
+fof(chain7, axiom, v7 = v8).
+fof(chain8, axiom, v8 = v9).
+fof(chain9, axiom, v9 = v10).
+fof(chain10, axiom, v10 = v11).
+fof(shortcut1, axiom, v0 = v6).
+fof(shortcut2, axiom, v3 = v9).
+fof(shortcut3, axiom, v5 = v11).
+fof(p_v0, axiom, p(v0)).
+fof(goal, conjecture, p(v11)).
@@ -0,0 +1,12 @@
+% File     : long_equality_chain.p
+% Problem  : Seven-step chain of ground equalities carries a predicate
+% Status   : Theorem
+fof(eq1, axiom, a = b).
+fof(eq2, axiom, b = c).
+fof(eq3, axiom, c = d).
+fof(eq4, axiom, d = e).
+fof(eq5, axiom, e = f).
+fof(eq6, axiom, f = g).
+fof(eq7, axiom, g = h).
+fof(p_a, axiom, p(a)).
+fof(goal, conjecture, p(h)).
@@ -0,0 +1,10 @@
+% File     : mixed_complexity_web.p
+% Problem  : Web of ground equalities between nested applications
+% Status   : Theorem
+fof(eq1, axiom, f(a) = g(b)).
+fof(eq2, axiom, g(b) = h(c)).
+fof(eq3, axiom, f(g(b)) = d).
+fof(eq4, axiom, g(h(c)) = e).
+fof(eq5, axiom, h(f(a)) = f(g(b))).
+fof(complex, axiom, q(h(f(a)), g(h(c)), f(g(b)))).
+fof(goal, conjecture, q(d, e, d)).
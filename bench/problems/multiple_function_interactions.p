@@ -0,0 +1,8 @@
+% File     : multiple_function_interactions.p
+% Problem  : Three chained function equalities rewrite all predicate arguments
+% Status   : Theorem
+fof(eq1, axiom, ! [X] : f(X) = g(X)).
+fof(eq2, axiom, ! [X] : g(X) = h(X)).
+fof(eq3, axiom, ! [X] : h(X) = j(X)).
+fof(original, axiom, p(f(a), g(b), h(c))).
+fof(goal, conjecture, p(j(a), j(b), j(c))).
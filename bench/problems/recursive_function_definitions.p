@@ -0,0 +1,7 @@
+% File     : recursive_function_definitions.p
+% Problem  : An involution collapses a triple application
+% Status   : Theorem
+fof(involution, axiom, ! [X] : f(f(X)) = X).
+fof(g_absorbs_f, axiom, ! [X] : g(f(X)) = g(X)).
+fof(complex, axiom, p(f(f(f(a))))).
+fof(goal, conjecture, p(f(a))).
@@ -0,0 +1,10 @@
+% File     : transitivity_chain_cnf.p
+% Problem  : Transitive closure over a six-element chain, in clause form
+% Status   : Unsatisfiable
+cnf(transitivity, axiom, ~ less(X, Y) | ~ less(Y, Z) | less(X, Z)).
+cnf(step1, axiom, less(c1, c2)).
+cnf(step2, axiom, less(c2, c3)).
+cnf(step3, axiom, less(c3, c4)).
+cnf(step4, axiom, less(c4, c5)).
+cnf(step5, axiom, less(c5, c6)).
+cnf(goal, negated_conjecture, ~ less(c1, c6)).
@@ -0,0 +1,220 @@
+#include "completion_cache.hpp"
+#include "../term/term_io.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace theorem_prover
+{
+
+    namespace
+    {
+        const char cache_magic[] = "TPKBCAC1";
+
+        // FNV-1a, which unlike std::hash is the same in every build, so
+        // file names stay valid across processes and compilers
+        std::uint64_t stable_hash(const std::string &data)
+        {
+            std::uint64_t hash = 14695981039346656037ULL;
+            for (unsigned char byte : data)
+            {
+                hash ^= byte;
+                hash *= 1099511628211ULL;
+            }
+            return hash;
+        }
+
+        std::string encode_result(const std::string &key, const KBResult &result)
+        {
+            BinaryWriter out;
+            out.write_string(cache_magic);
+            out.write_string(key);
+            out.write_varint(static_cast<std::uint64_t>(result.status));
+            out.write_string(result.message);
+            out.write_varint(result.iterations);
+            out.write_varint(result.total_equations_processed);
+            out.write_varint(result.total_critical_pairs_computed);
+            out.write_double(result.elapsed_time_seconds);
+
+            TermWriter terms(out);
+            out.write_varint(result.final_rules.size());
+            for (const auto &rule : result.final_rules)
+            {
+                terms.write(rule.lhs());
+                terms.write(rule.rhs());
+                out.write_string(rule.name());
+            }
+            return out.data();
+        }
+
+        // The result in a cache file, or nullopt if the file was written
+        // for another key
+        std::optional<KBResult> decode_result(const std::string &data, const std::string &key)
+        {
+            BinaryReader in(data);
+            if (in.read_string() != cache_magic)
+            {
+                throw SerializationError("not a completion cache file");
+            }
+            if (in.read_string() != key)
+            {
+                return std::nullopt;
+            }
+
+            KBResult result;
+            std::uint64_t status = in.read_varint();
+            if (status > static_cast<std::uint64_t>(KBResult::Status::UNKNOWN))
+            {
+                throw SerializationError("invalid completion status");
+            }
+            result.status = static_cast<KBResult::Status>(status);
+            result.message = in.read_string();
+            result.iterations = in.read_varint();
+            result.total_equations_processed = in.read_varint();
+            result.total_critical_pairs_computed = in.read_varint();
+            result.elapsed_time_seconds = in.read_double();
+
+            TermReader terms(in);
+            for (std::size_t i = 0, size = in.read_varint(); i < size; ++i)
+            {
+                TermDBPtr lhs = terms.read();
+                TermDBPtr rhs = terms.read();
+                result.final_rules.emplace_back(lhs, rhs, in.read_string());
+            }
+            if (!in.at_end())
+            {
+                throw SerializationError("trailing data after the result");
+            }
+            return result;
+        }
+    }
+
+    std::string CompletionCache::key(const std::vector<Equation> &equations, const std::string &ordering,
+                                     const KBConfig &config)
+    {
+        // Each equation is encoded on its own, with its own symbol numbers,
+        // so sorting the encodings makes the key independent of their order
+        std::vector<std::string> encoded;
+        encoded.reserve(equations.size());
+        for (const auto &equation : equations)
+        {
+            BinaryWriter out;
+            TermWriter terms(out);
+            terms.write(equation.lhs());
+            terms.write(equation.rhs());
+            encoded.push_back(out.data());
+        }
+        std::sort(encoded.begin(), encoded.end());
+
+        BinaryWriter out;
+        out.write_string(ordering);
+        out.write_varint(config.max_iterations);
+        out.write_varint(config.max_rules);
+        out.write_varint(config.max_equations);
+        out.write_double(config.max_time_seconds);
+        out.write_bool(config.enable_simplification);
+        out.write_bool(config.enable_subsumption);
+        out.write_bool(config.fair_processing);
+        out.write_varint(encoded.size());
+        for (const auto &equation : encoded)
+        {
+            out.write_string(equation);
+        }
+        return out.data();
+    }
+
+    std::optional<KBResult> CompletionCache::find(const std::string &key, const std::string &directory)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = results_.find(key);
+        if (it != results_.end())
+        {
+            ++hits_;
+            return it->second;
+        }
+
+        if (!directory.empty())
+        {
+            std::string path = file_path(directory, key);
+            if (std::ifstream(path, std::ios::binary))
+            {
+                try
+                {
+                    if (auto result = decode_result(read_binary_file(path), key))
+                    {
+                        ++hits_;
+                        results_.emplace(key, *result);
+                        return result;
+                    }
+                }
+                catch (const SerializationError &e)
+                {
+                    std::cerr << "Warning: completion cache file " << path << " ignored: " << e.what() << std::endl;
+                }
+            }
+        }
+
+        ++misses_;
+        return std::nullopt;
+    }
+
+    void CompletionCache::store(const std::string &key, const KBResult &result, const std::string &directory)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        results_[key] = result;
+        if (!directory.empty())
+        {
+            try
+            {
+                write_binary_file(file_path(directory, key), encode_result(key, result));
+            }
+            catch (const SerializationError &e)
+            {
+                std::cerr << "Warning: completion result not cached on disk: " << e.what() << std::endl;
+            }
+        }
+    }
+
+    std::size_t CompletionCache::size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return results_.size();
+    }
+
+    std::size_t CompletionCache::hits() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return hits_;
+    }
+
+    std::size_t CompletionCache::misses() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return misses_;
+    }
+
+    void CompletionCache::clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        results_.clear();
+        hits_ = 0;
+        misses_ = 0;
+    }
+
+    CompletionCache &CompletionCache::shared()
+    {
+        static CompletionCache cache;
+        return cache;
+    }
+
+    std::string CompletionCache::file_path(const std::string &directory, const std::string &key)
+    {
+        std::ostringstream name;
+        name << directory << "/" << std::hex << std::setw(16) << std::setfill('0') << stable_hash(key) << ".kbcache";
+        return name.str();
+    }
+
+} // namespace theorem_prover
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "knuth_bendix.hpp"
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace theorem_prover
+{
+
+    /**
+     * @brief Cache of Knuth-Bendix completion results
+     *
+     * Proving many goals over one equational theory completes the same
+     * equations every time. Results are kept by a canonical key of the
+     * equation set, the ordering and the completion limits, in memory and
+     * optionally in a directory with one file per key, so later processes
+     * can reuse them as well.
+     *
+     * The key ignores the order and names of the equations, and variables
+     * are compared as written; equations taken from normalized clauses
+     * number their variables from 0. Orderings cannot be inspected, so the
+     * caller names the ordering; one built with a non-default precedence
+     * or weights needs a name of its own. The time limit is part of the
+     * key, and a completion that ran out of time is remembered as such
+     * for the life of the cache: the same limit is not tried again, a
+     * higher one is. Running out of time depends on the machine's load, so
+     * callers store such results without a directory.
+     *
+     * All members are safe to call from several threads.
+     */
+    class CompletionCache
+    {
+    public:
+        CompletionCache() = default;
+
+        /**
+         * @brief Canonical key of a completion problem
+         * @param equations Input equations, in any order
+         * @param ordering Name of the term ordering, e.g. "lpo"
+         * @param config Completion limits and options; verbosity and
+         *               checkpoint settings do not take part
+         */
+        static std::string key(const std::vector<Equation> &equations, const std::string &ordering,
+                               const KBConfig &config);
+
+        /**
+         * @brief Look up a result, in memory first and then in the directory
+         * @param directory Directory of cache files; none if empty
+         * @return The stored result, or nullopt on a miss
+         *
+         * A file found on disk is kept in memory from then on. Unreadable
+         * or mismatching files count as misses and are reported on cerr.
+         */
+        std::optional<KBResult> find(const std::string &key, const std::string &directory = "");
+
+        /**
+         * @brief Store a result, in memory and in the directory if one is given
+         *
+         * A file that cannot be written is reported on cerr; the result
+         * stays cached in memory.
+         */
+        void store(const std::string &key, const KBResult &result, const std::string &directory = "");
+
+        std::size_t size() const;
+        std::size_t hits() const;
+        std::size_t misses() const;
+
+        /**
+         * @brief Forget the cached results and counters; files are kept
+         */
+        void clear();
+
+        /**
+         * @brief The cache shared by all provers in the process
+         */
+        static CompletionCache &shared();
+
+        /**
+         * @brief File holding the result for a key in a cache directory
+         */
+        static std::string file_path(const std::string &directory, const std::string &key);
+
+    private:
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, KBResult> results_;
+        std::size_t hits_ = 0;
+        std::size_t misses_ = 0;
+    };
+
+} // namespace theorem_prover
@@ -1,6 +1,7 @@
 #include "knuth_bendix.hpp"
 #include "../utils/gensym.hpp"
 #include <algorithm>
+#include <cstdint>
 #include <sstream>
 #include <iostream>
 #include <unordered_set>
@@ -8,6 +9,26 @@
 namespace theorem_prover
 {
 
+    namespace
+    {
+        const char checkpoint_magic[] = "TPKBCKP1";
+
+        void write_equation(BinaryWriter &out, TermWriter &terms, const TermDBPtr &lhs, const TermDBPtr &rhs,
+                            const std::string &name)
+        {
+            terms.write(lhs);
+            terms.write(rhs);
+            out.write_string(name);
+        }
+
+        Equation read_equation(BinaryReader &in, TermReader &terms)
+        {
+            TermDBPtr lhs = terms.read();
+            TermDBPtr rhs = terms.read();
+            return Equation(lhs, rhs, in.read_string());
+        }
+    }
+
     std::string KBStats::to_string() const
     {
         std::ostringstream oss;
@@ -30,7 +51,8 @@ namespace theorem_prover
         }
         else
         {
-            priority_queue_.push(std::make_pair(priority, equation));
+            priority_queue_.emplace_back(priority, equation);
+            std::push_heap(priority_queue_.begin(), priority_queue_.end(), PriorityComparator());
         }
     }
 
@@ -50,8 +72,9 @@ namespace theorem_prover
             if (priority_queue_.empty())
                 return std::nullopt;
 
-            Equation eq = priority_queue_.top().second;
-            priority_queue_.pop();
+            std::pop_heap(priority_queue_.begin(), priority_queue_.end(), PriorityComparator());
+            Equation eq = priority_queue_.back().second;
+            priority_queue_.pop_back();
             return eq;
         }
     }
@@ -75,12 +98,54 @@ namespace theorem_prover
         }
         else
         {
-            // Simple way to clear a priority queue
-            while (!priority_queue_.empty())
+            priority_queue_.clear();
+        }
+    }
+
+    void EquationQueue::save(BinaryWriter &out, TermWriter &terms) const
+    {
+        out.write_bool(fair_mode_);
+        if (fair_mode_)
+        {
+            out.write_varint(equation_queue_.size());
+            for (auto queue = equation_queue_; !queue.empty(); queue.pop())
+            {
+                const Equation &equation = queue.front();
+                write_equation(out, terms, equation.lhs(), equation.rhs(), equation.name());
+            }
+        }
+        else
+        {
+            out.write_varint(priority_queue_.size());
+            for (const auto &[priority, equation] : priority_queue_)
+            {
+                out.write_varint(priority);
+                write_equation(out, terms, equation.lhs(), equation.rhs(), equation.name());
+            }
+        }
+    }
+
+    void EquationQueue::restore(BinaryReader &in, TermReader &terms)
+    {
+        std::queue<Equation> equation_queue;
+        std::vector<std::pair<std::size_t, Equation>> priority_queue;
+        bool fair_mode = in.read_bool();
+        for (std::size_t i = 0, size = in.read_varint(); i < size; ++i)
+        {
+            if (fair_mode)
+            {
+                equation_queue.push(read_equation(in, terms));
+            }
+            else
             {
-                priority_queue_.pop();
+                std::size_t priority = in.read_varint();
+                priority_queue.emplace_back(priority, read_equation(in, terms));
             }
         }
+
+        fair_mode_ = fair_mode;
+        equation_queue_.swap(equation_queue);
+        priority_queue_.swap(priority_queue);
     }
 
     KnuthBendixCompletion::KnuthBendixCompletion(std::shared_ptr<TermOrdering> ordering,
@@ -117,6 +182,7 @@ namespace theorem_prover
         equation_queue_.clear();
         rule_counter_ = 0;
         equation_counter_ = 0;
+        iteration_ = 0;
 
         // Add initial rules
         for (const auto &rule : rules)
@@ -140,11 +206,79 @@ namespace theorem_prover
                       << " rules and " << equations.size() << " equations" << std::endl;
         }
 
-        // Run completion loop
+        return run();
+    }
+
+    KBResult KnuthBendixCompletion::resume(const std::string &checkpoint_file)
+    {
+        if (running_)
+        {
+            return KBResult::make_failure("Completion already in progress");
+        }
+
+        // Everything is read before any state is replaced, so a bad file
+        // leaves this instance as it was
+        std::string data = read_binary_file(checkpoint_file);
+        BinaryReader in(data);
+        if (in.read_string() != checkpoint_magic)
+        {
+            throw SerializationError(checkpoint_file + ": not a completion checkpoint");
+        }
+
+        std::size_t iteration = in.read_varint();
+        double elapsed = in.read_double();
+        std::size_t rule_counter = in.read_varint();
+        std::size_t equation_counter = in.read_varint();
+        KBStats stats;
+        for (std::size_t *counter : {&stats.equations_processed, &stats.critical_pairs_computed, &stats.rules_added,
+                                     &stats.rules_removed, &stats.equations_simplified, &stats.equations_subsumed,
+                                     &stats.orientation_failures})
+        {
+            *counter = in.read_varint();
+        }
+
+        TermReader terms(in);
+        std::vector<TermRewriteRule> rules;
+        for (std::size_t i = 0, size = in.read_varint(); i < size; ++i)
+        {
+            Equation equation = read_equation(in, terms);
+            rules.emplace_back(equation.lhs(), equation.rhs(), equation.name());
+        }
+        EquationQueue equation_queue;
+        equation_queue.restore(in, terms);
+        if (!in.at_end())
+        {
+            throw SerializationError(checkpoint_file + ": trailing data after the checkpoint");
+        }
+
+        running_ = true;
+        termination_requested_ = false;
+        start_time_ = std::chrono::steady_clock::now() -
+                      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                          std::chrono::duration<double>(elapsed));
+        iteration_ = iteration;
+        rule_counter_ = rule_counter;
+        equation_counter_ = equation_counter;
+        stats_ = stats;
+        rules_ = std::move(rules);
+        equation_queue_ = std::move(equation_queue);
+
+        if (config_.verbose)
+        {
+            std::cout << "Resuming KB completion at iteration " << iteration_ << " with " << rules_.size()
+                      << " rules and " << equation_queue_.size() << " equations" << std::endl;
+        }
+
+        return run();
+    }
+
+    KBResult KnuthBendixCompletion::run()
+    {
         KBResult result = completion_loop();
 
         // Finalize result
         result.final_rules = rules_;
+        result.iterations = iteration_;
         result.total_equations_processed = stats_.equations_processed;
         result.total_critical_pairs_computed = stats_.critical_pairs_computed;
 
@@ -165,29 +299,44 @@ namespace theorem_prover
 
     KBResult KnuthBendixCompletion::completion_loop()
     {
-        std::size_t iteration = 0;
-
-        std::cout << "Starting completion loop with max_iterations=" << config_.max_iterations
-                  << ", max_time=" << config_.max_time_seconds << std::endl;
-
-        while (!equation_queue_.empty() && iteration < config_.max_iterations)
+        if (config_.verbose)
         {
-            ++iteration;
+            std::cout << "Starting completion loop with max_iterations=" << config_.max_iterations
+                      << ", max_time=" << config_.max_time_seconds << std::endl;
+        }
 
+        double last_checkpoint = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time_).count();
+        while (!equation_queue_.empty() && iteration_ < config_.max_iterations)
+        {
             // Check timeout
             auto current_time = std::chrono::steady_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(current_time - start_time_);
             double elapsed = duration.count() / 1000.0;
 
-            if (elapsed > config_.max_time_seconds)
+            // Between iterations the state is the rules, the queue and the
+            // counters, so this is where checkpoints are taken
+            bool timed_out = elapsed > config_.max_time_seconds;
+            if (!config_.checkpoint_file.empty() &&
+                (timed_out || elapsed - last_checkpoint >= config_.checkpoint_interval_seconds))
+            {
+                save_checkpoint(elapsed);
+                last_checkpoint = elapsed;
+            }
+
+            ++iteration_;
+
+            if (timed_out)
             {
-                std::cout << "TIMEOUT: elapsed=" << elapsed << "s > max=" << config_.max_time_seconds << "s" << std::endl;
+                if (config_.verbose)
+                {
+                    std::cout << "TIMEOUT: elapsed=" << elapsed << "s > max=" << config_.max_time_seconds << "s" << std::endl;
+                }
                 return KBResult::make_timeout("Time limit exceeded");
             }
 
             if (config_.verbose)
             {
-                std::cout << "Iteration " << iteration << ", elapsed=" << elapsed
+                std::cout << "Iteration " << iteration_ << ", elapsed=" << elapsed
                           << "s, queue_size=" << equation_queue_.size() << std::endl;
             }
 
@@ -206,23 +355,33 @@ namespace theorem_prover
                 auto end_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time_);
                 if (end_duration.count() / 1000.0 > config_.max_time_seconds)
                 {
-                    std::cout << "TIMEOUT during equation processing" << std::endl;
+                    if (config_.verbose)
+                    {
+                        std::cout << "TIMEOUT during equation processing" << std::endl;
+                    }
                     return KBResult::make_timeout("Time limit exceeded during equation processing");
                 }
                 return KBResult::make_failure("Failed to process equation: " + equation_opt->name());
             }
 
             // Print progress
-            if (config_.verbose && iteration % 5 == 0)
+            if (config_.verbose && iteration_ % 5 == 0)
             {
                 print_progress();
             }
         }
 
-        std::cout << "Loop exited: iteration=" << iteration << ", queue_empty=" << equation_queue_.empty() << std::endl;
+        if (config_.verbose)
+        {
+            std::cout << "Loop exited: iteration=" << iteration_ << ", queue_empty=" << equation_queue_.empty() << std::endl;
+        }
 
-        if (iteration >= config_.max_iterations)
+        if (iteration_ >= config_.max_iterations)
         {
+            if (!config_.checkpoint_file.empty() && !equation_queue_.empty())
+            {
+                save_checkpoint(std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time_).count());
+            }
             return KBResult::make_timeout("Maximum iterations exceeded");
         }
 
@@ -405,18 +564,20 @@ namespace theorem_prover
         auto temp_system = std::make_shared<RewriteSystem>(ordering_);
         temp_system->add_rule(new_rule);
 
-        // Check each existing rule for simplification
+        // Check each existing rule for simplification; simplified rules are
+        // collected and appended afterwards, since erasing or appending
+        // invalidates both the iterator and the reference to the rule
+        std::vector<TermRewriteRule> simplified_rules;
         auto it = rules_.begin();
         while (it != rules_.end())
         {
-            const auto &rule = *it;
-
             // Try to simplify rule's RHS with new rule
-            auto simplified_rhs = temp_system->normalize(rule.rhs());
+            auto simplified_rhs = temp_system->normalize(it->rhs());
 
-            if (!(*simplified_rhs == *rule.rhs()))
+            if (!(*simplified_rhs == *it->rhs()))
             {
                 // Rule was simplified
+                TermRewriteRule rule = *it;
                 modified_rules.push_back(rule.name());
 
                 // Remove old rule
@@ -430,7 +591,7 @@ namespace theorem_prover
                 // Add back if still valid
                 if (simplified_rule.is_oriented(*ordering_))
                 {
-                    rules_.push_back(simplified_rule);
+                    simplified_rules.push_back(simplified_rule);
                     ++stats_.rules_added;
                 }
             }
@@ -439,6 +600,7 @@ namespace theorem_prover
                 ++it;
             }
         }
+        rules_.insert(rules_.end(), simplified_rules.begin(), simplified_rules.end());
 
         return modified_rules;
     }
@@ -560,6 +722,39 @@ namespace theorem_prover
         return "eq_" + std::to_string(++equation_counter_);
     }
 
+    void KnuthBendixCompletion::save_checkpoint(double elapsed) const
+    {
+        BinaryWriter out;
+        out.write_string(checkpoint_magic);
+        out.write_varint(iteration_);
+        out.write_double(elapsed);
+        out.write_varint(rule_counter_);
+        out.write_varint(equation_counter_);
+        for (std::size_t counter : {stats_.equations_processed, stats_.critical_pairs_computed, stats_.rules_added,
+                                    stats_.rules_removed, stats_.equations_simplified, stats_.equations_subsumed,
+                                    stats_.orientation_failures})
+        {
+            out.write_varint(counter);
+        }
+
+        TermWriter terms(out);
+        out.write_varint(rules_.size());
+        for (const auto &rule : rules_)
+        {
+            write_equation(out, terms, rule.lhs(), rule.rhs(), rule.name());
+        }
+        equation_queue_.save(out, terms);
+
+        try
+        {
+            write_binary_file(config_.checkpoint_file, out.data());
+        }
+        catch (const SerializationError &e)
+        {
+            std::cerr << "Warning: checkpoint not saved: " << e.what() << std::endl;
+        }
+    }
+
     void KnuthBendixCompletion::print_progress()
     {
         std::cout << "Progress: " << stats_.equations_processed
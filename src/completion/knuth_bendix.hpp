@@ -3,6 +3,7 @@
 #include "../term/term_db.hpp"
 #include "../term/rewriting.hpp"
 #include "../term/ordering.hpp"
+#include "../term/term_io.hpp"
 #include "critical_pairs.hpp"
 #include <memory>
 #include <vector>
@@ -28,6 +29,11 @@ namespace theorem_prover
         bool fair_processing = true;        // Process equations in fair order
         bool verbose = false;               // Enable verbose output
 
+        // Checkpointing: when a file is set, the completion state is saved
+        // to it periodically and when a limit stops the loop
+        std::string checkpoint_file;
+        double checkpoint_interval_seconds = 60.0;
+
         KBConfig() = default;
     };
 
@@ -118,6 +124,16 @@ namespace theorem_prover
          */
         void clear();
 
+        /**
+         * @brief Write the mode and the queued equations, in queue order
+         */
+        void save(BinaryWriter &out, TermWriter &terms) const;
+
+        /**
+         * @brief Replace the queue by one written with save
+         */
+        void restore(BinaryReader &in, TermReader &terms);
+
     private:
         bool fair_mode_;
         std::queue<Equation> equation_queue_;
@@ -132,10 +148,9 @@ namespace theorem_prover
             }
         };
 
-        std::priority_queue<std::pair<std::size_t, Equation>,
-                            std::vector<std::pair<std::size_t, Equation>>,
-                            PriorityComparator>
-            priority_queue_;
+        // Binary heap under PriorityComparator, kept as a plain vector so
+        // checkpoints can store it in its exact layout
+        std::vector<std::pair<std::size_t, Equation>> priority_queue_;
     };
 
     /**
@@ -208,6 +223,18 @@ namespace theorem_prover
         KBResult complete_from_rules(const std::vector<TermRewriteRule> &rules,
                                      const std::vector<Equation> &equations = {});
 
+        /**
+         * @brief Continue a completion from a checkpoint file
+         * @param checkpoint_file File saved through KBConfig::checkpoint_file
+         * @return Result of completion attempt
+         *
+         * The ordering and limits are this instance's; rules, queue,
+         * statistics and counters come from the checkpoint, so the search
+         * carries on exactly where the saved one stopped. Throws
+         * SerializationError if the file cannot be read.
+         */
+        KBResult resume(const std::string &checkpoint_file);
+
         /**
          * @brief Get current rewrite system
          * @return Current set of rules
@@ -240,9 +267,16 @@ namespace theorem_prover
         bool running_ = false;
         bool termination_requested_ = false;
         std::chrono::steady_clock::time_point start_time_;
+        std::size_t iteration_ = 0; // Completion loop iterations so far
 
         // Core completion algorithm steps
 
+        /**
+         * @brief Run the completion loop on the current state and fill in
+         *        the result's rules, statistics and time
+         */
+        KBResult run();
+
         /**
          * @brief Main completion loop
          * @return Result of completion
@@ -329,6 +363,12 @@ namespace theorem_prover
          */
         std::string generate_equation_name();
 
+        /**
+         * @brief Save the completion state to the checkpoint file
+         * @param elapsed Seconds spent in completion so far
+         */
+        void save_checkpoint(double elapsed) const;
+
         /**
          * @brief Print progress information (if verbose mode enabled)
          */
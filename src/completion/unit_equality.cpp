@@ -0,0 +1,714 @@
+#include "unit_equality.hpp"
+#include "../term/substitution.hpp"
+#include "../term/unification.hpp"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <map>
+#include <tuple>
+
+namespace theorem_prover
+{
+
+    namespace
+    {
+        SymbolId head_symbol(const TermDBPtr &term)
+        {
+            switch (term->kind())
+            {
+            case TermDB::TermKind::CONSTANT:
+                return SymbolTable::intern(std::static_pointer_cast<ConstantDB>(term)->symbol(), 0);
+            case TermDB::TermKind::FUNCTION_APPLICATION:
+            {
+                auto func_app = std::static_pointer_cast<FunctionApplicationDB>(term);
+                return SymbolTable::intern(func_app->symbol(), func_app->arguments().size());
+            }
+            default:
+                return SymbolTable::no_symbol;
+            }
+        }
+
+        bool same_term(const TermDBPtr &a, const TermDBPtr &b)
+        {
+            return a.get() == b.get() || *a == *b;
+        }
+
+        std::size_t term_size(const TermDBPtr &term)
+        {
+            if (term->kind() != TermDB::TermKind::FUNCTION_APPLICATION)
+            {
+                return 1;
+            }
+            std::size_t size = 1;
+            for (const auto &arg : std::static_pointer_cast<FunctionApplicationDB>(term)->arguments())
+            {
+                size += term_size(arg);
+            }
+            return size;
+        }
+
+        // Largest variable index plus one, 0 for ground terms
+        std::size_t variable_bound(const TermDBPtr &term)
+        {
+            switch (term->kind())
+            {
+            case TermDB::TermKind::VARIABLE:
+                return std::static_pointer_cast<VariableDB>(term)->index() + 1;
+            case TermDB::TermKind::FUNCTION_APPLICATION:
+            {
+                std::size_t bound = 0;
+                for (const auto &arg : std::static_pointer_cast<FunctionApplicationDB>(term)->arguments())
+                {
+                    bound = std::max(bound, variable_bound(arg));
+                }
+                return bound;
+            }
+            default:
+                return 0;
+            }
+        }
+
+        void mark_variables(const TermDBPtr &term, std::vector<bool> &seen)
+        {
+            if (term->kind() == TermDB::TermKind::VARIABLE)
+            {
+                seen[std::static_pointer_cast<VariableDB>(term)->index()] = true;
+            }
+            else if (term->kind() == TermDB::TermKind::FUNCTION_APPLICATION)
+            {
+                for (const auto &arg : std::static_pointer_cast<FunctionApplicationDB>(term)->arguments())
+                {
+                    mark_variables(arg, seen);
+                }
+            }
+        }
+
+        // Check if every variable of inner occurs in outer
+        bool variables_within(const TermDBPtr &inner, const TermDBPtr &outer, std::size_t variables)
+        {
+            std::vector<bool> in_outer(variables, false), in_inner(variables, false);
+            mark_variables(outer, in_outer);
+            mark_variables(inner, in_inner);
+            for (std::size_t i = 0; i < variables; ++i)
+            {
+                if (in_inner[i] && !in_outer[i])
+                    return false;
+            }
+            return true;
+        }
+
+        // One-way matching: extend bindings so that pattern instantiates to term
+        bool match(const TermDBPtr &pattern, const TermDBPtr &term, std::vector<TermDBPtr> &bindings)
+        {
+            switch (pattern->kind())
+            {
+            case TermDB::TermKind::VARIABLE:
+            {
+                auto &binding = bindings[std::static_pointer_cast<VariableDB>(pattern)->index()];
+                if (!binding)
+                {
+                    binding = term;
+                    return true;
+                }
+                return same_term(binding, term);
+            }
+            case TermDB::TermKind::CONSTANT:
+                return term->kind() == TermDB::TermKind::CONSTANT &&
+                       std::static_pointer_cast<ConstantDB>(pattern)->symbol() ==
+                           std::static_pointer_cast<ConstantDB>(term)->symbol();
+            case TermDB::TermKind::FUNCTION_APPLICATION:
+            {
+                if (term->kind() != TermDB::TermKind::FUNCTION_APPLICATION)
+                    return false;
+                auto pattern_app = std::static_pointer_cast<FunctionApplicationDB>(pattern);
+                auto term_app = std::static_pointer_cast<FunctionApplicationDB>(term);
+                const auto &pattern_args = pattern_app->arguments();
+                const auto &term_args = term_app->arguments();
+                if (pattern_args.size() != term_args.size() || pattern_app->symbol() != term_app->symbol())
+                    return false;
+                for (std::size_t i = 0; i < pattern_args.size(); ++i)
+                {
+                    if (!match(pattern_args[i], term_args[i], bindings))
+                        return false;
+                }
+                return true;
+            }
+            default:
+                return same_term(pattern, term);
+            }
+        }
+
+        // Apply bindings to a term, sharing every unchanged subterm
+        TermDBPtr instantiate(const TermDBPtr &term, const std::vector<TermDBPtr> &bindings)
+        {
+            if (term->kind() == TermDB::TermKind::VARIABLE)
+            {
+                std::size_t index = std::static_pointer_cast<VariableDB>(term)->index();
+                return index < bindings.size() && bindings[index] ? bindings[index] : term;
+            }
+            if (term->kind() != TermDB::TermKind::FUNCTION_APPLICATION)
+            {
+                return term;
+            }
+            auto func_app = std::static_pointer_cast<FunctionApplicationDB>(term);
+            std::vector<TermDBPtr> args;
+            bool changed = false;
+            args.reserve(func_app->arguments().size());
+            for (const auto &arg : func_app->arguments())
+            {
+                args.push_back(instantiate(arg, bindings));
+                changed = changed || args.back() != arg;
+            }
+            return changed ? make_function_application(func_app->symbol(), args) : term;
+        }
+
+        // Number the variables of an equation 0, 1, ... in order of first occurrence
+        std::size_t rename_canonically(TermDBPtr &s, TermDBPtr &t)
+        {
+            std::size_t bound = std::max(variable_bound(s), variable_bound(t));
+            std::vector<TermDBPtr> renaming(bound);
+            std::size_t next = 0;
+            std::function<void(const TermDBPtr &)> number = [&](const TermDBPtr &term)
+            {
+                if (term->kind() == TermDB::TermKind::VARIABLE)
+                {
+                    auto &target = renaming[std::static_pointer_cast<VariableDB>(term)->index()];
+                    if (!target)
+                        target = make_variable(next++);
+                }
+                else if (term->kind() == TermDB::TermKind::FUNCTION_APPLICATION)
+                {
+                    for (const auto &arg : std::static_pointer_cast<FunctionApplicationDB>(term)->arguments())
+                        number(arg);
+                }
+            };
+            number(s);
+            number(t);
+            s = instantiate(s, renaming);
+            t = instantiate(t, renaming);
+            return next;
+        }
+
+        void collect_symbols(const TermDBPtr &term, std::map<std::string, std::size_t> &arities)
+        {
+            if (term->kind() == TermDB::TermKind::CONSTANT)
+            {
+                arities.emplace(std::static_pointer_cast<ConstantDB>(term)->symbol(), 0);
+            }
+            else if (term->kind() == TermDB::TermKind::FUNCTION_APPLICATION)
+            {
+                auto func_app = std::static_pointer_cast<FunctionApplicationDB>(term);
+                arities.emplace(func_app->symbol(), func_app->arguments().size());
+                for (const auto &arg : func_app->arguments())
+                {
+                    collect_symbols(arg, arities);
+                }
+            }
+        }
+
+        std::shared_ptr<TermOrdering> problem_ordering(const std::vector<ClausePtr> &clauses)
+        {
+            std::map<std::string, std::size_t> arities;
+            for (const auto &clause : clauses)
+            {
+                auto [left, right] = get_equality_sides(clause->literals()[0].atom());
+                collect_symbols(left, arities);
+                collect_symbols(right, arities);
+            }
+
+            // Unary symbols first, then by decreasing arity, then by name
+            std::vector<std::pair<std::string, std::size_t>> symbols(arities.begin(), arities.end());
+            auto rank = [](std::size_t arity)
+            { return arity == 1 ? std::numeric_limits<std::size_t>::max() : arity; };
+            std::sort(symbols.begin(), symbols.end(), [&rank](const auto &a, const auto &b)
+                      { return rank(a.second) != rank(b.second) ? rank(a.second) > rank(b.second)
+                                                                : a.first > b.first; });
+
+            auto precedence = std::make_shared<Precedence>();
+            for (std::size_t i = 0; i + 1 < symbols.size(); ++i)
+            {
+                precedence->set_greater(symbols[i].first, symbols[i + 1].first);
+            }
+            auto ordering = make_kbo(precedence);
+            if (!symbols.empty() && symbols.front().second == 1)
+            {
+                ordering->set_weight(symbols.front().first, 0);
+            }
+            return ordering;
+        }
+
+        // Non-variable positions of a term in preorder
+        void non_variable_positions(const TermDBPtr &term, const Position &position, std::vector<Position> &positions)
+        {
+            if (term->kind() == TermDB::TermKind::VARIABLE)
+            {
+                return;
+            }
+            positions.push_back(position);
+            if (term->kind() == TermDB::TermKind::FUNCTION_APPLICATION)
+            {
+                const auto &args = std::static_pointer_cast<FunctionApplicationDB>(term)->arguments();
+                for (std::size_t i = 0; i < args.size(); ++i)
+                {
+                    non_variable_positions(args[i], position.descend(i), positions);
+                }
+            }
+        }
+
+        std::vector<Position> non_variable_positions(const TermDBPtr &term)
+        {
+            std::vector<Position> positions;
+            non_variable_positions(term, Position(), positions);
+            return positions;
+        }
+    } // namespace
+
+    bool UnitEqualityProver::is_unit_equality(const std::vector<ClausePtr> &clauses)
+    {
+        if (clauses.empty())
+        {
+            return false;
+        }
+        for (const auto &clause : clauses)
+        {
+            if (!clause || clause->size() != 1 || !is_equality(clause->literals()[0].atom()))
+            {
+                return false;
+            }
+            const auto &literal = clause->literals()[0];
+            if (literal.is_negative() && !find_all_variables(literal.atom()).empty())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    UnitEqualityProver::UnitEqualityProver(const std::vector<ClausePtr> &clauses,
+                                           std::shared_ptr<TermOrdering> ordering)
+        : ordering_(ordering ? std::move(ordering) : problem_ordering(clauses))
+    {
+        for (const auto &clause : clauses)
+        {
+            const auto &literal = clause->literals()[0];
+            auto sides = get_equality_sides(literal.atom());
+            if (literal.is_positive())
+            {
+                unprocessed_.push_back(sides);
+            }
+            else
+            {
+                goals_.push_back(sides);
+            }
+        }
+    }
+
+    UnitEqualityResult UnitEqualityProver::run(std::size_t max_equations, double max_time_ms)
+    {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        auto elapsed_ms = [&start_time]()
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start_time)
+                .count();
+        };
+
+        UnitEqualityResult result;
+        auto finish = [&](UnitEqualityResult::Status status)
+        {
+            result.status = status;
+            result.critical_pairs = critical_pairs_;
+            result.elapsed_time_ms = elapsed_ms();
+            return result;
+        };
+
+        // Positive equations alone always have a model (the one-element one)
+        if (goals_.empty())
+        {
+            return finish(UnitEqualityResult::Status::SATURATED);
+        }
+        if (goals_joined())
+        {
+            return finish(UnitEqualityResult::Status::PROVED);
+        }
+
+        while (true)
+        {
+            if (elapsed_ms() > max_time_ms || active_count_ + passive_.size() > max_equations)
+            {
+                return finish(UnitEqualityResult::Status::LIMIT);
+            }
+
+            // Input and simplified-away equations come before critical pairs
+            TermDBPtr s, t;
+            if (!unprocessed_.empty())
+            {
+                std::tie(s, t) = unprocessed_.front();
+                unprocessed_.pop_front();
+            }
+            else if (!passive_.empty())
+            {
+                PassivePair pair = passive_.top();
+                passive_.pop();
+                if (!active_[pair.outer / 2].alive || !active_[pair.inner / 2].alive)
+                {
+                    ++result.orphans;
+                    continue;
+                }
+                auto equation = critical_pair(pair.outer, pair.inner, pair.position);
+                if (!equation)
+                {
+                    continue;
+                }
+                std::tie(s, t) = *equation;
+            }
+            else
+            {
+                return finish(UnitEqualityResult::Status::SATURATED);
+            }
+
+            s = normalize(s);
+            t = normalize(t);
+            if (same_term(s, t) || subsumed(s, t))
+            {
+                continue;
+            }
+
+            activate(s, t);
+            ++result.iterations;
+
+            if (goals_joined())
+            {
+                return finish(UnitEqualityResult::Status::PROVED);
+            }
+        }
+    }
+
+    TermDBPtr UnitEqualityProver::normalize(const TermDBPtr &term) const
+    {
+        // Innermost: arguments first, then the root
+        TermDBPtr current = term;
+        if (term->kind() == TermDB::TermKind::FUNCTION_APPLICATION)
+        {
+            auto func_app = std::static_pointer_cast<FunctionApplicationDB>(term);
+            std::vector<TermDBPtr> args;
+            bool changed = false;
+            args.reserve(func_app->arguments().size());
+            for (const auto &arg : func_app->arguments())
+            {
+                args.push_back(normalize(arg));
+                changed = changed || args.back() != arg;
+            }
+            if (changed)
+            {
+                current = make_function_application(func_app->symbol(), args);
+            }
+        }
+
+        auto bucket = index_.find(head_symbol(current));
+        if (bucket == index_.end())
+        {
+            return current;
+        }
+        for (Direction direction : bucket->second)
+        {
+            if (auto rewritten = rewrite_root(current, direction))
+            {
+                return normalize(rewritten);
+            }
+        }
+        return current;
+    }
+
+    std::vector<Equation> UnitEqualityProver::active_equations() const
+    {
+        std::vector<Equation> equations;
+        for (const auto &equation : active_)
+        {
+            if (equation.alive)
+            {
+                equations.emplace_back(equation.lhs, equation.rhs);
+            }
+        }
+        return equations;
+    }
+
+    std::pair<const TermDBPtr &, const TermDBPtr &> UnitEqualityProver::sides(Direction direction) const
+    {
+        const auto &equation = active_[direction / 2];
+        if (direction % 2 == 0)
+        {
+            return {equation.lhs, equation.rhs};
+        }
+        return {equation.rhs, equation.lhs};
+    }
+
+    TermDBPtr UnitEqualityProver::rewrite_root(const TermDBPtr &term, Direction direction) const
+    {
+        const auto &equation = active_[direction / 2];
+        if (!equation.rewrites[direction % 2])
+        {
+            return nullptr;
+        }
+
+        auto [left, right] = sides(direction);
+        std::vector<TermDBPtr> bindings(equation.variables);
+        if (!match(left, term, bindings))
+        {
+            return nullptr;
+        }
+        auto result = instantiate(right, bindings);
+
+        // An unorientable equation rewrites only the instances it decreases
+        if (!equation.oriented && !ordering_->greater(term, result))
+        {
+            return nullptr;
+        }
+        return result;
+    }
+
+    bool UnitEqualityProver::reducible_by(const TermDBPtr &term, std::size_t equation) const
+    {
+        for (Direction direction : {Direction(2 * equation), Direction(2 * equation + 1)})
+        {
+            if (rewrite_root(term, direction))
+            {
+                return true;
+            }
+        }
+        if (term->kind() == TermDB::TermKind::FUNCTION_APPLICATION)
+        {
+            for (const auto &arg : std::static_pointer_cast<FunctionApplicationDB>(term)->arguments())
+            {
+                if (reducible_by(arg, equation))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    bool UnitEqualityProver::subsumed(const TermDBPtr &s, const TermDBPtr &t) const
+    {
+        for (const auto &[left, right] : {std::make_pair(s, t), std::make_pair(t, s)})
+        {
+            auto bucket = index_.find(head_symbol(left));
+            if (bucket == index_.end())
+            {
+                continue;
+            }
+            for (Direction direction : bucket->second)
+            {
+                auto [pattern_left, pattern_right] = sides(direction);
+                std::vector<TermDBPtr> bindings(active_[direction / 2].variables);
+                if (match(pattern_left, left, bindings) && match(pattern_right, right, bindings))
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void UnitEqualityProver::activate(const TermDBPtr &s, const TermDBPtr &t)
+    {
+        ActiveEquation equation;
+        equation.lhs = s;
+        equation.rhs = t;
+        equation.variables = rename_canonically(equation.lhs, equation.rhs);
+
+        // Orient when the ordering decides, with the right side's variables
+        // among the left side's so that rewriting never invents terms
+        bool left_to_right = ordering_->greater(equation.lhs, equation.rhs);
+        if (!left_to_right && ordering_->greater(equation.rhs, equation.lhs))
+        {
+            std::swap(equation.lhs, equation.rhs);
+            left_to_right = true;
+        }
+        bool rhs_within = variables_within(equation.rhs, equation.lhs, equation.variables);
+        bool lhs_within = variables_within(equation.lhs, equation.rhs, equation.variables);
+        equation.oriented = left_to_right && rhs_within;
+        equation.rewrites[0] = rhs_within && equation.lhs->kind() != TermDB::TermKind::VARIABLE;
+        equation.rewrites[1] = !equation.oriented && lhs_within &&
+                               equation.rhs->kind() != TermDB::TermKind::VARIABLE;
+
+        std::size_t id = active_.size();
+        active_.push_back(equation);
+        ++active_count_;
+        for (Direction direction = 2 * id; direction < 2 * id + (equation.oriented ? 1 : 2); ++direction)
+        {
+            const auto &left = sides(direction).first;
+            if (left->kind() != TermDB::TermKind::VARIABLE)
+            {
+                index_[head_symbol(left)].push_back(direction);
+            }
+        }
+
+        interreduce(id);
+        add_critical_pairs(id);
+    }
+
+    void UnitEqualityProver::unindex(std::size_t equation)
+    {
+        for (Direction direction : {Direction(2 * equation), Direction(2 * equation + 1)})
+        {
+            const auto &left = sides(direction).first;
+            auto bucket = index_.find(head_symbol(left));
+            if (bucket != index_.end())
+            {
+                auto &directions = bucket->second;
+                directions.erase(std::remove(directions.begin(), directions.end(), direction), directions.end());
+            }
+        }
+    }
+
+    void UnitEqualityProver::interreduce(std::size_t equation)
+    {
+        for (std::size_t i = 0; i < equation; ++i)
+        {
+            auto &other = active_[i];
+            if (!other.alive)
+            {
+                continue;
+            }
+
+            // A reducible rewrite side takes the equation out of the active
+            // set; it comes back through the unprocessed queue
+            if (reducible_by(other.lhs, equation) || (!other.oriented && reducible_by(other.rhs, equation)))
+            {
+                unindex(i);
+                other.alive = false;
+                --active_count_;
+                unprocessed_.emplace_back(other.lhs, other.rhs);
+            }
+            else if (other.oriented && reducible_by(other.rhs, equation))
+            {
+                other.rhs = normalize(other.rhs);
+            }
+        }
+    }
+
+    void UnitEqualityProver::add_critical_pairs(std::size_t equation)
+    {
+        auto directions = [this](std::size_t i)
+        {
+            std::vector<Direction> result{Direction(2 * i)};
+            if (!active_[i].oriented)
+            {
+                result.push_back(Direction(2 * i + 1));
+            }
+            return result;
+        };
+
+        auto own = directions(equation);
+        for (std::size_t i = 0; i <= equation; ++i)
+        {
+            if (!active_[i].alive)
+            {
+                continue;
+            }
+            for (Direction outer : own)
+            {
+                for (Direction inner : directions(i))
+                {
+                    add_overlaps(outer, inner);
+                    if (i != equation)
+                    {
+                        add_overlaps(inner, outer);
+                    }
+                }
+            }
+        }
+    }
+
+    void UnitEqualityProver::add_overlaps(Direction outer, Direction inner)
+    {
+        const auto &outer_left = sides(outer).first;
+        const auto &inner_left = sides(inner).first;
+        SymbolId inner_head = head_symbol(inner_left);
+
+        auto positions = non_variable_positions(outer_left);
+        for (std::uint32_t position = 0; position < positions.size(); ++position)
+        {
+            // A direction overlapping itself at the root gives a trivial pair
+            if (outer == inner && positions[position].is_root())
+            {
+                continue;
+            }
+            auto subterm = RewriteSystem::subterm_at(outer_left, positions[position]);
+            if (inner_head != SymbolTable::no_symbol && head_symbol(subterm) != inner_head)
+            {
+                continue;
+            }
+
+            auto equation = critical_pair(outer, inner, position);
+            if (!equation)
+            {
+                continue;
+            }
+
+            // Pairs that are already joinable are never stored
+            auto s = normalize(equation->first);
+            auto t = normalize(equation->second);
+            if (same_term(s, t))
+            {
+                continue;
+            }
+            passive_.push({static_cast<std::uint32_t>(term_size(s) + term_size(t)), outer, inner, position, age_++});
+            ++critical_pairs_;
+        }
+    }
+
+    std::optional<std::pair<TermDBPtr, TermDBPtr>>
+    UnitEqualityProver::critical_pair(Direction outer, Direction inner, std::uint32_t position) const
+    {
+        auto [outer_left, outer_right] = sides(outer);
+        auto positions = non_variable_positions(outer_left);
+        if (position >= positions.size())
+        {
+            return std::nullopt;
+        }
+
+        // Rename the inner equation apart from the outer one
+        int offset = static_cast<int>(active_[outer / 2].variables);
+        auto inner_left = SubstitutionEngine::shift(sides(inner).first, offset);
+        auto inner_right = SubstitutionEngine::shift(sides(inner).second, offset);
+
+        auto unification = Unifier::unify(RewriteSystem::subterm_at(outer_left, positions[position]), inner_left);
+        if (!unification.success)
+        {
+            return std::nullopt;
+        }
+        const auto &unifier = unification.substitution;
+
+        // Unorientable equations only overlap where the instance is not increasing
+        auto instance_increases = [&](Direction direction, const TermDBPtr &left, const TermDBPtr &right)
+        {
+            return !active_[direction / 2].oriented &&
+                   ordering_->greater(SubstitutionEngine::substitute(right, unifier),
+                                      SubstitutionEngine::substitute(left, unifier));
+        };
+        if (instance_increases(outer, outer_left, outer_right) || instance_increases(inner, inner_left, inner_right))
+        {
+            return std::nullopt;
+        }
+
+        auto left = RewriteSystem::replace_at(outer_left, positions[position], inner_right);
+        return std::make_pair(SubstitutionEngine::substitute(left, unifier),
+                              SubstitutionEngine::substitute(outer_right, unifier));
+    }
+
+    bool UnitEqualityProver::goals_joined()
+    {
+        for (auto &[left, right] : goals_)
+        {
+            left = normalize(left);
+            right = normalize(right);
+            if (same_term(left, right))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+} // namespace theorem_prover
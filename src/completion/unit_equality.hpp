@@ -0,0 +1,179 @@
+#pragma once
+
+#include "../resolution/clause.hpp"
+#include "../term/term_db.hpp"
+#include "../term/rewriting.hpp"
+#include "../term/ordering.hpp"
+#include "../term/symbol_table.hpp"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace theorem_prover
+{
+
+    /**
+     * @brief Result of a unit equality proof attempt
+     */
+    struct UnitEqualityResult
+    {
+        enum class Status
+        {
+            PROVED,    // Both sides of some goal rewrite to the same term
+            SATURATED, // Completion finished without joining any goal: the clauses are satisfiable
+            LIMIT      // Equation or time limit reached first
+        };
+
+        Status status = Status::SATURATED;
+        std::size_t iterations = 0;     // Equations selected and made active
+        std::size_t critical_pairs = 0; // Critical pairs computed and kept passive
+        std::size_t orphans = 0;        // Passive pairs dropped because a parent was simplified away
+        double elapsed_time_ms = 0.0;
+    };
+
+    /**
+     * @brief Ordered completion for problems made of unit equations
+     *
+     * The input is a set of unit clauses over "=": positive ones are the
+     * axioms, negative ones the (ground) goals. Axioms are completed into
+     * a ground-convergent system in the style of unfailing Knuth-Bendix
+     * completion: equations the ordering can orient become rewrite rules,
+     * the others rewrite in whichever direction decreases the instance.
+     * Each newly active equation interreduces the active set, then its
+     * critical pairs with every active equation go to the passive set.
+     * After every step the goals are rewritten; a goal whose sides meet is
+     * proved. With no goal joined once the passive set runs dry, every goal
+     * fails in the ground-convergent system, so the clauses are satisfiable.
+     *
+     * Active equations are found through a demodulation index keyed by the
+     * interned head symbol of each rewrite side. Passive critical pairs are
+     * kept as (weight, parents, position) records rather than terms and
+     * recomputed when selected; a pair whose parent was simplified away in
+     * the meantime is dropped, since the parent re-enters as a new equation
+     * and builds its critical pairs again.
+     */
+    class UnitEqualityProver
+    {
+    public:
+        /**
+         * @brief Check if the clauses form a unit equality problem
+         *
+         * Every clause is a single literal over "=", and every negative
+         * literal is ground.
+         */
+        static bool is_unit_equality(const std::vector<ClausePtr> &clauses);
+
+        /**
+         * @brief Load a problem; the clauses must satisfy is_unit_equality
+         * @param clauses Unit equations and goals
+         * @param ordering Reduction ordering, total on ground terms; by
+         *        default a KBO whose precedence puts unary symbols first,
+         *        then symbols of higher arity, with the first unary symbol
+         *        weighing 0 (so that e.g. i(x * y) → i(y) * i(x) in groups)
+         */
+        explicit UnitEqualityProver(const std::vector<ClausePtr> &clauses,
+                                    std::shared_ptr<TermOrdering> ordering = nullptr);
+
+        /**
+         * @brief Run completion until a goal is joined, the passive set is
+         *        empty, or a limit is reached
+         * @param max_equations Bound on active plus passive equations
+         * @param max_time_ms Time limit
+         */
+        UnitEqualityResult run(std::size_t max_equations, double max_time_ms);
+
+        /**
+         * @brief Rewrite a term to normal form with the active equations
+         */
+        TermDBPtr normalize(const TermDBPtr &term) const;
+
+        /**
+         * @brief The active equations, rules oriented left to right
+         */
+        std::vector<Equation> active_equations() const;
+
+        /**
+         * @brief Number of passive critical pairs, orphans included
+         */
+        std::size_t passive_count() const { return passive_.size(); }
+
+    private:
+        struct ActiveEquation
+        {
+            TermDBPtr lhs;
+            TermDBPtr rhs;
+            bool oriented;          // lhs > rhs; otherwise each instance is checked
+            bool rewrites[2];       // Direction may rewrite: its left side holds all its variables
+            std::size_t variables;  // Variables are numbered 0..variables-1
+            bool alive = true;      // False once simplified away
+        };
+
+        // A rewrite direction of an active equation: equation * 2, plus 1 for right to left
+        using Direction = std::uint32_t;
+
+        // A passive critical pair: the left side of inner overlaps the
+        // non-variable position of the left side of outer with the given
+        // preorder number. 24 bytes instead of two terms.
+        struct PassivePair
+        {
+            std::uint32_t weight;
+            Direction outer;
+            Direction inner;
+            std::uint32_t position;
+            std::uint64_t age;
+        };
+
+        // Lightest first, then oldest
+        struct Heavier
+        {
+            bool operator()(const PassivePair &a, const PassivePair &b) const
+            {
+                return a.weight != b.weight ? a.weight > b.weight : a.age > b.age;
+            }
+        };
+
+        std::shared_ptr<TermOrdering> ordering_;
+        std::vector<ActiveEquation> active_;
+        std::size_t active_count_ = 0;
+        std::unordered_map<SymbolId, std::vector<Direction>> index_; // By head symbol of the left side
+        std::priority_queue<PassivePair, std::vector<PassivePair>, Heavier> passive_;
+        std::deque<std::pair<TermDBPtr, TermDBPtr>> unprocessed_; // Axioms and simplified-away equations
+        std::vector<std::pair<TermDBPtr, TermDBPtr>> goals_;       // Kept in normal form
+        std::uint64_t age_ = 0;
+        std::size_t critical_pairs_ = 0;
+
+        // Sides of a direction, left side first
+        std::pair<const TermDBPtr &, const TermDBPtr &> sides(Direction direction) const;
+
+        // Rewrite at the root with one direction; nullptr if it does not apply
+        TermDBPtr rewrite_root(const TermDBPtr &term, Direction direction) const;
+
+        // Check if some direction of the equation rewrites a subterm of the term
+        bool reducible_by(const TermDBPtr &term, std::size_t equation) const;
+
+        // Check if an active equation is at least as general as s = t
+        bool subsumed(const TermDBPtr &s, const TermDBPtr &t) const;
+
+        void activate(const TermDBPtr &s, const TermDBPtr &t);
+        void unindex(std::size_t equation);
+
+        // Simplify active equations with the newest one
+        void interreduce(std::size_t equation);
+
+        // Queue the critical pairs between the newest equation and the active set
+        void add_critical_pairs(std::size_t equation);
+        void add_overlaps(Direction outer, Direction inner);
+
+        std::optional<std::pair<TermDBPtr, TermDBPtr>>
+        critical_pair(Direction outer, Direction inner, std::uint32_t position) const;
+
+        // Rewrite the goals with the active set; true if one is joined
+        bool goals_joined();
+    };
+
+} // namespace theorem_prover
@@ -0,0 +1,608 @@
+#include "datalog_engine.hpp"
+#include "../utils/hash.hpp"
+#include <algorithm>
+#include <chrono>
+#include <unordered_set>
+
+namespace theorem_prover
+{
+
+    namespace
+    {
+        // The atom of a literal if it is a predicate over constants and variables
+        bool is_flat_atom(const TermDBPtr &atom)
+        {
+            if (atom->kind() == TermDB::TermKind::CONSTANT)
+            {
+                return std::static_pointer_cast<ConstantDB>(atom)->symbol() != "=";
+            }
+            if (atom->kind() != TermDB::TermKind::FUNCTION_APPLICATION)
+            {
+                return false;
+            }
+            auto application = std::static_pointer_cast<FunctionApplicationDB>(atom);
+            if (application->symbol() == "=")
+            {
+                return false;
+            }
+            for (const auto &argument : application->arguments())
+            {
+                if (argument->kind() != TermDB::TermKind::CONSTANT &&
+                    argument->kind() != TermDB::TermKind::VARIABLE)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void collect_variables(const TermDBPtr &atom, std::unordered_set<std::size_t> &variables)
+        {
+            if (atom->kind() != TermDB::TermKind::FUNCTION_APPLICATION)
+            {
+                return;
+            }
+            for (const auto &argument : std::static_pointer_cast<FunctionApplicationDB>(atom)->arguments())
+            {
+                if (argument->kind() == TermDB::TermKind::VARIABLE)
+                {
+                    variables.insert(std::static_pointer_cast<VariableDB>(argument)->index());
+                }
+            }
+        }
+    } // namespace
+
+    const std::vector<std::uint32_t> Relation::no_rows_;
+
+    std::size_t Relation::hash(const std::vector<SymbolId> &tuple) const
+    {
+        std::size_t seed = tuple.size();
+        for (SymbolId value : tuple)
+        {
+            hash_combine(seed, value);
+        }
+        return seed;
+    }
+
+    bool Relation::row_equals(std::uint32_t row, const std::vector<SymbolId> &tuple) const
+    {
+        for (std::size_t column = 0; column < columns_.size(); ++column)
+        {
+            if (columns_[column][row] != tuple[column])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Relation::contains(const std::vector<SymbolId> &tuple) const
+    {
+        auto range = rows_by_hash_.equal_range(hash(tuple));
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (row_equals(it->second, tuple))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool Relation::insert(const std::vector<SymbolId> &tuple)
+    {
+        std::size_t key = hash(tuple);
+        auto range = rows_by_hash_.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (row_equals(it->second, tuple))
+            {
+                return false;
+            }
+        }
+
+        auto row = static_cast<std::uint32_t>(rows_++);
+        rows_by_hash_.emplace(key, row);
+        for (std::size_t column = 0; column < columns_.size(); ++column)
+        {
+            columns_[column].push_back(tuple[column]);
+            if (column < indexes_.size() && indexes_[column])
+            {
+                (*indexes_[column])[tuple[column]].push_back(row);
+            }
+        }
+        return true;
+    }
+
+    const std::vector<std::uint32_t> &Relation::rows_with(std::size_t column, SymbolId value)
+    {
+        if (indexes_.size() < columns_.size())
+        {
+            indexes_.resize(columns_.size());
+        }
+        if (!indexes_[column])
+        {
+            indexes_[column] = std::make_unique<std::unordered_map<SymbolId, std::vector<std::uint32_t>>>();
+            for (std::uint32_t row = 0; row < rows_; ++row)
+            {
+                (*indexes_[column])[columns_[column][row]].push_back(row);
+            }
+        }
+        auto rows = indexes_[column]->find(value);
+        return rows == indexes_[column]->end() ? no_rows_ : rows->second;
+    }
+
+    bool DatalogEngine::is_datalog(const std::vector<ClausePtr> &clauses)
+    {
+        for (const auto &clause : clauses)
+        {
+            if (!clause || clause->is_empty())
+            {
+                return false;
+            }
+
+            std::size_t positive = 0;
+            std::unordered_set<std::size_t> body_variables;
+            std::unordered_set<std::size_t> head_variables;
+            for (const auto &literal : clause->literals())
+            {
+                if (!is_flat_atom(literal.atom()))
+                {
+                    return false;
+                }
+                if (literal.is_positive())
+                {
+                    ++positive;
+                    collect_variables(literal.atom(), head_variables);
+                }
+                else
+                {
+                    collect_variables(literal.atom(), body_variables);
+                }
+            }
+
+            if (positive > 1)
+            {
+                return false;
+            }
+            for (std::size_t variable : head_variables)
+            {
+                if (!body_variables.count(variable))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    DatalogEngine::DatalogEngine(const std::vector<ClausePtr> &clauses)
+    {
+        for (const auto &clause : clauses)
+        {
+            std::unordered_map<std::size_t, SymbolId> variables;
+            Rule rule;
+            for (const auto &literal : clause->literals())
+            {
+                Atom atom = convert(literal, variables);
+                if (literal.is_positive())
+                {
+                    rule.head = std::move(atom);
+                }
+                else
+                {
+                    rule.body.push_back(std::move(atom));
+                }
+            }
+            rule.variables = variables.size();
+
+            if (!rule.body.empty())
+            {
+                for (std::size_t atom = 0; atom < rule.body.size(); ++atom)
+                {
+                    rule.body[atom].table->uses.emplace_back(rules_.size(), atom);
+                }
+                rules_.push_back(std::move(rule));
+                continue;
+            }
+
+            // A ground fact
+            std::vector<SymbolId> tuple;
+            for (const auto &argument : rule.head->arguments)
+            {
+                tuple.push_back(argument.value);
+            }
+            if (rule.head->table->relation.insert(tuple))
+            {
+                ++facts_;
+                mark_changed(*rule.head->table);
+            }
+        }
+
+        // The facts loaded are the delta of the first round
+        advance();
+    }
+
+    void DatalogEngine::mark_changed(Table &table)
+    {
+        if (!table.changed)
+        {
+            table.changed = true;
+            changed_.push_back(&table);
+        }
+    }
+
+    bool DatalogEngine::advance()
+    {
+        std::vector<Table *> advanced;
+        advanced.swap(changed_);
+        for (Table *table : advanced)
+        {
+            table->stable = table->recent;
+            table->recent = static_cast<std::uint32_t>(table->relation.size());
+            table->changed = false;
+        }
+        for (Table *table : advanced)
+        {
+            if (table->stable < table->recent)
+            {
+                mark_changed(*table);
+            }
+        }
+        return !changed_.empty();
+    }
+
+    DatalogEngine::Atom DatalogEngine::convert(const Literal &literal,
+                                               std::unordered_map<std::size_t, SymbolId> &variables)
+    {
+        Atom atom;
+        const TermDBPtr &term = literal.atom();
+        std::string symbol;
+        std::vector<TermDBPtr> arguments;
+        if (term->kind() == TermDB::TermKind::CONSTANT)
+        {
+            symbol = std::static_pointer_cast<ConstantDB>(term)->symbol();
+        }
+        else
+        {
+            auto application = std::static_pointer_cast<FunctionApplicationDB>(term);
+            symbol = application->symbol();
+            arguments = application->arguments();
+        }
+
+        atom.predicate = SymbolTable::intern(symbol, arguments.size());
+        names_.emplace(atom.predicate, symbol);
+        for (const auto &argument : arguments)
+        {
+            if (argument->kind() == TermDB::TermKind::VARIABLE)
+            {
+                std::size_t index = std::static_pointer_cast<VariableDB>(argument)->index();
+                auto number = variables.emplace(index, static_cast<SymbolId>(variables.size())).first->second;
+                atom.arguments.push_back({true, number});
+            }
+            else
+            {
+                const std::string &constant = std::static_pointer_cast<ConstantDB>(argument)->symbol();
+                SymbolId id = SymbolTable::intern(constant, 0);
+                names_.emplace(id, constant);
+                atom.arguments.push_back({false, id});
+            }
+        }
+
+        // Every predicate gets a relation, so joins never meet a missing one
+        atom.table = &tables_.try_emplace(atom.predicate, arguments.size()).first->second;
+        return atom;
+    }
+
+    std::vector<std::size_t> DatalogEngine::join_order(const Rule &rule, std::size_t first) const
+    {
+        std::vector<std::size_t> order{first};
+        std::vector<bool> used(rule.body.size(), false);
+        std::vector<bool> bound(rule.variables, false);
+
+        auto use = [&](std::size_t atom)
+        {
+            used[atom] = true;
+            for (const auto &argument : rule.body[atom].arguments)
+            {
+                if (argument.is_variable)
+                {
+                    bound[argument.value] = true;
+                }
+            }
+        };
+        use(first);
+
+        while (order.size() < rule.body.size())
+        {
+            std::size_t best = rule.body.size();
+            std::size_t best_bound = 0;
+            std::size_t best_size = 0;
+            for (std::size_t atom = 0; atom < rule.body.size(); ++atom)
+            {
+                if (used[atom])
+                {
+                    continue;
+                }
+                std::size_t bound_arguments = 0;
+                for (const auto &argument : rule.body[atom].arguments)
+                {
+                    if (!argument.is_variable || bound[argument.value])
+                    {
+                        ++bound_arguments;
+                    }
+                }
+                std::size_t size = rule.body[atom].table->relation.size();
+                if (best == rule.body.size() || bound_arguments > best_bound ||
+                    (bound_arguments == best_bound && size < best_size))
+                {
+                    best = atom;
+                    best_bound = bound_arguments;
+                    best_size = size;
+                }
+            }
+            order.push_back(best);
+            use(best);
+        }
+        return order;
+    }
+
+    bool DatalogEngine::join(const Rule &rule, const std::vector<std::size_t> &order,
+                             const std::vector<RowRange> &ranges, std::size_t step,
+                             std::vector<SymbolId> &binding,
+                             const std::function<bool(const std::vector<SymbolId> &)> &on_match)
+    {
+        if (step == order.size())
+        {
+            return on_match(binding);
+        }
+
+        const Atom &atom = rule.body[order[step]];
+        const RowRange &range = ranges[order[step]];
+        if (range.begin >= range.end)
+        {
+            return true;
+        }
+        Relation &relation = atom.table->relation;
+
+        // Look rows up by the bound argument with the fewest of them
+        const std::vector<std::uint32_t> *candidates = nullptr;
+        for (std::size_t column = 0; column < atom.arguments.size(); ++column)
+        {
+            const Argument &argument = atom.arguments[column];
+            SymbolId value = argument.is_variable ? binding[argument.value] : argument.value;
+            if (value != SymbolTable::no_symbol)
+            {
+                const auto &rows = relation.rows_with(column, value);
+                if (!candidates || rows.size() < candidates->size())
+                {
+                    candidates = &rows;
+                }
+            }
+        }
+
+        std::vector<SymbolId> bound_here;
+        auto visit = [&](std::uint32_t row)
+        {
+            bool matches = true;
+            bound_here.clear();
+            for (std::size_t column = 0; column < atom.arguments.size() && matches; ++column)
+            {
+                const Argument &argument = atom.arguments[column];
+                SymbolId value = relation.value(row, column);
+                if (!argument.is_variable)
+                {
+                    matches = argument.value == value;
+                }
+                else if (binding[argument.value] != SymbolTable::no_symbol)
+                {
+                    matches = binding[argument.value] == value;
+                }
+                else
+                {
+                    binding[argument.value] = value;
+                    bound_here.push_back(argument.value);
+                }
+            }
+
+            bool more = !matches || join(rule, order, ranges, step + 1, binding, on_match);
+            for (SymbolId variable : bound_here)
+            {
+                binding[variable] = SymbolTable::no_symbol;
+            }
+            return more;
+        };
+
+        if (candidates)
+        {
+            auto row = std::lower_bound(candidates->begin(), candidates->end(), range.begin);
+            for (; row != candidates->end() && *row < range.end; ++row)
+            {
+                if (!visit(*row))
+                {
+                    return false;
+                }
+            }
+        }
+        else
+        {
+            for (std::uint32_t row = range.begin; row < range.end; ++row)
+            {
+                if (!visit(row))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    DatalogResult DatalogEngine::evaluate(std::size_t max_facts, double max_time_ms)
+    {
+        auto start_time = std::chrono::steady_clock::now();
+        DatalogResult result;
+
+        // Only the rules over a relation with new facts have work to do
+        while (!changed_.empty())
+        {
+            ++rounds_;
+            bool refuted = false;
+
+            // Derived facts are inserted after each join, as the join reads
+            // the relations they go to
+            std::vector<std::vector<SymbolId>> derived;
+            std::vector<Table *> delta_tables = changed_;
+            for (const Table *delta_table : delta_tables)
+            {
+                for (const auto &[rule_index, delta] : delta_table->uses)
+                {
+                    if (refuted)
+                    {
+                        break;
+                    }
+                    const Rule &rule = rules_[rule_index];
+
+                    // Atoms before the delta atom see the older facts only,
+                    // atoms after it the delta as well, so each combination
+                    // with a new fact is joined exactly once
+                    std::vector<RowRange> ranges;
+                    for (std::size_t atom = 0; atom < rule.body.size(); ++atom)
+                    {
+                        const Table &table = *rule.body[atom].table;
+                        if (atom < delta)
+                        {
+                            ranges.push_back({0, table.stable});
+                        }
+                        else if (atom == delta)
+                        {
+                            ranges.push_back({table.stable, table.recent});
+                        }
+                        else
+                        {
+                            ranges.push_back({0, table.recent});
+                        }
+                    }
+
+                    std::vector<SymbolId> binding(rule.variables, SymbolTable::no_symbol);
+                    join(rule, join_order(rule, delta), ranges, 0, binding,
+                         [&](const std::vector<SymbolId> &solution)
+                         {
+                             if (!rule.head)
+                             {
+                                 refuted = true;
+                                 return false;
+                             }
+                             std::vector<SymbolId> tuple;
+                             for (const auto &argument : rule.head->arguments)
+                             {
+                                 tuple.push_back(argument.is_variable ? solution[argument.value] : argument.value);
+                             }
+                             derived.push_back(std::move(tuple));
+                             return true;
+                         });
+
+                    if (rule.head)
+                    {
+                        Table &head = *rule.head->table;
+                        for (const auto &tuple : derived)
+                        {
+                            if (head.relation.insert(tuple))
+                            {
+                                ++facts_;
+                                mark_changed(head);
+                            }
+                        }
+                        derived.clear();
+                    }
+                }
+            }
+
+            advance();
+
+            double elapsed_ms = std::chrono::duration<double, std::milli>(
+                                    std::chrono::steady_clock::now() - start_time)
+                                    .count();
+            result.elapsed_time_ms = elapsed_ms;
+            if (refuted)
+            {
+                result.status = DatalogResult::Status::REFUTED;
+                break;
+            }
+            if (fact_count() > max_facts || elapsed_ms >= max_time_ms)
+            {
+                result.status = DatalogResult::Status::LIMIT;
+                break;
+            }
+        }
+
+        result.rounds = rounds_;
+        result.facts = fact_count();
+        return result;
+    }
+
+    bool DatalogEngine::holds(const TermDBPtr &atom) const
+    {
+        if (!is_flat_atom(atom))
+        {
+            return false;
+        }
+
+        std::string symbol;
+        std::vector<SymbolId> tuple;
+        if (atom->kind() == TermDB::TermKind::CONSTANT)
+        {
+            symbol = std::static_pointer_cast<ConstantDB>(atom)->symbol();
+        }
+        else
+        {
+            auto application = std::static_pointer_cast<FunctionApplicationDB>(atom);
+            symbol = application->symbol();
+            for (const auto &argument : application->arguments())
+            {
+                if (argument->kind() != TermDB::TermKind::CONSTANT)
+                {
+                    return false;
+                }
+                tuple.push_back(SymbolTable::intern(std::static_pointer_cast<ConstantDB>(argument)->symbol(), 0));
+            }
+        }
+
+        auto table = tables_.find(SymbolTable::intern(symbol, tuple.size()));
+        return table != tables_.end() && table->second.relation.contains(tuple);
+    }
+
+    std::size_t DatalogEngine::fact_count() const
+    {
+        return facts_;
+    }
+
+    std::vector<ClausePtr> DatalogEngine::facts() const
+    {
+        std::vector<ClausePtr> clauses;
+        for (const auto &[predicate, table] : tables_)
+        {
+            const Relation &relation = table.relation;
+            const std::string &name = names_.at(predicate);
+            for (std::size_t row = 0; row < relation.size(); ++row)
+            {
+                TermDBPtr atom;
+                if (relation.arity() == 0)
+                {
+                    atom = make_constant(name);
+                }
+                else
+                {
+                    std::vector<TermDBPtr> arguments;
+                    for (std::size_t column = 0; column < relation.arity(); ++column)
+                    {
+                        arguments.push_back(make_constant(names_.at(relation.value(row, column))));
+                    }
+                    atom = make_function_application(name, arguments);
+                }
+                clauses.push_back(std::make_shared<Clause>(std::vector<Literal>{Literal(atom, true)}));
+            }
+        }
+        return clauses;
+    }
+
+} // namespace theorem_prover
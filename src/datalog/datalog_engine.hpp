@@ -0,0 +1,199 @@
+#pragma once
+
+#include "../resolution/clause.hpp"
+#include "../term/symbol_table.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace theorem_prover
+{
+
+    /**
+     * @brief Result of evaluating a Datalog program
+     */
+    struct DatalogResult
+    {
+        enum class Status
+        {
+            REFUTED,   // Some goal clause has all of its atoms in the least model
+            SATURATED, // Least model computed; no goal holds, so the clauses are satisfiable
+            LIMIT      // Fact or time limit reached before the fixpoint
+        };
+
+        Status status = Status::SATURATED;
+        std::size_t rounds = 0; // Semi-naive iterations
+        std::size_t facts = 0;  // Facts in the model at termination
+        double elapsed_time_ms = 0.0;
+    };
+
+    /**
+     * @brief One relation: a set of ground tuples stored column by column
+     *
+     * Rows are only ever appended, so a range of row numbers stands for the
+     * facts of one round. Each column can have a hash index from a value to
+     * the rows holding it, built on first use and kept up to date.
+     */
+    class Relation
+    {
+    public:
+        explicit Relation(std::size_t arity = 0) : columns_(arity) {}
+
+        std::size_t arity() const { return columns_.size(); }
+        std::size_t size() const { return rows_; }
+        SymbolId value(std::size_t row, std::size_t column) const { return columns_[column][row]; }
+
+        /**
+         * @brief Append a tuple unless it is already present
+         * @return true if the tuple was new
+         */
+        bool insert(const std::vector<SymbolId> &tuple);
+
+        /**
+         * @brief Check if the relation holds the tuple
+         */
+        bool contains(const std::vector<SymbolId> &tuple) const;
+
+        /**
+         * @brief Rows holding the value in the column, in increasing order
+         */
+        const std::vector<std::uint32_t> &rows_with(std::size_t column, SymbolId value);
+
+    private:
+        std::vector<std::vector<SymbolId>> columns_;
+        std::size_t rows_ = 0;
+        std::unordered_multimap<std::size_t, std::uint32_t> rows_by_hash_; // For duplicate detection
+        std::vector<std::unique_ptr<std::unordered_map<SymbolId, std::vector<std::uint32_t>>>> indexes_;
+
+        static const std::vector<std::uint32_t> no_rows_;
+
+        std::size_t hash(const std::vector<SymbolId> &tuple) const;
+        bool row_equals(std::uint32_t row, const std::vector<SymbolId> &tuple) const;
+    };
+
+    /**
+     * @brief Bottom-up evaluation of function-free Horn clause sets
+     *
+     * Facts (ground positive units) seed the relations. Rules (one positive
+     * literal whose variables all occur among the negative ones) are applied
+     * semi-naively: each round, every rule is joined once per body atom with
+     * that atom restricted to the facts new in the previous round, so no
+     * derivation is repeated. Body atoms are joined in order of the number
+     * of bound arguments, then relation size, looking rows up through the
+     * column indexes. Goal clauses (all literals negative) are queries; the
+     * clause set is unsatisfiable exactly when one of them has an instance
+     * whose atoms all belong to the least model.
+     */
+    class DatalogEngine
+    {
+    public:
+        /**
+         * @brief Check if the clauses form a Datalog program
+         *
+         * Every clause is a Horn clause, every atom is a predicate over
+         * constants and variables, equality does not occur, and every
+         * variable of a positive literal occurs in a negative one.
+         */
+        static bool is_datalog(const std::vector<ClausePtr> &clauses);
+
+        /**
+         * @brief Load a program; the clauses must satisfy is_datalog
+         */
+        explicit DatalogEngine(const std::vector<ClausePtr> &clauses);
+
+        /**
+         * @brief Run the fixpoint until a goal holds, no new fact is derived,
+         *        or a limit is reached
+         */
+        DatalogResult evaluate(std::size_t max_facts, double max_time_ms);
+
+        /**
+         * @brief Check if a ground atom is in the model computed so far
+         */
+        bool holds(const TermDBPtr &atom) const;
+
+        /**
+         * @brief Number of facts in the model computed so far
+         */
+        std::size_t fact_count() const;
+
+        /**
+         * @brief The model computed so far, as positive unit clauses
+         */
+        std::vector<ClausePtr> facts() const;
+
+    private:
+        // A relation with the boundaries of the last two rounds: rows before
+        // stable were known two rounds ago, rows from stable to recent are
+        // the delta of the last round
+        struct Table
+        {
+            explicit Table(std::size_t arity) : relation(arity) {}
+
+            Relation relation;
+            std::uint32_t stable = 0;
+            std::uint32_t recent = 0;
+            bool changed = false;                                // Listed among the tables to advance
+            std::vector<std::pair<std::size_t, std::size_t>> uses; // (rule, body atom) over this relation
+        };
+
+        // An argument of an atom: a constant, or a variable numbered within its clause
+        struct Argument
+        {
+            bool is_variable;
+            SymbolId value; // Constant id, or variable number
+        };
+
+        struct Atom
+        {
+            SymbolId predicate;
+            Table *table; // Tables are never erased, so this stays valid
+            std::vector<Argument> arguments;
+        };
+
+        // A rule without a head is a goal
+        struct Rule
+        {
+            std::vector<Atom> body;
+            std::optional<Atom> head;
+            std::size_t variables = 0;
+        };
+
+        // Rows of a relation visible to one body atom in a join
+        struct RowRange
+        {
+            std::uint32_t begin;
+            std::uint32_t end;
+        };
+
+        std::unordered_map<SymbolId, Table> tables_; // By predicate
+        std::vector<Rule> rules_;
+        std::vector<Table *> changed_; // Tables with a delta or new rows
+        std::unordered_map<SymbolId, std::string> names_; // Predicates and constants, for facts()
+        std::size_t rounds_ = 0;
+        std::size_t facts_ = 0;
+
+        Atom convert(const Literal &literal, std::unordered_map<std::size_t, SymbolId> &variables);
+
+        // List a table among those to advance at the end of the round
+        void mark_changed(Table &table);
+
+        // Make the rows derived in the round the next delta; false if there are none
+        bool advance();
+
+        // Join the body atoms in the given order, each over its row range;
+        // on_match sees every complete binding and returns false to stop
+        bool join(const Rule &rule, const std::vector<std::size_t> &order, const std::vector<RowRange> &ranges,
+                  std::size_t step, std::vector<SymbolId> &binding,
+                  const std::function<bool(const std::vector<SymbolId> &)> &on_match);
+
+        // Order the body atoms for a join starting with the given one: next
+        // the atom with the most bound arguments, then the smallest relation
+        std::vector<std::size_t> join_order(const Rule &rule, std::size_t first) const;
+    };
+
+} // namespace theorem_prover
@@ -0,0 +1,652 @@
+#include "model_finder.hpp"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <sstream>
+
+namespace theorem_prover
+{
+
+    namespace
+    {
+        // base^exponent, saturating at SIZE_MAX
+        std::size_t power(std::size_t base, std::size_t exponent)
+        {
+            std::size_t result = 1;
+            for (std::size_t i = 0; i < exponent; ++i)
+            {
+                if (base != 0 && result > SIZE_MAX / base)
+                {
+                    return SIZE_MAX;
+                }
+                result *= base;
+            }
+            return result;
+        }
+
+        std::size_t saturating_add(std::size_t a, std::size_t b)
+        {
+            return a > SIZE_MAX - b ? SIZE_MAX : a + b;
+        }
+
+        // Step to the next tuple over {0, ..., n - 1}, last position fastest; false after the last
+        bool next_tuple(std::vector<std::uint32_t> &tuple, std::size_t n)
+        {
+            for (std::size_t i = tuple.size(); i-- > 0;)
+            {
+                if (++tuple[i] < n)
+                {
+                    return true;
+                }
+                tuple[i] = 0;
+            }
+            return false;
+        }
+
+        // Row-major position of the tuple formed by the given elements
+        template <typename Elements>
+        std::size_t tuple_index(const Elements &elements, std::size_t count, std::size_t n)
+        {
+            std::size_t index = 0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                index = index * n + elements(i);
+            }
+            return index;
+        }
+
+        bool is_first_order_term(const TermDBPtr &term)
+        {
+            switch (term->kind())
+            {
+            case TermDB::TermKind::VARIABLE:
+            case TermDB::TermKind::CONSTANT:
+                return true;
+            case TermDB::TermKind::FUNCTION_APPLICATION:
+            {
+                auto application = std::static_pointer_cast<FunctionApplicationDB>(term);
+                if (application->symbol() == "=")
+                {
+                    return false;
+                }
+                for (const auto &argument : application->arguments())
+                {
+                    if (!is_first_order_term(argument))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            default:
+                return false;
+            }
+        }
+
+        bool is_first_order_atom(const TermDBPtr &atom)
+        {
+            if (atom->kind() == TermDB::TermKind::CONSTANT)
+            {
+                return true;
+            }
+            if (atom->kind() != TermDB::TermKind::FUNCTION_APPLICATION)
+            {
+                return false;
+            }
+            auto application = std::static_pointer_cast<FunctionApplicationDB>(atom);
+            if (application->symbol() == "=" && application->arguments().size() != 2)
+            {
+                return false;
+            }
+            for (const auto &argument : application->arguments())
+            {
+                if (!is_first_order_term(argument))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    } // namespace
+
+    std::optional<std::uint32_t> FiniteModel::evaluate(const TermDBPtr &term,
+                                                       const std::vector<std::uint32_t> &assignment) const
+    {
+        switch (term->kind())
+        {
+        case TermDB::TermKind::VARIABLE:
+        {
+            auto index = std::static_pointer_cast<VariableDB>(term)->index();
+            if (index >= assignment.size())
+            {
+                return std::nullopt;
+            }
+            return assignment[index];
+        }
+        case TermDB::TermKind::CONSTANT:
+        {
+            auto table = functions.find({std::static_pointer_cast<ConstantDB>(term)->symbol(), 0});
+            if (table == functions.end())
+            {
+                return std::nullopt;
+            }
+            return table->second[0];
+        }
+        case TermDB::TermKind::FUNCTION_APPLICATION:
+        {
+            auto application = std::static_pointer_cast<FunctionApplicationDB>(term);
+            const auto &arguments = application->arguments();
+            auto table = functions.find({application->symbol(), arguments.size()});
+            if (table == functions.end())
+            {
+                return std::nullopt;
+            }
+            std::size_t index = 0;
+            for (const auto &argument : arguments)
+            {
+                auto value = evaluate(argument, assignment);
+                if (!value)
+                {
+                    return std::nullopt;
+                }
+                index = index * domain_size + *value;
+            }
+            return table->second[index];
+        }
+        default:
+            return std::nullopt;
+        }
+    }
+
+    bool FiniteModel::satisfies(const Clause &clause) const
+    {
+        std::vector<std::size_t> variables;
+        std::size_t bound = 0;
+        for (const auto &literal : clause.literals())
+        {
+            for (std::size_t index : find_all_variables(literal.atom()))
+            {
+                variables.push_back(index);
+                bound = std::max(bound, index + 1);
+            }
+        }
+        std::sort(variables.begin(), variables.end());
+        variables.erase(std::unique(variables.begin(), variables.end()), variables.end());
+
+        // Truth value of a literal's atom under the assignment, nullopt if undefined
+        auto holds = [this](const TermDBPtr &atom, const std::vector<std::uint32_t> &assignment) -> std::optional<bool>
+        {
+            if (atom->kind() == TermDB::TermKind::CONSTANT)
+            {
+                auto table = predicates.find({std::static_pointer_cast<ConstantDB>(atom)->symbol(), 0});
+                return table == predicates.end() ? std::nullopt : std::optional<bool>(table->second[0]);
+            }
+            if (atom->kind() != TermDB::TermKind::FUNCTION_APPLICATION)
+            {
+                return std::nullopt;
+            }
+            auto application = std::static_pointer_cast<FunctionApplicationDB>(atom);
+            const auto &arguments = application->arguments();
+            std::vector<std::uint32_t> values;
+            for (const auto &argument : arguments)
+            {
+                auto value = evaluate(argument, assignment);
+                if (!value)
+                {
+                    return std::nullopt;
+                }
+                values.push_back(*value);
+            }
+            if (application->symbol() == "=" && values.size() == 2)
+            {
+                return values[0] == values[1];
+            }
+            auto table = predicates.find({application->symbol(), values.size()});
+            if (table == predicates.end())
+            {
+                return std::nullopt;
+            }
+            return table->second[tuple_index([&](std::size_t i)
+                                             { return values[i]; },
+                                             values.size(), domain_size)];
+        };
+
+        std::vector<std::uint32_t> elements(variables.size(), 0);
+        std::vector<std::uint32_t> assignment(bound, 0);
+        do
+        {
+            for (std::size_t i = 0; i < variables.size(); ++i)
+            {
+                assignment[variables[i]] = elements[i];
+            }
+            bool satisfied = false;
+            for (const auto &literal : clause.literals())
+            {
+                auto value = holds(literal.atom(), assignment);
+                if (!value)
+                {
+                    return false;
+                }
+                if (*value == literal.is_positive())
+                {
+                    satisfied = true;
+                    break;
+                }
+            }
+            if (!satisfied)
+            {
+                return false;
+            }
+        } while (next_tuple(elements, domain_size));
+        return true;
+    }
+
+    std::string FiniteModel::to_string() const
+    {
+        std::ostringstream out;
+        const char *separator = "";
+        auto write_tuple = [&](const std::string &name, const std::vector<std::uint32_t> &tuple)
+        {
+            out << separator << name;
+            separator = ", ";
+            if (!tuple.empty())
+            {
+                out << "(";
+                for (std::size_t i = 0; i < tuple.size(); ++i)
+                {
+                    out << (i > 0 ? ", " : "") << tuple[i];
+                }
+                out << ")";
+            }
+        };
+
+        for (const auto &[symbol, values] : functions)
+        {
+            std::vector<std::uint32_t> tuple(symbol.second, 0);
+            std::size_t row = 0;
+            do
+            {
+                write_tuple(symbol.first, tuple);
+                out << " = " << values[row++];
+            } while (next_tuple(tuple, domain_size));
+        }
+        for (const auto &[symbol, values] : predicates)
+        {
+            std::vector<std::uint32_t> tuple(symbol.second, 0);
+            std::size_t row = 0;
+            do
+            {
+                if (values[row++])
+                {
+                    write_tuple(symbol.first, tuple);
+                }
+            } while (next_tuple(tuple, domain_size));
+        }
+        return out.str();
+    }
+
+    bool ModelFinder::is_first_order(const std::vector<ClausePtr> &clauses)
+    {
+        for (const auto &clause : clauses)
+        {
+            for (const auto &literal : clause->literals())
+            {
+                if (!is_first_order_atom(literal.atom()))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    ModelFinder::ModelFinder(const std::vector<ClausePtr> &clauses)
+    {
+        for (const auto &clause : clauses)
+        {
+            flatten(*clause);
+        }
+    }
+
+    std::uint32_t ModelFinder::predicate_id(const std::string &name, std::size_t arity)
+    {
+        auto [it, inserted] = predicate_ids_.emplace(FiniteModel::Symbol(name, arity),
+                                                     static_cast<std::uint32_t>(predicates_.size()));
+        if (inserted)
+        {
+            predicates_.push_back(it->first);
+        }
+        return it->second;
+    }
+
+    std::uint32_t ModelFinder::function_id(const std::string &name, std::size_t arity)
+    {
+        auto [it, inserted] = function_ids_.emplace(FiniteModel::Symbol(name, arity),
+                                                    static_cast<std::uint32_t>(functions_.size()));
+        if (inserted)
+        {
+            functions_.push_back(it->first);
+        }
+        return it->second;
+    }
+
+    void ModelFinder::flatten(const Clause &clause)
+    {
+        FlatClause flat;
+        std::map<std::size_t, std::uint32_t> variables;     // Clause variable index to flat variable
+        std::vector<std::pair<TermDBPtr, std::uint32_t>> named; // Subterms already given a variable
+        std::vector<FlatLiteral> definitions;               // f(...) != y for each named subterm
+
+        std::function<std::uint32_t(const TermDBPtr &)> name_term;
+
+        // The literal f(arguments) = result for a constant or application
+        auto application_literal = [&](const TermDBPtr &term, std::uint32_t result, bool positive)
+        {
+            FlatLiteral literal{FlatLiteral::Kind::FUNCTION, positive, 0, {}};
+            if (term->kind() == TermDB::TermKind::CONSTANT)
+            {
+                literal.symbol = function_id(std::static_pointer_cast<ConstantDB>(term)->symbol(), 0);
+            }
+            else
+            {
+                auto application = std::static_pointer_cast<FunctionApplicationDB>(term);
+                for (const auto &argument : application->arguments())
+                {
+                    literal.arguments.push_back(name_term(argument));
+                }
+                literal.symbol = function_id(application->symbol(), application->arguments().size());
+            }
+            literal.arguments.push_back(result);
+            return literal;
+        };
+
+        name_term = [&](const TermDBPtr &term) -> std::uint32_t
+        {
+            if (term->kind() == TermDB::TermKind::VARIABLE)
+            {
+                auto [it, inserted] = variables.emplace(std::static_pointer_cast<VariableDB>(term)->index(),
+                                                        flat.variables);
+                if (inserted)
+                {
+                    ++flat.variables;
+                }
+                return it->second;
+            }
+            for (const auto &[subterm, variable] : named)
+            {
+                if (*subterm == *term)
+                {
+                    return variable;
+                }
+            }
+            std::uint32_t variable = flat.variables++;
+            named.emplace_back(term, variable);
+            definitions.push_back(application_literal(term, variable, false));
+            return variable;
+        };
+
+        for (const auto &literal : clause.literals())
+        {
+            const auto &atom = literal.atom();
+            if (is_equality(atom))
+            {
+                auto [left, right] = get_equality_sides(atom);
+                if (left->kind() == TermDB::TermKind::VARIABLE && right->kind() == TermDB::TermKind::VARIABLE)
+                {
+                    flat.literals.push_back({FlatLiteral::Kind::EQUAL, literal.is_positive(), 0,
+                                             {name_term(left), name_term(right)}});
+                    continue;
+                }
+                if (left->kind() == TermDB::TermKind::VARIABLE)
+                {
+                    std::swap(left, right);
+                }
+                flat.literals.push_back(application_literal(left, name_term(right), literal.is_positive()));
+                continue;
+            }
+
+            FlatLiteral flat_literal{FlatLiteral::Kind::PREDICATE, literal.is_positive(), 0, {}};
+            if (atom->kind() == TermDB::TermKind::CONSTANT)
+            {
+                flat_literal.symbol = predicate_id(std::static_pointer_cast<ConstantDB>(atom)->symbol(), 0);
+            }
+            else
+            {
+                auto application = std::static_pointer_cast<FunctionApplicationDB>(atom);
+                for (const auto &argument : application->arguments())
+                {
+                    flat_literal.arguments.push_back(name_term(argument));
+                }
+                flat_literal.symbol = predicate_id(application->symbol(), application->arguments().size());
+            }
+            flat.literals.push_back(std::move(flat_literal));
+        }
+
+        flat.literals.insert(flat.literals.end(), definitions.begin(), definitions.end());
+        clauses_.push_back(std::move(flat));
+    }
+
+    std::size_t ModelFinder::ground_size(std::size_t domain_size) const
+    {
+        std::size_t size = 0;
+        for (const auto &clause : clauses_)
+        {
+            size = saturating_add(size, power(domain_size, clause.variables));
+        }
+
+        // One at-least-one clause and n(n-1)/2 at-most-one clauses per argument tuple
+        std::size_t per_tuple = 1 + domain_size * (domain_size - 1) / 2;
+        for (const auto &symbol : functions_)
+        {
+            std::size_t tuples = power(domain_size, symbol.second);
+            size = saturating_add(size, tuples > SIZE_MAX / per_tuple ? SIZE_MAX : tuples * per_tuple);
+        }
+        return size;
+    }
+
+    bool ModelFinder::ground(std::size_t domain_size, SatSolver &solver,
+                             std::vector<SatSolver::Variable> &predicate_base,
+                             std::vector<SatSolver::Variable> &function_base,
+                             std::chrono::steady_clock::time_point deadline) const
+    {
+        const std::size_t n = domain_size;
+        auto allocate = [&solver](std::size_t count)
+        {
+            auto first = static_cast<SatSolver::Variable>(solver.variable_count());
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                solver.new_variable();
+            }
+            return first;
+        };
+
+        predicate_base.clear();
+        for (const auto &symbol : predicates_)
+        {
+            predicate_base.push_back(allocate(power(n, symbol.second)));
+        }
+        function_base.clear();
+        for (const auto &symbol : functions_)
+        {
+            function_base.push_back(allocate(power(n, symbol.second) * n));
+        }
+
+        // Every function maps each argument tuple to exactly one element
+        for (std::size_t f = 0; f < functions_.size(); ++f)
+        {
+            std::size_t tuples = power(n, functions_[f].second);
+            for (std::size_t tuple = 0; tuple < tuples; ++tuple)
+            {
+                auto value = [&](std::size_t element)
+                { return static_cast<SatSolver::Variable>(function_base[f] + tuple * n + element); };
+                std::vector<SatSolver::Lit> some_value;
+                for (std::size_t d = 0; d < n; ++d)
+                {
+                    some_value.push_back(SatSolver::positive(value(d)));
+                    for (std::size_t e = d + 1; e < n; ++e)
+                    {
+                        solver.add_clause({SatSolver::negative(value(d)), SatSolver::negative(value(e))});
+                    }
+                }
+                solver.add_clause(std::move(some_value));
+            }
+        }
+
+        // Symmetry breaking: constant i names element d only if d <= i and,
+        // for d > 0, an earlier constant names d - 1
+        std::vector<SatSolver::Variable> constants;
+        for (std::size_t f = 0; f < functions_.size(); ++f)
+        {
+            if (functions_[f].second == 0)
+            {
+                constants.push_back(function_base[f]);
+            }
+        }
+        for (std::size_t i = 0; i < constants.size(); ++i)
+        {
+            for (std::size_t d = 1; d < n; ++d)
+            {
+                auto names_d = static_cast<SatSolver::Variable>(constants[i] + d);
+                if (d > i)
+                {
+                    solver.add_clause({SatSolver::negative(names_d)});
+                    continue;
+                }
+                std::vector<SatSolver::Lit> earlier{SatSolver::negative(names_d)};
+                for (std::size_t j = 0; j < i; ++j)
+                {
+                    earlier.push_back(SatSolver::positive(static_cast<SatSolver::Variable>(constants[j] + d - 1)));
+                }
+                solver.add_clause(std::move(earlier));
+            }
+        }
+
+        // Every instance of every flat clause; large groundings take a while,
+        // so the deadline is checked every few thousand instances
+        std::vector<SatSolver::Lit> instance;
+        std::size_t instances = 0;
+        for (const auto &clause : clauses_)
+        {
+            std::vector<std::uint32_t> assignment(clause.variables, 0);
+            do
+            {
+                instance.clear();
+                bool satisfied = false;
+                for (const auto &literal : clause.literals)
+                {
+                    const auto &arguments = literal.arguments;
+                    auto element = [&](std::size_t i)
+                    { return assignment[arguments[i]]; };
+                    if (literal.kind == FlatLiteral::Kind::EQUAL)
+                    {
+                        // Decided by the assignment: drop the literal or the instance
+                        if ((element(0) == element(1)) == literal.positive)
+                        {
+                            satisfied = true;
+                            break;
+                        }
+                        continue;
+                    }
+                    SatSolver::Variable variable =
+                        literal.kind == FlatLiteral::Kind::PREDICATE
+                            ? static_cast<SatSolver::Variable>(predicate_base[literal.symbol] +
+                                                               tuple_index(element, arguments.size(), n))
+                            : static_cast<SatSolver::Variable>(function_base[literal.symbol] +
+                                                               tuple_index(element, arguments.size() - 1, n) * n +
+                                                               element(arguments.size() - 1));
+                    instance.push_back(literal.positive ? SatSolver::positive(variable)
+                                                        : SatSolver::negative(variable));
+                }
+                if (!satisfied)
+                {
+                    solver.add_clause(instance);
+                }
+                if (++instances % 4096 == 0 && std::chrono::steady_clock::now() >= deadline)
+                {
+                    return false;
+                }
+            } while (next_tuple(assignment, n));
+        }
+        return true;
+    }
+
+    ModelFinderResult ModelFinder::find(std::size_t max_domain_size, double max_time_ms,
+                                        std::size_t max_ground_clauses)
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                    std::chrono::duration<double, std::milli>(max_time_ms));
+        auto elapsed = [&start]()
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        ModelFinderResult result;
+        for (std::size_t n = 1; n <= max_domain_size; ++n)
+        {
+            if (ground_size(n) > max_ground_clauses || elapsed() >= max_time_ms)
+            {
+                result.status = ModelFinderResult::Status::LIMIT;
+                break;
+            }
+            result.domain_size = n;
+
+            SatSolver solver;
+            std::vector<SatSolver::Variable> predicate_base;
+            std::vector<SatSolver::Variable> function_base;
+            if (!ground(n, solver, predicate_base, function_base, deadline))
+            {
+                result.status = ModelFinderResult::Status::LIMIT;
+                break;
+            }
+            result.sat_variables = solver.variable_count();
+            result.sat_clauses = solver.clause_count();
+
+            auto outcome = solver.solve(max_time_ms - elapsed());
+            if (outcome == SatSolver::Result::UNKNOWN)
+            {
+                result.status = ModelFinderResult::Status::LIMIT;
+                break;
+            }
+            if (outcome == SatSolver::Result::UNSATISFIABLE)
+            {
+                continue;
+            }
+
+            auto model = std::make_shared<FiniteModel>();
+            model->domain_size = n;
+            for (std::size_t f = 0; f < functions_.size(); ++f)
+            {
+                auto &values = model->functions[functions_[f]];
+                std::size_t tuples = power(n, functions_[f].second);
+                values.assign(tuples, 0);
+                for (std::size_t tuple = 0; tuple < tuples; ++tuple)
+                {
+                    for (std::size_t d = 0; d < n; ++d)
+                    {
+                        if (solver.value(static_cast<SatSolver::Variable>(function_base[f] + tuple * n + d)))
+                        {
+                            values[tuple] = static_cast<std::uint32_t>(d);
+                        }
+                    }
+                }
+            }
+            for (std::size_t p = 0; p < predicates_.size(); ++p)
+            {
+                auto &values = model->predicates[predicates_[p]];
+                std::size_t tuples = power(n, predicates_[p].second);
+                values.assign(tuples, false);
+                for (std::size_t tuple = 0; tuple < tuples; ++tuple)
+                {
+                    values[tuple] = solver.value(static_cast<SatSolver::Variable>(predicate_base[p] + tuple));
+                }
+            }
+            result.status = ModelFinderResult::Status::FOUND;
+            result.model = std::move(model);
+            break;
+        }
+        result.elapsed_time_ms = elapsed();
+        return result;
+    }
+
+} // namespace theorem_prover
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "sat_solver.hpp"
+#include "../resolution/clause.hpp"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace theorem_prover
+{
+
+    /**
+     * @brief A finite interpretation: domain {0, ..., domain_size - 1}
+     *        with a table per function and predicate symbol
+     */
+    struct FiniteModel
+    {
+        using Symbol = std::pair<std::string, std::size_t>; // Name and arity
+
+        std::size_t domain_size = 0;
+        std::map<Symbol, std::vector<std::uint32_t>> functions; // Value per argument tuple, first argument most significant
+        std::map<Symbol, std::vector<bool>> predicates;         // Truth value per argument tuple
+
+        /**
+         * @brief Value of a term under an assignment of its variables
+         * @param assignment Domain element per variable index
+         * @return The value, or nullopt if the term uses a symbol outside the model
+         */
+        std::optional<std::uint32_t> evaluate(const TermDBPtr &term,
+                                              const std::vector<std::uint32_t> &assignment) const;
+
+        /**
+         * @brief Check if every instance of the clause over the domain holds
+         */
+        bool satisfies(const Clause &clause) const;
+
+        /**
+         * @brief The tables as text, e.g. "a = 0, f(0) = 1, f(1) = 0, p(1)"
+         */
+        std::string to_string() const;
+    };
+
+    /**
+     * @brief Result of a model search
+     */
+    struct ModelFinderResult
+    {
+        enum class Status
+        {
+            FOUND,    // A model of the clauses, so they are satisfiable
+            NO_MODEL, // No model up to the largest domain size tried; says nothing beyond
+            LIMIT     // Time or ground clause limit reached first
+        };
+
+        Status status = Status::NO_MODEL;
+        std::size_t domain_size = 0;  // Of the model found, or the last size tried
+        std::size_t sat_variables = 0; // In the last SAT problem
+        std::size_t sat_clauses = 0;
+        double elapsed_time_ms = 0.0;
+        std::shared_ptr<FiniteModel> model;
+    };
+
+    /**
+     * @brief Finite model search by reduction to SAT, in the style of MACE
+     *
+     * Every clause is first flattened: each non-variable argument, and each
+     * side of an equation, is replaced by a fresh variable y together with
+     * the literal f(...) != y, so that literals are p(x...), f(x...) = y or
+     * x = y. Repeated subterms of a clause share their variable. For a
+     * domain size n, the propositional variables are the truth values of
+     * p(d...) and f(d...) = e over domain elements d and e. Each flat clause
+     * is instantiated with every assignment of its variables, and every
+     * f(d...) takes exactly one value. Isomorphic models are cut down by
+     * numbering the elements in order of the constants naming them: the
+     * i-th constant is at most i, and takes a value d > 0 only if an earlier
+     * constant takes d - 1. Domain sizes are tried from 1 upwards.
+     */
+    class ModelFinder
+    {
+    public:
+        /**
+         * @brief Check if the clauses are first-order: every atom a predicate
+         *        or equation over variables, constants and applications
+         */
+        static bool is_first_order(const std::vector<ClausePtr> &clauses);
+
+        /**
+         * @brief Load and flatten the clauses, which must satisfy is_first_order
+         */
+        explicit ModelFinder(const std::vector<ClausePtr> &clauses);
+
+        /**
+         * @brief Try domain sizes 1 to max_domain_size until a model is found
+         * @param max_ground_clauses Skip the sizes whose SAT problem would be larger
+         */
+        ModelFinderResult find(std::size_t max_domain_size, double max_time_ms,
+                               std::size_t max_ground_clauses = 2000000);
+
+    private:
+        // A literal of a flat clause; variables are numbered within the clause
+        struct FlatLiteral
+        {
+            enum class Kind
+            {
+                PREDICATE, // predicates_[symbol](arguments)
+                FUNCTION,  // functions_[symbol](arguments but the last) = last argument
+                EQUAL      // arguments[0] = arguments[1]
+            } kind;
+            bool positive;
+            std::uint32_t symbol;
+            std::vector<std::uint32_t> arguments;
+        };
+
+        struct FlatClause
+        {
+            std::vector<FlatLiteral> literals;
+            std::uint32_t variables = 0;
+        };
+
+        std::vector<FiniteModel::Symbol> predicates_;
+        std::vector<FiniteModel::Symbol> functions_; // Constants included, in order of appearance
+        std::map<FiniteModel::Symbol, std::uint32_t> predicate_ids_;
+        std::map<FiniteModel::Symbol, std::uint32_t> function_ids_;
+        std::vector<FlatClause> clauses_;
+
+        void flatten(const Clause &clause);
+
+        std::uint32_t predicate_id(const std::string &name, std::size_t arity);
+        std::uint32_t function_id(const std::string &name, std::size_t arity);
+
+        // Ground clauses needed for a domain size, saturating at SIZE_MAX
+        std::size_t ground_size(std::size_t domain_size) const;
+
+        // Ground the clauses into the solver; the first SAT variable of each symbol's table.
+        // False if the deadline passed first
+        bool ground(std::size_t domain_size, SatSolver &solver, std::vector<SatSolver::Variable> &predicate_base,
+                    std::vector<SatSolver::Variable> &function_base,
+                    std::chrono::steady_clock::time_point deadline) const;
+    };
+
+} // namespace theorem_prover
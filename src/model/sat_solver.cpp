@@ -0,0 +1,431 @@
+#include "sat_solver.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace theorem_prover
+{
+
+    namespace
+    {
+        constexpr double activity_decay = 0.95;
+        constexpr std::size_t restart_unit = 100; // Conflicts per unit of the Luby sequence
+
+        // The i-th element (from 0) of the Luby sequence 1 1 2 1 1 2 4 1 1 2 ...
+        std::size_t luby(std::size_t i)
+        {
+            std::size_t size = 1;
+            std::size_t exponent = 0;
+            while (size < i + 1)
+            {
+                ++exponent;
+                size = 2 * size + 1;
+            }
+            while (size - 1 != i)
+            {
+                size = (size - 1) >> 1;
+                --exponent;
+                i = i % size;
+            }
+            return std::size_t(1) << exponent;
+        }
+    } // namespace
+
+    SatSolver::Variable SatSolver::new_variable()
+    {
+        auto variable = static_cast<Variable>(assigns_.size());
+        assigns_.push_back(-1);
+        levels_.push_back(0);
+        reasons_.push_back(no_clause);
+        polarity_.push_back(false);
+        activity_.push_back(0.0);
+        heap_position_.push_back(-1);
+        seen_.push_back(false);
+        watches_.emplace_back();
+        watches_.emplace_back();
+        heap_insert(variable);
+        return variable;
+    }
+
+    bool SatSolver::add_clause(std::vector<Lit> literals)
+    {
+        if (inconsistent_)
+        {
+            return false;
+        }
+
+        // Sorting puts x next to ¬x, so duplicates and tautologies are adjacent
+        std::sort(literals.begin(), literals.end());
+        literals.erase(std::unique(literals.begin(), literals.end()), literals.end());
+        for (std::size_t i = 1; i < literals.size(); ++i)
+        {
+            if (literals[i] == negate(literals[i - 1]))
+            {
+                return true;
+            }
+        }
+
+        if (literals.empty())
+        {
+            inconsistent_ = true;
+            return false;
+        }
+        if (literals.size() == 1)
+        {
+            units_.push_back(literals[0]);
+            return true;
+        }
+        clauses_.push_back(std::move(literals));
+        watch(static_cast<ClauseRef>(clauses_.size() - 1));
+        return true;
+    }
+
+    SatSolver::Result SatSolver::solve(double max_time_ms)
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto out_of_time = [&]()
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() >
+                   max_time_ms;
+        };
+
+        model_.clear();
+        backtrack(0);
+        if (inconsistent_)
+        {
+            return Result::UNSATISFIABLE;
+        }
+        for (Lit unit : units_)
+        {
+            std::int8_t value = literal_value(unit);
+            if (value == 0)
+            {
+                inconsistent_ = true;
+                return Result::UNSATISFIABLE;
+            }
+            if (value < 0)
+            {
+                assign(unit, no_clause);
+            }
+        }
+
+        std::size_t restarts = 0;
+        std::size_t conflicts_to_restart = restart_unit * luby(0);
+        std::size_t decisions = 0;
+        while (true)
+        {
+            ClauseRef conflict = propagate();
+            if (conflict != no_clause)
+            {
+                ++conflicts_;
+                if (decision_level() == 0)
+                {
+                    inconsistent_ = true;
+                    return Result::UNSATISFIABLE;
+                }
+
+                std::uint32_t level = 0;
+                auto learnt = analyze(conflict, level);
+                backtrack(level);
+                if (learnt.size() == 1)
+                {
+                    assign(learnt[0], no_clause);
+                }
+                else
+                {
+                    clauses_.push_back(std::move(learnt));
+                    auto clause = static_cast<ClauseRef>(clauses_.size() - 1);
+                    watch(clause);
+                    assign(clauses_[clause][0], clause);
+                }
+                bump_ /= activity_decay;
+
+                if (--conflicts_to_restart == 0)
+                {
+                    backtrack(0);
+                    conflicts_to_restart = restart_unit * luby(++restarts);
+                }
+                if (conflicts_ % 256 == 0 && out_of_time())
+                {
+                    backtrack(0);
+                    return Result::UNKNOWN;
+                }
+                continue;
+            }
+
+            if (++decisions % 1024 == 0 && out_of_time())
+            {
+                backtrack(0);
+                return Result::UNKNOWN;
+            }
+
+            // Decide on the most active unassigned variable
+            bool decided = false;
+            while (!heap_.empty())
+            {
+                Variable variable = heap_pop();
+                if (assigns_[variable] < 0)
+                {
+                    trail_limits_.push_back(trail_.size());
+                    assign(polarity_[variable] ? positive(variable) : negative(variable), no_clause);
+                    decided = true;
+                    break;
+                }
+            }
+            if (!decided)
+            {
+                model_.resize(assigns_.size());
+                for (std::size_t variable = 0; variable < assigns_.size(); ++variable)
+                {
+                    model_[variable] = assigns_[variable] == 1;
+                }
+                backtrack(0);
+                return Result::SATISFIABLE;
+            }
+        }
+    }
+
+    void SatSolver::assign(Lit literal, ClauseRef reason)
+    {
+        Variable variable = variable_of(literal);
+        assigns_[variable] = (literal & 1) ? 0 : 1;
+        levels_[variable] = decision_level();
+        reasons_[variable] = reason;
+        trail_.push_back(literal);
+    }
+
+    void SatSolver::watch(ClauseRef clause)
+    {
+        watches_[clauses_[clause][0]].push_back(clause);
+        watches_[clauses_[clause][1]].push_back(clause);
+    }
+
+    SatSolver::ClauseRef SatSolver::propagate()
+    {
+        while (head_ < trail_.size())
+        {
+            Lit false_literal = negate(trail_[head_++]);
+            auto &watchers = watches_[false_literal];
+            std::size_t kept = 0;
+            std::size_t i = 0;
+            while (i < watchers.size())
+            {
+                ClauseRef clause = watchers[i++];
+                auto &literals = clauses_[clause];
+
+                // Keep the false watch second, so the first is the one implied
+                if (literals[0] == false_literal)
+                {
+                    std::swap(literals[0], literals[1]);
+                }
+                if (literal_value(literals[0]) == 1)
+                {
+                    watchers[kept++] = clause;
+                    continue;
+                }
+
+                bool moved = false;
+                for (std::size_t k = 2; k < literals.size(); ++k)
+                {
+                    if (literal_value(literals[k]) != 0)
+                    {
+                        std::swap(literals[1], literals[k]);
+                        watches_[literals[1]].push_back(clause);
+                        moved = true;
+                        break;
+                    }
+                }
+                if (moved)
+                {
+                    continue;
+                }
+
+                watchers[kept++] = clause;
+                if (literal_value(literals[0]) == 0)
+                {
+                    while (i < watchers.size())
+                    {
+                        watchers[kept++] = watchers[i++];
+                    }
+                    watchers.resize(kept);
+                    head_ = trail_.size();
+                    return clause;
+                }
+                assign(literals[0], clause);
+            }
+            watchers.resize(kept);
+        }
+        return no_clause;
+    }
+
+    std::vector<SatSolver::Lit> SatSolver::analyze(ClauseRef conflict, std::uint32_t &backjump_level)
+    {
+        std::vector<Lit> learnt{0}; // Slot for the asserting literal
+        std::size_t open = 0;      // Literals of the current level still to resolve away
+        std::size_t index = trail_.size();
+        ClauseRef reason = conflict;
+        bool first = true;
+        Lit implied = 0;
+
+        do
+        {
+            const auto &literals = clauses_[reason];
+            for (std::size_t j = first ? 0 : 1; j < literals.size(); ++j)
+            {
+                Variable variable = variable_of(literals[j]);
+                if (!seen_[variable] && levels_[variable] > 0)
+                {
+                    seen_[variable] = true;
+                    bump(variable);
+                    if (levels_[variable] == decision_level())
+                    {
+                        ++open;
+                    }
+                    else
+                    {
+                        learnt.push_back(literals[j]);
+                    }
+                }
+            }
+            first = false;
+
+            // The next marked literal on the trail
+            while (!seen_[variable_of(trail_[--index])])
+            {
+            }
+            implied = trail_[index];
+            reason = reasons_[variable_of(implied)];
+            seen_[variable_of(implied)] = false;
+            --open;
+        } while (open > 0);
+        learnt[0] = negate(implied);
+
+        for (std::size_t j = 1; j < learnt.size(); ++j)
+        {
+            seen_[variable_of(learnt[j])] = false;
+        }
+
+        // Watch the literal of the backjump level second
+        backjump_level = 0;
+        if (learnt.size() > 1)
+        {
+            std::size_t highest = 1;
+            for (std::size_t j = 2; j < learnt.size(); ++j)
+            {
+                if (levels_[variable_of(learnt[j])] > levels_[variable_of(learnt[highest])])
+                {
+                    highest = j;
+                }
+            }
+            std::swap(learnt[1], learnt[highest]);
+            backjump_level = levels_[variable_of(learnt[1])];
+        }
+        return learnt;
+    }
+
+    void SatSolver::backtrack(std::uint32_t level)
+    {
+        if (decision_level() <= level)
+        {
+            return;
+        }
+        for (std::size_t i = trail_.size(); i-- > trail_limits_[level];)
+        {
+            Variable variable = variable_of(trail_[i]);
+            polarity_[variable] = assigns_[variable] == 1;
+            assigns_[variable] = -1;
+            reasons_[variable] = no_clause;
+            heap_insert(variable);
+        }
+        trail_.resize(trail_limits_[level]);
+        trail_limits_.resize(level);
+        head_ = trail_.size();
+    }
+
+    void SatSolver::bump(Variable variable)
+    {
+        activity_[variable] += bump_;
+        if (activity_[variable] > 1e100)
+        {
+            for (auto &activity : activity_)
+            {
+                activity *= 1e-100;
+            }
+            bump_ *= 1e-100;
+        }
+        if (heap_position_[variable] >= 0)
+        {
+            heap_up(static_cast<std::size_t>(heap_position_[variable]));
+        }
+    }
+
+    void SatSolver::heap_insert(Variable variable)
+    {
+        if (heap_position_[variable] >= 0)
+        {
+            return;
+        }
+        heap_position_[variable] = static_cast<std::int32_t>(heap_.size());
+        heap_.push_back(variable);
+        heap_up(heap_.size() - 1);
+    }
+
+    void SatSolver::heap_up(std::size_t position)
+    {
+        Variable variable = heap_[position];
+        while (position > 0)
+        {
+            std::size_t parent = (position - 1) / 2;
+            if (activity_[heap_[parent]] >= activity_[variable])
+            {
+                break;
+            }
+            heap_[position] = heap_[parent];
+            heap_position_[heap_[position]] = static_cast<std::int32_t>(position);
+            position = parent;
+        }
+        heap_[position] = variable;
+        heap_position_[variable] = static_cast<std::int32_t>(position);
+    }
+
+    void SatSolver::heap_down(std::size_t position)
+    {
+        Variable variable = heap_[position];
+        while (true)
+        {
+            std::size_t child = 2 * position + 1;
+            if (child >= heap_.size())
+            {
+                break;
+            }
+            if (child + 1 < heap_.size() && activity_[heap_[child + 1]] > activity_[heap_[child]])
+            {
+                ++child;
+            }
+            if (activity_[heap_[child]] <= activity_[variable])
+            {
+                break;
+            }
+            heap_[position] = heap_[child];
+            heap_position_[heap_[position]] = static_cast<std::int32_t>(position);
+            position = child;
+        }
+        heap_[position] = variable;
+        heap_position_[variable] = static_cast<std::int32_t>(position);
+    }
+
+    SatSolver::Variable SatSolver::heap_pop()
+    {
+        Variable top = heap_[0];
+        heap_position_[top] = -1;
+        Variable last = heap_.back();
+        heap_.pop_back();
+        if (!heap_.empty())
+        {
+            heap_[0] = last;
+            heap_position_[last] = 0;
+            heap_down(0);
+        }
+        return top;
+    }
+
+} // namespace theorem_prover
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace theorem_prover
+{
+
+    /**
+     * @brief Conflict-driven clause learning SAT solver
+     *
+     * Clauses are watched by their first two literals. Conflicts are
+     * analysed to the first unique implication point, and the learnt clause
+     * backjumps to the second highest level it mentions. Decisions take the
+     * unassigned variable of highest activity, bumped for every variable met
+     * in conflict analysis, with its last assigned polarity (false at
+     * first). The search restarts after a Luby sequence of conflict counts.
+     */
+    class SatSolver
+    {
+    public:
+        using Variable = std::uint32_t;
+        using Lit = std::uint32_t; // Variable * 2, plus 1 if negated
+
+        enum class Result
+        {
+            SATISFIABLE,
+            UNSATISFIABLE,
+            UNKNOWN // Time limit reached
+        };
+
+        static Lit positive(Variable variable) { return variable << 1; }
+        static Lit negative(Variable variable) { return (variable << 1) | 1; }
+        static Lit negate(Lit literal) { return literal ^ 1; }
+        static Variable variable_of(Lit literal) { return literal >> 1; }
+
+        Variable new_variable();
+        std::size_t variable_count() const { return assigns_.size(); }
+        std::size_t clause_count() const { return clauses_.size() + units_.size(); }
+        std::size_t conflicts() const { return conflicts_; }
+
+        /**
+         * @brief Add a clause before solving
+         * @return false if the clauses are now known to be unsatisfiable
+         */
+        bool add_clause(std::vector<Lit> literals);
+
+        /**
+         * @brief Search for an assignment satisfying every clause
+         */
+        Result solve(double max_time_ms);
+
+        /**
+         * @brief Value of a variable in the satisfying assignment found
+         */
+        bool value(Variable variable) const { return model_[variable]; }
+
+    private:
+        using ClauseRef = std::uint32_t;
+        static constexpr ClauseRef no_clause = UINT32_MAX;
+
+        std::vector<std::vector<Lit>> clauses_; // Input and learnt; the first two literals are watched
+        std::vector<Lit> units_;                // Unit input clauses, assigned at level 0
+        std::vector<std::vector<ClauseRef>> watches_; // By literal: clauses to visit when it becomes false
+        bool inconsistent_ = false;
+
+        std::vector<std::int8_t> assigns_; // Per variable: -1 unassigned, 0 false, 1 true
+        std::vector<std::uint32_t> levels_;
+        std::vector<ClauseRef> reasons_;
+        std::vector<bool> polarity_; // Last assigned value, reused by decisions
+        std::vector<Lit> trail_;
+        std::vector<std::size_t> trail_limits_; // Trail size at each decision
+        std::size_t head_ = 0;                  // Trail position up to which propagation is done
+
+        // Variable activities in a binary max-heap of unassigned candidates
+        std::vector<double> activity_;
+        double bump_ = 1.0;
+        std::vector<Variable> heap_;
+        std::vector<std::int32_t> heap_position_; // -1 when not in the heap
+
+        std::vector<bool> seen_; // Scratch space of conflict analysis
+        std::vector<bool> model_;
+        std::size_t conflicts_ = 0;
+
+        std::int8_t literal_value(Lit literal) const
+        {
+            std::int8_t value = assigns_[variable_of(literal)];
+            return value < 0 ? value : static_cast<std::int8_t>(value ^ (literal & 1));
+        }
+        std::uint32_t decision_level() const { return static_cast<std::uint32_t>(trail_limits_.size()); }
+
+        void assign(Lit literal, ClauseRef reason);
+        void watch(ClauseRef clause);
+
+        // Unit propagation; the conflicting clause, or no_clause
+        ClauseRef propagate();
+
+        // First-UIP learnt clause, asserting literal first, and the level to backjump to
+        std::vector<Lit> analyze(ClauseRef conflict, std::uint32_t &backjump_level);
+        void backtrack(std::uint32_t level);
+
+        void bump(Variable variable);
+        void heap_insert(Variable variable);
+        void heap_up(std::size_t position);
+        void heap_down(std::size_t position);
+        Variable heap_pop();
+    };
+
+} // namespace theorem_prover
@@ -0,0 +1,1029 @@
+#include "tptp_parser.hpp"
+#include "../resolution/cnf_converter.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace theorem_prover
+{
+
+    namespace
+    {
+
+        /**
+         * Read-only memory mapping of a whole file
+         */
+        class MappedFile
+        {
+        public:
+            explicit MappedFile(const std::string &path)
+            {
+                int fd = ::open(path.c_str(), O_RDONLY);
+                if (fd < 0)
+                {
+                    return;
+                }
+
+                struct stat info;
+                if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode))
+                {
+                    identity_ = {info.st_dev, info.st_ino};
+                    size_ = static_cast<std::size_t>(info.st_size);
+                    ok_ = true;
+                    if (size_ > 0)
+                    {
+                        void *data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                        if (data == MAP_FAILED)
+                        {
+                            ok_ = false;
+                        }
+                        else
+                        {
+                            data_ = static_cast<const char *>(data);
+                            ::madvise(data, size_, MADV_SEQUENTIAL);
+                        }
+                    }
+                }
+                ::close(fd);
+            }
+
+            ~MappedFile()
+            {
+                if (data_)
+                {
+                    ::munmap(const_cast<char *>(data_), size_);
+                }
+            }
+
+            MappedFile(const MappedFile &) = delete;
+            MappedFile &operator=(const MappedFile &) = delete;
+
+            bool ok() const { return ok_; }
+            std::string_view text() const { return std::string_view(data_ ? data_ : "", size_); }
+
+            // Device and inode, the same for every path naming the file
+            std::pair<dev_t, ino_t> identity() const { return identity_; }
+
+        private:
+            const char *data_ = nullptr;
+            std::size_t size_ = 0;
+            bool ok_ = false;
+            std::pair<dev_t, ino_t> identity_{};
+        };
+
+        enum class TokenKind
+        {
+            LOWER_WORD,      // Functors, predicates, keywords, roles
+            UPPER_WORD,      // Variables
+            DOLLAR_WORD,     // $true, $false
+            SINGLE_QUOTED,   // 'quoted name' (text without quotes)
+            DISTINCT_OBJECT, // "distinct object" (text with quotes)
+            NUMBER,
+            PUNCT, // ( ) [ ] , . :
+            OPERATOR,
+            END
+        };
+
+        struct Token
+        {
+            TokenKind kind = TokenKind::END;
+            std::string_view text;
+            std::size_t line = 1;
+            std::size_t column = 1;
+        };
+
+        inline bool is_lower(char c) { return c >= 'a' && c <= 'z'; }
+        inline bool is_upper(char c) { return c >= 'A' && c <= 'Z'; }
+        inline bool is_digit(char c) { return c >= '0' && c <= '9'; }
+        inline bool is_word(char c) { return is_lower(c) || is_upper(c) || is_digit(c) || c == '_'; }
+
+        const std::string EQUALITY = "=";
+
+        std::string directory_of(const std::string &path)
+        {
+            std::size_t slash = path.find_last_of('/');
+            return slash == std::string::npos ? "." : path.substr(0, slash);
+        }
+
+    } // namespace
+
+    /**
+     * Recursive descent parser over the text of one file
+     *
+     * Tokens are views into the text; symbols are interned in the owning
+     * TPTPParser, which outlives all formulas built here.
+     */
+    class TPTPParser::FileParser
+    {
+    public:
+        FileParser(TPTPParser &owner, std::string_view text, const std::string &source,
+                   const FormulaHandler &handler, const std::unordered_set<std::string> *selection)
+            : owner_(owner), source_(source), handler_(handler), selection_(selection),
+              p_(text.data()), end_(text.data() + text.size()), line_start_(text.data())
+        {
+            advance();
+        }
+
+        void parse()
+        {
+            while (current_.kind != TokenKind::END)
+            {
+                if (current_.kind == TokenKind::LOWER_WORD && current_.text == "include")
+                {
+                    parse_include();
+                    continue;
+                }
+
+                TPTPFormula formula = parse_annotated_formula();
+                if (!selection_ || selection_->count(formula.name) > 0)
+                {
+                    handler_(std::move(formula));
+                }
+            }
+        }
+
+        const std::string &expected_status() const { return expected_status_; }
+
+    private:
+        TPTPParser &owner_;
+        const std::string &source_;
+        const FormulaHandler &handler_;
+        const std::unordered_set<std::string> *selection_;
+
+        const char *p_;
+        const char *end_;
+        const char *line_start_;
+        std::size_t line_ = 1;
+        Token current_;
+        std::string expected_status_;
+        std::deque<std::string> unescaped_; // Quoted names containing escapes
+
+        // FOF: names of the enclosing quantified variables, innermost last
+        std::vector<std::string_view> bound_;
+        // CNF: variable numbering of the current clause
+        bool parsing_cnf_ = false;
+        std::vector<std::string_view> clause_variables_;
+
+        [[noreturn]] void error(const Token &token, const std::string &message) const
+        {
+            throw TPTPParseError(source_, token.line, token.column, message);
+        }
+
+        // Lexer
+
+        std::size_t column() const { return static_cast<std::size_t>(p_ - line_start_) + 1; }
+
+        void newline()
+        {
+            ++line_;
+            line_start_ = p_ + 1;
+        }
+
+        void skip_layout()
+        {
+            while (p_ < end_)
+            {
+                char c = *p_;
+                if (c == '\n')
+                {
+                    newline();
+                    ++p_;
+                }
+                else if (c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v')
+                {
+                    ++p_;
+                }
+                else if (c == '%')
+                {
+                    const char *start = p_;
+                    while (p_ < end_ && *p_ != '\n')
+                    {
+                        ++p_;
+                    }
+                    if (expected_status_.empty())
+                    {
+                        read_header_comment(std::string_view(start, p_ - start));
+                    }
+                }
+                else if (c == '/' && p_ + 1 < end_ && p_[1] == '*')
+                {
+                    std::size_t line = line_, col = column();
+                    p_ += 2;
+                    while (p_ + 1 < end_ && !(p_[0] == '*' && p_[1] == '/'))
+                    {
+                        if (*p_ == '\n')
+                        {
+                            newline();
+                        }
+                        ++p_;
+                    }
+                    if (p_ + 1 >= end_)
+                    {
+                        throw TPTPParseError(source_, line, col, "unterminated comment");
+                    }
+                    p_ += 2;
+                }
+                else
+                {
+                    break;
+                }
+            }
+        }
+
+        void read_header_comment(std::string_view comment)
+        {
+            // "% Status   : Theorem"
+            std::size_t i = comment.find_first_not_of("% ");
+            if (i == std::string_view::npos || comment.substr(i, 6) != "Status")
+            {
+                return;
+            }
+            std::size_t colon = comment.find(':', i);
+            if (colon == std::string_view::npos)
+            {
+                return;
+            }
+            std::size_t start = comment.find_first_not_of(" \t", colon + 1);
+            if (start == std::string_view::npos)
+            {
+                return;
+            }
+            std::size_t stop = comment.find_first_of(" \t\r", start);
+            expected_status_ = std::string(comment.substr(start, stop == std::string_view::npos ? stop : stop - start));
+        }
+
+        void advance()
+        {
+            skip_layout();
+
+            current_.line = line_;
+            current_.column = column();
+
+            if (p_ >= end_)
+            {
+                current_.kind = TokenKind::END;
+                current_.text = std::string_view();
+                return;
+            }
+
+            const char *start = p_;
+            char c = *p_;
+
+            if (is_lower(c) || is_upper(c) || c == '$')
+            {
+                ++p_;
+                while (p_ < end_ && is_word(*p_))
+                {
+                    ++p_;
+                }
+                current_.kind = c == '$' ? TokenKind::DOLLAR_WORD
+                              : is_upper(c) ? TokenKind::UPPER_WORD
+                                            : TokenKind::LOWER_WORD;
+            }
+            else if (is_digit(c) || ((c == '-' || c == '+') && p_ + 1 < end_ && is_digit(p_[1])))
+            {
+                ++p_;
+                while (p_ < end_ && (is_word(*p_) || ((*p_ == '.' || *p_ == '/') && p_ + 1 < end_ && is_digit(p_[1]))))
+                {
+                    ++p_;
+                }
+                current_.kind = TokenKind::NUMBER;
+            }
+            else if (c == '\'' || c == '"')
+            {
+                lex_quoted(c);
+                return;
+            }
+            else
+            {
+                current_.kind = TokenKind::OPERATOR;
+                char next = p_ + 1 < end_ ? p_[1] : '\0';
+                char after = p_ + 2 < end_ ? p_[2] : '\0';
+                switch (c)
+                {
+                case '<':
+                    if ((next == '=' || next == '~') && after == '>')
+                        p_ += 3; // <=> or <~>
+                    else if (next == '=')
+                        p_ += 2; // <=
+                    else
+                        error(current_, "unexpected character '<'");
+                    break;
+                case '=':
+                    p_ += next == '>' ? 2 : 1; // => or =
+                    break;
+                case '~':
+                    p_ += (next == '|' || next == '&') ? 2 : 1; // ~| ~& or ~
+                    break;
+                case '!':
+                    p_ += next == '=' ? 2 : 1; // != or !
+                    break;
+                case '&':
+                case '|':
+                case '?':
+                    ++p_;
+                    break;
+                case '(':
+                case ')':
+                case '[':
+                case ']':
+                case ',':
+                case '.':
+                case ':':
+                    current_.kind = TokenKind::PUNCT;
+                    ++p_;
+                    break;
+                default:
+                    error(current_, std::string("unexpected character '") + c + "'");
+                }
+            }
+
+            current_.text = std::string_view(start, p_ - start);
+        }
+
+        void lex_quoted(char quote)
+        {
+            const char *start = p_;
+            ++p_;
+            bool escaped = false;
+            while (p_ < end_ && *p_ != quote)
+            {
+                if (*p_ == '\\' && p_ + 1 < end_)
+                {
+                    escaped = true;
+                    ++p_;
+                }
+                else if (*p_ == '\n')
+                {
+                    newline();
+                }
+                ++p_;
+            }
+            if (p_ >= end_)
+            {
+                error(current_, "unterminated quoted name");
+            }
+            ++p_;
+
+            current_.kind = quote == '\'' ? TokenKind::SINGLE_QUOTED : TokenKind::DISTINCT_OBJECT;
+
+            // Single-quoted names drop their quotes; distinct objects keep
+            // them so they never coincide with plain names
+            std::string_view raw(start, p_ - start);
+            if (quote == '\'')
+            {
+                raw = raw.substr(1, raw.size() - 2);
+            }
+            if (!escaped)
+            {
+                current_.text = raw;
+                return;
+            }
+
+            std::string value;
+            value.reserve(raw.size());
+            for (std::size_t i = 0; i < raw.size(); ++i)
+            {
+                if (raw[i] == '\\' && i + 1 < raw.size())
+                {
+                    ++i;
+                }
+                value += raw[i];
+            }
+            unescaped_.push_back(std::move(value));
+            current_.text = unescaped_.back();
+        }
+
+        bool at(std::string_view text) const
+        {
+            return (current_.kind == TokenKind::PUNCT || current_.kind == TokenKind::OPERATOR) &&
+                   current_.text == text;
+        }
+
+        void expect(std::string_view text)
+        {
+            if (!at(text))
+            {
+                error(current_, "expected '" + std::string(text) + "' but found '" +
+                                    std::string(current_.text) + "'");
+            }
+            advance();
+        }
+
+        bool at_formula_name() const
+        {
+            return current_.kind == TokenKind::LOWER_WORD || current_.kind == TokenKind::NUMBER ||
+                   current_.kind == TokenKind::SINGLE_QUOTED;
+        }
+
+        // Include directives
+
+        void parse_include()
+        {
+            Token keyword = current_;
+            advance();
+            expect("(");
+            if (current_.kind != TokenKind::SINGLE_QUOTED)
+            {
+                error(current_, "expected quoted file name");
+            }
+            std::string path(current_.text);
+            advance();
+
+            std::unique_ptr<std::unordered_set<std::string>> selection;
+            if (at(","))
+            {
+                advance();
+                expect("[");
+                selection = std::make_unique<std::unordered_set<std::string>>();
+                bool first = true;
+                while (!at("]"))
+                {
+                    if (!first)
+                    {
+                        expect(",");
+                    }
+                    if (!at_formula_name())
+                    {
+                        error(current_, "expected formula name");
+                    }
+                    // A nested selection can only narrow an enclosing one
+                    if (!selection_ || selection_->count(std::string(current_.text)) > 0)
+                    {
+                        selection->emplace(current_.text);
+                    }
+                    advance();
+                    first = false;
+                }
+                advance();
+            }
+            expect(")");
+            expect(".");
+
+            std::string resolved = owner_.resolve_include(path, directory_of(source_));
+            if (resolved.empty())
+            {
+                error(keyword, "cannot find included file '" + path + "'");
+            }
+            owner_.parse_path(resolved, handler_, selection ? selection.get() : selection_);
+        }
+
+        // Annotated formulas
+
+        TPTPFormula parse_annotated_formula()
+        {
+            Token keyword = current_;
+            if (keyword.kind != TokenKind::LOWER_WORD)
+            {
+                error(keyword, "expected fof, cnf or include");
+            }
+            bool fof = keyword.text == "fof";
+            if (!fof && keyword.text != "cnf")
+            {
+                error(keyword, "unsupported language '" + std::string(keyword.text) + "'");
+            }
+            advance();
+            expect("(");
+
+            TPTPFormula result;
+            result.language = fof ? TPTPFormula::Language::FOF : TPTPFormula::Language::CNF;
+
+            if (!at_formula_name())
+            {
+                error(current_, "expected formula name");
+            }
+            result.name = std::string(current_.text);
+            advance();
+            expect(",");
+
+            result.role = parse_role();
+            advance();
+            expect(",");
+
+            if (fof)
+            {
+                bound_.clear();
+                result.formula = parse_fof_formula();
+            }
+            else
+            {
+                clause_variables_.clear();
+                result.clause = parse_cnf_formula();
+            }
+
+            if (at(","))
+            {
+                skip_annotations();
+            }
+            expect(")");
+            expect(".");
+            return result;
+        }
+
+        TPTPFormula::Role parse_role()
+        {
+            std::string_view role = current_.text;
+            if (current_.kind == TokenKind::LOWER_WORD)
+            {
+                if (role == "conjecture")
+                    return TPTPFormula::Role::CONJECTURE;
+                if (role == "negated_conjecture")
+                    return TPTPFormula::Role::NEGATED_CONJECTURE;
+                if (role == "axiom" || role == "hypothesis" || role == "definition" ||
+                    role == "assumption" || role == "lemma" || role == "theorem" ||
+                    role == "corollary" || role == "plain")
+                    return TPTPFormula::Role::AXIOM;
+            }
+            error(current_, "unsupported formula role '" + std::string(role) + "'");
+        }
+
+        void skip_annotations()
+        {
+            // Source and useful-info terms are not interpreted
+            std::size_t depth = 0;
+            advance();
+            while (current_.kind != TokenKind::END)
+            {
+                if (at("(") || at("["))
+                {
+                    ++depth;
+                }
+                else if (at(")") || at("]"))
+                {
+                    if (depth == 0)
+                    {
+                        return;
+                    }
+                    --depth;
+                }
+                advance();
+            }
+            error(current_, "unterminated annotations");
+        }
+
+        // FOF formulas
+
+        TermDBPtr parse_fof_formula()
+        {
+            TermDBPtr left = parse_fof_unitary();
+
+            if (at("&") || at("|"))
+            {
+                // Associative connectives may be chained, but not mixed
+                std::string_view op = current_.text;
+                while (at(op))
+                {
+                    advance();
+                    TermDBPtr right = parse_fof_unitary();
+                    left = op == "&" ? make_and(left, right) : make_or(left, right);
+                }
+                if (at("&") || at("|"))
+                {
+                    error(current_, "mixed & and | need parentheses");
+                }
+                return left;
+            }
+
+            if (current_.kind != TokenKind::OPERATOR)
+            {
+                return left;
+            }
+
+            std::string_view op = current_.text;
+            if (op != "=>" && op != "<=" && op != "<=>" && op != "<~>" && op != "~|" && op != "~&")
+            {
+                return left;
+            }
+            advance();
+            TermDBPtr right = parse_fof_unitary();
+
+            if (op == "=>")
+                return make_implies(left, right);
+            if (op == "<=")
+                return make_implies(right, left);
+            if (op == "~|")
+                return make_not(make_or(left, right));
+            if (op == "~&")
+                return make_not(make_and(left, right));
+
+            auto iff = make_and(make_implies(left, right), make_implies(right, left));
+            return op == "<=>" ? iff : make_not(iff);
+        }
+
+        TermDBPtr parse_fof_unitary()
+        {
+            if (at("("))
+            {
+                advance();
+                TermDBPtr formula = parse_fof_formula();
+                expect(")");
+                return formula;
+            }
+
+            if (at("~"))
+            {
+                advance();
+                return make_not(parse_fof_unitary());
+            }
+
+            if (at("!") || at("?"))
+            {
+                bool universal = current_.text == "!";
+                advance();
+                expect("[");
+
+                std::size_t first = bound_.size();
+                do
+                {
+                    if (bound_.size() > first)
+                    {
+                        advance();
+                    }
+                    if (current_.kind != TokenKind::UPPER_WORD)
+                    {
+                        error(current_, "expected variable");
+                    }
+                    bound_.push_back(current_.text);
+                    advance();
+                } while (at(","));
+                expect("]");
+                expect(":");
+
+                TermDBPtr body = parse_fof_unitary();
+
+                while (bound_.size() > first)
+                {
+                    const std::string &hint = owner_.intern(bound_.back()).name;
+                    bound_.pop_back();
+                    body = universal ? make_forall(hint, body) : make_exists(hint, body);
+                }
+                return body;
+            }
+
+            return parse_atom();
+        }
+
+        // Atoms and terms (shared by FOF and CNF)
+
+        TermDBPtr parse_atom()
+        {
+            Token start = current_;
+            if (start.kind == TokenKind::DOLLAR_WORD)
+            {
+                error(start, "unsupported defined symbol '" + std::string(start.text) + "'");
+            }
+
+            TermDBPtr left = parse_term();
+            if (at("=") || at("!="))
+            {
+                bool negated = current_.text == "!=";
+                advance();
+                TermDBPtr equality = make_function_application(EQUALITY, {left, parse_term()});
+                return negated ? make_not(equality) : equality;
+            }
+
+            if (left->kind() == TermDB::TermKind::VARIABLE)
+            {
+                error(start, "variable used as a formula");
+            }
+            return left;
+        }
+
+        TermDBPtr parse_term()
+        {
+            Token token = current_;
+            switch (token.kind)
+            {
+            case TokenKind::UPPER_WORD:
+                advance();
+                return owner_.variable(variable_index(token));
+
+            case TokenKind::LOWER_WORD:
+            case TokenKind::SINGLE_QUOTED:
+            case TokenKind::DISTINCT_OBJECT:
+            case TokenKind::NUMBER:
+            {
+                Symbol &symbol = owner_.intern(token.text);
+                advance();
+                if (!at("("))
+                {
+                    if (!symbol.constant)
+                    {
+                        symbol.constant = make_constant(symbol.name);
+                    }
+                    return symbol.constant;
+                }
+                if (token.kind == TokenKind::DISTINCT_OBJECT || token.kind == TokenKind::NUMBER)
+                {
+                    error(current_, "'" + symbol.name + "' cannot take arguments");
+                }
+
+                advance();
+                std::vector<TermDBPtr> args;
+                args.push_back(parse_term());
+                while (at(","))
+                {
+                    advance();
+                    args.push_back(parse_term());
+                }
+                expect(")");
+                return make_function_application(symbol.name, args);
+            }
+
+            default:
+                error(token, "expected term but found '" + std::string(token.text) + "'");
+            }
+        }
+
+        std::size_t variable_index(const Token &token)
+        {
+            if (parsing_cnf_)
+            {
+                // CNF variables are implicitly universally quantified; clauses
+                // have few of them, so a linear scan beats hashing
+                for (std::size_t i = 0; i < clause_variables_.size(); ++i)
+                {
+                    if (clause_variables_[i] == token.text)
+                    {
+                        return i;
+                    }
+                }
+                clause_variables_.push_back(token.text);
+                return clause_variables_.size() - 1;
+            }
+
+            for (std::size_t i = bound_.size(); i-- > 0;)
+            {
+                if (bound_[i] == token.text)
+                {
+                    return bound_.size() - 1 - i;
+                }
+            }
+            error(token, "unbound variable " + std::string(token.text));
+        }
+
+        // CNF formulas
+
+        ClausePtr parse_cnf_formula()
+        {
+            parsing_cnf_ = true;
+            bool parenthesized = at("(");
+            if (parenthesized)
+            {
+                advance();
+            }
+
+            std::vector<Literal> literals;
+            bool tautology = false;
+            parse_cnf_literal(literals, tautology);
+            while (at("|"))
+            {
+                advance();
+                parse_cnf_literal(literals, tautology);
+            }
+
+            if (parenthesized)
+            {
+                expect(")");
+            }
+            parsing_cnf_ = false;
+
+            return tautology ? nullptr : std::make_shared<Clause>(literals);
+        }
+
+        void parse_cnf_literal(std::vector<Literal> &literals, bool &tautology)
+        {
+            bool positive = true;
+            if (at("~"))
+            {
+                positive = false;
+                advance();
+            }
+
+            if (current_.kind == TokenKind::DOLLAR_WORD &&
+                (current_.text == "$true" || current_.text == "$false"))
+            {
+                // $false literals vanish, $true literals make the clause trivially true
+                tautology = tautology || ((current_.text == "$true") == positive);
+                advance();
+                return;
+            }
+
+            TermDBPtr atom = parse_atom();
+            if (atom->kind() == TermDB::TermKind::NOT)
+            {
+                // X != Y
+                atom = std::static_pointer_cast<NotDB>(atom)->body();
+                positive = !positive;
+            }
+            literals.emplace_back(atom, positive);
+        }
+    };
+
+    TPTPParser::TPTPParser(const std::string &include_root)
+        : include_root_(include_root)
+    {
+        if (include_root_.empty())
+        {
+            const char *tptp = std::getenv("TPTP");
+            include_root_ = tptp ? tptp : "";
+        }
+    }
+
+    TPTPParser::~TPTPParser() = default;
+
+    TPTPParser::Symbol &TPTPParser::intern(std::string_view text)
+    {
+        auto it = symbol_index_.find(text);
+        if (it != symbol_index_.end())
+        {
+            return *it->second;
+        }
+
+        symbols_.push_back(Symbol{std::string(text), nullptr});
+        Symbol &symbol = symbols_.back();
+        symbol_index_.emplace(std::string_view(symbol.name), &symbol);
+        return symbol;
+    }
+
+    const TermDBPtr &TPTPParser::variable(std::size_t index)
+    {
+        while (variables_.size() <= index)
+        {
+            variables_.push_back(make_variable(variables_.size()));
+        }
+        return variables_[index];
+    }
+
+    std::string TPTPParser::resolve_include(const std::string &path, const std::string &directory) const
+    {
+        std::vector<std::string> candidates;
+        if (!path.empty() && path[0] == '/')
+        {
+            candidates.push_back(path);
+        }
+        else
+        {
+            candidates.push_back(directory + "/" + path);
+            if (!include_root_.empty())
+            {
+                candidates.push_back(include_root_ + "/" + path);
+            }
+        }
+
+        for (const auto &candidate : candidates)
+        {
+            if (::access(candidate.c_str(), R_OK) == 0)
+            {
+                return candidate;
+            }
+        }
+        return "";
+    }
+
+    void TPTPParser::parse_path(const std::string &path, const FormulaHandler &handler,
+                                const std::unordered_set<std::string> *selection)
+    {
+        MappedFile file(path);
+        if (!file.ok())
+        {
+            throw TPTPParseError(path, 0, 0, "cannot open file");
+        }
+
+        // Files are compared by identity, as paths like "sub/../a.p" or
+        // links name the same file differently
+        if (std::find(include_stack_.begin(), include_stack_.end(), file.identity()) != include_stack_.end())
+        {
+            throw TPTPParseError(path, 0, 0, "recursive include");
+        }
+
+        include_stack_.push_back(file.identity());
+        try
+        {
+            FileParser parser(*this, file.text(), path, handler, selection);
+            parser.parse();
+            if (include_stack_.size() == 1 && expected_status_.empty())
+            {
+                expected_status_ = parser.expected_status();
+            }
+        }
+        catch (...)
+        {
+            include_stack_.pop_back();
+            throw;
+        }
+        include_stack_.pop_back();
+    }
+
+    void TPTPParser::stream_file(const std::string &path, const FormulaHandler &handler)
+    {
+        parse_path(path, handler, nullptr);
+    }
+
+    void TPTPParser::stream_string(std::string_view text, const std::string &source,
+                                   const FormulaHandler &handler)
+    {
+        FileParser parser(*this, text, source, handler, nullptr);
+        parser.parse();
+        if (expected_status_.empty())
+        {
+            expected_status_ = parser.expected_status();
+        }
+    }
+
+    TPTPProblem TPTPParser::parse_string(const std::string &text, const std::string &source)
+    {
+        TPTPParser parser;
+        TPTPProblem problem;
+        problem.name = source;
+        parser.stream_string(text, source, [&](TPTPFormula &&formula)
+                             { problem.formulas.push_back(std::move(formula)); });
+        problem.expected_status = parser.expected_status();
+        return problem;
+    }
+
+    TPTPProblem TPTPParser::parse_file(const std::string &path)
+    {
+        TPTPParser parser;
+        TPTPProblem problem;
+        parser.stream_file(path, [&](TPTPFormula &&formula)
+                           { problem.formulas.push_back(std::move(formula)); });
+        problem.expected_status = parser.expected_status();
+
+        std::string name = path.substr(path.find_last_of('/') + 1);
+        problem.name = name.substr(0, name.find_last_of('.'));
+        return problem;
+    }
+
+    TermDBPtr TPTPProblem::conjecture() const
+    {
+        TermDBPtr result;
+        for (const auto &formula : formulas)
+        {
+            if (formula.language == TPTPFormula::Language::FOF &&
+                formula.role == TPTPFormula::Role::CONJECTURE)
+            {
+                result = result ? make_and(result, formula.formula) : formula.formula;
+            }
+        }
+        return result;
+    }
+
+    std::vector<TermDBPtr> TPTPProblem::hypotheses() const
+    {
+        std::vector<TermDBPtr> result;
+        for (const auto &formula : formulas)
+        {
+            if (formula.language == TPTPFormula::Language::FOF &&
+                formula.role != TPTPFormula::Role::CONJECTURE)
+            {
+                result.push_back(formula.formula);
+            }
+        }
+        return result;
+    }
+
+    bool TPTPProblem::is_fof() const
+    {
+        for (const auto &formula : formulas)
+        {
+            if (formula.language != TPTPFormula::Language::FOF)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<ClausePtr> TPTPProblem::refutation_clauses() const
+    {
+        std::vector<ClausePtr> clauses;
+        std::size_t skolems = 0;
+        for (const auto &formula : formulas)
+        {
+            if (formula.language == TPTPFormula::Language::CNF)
+            {
+                if (formula.clause)
+                {
+                    clauses.push_back(formula.clause);
+                }
+            }
+            else if (formula.role != TPTPFormula::Role::CONJECTURE)
+            {
+                auto cnf = CNFConverter::to_cnf(formula.formula, skolems);
+                clauses.insert(clauses.end(), cnf.begin(), cnf.end());
+            }
+        }
+
+        if (auto goal = conjecture())
+        {
+            auto cnf = CNFConverter::to_cnf(make_not(goal), skolems);
+            clauses.insert(clauses.end(), cnf.begin(), cnf.end());
+        }
+        return clauses;
+    }
+
+} // namespace theorem_prover
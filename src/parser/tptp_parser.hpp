@@ -0,0 +1,201 @@
+#pragma once
+
+#include "../term/term_db.hpp"
+#include "../resolution/clause.hpp"
+#include <deque>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/types.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace theorem_prover
+{
+
+    /**
+     * @brief Error raised for malformed problem files
+     */
+    class TPTPParseError : public std::runtime_error
+    {
+    public:
+        TPTPParseError(const std::string &source, std::size_t line, std::size_t column,
+                       const std::string &message)
+            : std::runtime_error(source + ":" + std::to_string(line) + ":" +
+                                 std::to_string(column) + ": " + message),
+              line_(line), column_(column) {}
+
+        std::size_t line() const { return line_; }
+        std::size_t column() const { return column_; }
+
+    private:
+        std::size_t line_;
+        std::size_t column_;
+    };
+
+    /**
+     * @brief One annotated formula of a problem file
+     *
+     * FOF formulas are closed TermDB formulas (quantified variables use
+     * De Bruijn indices); CNF formulas are parsed straight into clauses whose
+     * variables are numbered per clause.
+     */
+    struct TPTPFormula
+    {
+        enum class Language
+        {
+            FOF,
+            CNF
+        };
+
+        enum class Role
+        {
+            AXIOM,             // axiom, hypothesis, definition, lemma, theorem, ...
+            CONJECTURE,        // To be proved
+            NEGATED_CONJECTURE // Already negated, part of the refutation
+        };
+
+        std::string name;
+        Language language = Language::FOF;
+        Role role = Role::AXIOM;
+        TermDBPtr formula; // FOF only
+        ClausePtr clause;  // CNF only (nullptr for clauses containing $true)
+    };
+
+    /**
+     * @brief A parsed problem: its formulas plus header information
+     */
+    struct TPTPProblem
+    {
+        std::string name;
+        std::string expected_status; // From a "% Status : ..." header line, if present
+        std::vector<TPTPFormula> formulas;
+
+        /**
+         * Conjunction of all FOF conjectures (nullptr if there are none)
+         */
+        TermDBPtr conjecture() const;
+
+        /**
+         * All FOF formulas that are not conjectures
+         */
+        std::vector<TermDBPtr> hypotheses() const;
+
+        /**
+         * True if every formula is FOF, so the problem can be passed to
+         * ResolutionProver::prove as goal and hypotheses
+         */
+        bool is_fof() const;
+
+        /**
+         * The clause set whose unsatisfiability establishes the problem:
+         * CNF of all axioms, CNF of the negated conjecture, and all CNF clauses.
+         * Skolem symbols are numbered sk0, sk1, ... in formula order.
+         */
+        std::vector<ClausePtr> refutation_clauses() const;
+    };
+
+    /**
+     * @brief Streaming reader for problems in the FOF and CNF dialects of TPTP
+     *
+     * Supported: fof/cnf annotated formulas with the connectives
+     * ~ & | => <= <=> <~> ~| ~&, quantifiers ! and ?, = and !=, quoted names,
+     * numbers and distinct objects as constants, % and block comments, and
+     * include directives with optional name selection. Annotations after the
+     * formula are skipped. Uppercase identifiers are variables, as in TPTP.
+     *
+     * Files are memory-mapped and tokenized in place; formulas are built as
+     * TermDB directly and handed to the caller one at a time, so large axiom
+     * sets are never held as text or as a whole. Symbols are interned per
+     * parser instance and constants and variables share one node per symbol,
+     * so reusing a parser for several files also shares their terms.
+     */
+    class TPTPParser
+    {
+    public:
+        using FormulaHandler = std::function<void(TPTPFormula &&)>;
+
+        /**
+         * @param include_root Directory against which include paths are
+         *        resolved when not found next to the including file
+         *        (defaults to the TPTP environment variable)
+         */
+        explicit TPTPParser(const std::string &include_root = "");
+        ~TPTPParser();
+
+        TPTPParser(const TPTPParser &) = delete;
+        TPTPParser &operator=(const TPTPParser &) = delete;
+
+        /**
+         * Parse a file, passing each formula (including those of included
+         * files) to the handler in order
+         * @throws TPTPParseError if a file cannot be read or is malformed
+         */
+        void stream_file(const std::string &path, const FormulaHandler &handler);
+
+        /**
+         * Parse problem text, passing each formula to the handler in order
+         * @param source Name used in error messages; includes are resolved
+         *        relative to its directory
+         * @throws TPTPParseError on malformed input
+         */
+        void stream_string(std::string_view text, const std::string &source,
+                           const FormulaHandler &handler);
+
+        /**
+         * Value of the first "% Status : ..." header line of a top-level file
+         */
+        const std::string &expected_status() const { return expected_status_; }
+
+        /**
+         * Number of distinct symbols interned so far
+         */
+        std::size_t symbol_count() const { return symbols_.size(); }
+
+        /**
+         * Parse problem text into a problem
+         * @param text The problem text
+         * @param source Name used for the problem and in error messages
+         * @throws TPTPParseError on malformed input
+         */
+        static TPTPProblem parse_string(const std::string &text,
+                                        const std::string &source = "<string>");
+
+        /**
+         * Parse a problem file; the problem is named after the file
+         * @throws TPTPParseError if a file cannot be read or is malformed
+         */
+        static TPTPProblem parse_file(const std::string &path);
+
+    private:
+        class FileParser;
+
+        struct Symbol
+        {
+            std::string name;
+            TermDBPtr constant; // Shared node for the symbol used as a constant
+        };
+
+        std::string include_root_;
+        std::vector<std::pair<dev_t, ino_t>> include_stack_; // Files being parsed, for cycle detection
+        std::string expected_status_;
+
+        std::deque<Symbol> symbols_; // Stable addresses for symbol_index_ keys
+        std::unordered_map<std::string_view, Symbol *> symbol_index_;
+        std::vector<TermDBPtr> variables_; // Shared variable nodes by index
+
+        Symbol &intern(std::string_view text);
+        const TermDBPtr &variable(std::size_t index);
+
+        // Path of an included file, or "" if it cannot be found
+        std::string resolve_include(const std::string &path, const std::string &directory) const;
+
+        // Parse one file, passing only formulas named in selection (if set)
+        void parse_path(const std::string &path, const FormulaHandler &handler,
+                        const std::unordered_set<std::string> *selection);
+    };
+
+} // namespace theorem_prover
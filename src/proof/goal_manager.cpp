@@ -5,7 +5,8 @@
 namespace theorem_prover
 {
 
-    GoalManager::GoalManager() {}
+    GoalManager::GoalManager(std::shared_ptr<LemmaStore> lemma_store)
+        : lemma_store_(std::move(lemma_store)) {}
 
     std::vector<ProofStatePtr> GoalManager::decompose_goal(
         ProofContext &context,
@@ -14,6 +15,15 @@ namespace theorem_prover
 
         auto goal = state->goal();
 
+        // A goal proven before needs no decomposition
+        if (lemma_store_)
+        {
+            if (auto proved = lemma_store_->close_goal(context, state))
+            {
+                return {proved};
+            }
+        }
+
         // Handle different goal types
         if (goal->kind() == TermDB::TermKind::AND)
         {
@@ -31,6 +41,11 @@ namespace theorem_prover
 
         std::string goal_key = term_key(goal);
         proven_subgoals_[goal_key] = state;
+
+        if (lemma_store_)
+        {
+            lemma_store_->add(goal, state->hypotheses(), state->certification().justification);
+        }
     }
 
     ProofStatePtr GoalManager::try_recombine(
@@ -443,7 +458,13 @@ namespace theorem_prover
             ProofCertification::Status::PROVED_BY_RULE,
             "Proof completed by recombining subgoals");
 
-        // Register this proven goal
+        // Register this proven goal. The completed state has the
+        // conjunction itself as a hypothesis, so the lemma is stored
+        // with the hypotheses it was built from.
+        if (lemma_store_)
+        {
+            lemma_store_->add(parent_goal, merged_hypotheses, "Recombined subgoals");
+        }
         register_proven_subgoal(parent_goal, completed_state);
 
         return completed_state;
@@ -601,7 +622,7 @@ namespace theorem_prover
     Tactic goal_oriented_search(GoalManager &goal_manager, const Tactic &inner_tactic)
     {
         // Optimized tactic sequencing
-        return sequence({
+        std::vector<Tactic> steps = {
 
             register_proven_subgoal(goal_manager),
 
@@ -611,7 +632,14 @@ namespace theorem_prover
 
             recombine_subgoals(goal_manager),
 
-            decompose_goals(goal_manager)});
+            decompose_goals(goal_manager)};
+
+        // Stored lemmas are tried before any search
+        if (goal_manager.lemma_store())
+        {
+            steps.insert(steps.begin(), use_lemmas(goal_manager.lemma_store()));
+        }
+        return sequence(steps);
     }
 
 } // namespace theorem_prover
\ No newline at end of file
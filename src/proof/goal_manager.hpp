@@ -3,6 +3,7 @@
 
 #include "proof_state.hpp"
 #include "tactic.hpp"
+#include "lemma_store.hpp"
 #include <unordered_map>
 #include <memory>
 #include <vector>
@@ -17,10 +18,14 @@ namespace theorem_prover {
  * Tracks subgoals that have been proven and can recombine them to 
  * prove the parent goal. This supports structured incremental proofs
  * by allowing divide-and-conquer reasoning strategies.
+ *
+ * With a lemma store, goals proven by an earlier proof (of this manager
+ * or any other sharing the store) are closed without search, and the
+ * goals this manager proves are added to the store.
  */
 class GoalManager {
 public:
-    GoalManager();
+    explicit GoalManager(std::shared_ptr<LemmaStore> lemma_store = nullptr);
     
     /**
      * Decomposes a goal into simpler subgoals
@@ -68,9 +73,15 @@ public:
     bool all_subgoals_proven(const TermDBPtr& goal) const;
     
     /**
-     * Clears all proven subgoals and goal decompositions
+     * Clears all proven subgoals and goal decompositions; the lemma store
+     * is left as it is
      */
     void clear();
+
+    /**
+     * The lemma store consulted and extended, or nullptr
+     */
+    const std::shared_ptr<LemmaStore>& lemma_store() const { return lemma_store_; }
     
 private:
     // Maps from term string representation to the state that proves it
@@ -79,6 +90,9 @@ private:
     // Maps from parent goal string to a vector of subgoal strings
     // preserving the left-right structure for conjunctions
     std::unordered_map<std::string, std::vector<std::string>> goal_decompositions_;
+
+    // Lemmas shared across proofs; may be null
+    std::shared_ptr<LemmaStore> lemma_store_;
     
     // Generate a canonical string representation of a term
     // Handles alpha-equivalence of terms
@@ -0,0 +1,333 @@
+#include "lemma_store.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace theorem_prover
+{
+
+    namespace
+    {
+        const char store_magic[] = "TPLEMMA1";
+
+        // Prefix form of the term: every node is a tag, symbols carry their
+        // length and applications their arity, so the key is unambiguous.
+        // Bound variables are de Bruijn indices and hints are left out.
+        bool append_key(const TermDBPtr &term, std::string &key)
+        {
+            auto append_symbol = [&key](const std::string &symbol)
+            {
+                key += std::to_string(symbol.size()) + ":" + symbol;
+            };
+
+            switch (term->kind())
+            {
+            case TermDB::TermKind::VARIABLE:
+                key += "v" + std::to_string(std::static_pointer_cast<VariableDB>(term)->index()) + ";";
+                return true;
+            case TermDB::TermKind::CONSTANT:
+                key += "c";
+                append_symbol(std::static_pointer_cast<ConstantDB>(term)->symbol());
+                return true;
+            case TermDB::TermKind::FUNCTION_APPLICATION:
+            {
+                auto application = std::static_pointer_cast<FunctionApplicationDB>(term);
+                key += "f" + std::to_string(application->arguments().size()) + "/";
+                append_symbol(application->symbol());
+                for (const auto &argument : application->arguments())
+                {
+                    if (!append_key(argument, key))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            case TermDB::TermKind::AND:
+            {
+                auto conjunction = std::static_pointer_cast<AndDB>(term);
+                key += "&";
+                return append_key(conjunction->left(), key) && append_key(conjunction->right(), key);
+            }
+            case TermDB::TermKind::OR:
+            {
+                auto disjunction = std::static_pointer_cast<OrDB>(term);
+                key += "|";
+                return append_key(disjunction->left(), key) && append_key(disjunction->right(), key);
+            }
+            case TermDB::TermKind::NOT:
+                key += "~";
+                return append_key(std::static_pointer_cast<NotDB>(term)->body(), key);
+            case TermDB::TermKind::IMPLIES:
+            {
+                auto implication = std::static_pointer_cast<ImpliesDB>(term);
+                key += ">";
+                return append_key(implication->antecedent(), key) && append_key(implication->consequent(), key);
+            }
+            case TermDB::TermKind::FORALL:
+                key += "A";
+                return append_key(std::static_pointer_cast<ForallDB>(term)->body(), key);
+            case TermDB::TermKind::EXISTS:
+                key += "E";
+                return append_key(std::static_pointer_cast<ExistsDB>(term)->body(), key);
+            default:
+                return false;
+            }
+        }
+
+        // Sorted, distinct keys of the hypotheses; nullopt if one has no key
+        std::optional<std::vector<std::string>> context_keys(const std::vector<Hypothesis> &hypotheses)
+        {
+            std::vector<std::string> keys;
+            keys.reserve(hypotheses.size());
+            for (const auto &hypothesis : hypotheses)
+            {
+                std::string key = LemmaStore::formula_key(hypothesis.formula());
+                if (key.empty())
+                {
+                    return std::nullopt;
+                }
+                keys.push_back(std::move(key));
+            }
+            std::sort(keys.begin(), keys.end());
+            keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+            return keys;
+        }
+
+        bool is_subset(const std::vector<std::string> &subset, const std::vector<std::string> &set)
+        {
+            return std::includes(set.begin(), set.end(), subset.begin(), subset.end());
+        }
+    }
+
+    LemmaStore::LemmaStore(const std::string &path) : path_(path)
+    {
+        if (!std::ifstream(path, std::ios::binary))
+        {
+            BinaryWriter header;
+            header.write_string(store_magic);
+            write_binary_file(path, header.data());
+            return;
+        }
+
+        // Records are length-prefixed, so one cut short by a crash while
+        // appending is recognized and dropped
+        std::string data = read_binary_file(path);
+        BinaryReader in(data);
+        if (in.read_string() != store_magic)
+        {
+            throw SerializationError(path + ": not a lemma store");
+        }
+        while (!in.at_end())
+        {
+            std::string record;
+            try
+            {
+                record = in.read_string();
+            }
+            catch (const SerializationError &)
+            {
+                std::cerr << "Warning: " << path << ": incomplete last lemma dropped" << std::endl;
+                break;
+            }
+
+            BinaryReader fields(record);
+            std::string key = fields.read_string();
+            Lemma lemma;
+            lemma.context.resize(fields.read_count());
+            for (auto &hypothesis : lemma.context)
+            {
+                hypothesis = fields.read_string();
+            }
+            lemma.justification = fields.read_string();
+            insert(key, std::move(lemma));
+        }
+    }
+
+    bool LemmaStore::add(const TermDBPtr &formula, const std::vector<Hypothesis> &context,
+                         const std::string &justification)
+    {
+        std::string key = formula_key(formula);
+        auto hypotheses = context_keys(context);
+        if (key.empty() || !hypotheses || std::binary_search(hypotheses->begin(), hypotheses->end(), key))
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        Lemma lemma{*hypotheses, justification};
+        if (!insert(key, lemma))
+        {
+            return false;
+        }
+
+        if (!path_.empty())
+        {
+            BinaryWriter fields;
+            fields.write_string(key);
+            fields.write_varint(lemma.context.size());
+            for (const auto &hypothesis : lemma.context)
+            {
+                fields.write_string(hypothesis);
+            }
+            fields.write_string(lemma.justification);
+            BinaryWriter record;
+            record.write_string(fields.data());
+
+            std::ofstream out(path_, std::ios::binary | std::ios::app);
+            out.write(record.data().data(), static_cast<std::streamsize>(record.data().size()));
+            if (!out)
+            {
+                std::cerr << "Warning: lemma not saved to " << path_ << std::endl;
+            }
+        }
+        return true;
+    }
+
+    std::optional<std::string> LemmaStore::find(const TermDBPtr &formula,
+                                                const std::vector<Hypothesis> &context) const
+    {
+        std::string key = formula_key(formula);
+        if (key.empty())
+        {
+            return std::nullopt;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = lemmas_.find(key);
+        if (it == lemmas_.end())
+        {
+            return std::nullopt;
+        }
+        auto hypotheses = context_keys(context);
+        for (const auto &lemma : it->second)
+        {
+            // A hypothesis without a key can still be one the lemma does not need
+            if (lemma.context.empty() || (hypotheses && is_subset(lemma.context, *hypotheses)))
+            {
+                ++hits_;
+                return lemma.justification;
+            }
+        }
+        return std::nullopt;
+    }
+
+    ProofStatePtr LemmaStore::close_goal(ProofContext &context, const ProofStatePtr &state) const
+    {
+        auto justification = find(state->goal(), state->hypotheses());
+        if (!justification)
+        {
+            return nullptr;
+        }
+
+        // The lemma enters as a hypothesis that proves the goal directly
+        auto lemma_state = context.apply_rule(
+            state,
+            "lemma",
+            {},
+            {Hypothesis("lemma", state->goal())},
+            state->goal());
+        auto proved_state = context.apply_rule(
+            lemma_state,
+            "direct_proof",
+            {"lemma"},
+            {},
+            state->goal());
+        proved_state->mark_as_proved(
+            ProofCertification::Status::PROVED_BY_RULE,
+            "Lemma: " + *justification);
+        return proved_state;
+    }
+
+    std::size_t LemmaStore::size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::size_t count = 0;
+        for (const auto &[key, lemmas] : lemmas_)
+        {
+            count += lemmas.size();
+        }
+        return count;
+    }
+
+    std::size_t LemmaStore::hits() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return hits_;
+    }
+
+    std::string LemmaStore::formula_key(const TermDBPtr &formula)
+    {
+        std::string key;
+        return formula && append_key(formula, key) ? key : std::string();
+    }
+
+    bool LemmaStore::insert(const std::string &key, Lemma lemma)
+    {
+        // Keep only the lemmas with the weakest contexts
+        auto &lemmas = lemmas_[key];
+        for (const auto &existing : lemmas)
+        {
+            if (is_subset(existing.context, lemma.context))
+            {
+                return false;
+            }
+        }
+        lemmas.erase(std::remove_if(lemmas.begin(), lemmas.end(),
+                                    [&lemma](const Lemma &existing)
+                                    { return is_subset(lemma.context, existing.context); }),
+                     lemmas.end());
+        lemmas.push_back(std::move(lemma));
+        return true;
+    }
+
+    // Tactics that use the lemma store
+
+    Tactic use_lemmas(const std::shared_ptr<LemmaStore> &store)
+    {
+        return [store](
+                   ProofContext &context,
+                   const ProofStatePtr &state,
+                   std::optional<ConstraintViolation> & /*violation*/) -> std::vector<ProofStatePtr>
+        {
+            if (state->is_proved())
+            {
+                return {state};
+            }
+
+            if (auto proved = store->close_goal(context, state))
+            {
+                return {proved};
+            }
+            return {state};
+        };
+    }
+
+    Tactic with_lemmas(const std::shared_ptr<LemmaStore> &store, const Tactic &inner_tactic)
+    {
+        return [store, inner_tactic](
+                   ProofContext &context,
+                   const ProofStatePtr &state,
+                   std::optional<ConstraintViolation> &violation) -> std::vector<ProofStatePtr>
+        {
+            if (!state->is_proved())
+            {
+                if (auto proved = store->close_goal(context, state))
+                {
+                    return {proved};
+                }
+            }
+
+            auto results = inner_tactic(context, state, violation);
+            for (const auto &result : results)
+            {
+                if (result->is_proved())
+                {
+                    store->add(result->goal(), result->hypotheses(), result->certification().justification);
+                }
+            }
+            return results;
+        };
+    }
+
+} // namespace theorem_prover
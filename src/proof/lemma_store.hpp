@@ -0,0 +1,106 @@
+#pragma once
+
+#include "proof_state.hpp"
+#include "tactic.hpp"
+#include "../utils/binary_io.hpp"
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace theorem_prover
+{
+
+    /**
+     * Lemmas proven earlier, for reuse by later proofs
+     *
+     * A lemma is a formula together with the hypotheses it was proven
+     * under. It closes a goal that is the same formula up to the names of
+     * bound variables, in a state that has at least those hypotheses;
+     * hypothesis names do not matter. Formulas are compared by a canonical
+     * key of their de Bruijn form, so alpha-equivalent goals share one.
+     *
+     * A store can be memory only, or backed by a file that is read when
+     * the store is opened and appended to as lemmas are added, so lemmas
+     * outlive the process. All members are safe to call from several
+     * threads.
+     */
+    class LemmaStore
+    {
+    public:
+        // A store kept in memory only
+        LemmaStore() = default;
+
+        // A store backed by the file, created if missing. Throws
+        // SerializationError if the file exists but is not a lemma store;
+        // a record cut short at the end is dropped with a warning.
+        explicit LemmaStore(const std::string &path);
+
+        /**
+         * Record a proven formula
+         *
+         * @param formula The formula proven
+         * @param context The hypotheses of the proof
+         * @param justification How it was proven, reported on reuse
+         * @return false if a lemma already covers it, or if the formula is
+         *         among its own hypotheses, which makes it useless to store
+         */
+        bool add(const TermDBPtr &formula, const std::vector<Hypothesis> &context,
+                 const std::string &justification);
+
+        /**
+         * The justification of a lemma that proves the formula under the
+         * hypotheses, or nullopt if there is none
+         */
+        std::optional<std::string> find(const TermDBPtr &formula, const std::vector<Hypothesis> &context) const;
+
+        /**
+         * A proved successor of the state if a lemma closes its goal,
+         * otherwise nullptr
+         */
+        ProofStatePtr close_goal(ProofContext &context, const ProofStatePtr &state) const;
+
+        std::size_t size() const;
+        std::size_t hits() const;
+
+        // Canonical key of a formula: equal for alpha-equivalent formulas
+        static std::string formula_key(const TermDBPtr &formula);
+
+    private:
+        struct Lemma
+        {
+            std::vector<std::string> context; // Sorted, distinct formula keys of the hypotheses
+            std::string justification;
+        };
+
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, std::vector<Lemma>> lemmas_; // By formula key
+        std::string path_;                                            // Backing file; empty if memory only
+        mutable std::size_t hits_ = 0;
+
+        // Record a lemma in memory; false if it is already covered
+        bool insert(const std::string &key, Lemma lemma);
+    };
+
+    /**
+     * Creates a tactic that closes goals proven by a stored lemma, and
+     * leaves other states as they are
+     *
+     * @param store The lemma store to consult
+     * @return Tactic A tactic that reuses lemmas
+     */
+    Tactic use_lemmas(const std::shared_ptr<LemmaStore> &store);
+
+    /**
+     * Creates a tactic that consults the store before the inner tactic and
+     * records the goals of the proved states it produces
+     *
+     * @param store The lemma store to consult and extend
+     * @param inner_tactic The tactic to run when no lemma applies
+     * @return Tactic The inner tactic with lemma reuse
+     */
+    Tactic with_lemmas(const std::shared_ptr<LemmaStore> &store, const Tactic &inner_tactic);
+
+} // namespace theorem_prover
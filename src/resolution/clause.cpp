@@ -7,6 +7,8 @@
 #include "../term/unification.hpp"
 #include <set>
 #include <algorithm>
+#include <memory>
+#include <new>
 #include <sstream>
 #include <unordered_set>
 
@@ -93,26 +95,155 @@ namespace theorem_prover
         return result;
     }
 
+    namespace
+    {
+
+        // Symbol and variable occurrences of a term, and its largest variable index + 1
+        void measure_term(const TermDBPtr &term, std::size_t &weight, std::size_t &variable_bound)
+        {
+            ++weight;
+            switch (term->kind())
+            {
+            case TermDB::TermKind::VARIABLE:
+            {
+                auto var = std::static_pointer_cast<VariableDB>(term);
+                variable_bound = std::max(variable_bound, var->index() + 1);
+                break;
+            }
+            case TermDB::TermKind::FUNCTION_APPLICATION:
+            {
+                auto app = std::static_pointer_cast<FunctionApplicationDB>(term);
+                for (const auto &arg : app->arguments())
+                {
+                    measure_term(arg, weight, variable_bound);
+                }
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+    } // namespace
+
     // Clause implementation
     Clause::Clause(const std::vector<Literal> &literals)
-        : literals_(literals), hash_computed_(false) {}
+    {
+        build(std::vector<Literal>(literals));
+    }
+
+    Clause::Clause(std::vector<Literal> &&literals)
+    {
+        build(std::move(literals));
+    }
 
     Clause::Clause(const std::vector<LiteralPtr> &literals)
-        : hash_computed_(false)
     {
+        std::vector<Literal> copy;
+        copy.reserve(literals.size());
         for (const auto &lit_ptr : literals)
         {
-            literals_.push_back(*lit_ptr);
+            copy.push_back(*lit_ptr);
+        }
+        build(std::move(copy));
+    }
+
+    Clause::Clause(const Clause &other)
+    {
+        if (!other.storage_)
+        {
+            return;
+        }
+
+        // Features, caches and signatures carry over unchanged
+        std::size_t size = other.storage_->size;
+        storage_.reset(allocate(size));
+        ClausePool *pool = storage_->pool;
+        *storage_ = *other.storage_;
+        storage_->pool = pool;
+        storage_->id = no_clause_id;
+        std::uninitialized_copy_n(other.storage_->literals(), size, storage_->literals());
+        if (storage_->features_computed)
+        {
+            std::uninitialized_copy_n(other.storage_->signatures(), size, storage_->signatures());
+        }
+    }
+
+    Clause &Clause::operator=(Clause other) noexcept
+    {
+        storage_.swap(other.storage_);
+        return *this;
+    }
+
+    std::size_t Clause::block_bytes(std::size_t size)
+    {
+        // Header, literals and signatures are all 8-byte aligned
+        return sizeof(Storage) + size * (sizeof(Literal) + sizeof(LiteralSignature));
+    }
+
+    Clause::Storage *Clause::allocate(std::size_t size)
+    {
+        ClausePool *pool = ClausePool::current();
+        if (size > ClausePool::max_pooled_literals)
+        {
+            pool = nullptr;
+        }
+
+        void *block = pool ? pool->allocate(size, block_bytes(size)) : ::operator new(block_bytes(size));
+        Storage *storage = new (block) Storage();
+        storage->size = size;
+        storage->pool = pool;
+        return storage;
+    }
+
+    void Clause::StorageDeleter::operator()(Storage *storage) const
+    {
+        std::size_t size = storage->size;
+        ClausePool *pool = storage->pool;
+        std::destroy_n(storage->literals(), size);
+        storage->~Storage();
+        if (pool)
+        {
+            pool->deallocate(storage, size);
         }
+        else
+        {
+            ::operator delete(storage);
+        }
+    }
+
+    void Clause::build(std::vector<Literal> &&literals)
+    {
+        if (literals.empty())
+        {
+            return;
+        }
+
+        storage_.reset(allocate(literals.size()));
+        std::uninitialized_move(literals.begin(), literals.end(), storage_->literals());
+    }
+
+    void Clause::compute_features() const
+    {
+        // Many clauses are intermediate results that are never inspected,
+        // so the features are filled in on first use rather than in build
+        const Literal *slots = storage_->literals();
+        LiteralSignature *signatures = storage_->signatures();
+        for (std::size_t i = 0; i < storage_->size; ++i)
+        {
+            new (signatures + i) LiteralSignature(literal_signature(slots[i]));
+            measure_term(slots[i].atom(), storage_->weight, storage_->variable_bound);
+        }
+        storage_->features_computed = true;
     }
 
     bool Clause::is_tautology() const
     {
-        for (std::size_t i = 0; i < literals_.size(); ++i)
+        for (std::size_t i = 0; i < literals().size(); ++i)
         {
-            for (std::size_t j = i + 1; j < literals_.size(); ++j)
+            for (std::size_t j = i + 1; j < literals().size(); ++j)
             {
-                if (literals_[i].is_complementary(literals_[j]))
+                if (literals()[i].is_complementary(literals()[j]))
                 {
                     return true;
                 }
@@ -130,7 +261,7 @@ namespace theorem_prover
 
         // Remove duplicates
         std::vector<Literal> unique_literals;
-        for (const auto &lit : literals_)
+        for (const auto &lit : literals())
         {
             bool found = false;
             for (const auto &existing : unique_literals)
@@ -153,9 +284,9 @@ namespace theorem_prover
     Clause Clause::substitute(const SubstitutionMap &subst) const
     {
         std::vector<Literal> new_literals;
-        new_literals.reserve(literals_.size());
+        new_literals.reserve(literals().size());
 
-        for (const auto &lit : literals_)
+        for (const auto &lit : literals())
         {
             auto new_atom = SubstitutionEngine::substitute(lit.atom(), subst);
             new_literals.emplace_back(new_atom, lit.is_positive());
@@ -170,7 +301,7 @@ namespace theorem_prover
 
         // Find all variables in all literals
         std::set<std::size_t> all_variables;
-        for (const auto &lit : literals_)
+        for (const auto &lit : literals())
         {
             auto lit_vars = find_all_variables(lit.atom());
             all_variables.insert(lit_vars.begin(), lit_vars.end());
@@ -188,16 +319,16 @@ namespace theorem_prover
 
     bool Clause::equals(const Clause &other) const
     {
-        if (literals_.size() != other.literals_.size())
+        if (literals().size() != other.literals().size())
         {
             return false;
         }
 
         // Check if all literals match (order independent)
-        for (const auto &lit1 : literals_)
+        for (const auto &lit1 : literals())
         {
             bool found = false;
-            for (const auto &lit2 : other.literals_)
+            for (const auto &lit2 : other.literals())
             {
                 if (lit1.equals(lit2))
                 {
@@ -216,36 +347,300 @@ namespace theorem_prover
 
     std::size_t Clause::hash() const
     {
-        if (!hash_computed_)
+        if (!storage_)
+        {
+            return 0;
+        }
+        if (!storage_->hash_computed)
         {
             compute_hash();
         }
-        return hash_cache_;
+        return storage_->hash;
     }
 
     void Clause::compute_hash() const
     {
-        hash_cache_ = 0;
-        for (const auto &lit : literals_)
+        storage_->hash = 0;
+        for (const auto &lit : literals())
+        {
+            hash_combine(storage_->hash, lit.hash());
+        }
+        storage_->hash_computed = true;
+    }
+
+    namespace
+    {
+
+        /**
+         * Hash of a term with its variables numbered in order of first
+         * occurrence, so that it does not change under variable renaming
+         */
+        std::size_t renaming_invariant_hash(const TermDBPtr &term, std::vector<std::size_t> &seen)
+        {
+            switch (term->kind())
+            {
+            case TermDB::TermKind::VARIABLE:
+            {
+                std::size_t index = std::static_pointer_cast<VariableDB>(term)->index();
+                auto it = std::find(seen.begin(), seen.end(), index);
+                std::size_t h = 0x51ed27;
+                hash_combine(h, static_cast<std::size_t>(it - seen.begin()));
+                if (it == seen.end())
+                {
+                    seen.push_back(index);
+                }
+                return h;
+            }
+            case TermDB::TermKind::CONSTANT:
+                return std::hash<std::string>{}(std::static_pointer_cast<ConstantDB>(term)->symbol());
+            case TermDB::TermKind::FUNCTION_APPLICATION:
+            {
+                auto app = std::static_pointer_cast<FunctionApplicationDB>(term);
+                std::size_t h = std::hash<std::string>{}(app->symbol());
+                for (const auto &arg : app->arguments())
+                {
+                    hash_combine(h, renaming_invariant_hash(arg, seen));
+                }
+                return h;
+            }
+            default:
+                // Clause atoms are first-order; other terms only compare exactly
+                return term->hash();
+            }
+        }
+
+        /**
+         * Variant key of a literal: equal for literals that are variants of
+         * each other on their own
+         */
+        std::size_t literal_variant_key(const Literal &literal)
+        {
+            std::vector<std::size_t> seen;
+            std::size_t h = renaming_invariant_hash(literal.atom(), seen);
+            hash_combine(h, literal.is_positive());
+            return h;
+        }
+
+        /**
+         * Variable correspondence built while checking for a variant; each
+         * pair is (variable of the first clause, variable of the second)
+         */
+        using VariablePairs = std::vector<std::pair<std::size_t, std::size_t>>;
+
+        bool match_renaming(const TermDBPtr &t1, const TermDBPtr &t2, VariablePairs &pairs)
+        {
+            if (t1->kind() != t2->kind())
+            {
+                return false;
+            }
+
+            switch (t1->kind())
+            {
+            case TermDB::TermKind::VARIABLE:
+            {
+                std::size_t v1 = std::static_pointer_cast<VariableDB>(t1)->index();
+                std::size_t v2 = std::static_pointer_cast<VariableDB>(t2)->index();
+                for (const auto &pair : pairs)
+                {
+                    if (pair.first == v1 || pair.second == v2)
+                    {
+                        return pair.first == v1 && pair.second == v2;
+                    }
+                }
+                pairs.emplace_back(v1, v2);
+                return true;
+            }
+            case TermDB::TermKind::CONSTANT:
+                return std::static_pointer_cast<ConstantDB>(t1)->symbol() ==
+                       std::static_pointer_cast<ConstantDB>(t2)->symbol();
+            case TermDB::TermKind::FUNCTION_APPLICATION:
+            {
+                auto app1 = std::static_pointer_cast<FunctionApplicationDB>(t1);
+                auto app2 = std::static_pointer_cast<FunctionApplicationDB>(t2);
+                if (app1->symbol() != app2->symbol() || app1->arguments().size() != app2->arguments().size())
+                {
+                    return false;
+                }
+                for (std::size_t i = 0; i < app1->arguments().size(); ++i)
+                {
+                    if (!match_renaming(app1->arguments()[i], app2->arguments()[i], pairs))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            default:
+                return *t1 == *t2;
+            }
+        }
+
+        /**
+         * Assign literal i of the first clause to an unused literal of the
+         * second with the same key, extending the variable correspondence;
+         * backtracks over literals with equal keys
+         */
+        bool match_literals(const ArrayView<Literal> &lits1, const ArrayView<Literal> &lits2,
+                            const std::vector<std::size_t> &keys1, const std::vector<std::size_t> &keys2,
+                            std::size_t i, std::vector<bool> &used, VariablePairs &pairs)
+        {
+            if (i == lits1.size())
+            {
+                return true;
+            }
+
+            for (std::size_t j = 0; j < lits2.size(); ++j)
+            {
+                if (used[j] || keys1[i] != keys2[j])
+                {
+                    continue;
+                }
+
+                std::size_t mark = pairs.size();
+                if (match_renaming(lits1[i].atom(), lits2[j].atom(), pairs))
+                {
+                    used[j] = true;
+                    if (match_literals(lits1, lits2, keys1, keys2, i + 1, used, pairs))
+                    {
+                        return true;
+                    }
+                    used[j] = false;
+                }
+                pairs.resize(mark);
+            }
+            return false;
+        }
+
+        void collect_variables_in_order(const TermDBPtr &term, std::vector<std::size_t> &order)
+        {
+            switch (term->kind())
+            {
+            case TermDB::TermKind::VARIABLE:
+            {
+                std::size_t index = std::static_pointer_cast<VariableDB>(term)->index();
+                if (std::find(order.begin(), order.end(), index) == order.end())
+                {
+                    order.push_back(index);
+                }
+                break;
+            }
+            case TermDB::TermKind::FUNCTION_APPLICATION:
+                for (const auto &arg : std::static_pointer_cast<FunctionApplicationDB>(term)->arguments())
+                {
+                    collect_variables_in_order(arg, order);
+                }
+                break;
+            default:
+                break;
+            }
+        }
+
+    } // namespace
+
+    std::size_t Clause::variant_hash() const
+    {
+        if (!storage_)
+        {
+            return 0;
+        }
+        if (!storage_->variant_hash_computed)
+        {
+            // Combine the literal keys in sorted order so the result does not
+            // depend on literal order either
+            std::vector<std::size_t> keys;
+            keys.reserve(literals().size());
+            for (const auto &lit : literals())
+            {
+                keys.push_back(literal_variant_key(lit));
+            }
+            std::sort(keys.begin(), keys.end());
+
+            storage_->variant_hash = storage_->size;
+            for (std::size_t key : keys)
+            {
+                hash_combine(storage_->variant_hash, key);
+            }
+            storage_->variant_hash_computed = true;
+        }
+        return storage_->variant_hash;
+    }
+
+    bool Clause::is_variant(const Clause &other) const
+    {
+        if (literals().size() != other.literals().size() || variant_hash() != other.variant_hash())
+        {
+            return false;
+        }
+
+        std::vector<std::size_t> keys1, keys2;
+        keys1.reserve(literals().size());
+        keys2.reserve(literals().size());
+        for (std::size_t i = 0; i < literals().size(); ++i)
+        {
+            keys1.push_back(literal_variant_key(literals()[i]));
+            keys2.push_back(literal_variant_key(other.literals()[i]));
+        }
+
+        std::vector<bool> used(literals().size(), false);
+        VariablePairs pairs;
+        return match_literals(literals(), other.literals(), keys1, keys2, 0, used, pairs);
+    }
+
+    Clause Clause::canonical() const
+    {
+        std::vector<std::pair<std::size_t, std::size_t>> order; // (key, literal index)
+        order.reserve(literals().size());
+        for (std::size_t i = 0; i < literals().size(); ++i)
+        {
+            order.emplace_back(literal_variant_key(literals()[i]), i);
+        }
+        std::stable_sort(order.begin(), order.end(), [](const auto &a, const auto &b)
+                         { return a.first < b.first; });
+
+        std::vector<Literal> sorted;
+        std::vector<std::size_t> variables;
+        sorted.reserve(literals().size());
+        for (const auto &entry : order)
+        {
+            sorted.push_back(literals()[entry.second]);
+            collect_variables_in_order(sorted.back().atom(), variables);
+        }
+
+        SubstitutionMap renaming;
+        for (std::size_t i = 0; i < variables.size(); ++i)
         {
-            hash_combine(hash_cache_, lit.hash());
+            if (variables[i] != i)
+            {
+                renaming[variables[i]] = make_variable(i);
+            }
         }
-        hash_computed_ = true;
+
+        Clause result(std::move(sorted));
+        if (!renaming.empty())
+        {
+            result = result.substitute(renaming);
+        }
+        if (result.storage_)
+        {
+            result.storage_->variant_hash = variant_hash();
+            result.storage_->variant_hash_computed = true;
+        }
+        return result;
     }
 
     std::string Clause::to_string() const
     {
-        if (literals_.empty())
+        if (literals().empty())
         {
             return "□"; // Empty clause symbol
         }
 
         std::ostringstream oss;
-        for (std::size_t i = 0; i < literals_.size(); ++i)
+        for (std::size_t i = 0; i < literals().size(); ++i)
         {
             if (i > 0)
                 oss << " ∨ ";
-            oss << literals_[i].to_string();
+            oss << literals()[i].to_string();
         }
         return oss.str();
     }
@@ -315,7 +710,13 @@ namespace theorem_prover
             }
         }
 
+        // simplify() turns a tautology into the empty clause, which would
+        // read as a refutation
         auto resolvent = std::make_shared<Clause>(resolvent_literals);
+        if (resolvent->is_tautology())
+        {
+            return ResolutionResult::make_failure("Resolvent is a tautology");
+        }
         resolvent = std::make_shared<Clause>(resolvent->simplify());
 
         return ResolutionResult::make_success(resolvent);
@@ -323,39 +724,110 @@ namespace theorem_prover
 
     ClausePtr ResolutionInference::factor(const ClausePtr &clause)
     {
-        std::vector<Literal> factored_literals;
+        auto all = factors(clause);
+        return all.empty() ? clause : all.front();
+    }
 
-        for (std::size_t i = 0; i < clause->literals().size(); ++i)
-        {
-            const auto &lit1 = clause->literals()[i];
-            bool kept = false;
+    std::vector<ClausePtr> ResolutionInference::factors(const ClausePtr &clause)
+    {
+        std::vector<ClausePtr> result;
+        const auto &literals = clause->literals();
+        const auto &signatures = clause->signatures();
 
-            // Try to unify with existing literals of same polarity
-            for (std::size_t j = 0; j < factored_literals.size(); ++j)
+        for (std::size_t i = 0; i < literals.size(); ++i)
+        {
+            for (std::size_t j = i + 1; j < literals.size(); ++j)
             {
-                const auto &lit2 = factored_literals[j];
+                if (signatures[i].head != signatures[j].head ||
+                    signatures[i].positive != signatures[j].positive)
+                {
+                    continue;
+                }
 
-                if (lit1.is_positive() == lit2.is_positive())
+                auto unif_result = Unifier::unify(literals[i].atom(), literals[j].atom());
+                if (!unif_result.success)
                 {
-                    auto unif_result = Unifier::unify(lit1.atom(), lit2.atom());
-                    if (unif_result.success)
+                    continue;
+                }
+
+                // Merge the literals σ made equal
+                Clause instance = clause->substitute(unif_result.substitution);
+                std::vector<Literal> merged;
+                for (const auto &lit : instance.literals())
+                {
+                    if (std::none_of(merged.begin(), merged.end(), [&](const Literal &existing)
+                                     { return existing.equals(lit); }))
                     {
-                        // Replace with unified version
-                        auto new_atom = SubstitutionEngine::substitute(lit1.atom(), unif_result.substitution);
-                        factored_literals[j] = Literal(new_atom, lit1.is_positive());
-                        kept = true;
-                        break;
+                        merged.push_back(lit);
                     }
                 }
+
+                auto factored = std::make_shared<Clause>(merged);
+                if (factored->is_tautology() ||
+                    std::any_of(result.begin(), result.end(), [&](const ClausePtr &existing)
+                                { return existing->is_variant(*factored); }))
+                {
+                    continue;
+                }
+                result.push_back(factored);
             }
+        }
+
+        return result;
+    }
+
+    ClausePtr ResolutionInference::subsumption_resolution(const ClausePtr &clause, const ClausePtr &simplifier)
+    {
+        if (!clause || !simplifier || simplifier->is_empty() || simplifier->size() > clause->size())
+        {
+            return nullptr;
+        }
 
-            if (!kept)
+        const auto &literals = clause->literals();
+        const auto &clause_signatures = clause->signatures();
+        const auto &simplifier_signatures = simplifier->signatures();
+        for (std::size_t i = 0; i < literals.size(); ++i)
+        {
+            // Some literal of the simplifier must be able to match ¬L, and
+            // each one some literal of C ∨ ¬L
+            auto negated = clause_signatures[i].complement();
+            bool possible = false;
+            for (const auto &candidate : simplifier_signatures)
             {
-                factored_literals.push_back(lit1);
+                possible = possible || candidate.may_match(negated);
+            }
+            for (std::size_t k = 0; possible && k < simplifier_signatures.size(); ++k)
+            {
+                bool has_target = simplifier_signatures[k].may_match(negated);
+                for (std::size_t j = 0; !has_target && j < clause_signatures.size(); ++j)
+                {
+                    has_target = j != i && simplifier_signatures[k].may_match(clause_signatures[j]);
+                }
+                possible = has_target;
+            }
+            if (!possible)
+            {
+                continue;
             }
-        }
 
-        return std::make_shared<Clause>(factored_literals);
+            // The simplifier subsumes C ∨ ¬L exactly when L can be cut
+            std::vector<Literal> probe = literals;
+            probe[i] = literals[i].negate();
+            if (simplifier->subsumes(Clause(probe)))
+            {
+                std::vector<Literal> rest;
+                rest.reserve(literals.size() - 1);
+                for (std::size_t j = 0; j < literals.size(); ++j)
+                {
+                    if (j != i)
+                    {
+                        rest.push_back(literals[j]);
+                    }
+                }
+                return std::make_shared<Clause>(rest);
+            }
+        }
+        return nullptr;
     }
 
     std::size_t ResolutionInference::find_max_variable_index(const ClausePtr &clause1,
@@ -366,134 +838,277 @@ namespace theorem_prover
         return 100; // Placeholder
     }
 
-    bool Clause::subsumes(const Clause &other) const
-    {
-        return subsumes(std::make_shared<Clause>(*this),
-                        std::make_shared<Clause>(other));
-    }
-
-    bool Clause::subsumes(const ClausePtr &c1, const ClausePtr &c2)
-    {
-        // Quick checks first
-        if (!c1 || !c2)
-            return false;
-        if (c1->size() > c2->size())
-            return false;
-        if (c1->is_empty())
-            return true; // Empty clause subsumes everything
-        if (c2->is_empty())
-            return false; // Nothing subsumes empty clause except empty
-
-        // Try unification-based subsumption
-        return try_all_literal_mappings(c1, c2);
-    }
-
-    bool Clause::try_all_literal_mappings(const ClausePtr &c1, const ClausePtr &c2)
+    namespace
     {
-        std::vector<int> mapping(c1->size(), -1);
-        std::vector<bool> used(c2->size(), false);
 
-        return find_consistent_mapping(c1, c2, 0, mapping, used);
-    }
-
-    bool Clause::find_consistent_mapping(const ClausePtr &c1, const ClausePtr &c2,
-                                         int lit_idx, std::vector<int> &mapping,
-                                         std::vector<bool> &used)
-    {
-        // Base case: all literals in c1 have been mapped
-        if (lit_idx == static_cast<int>(c1->size()))
+        void summarize_term(const TermDBPtr &term, Clause::LiteralSignature &signature)
         {
-            return check_substitution_consistency(c1, c2, mapping);
+            switch (term->kind())
+            {
+            case TermDB::TermKind::VARIABLE:
+                break;
+            case TermDB::TermKind::CONSTANT:
+                signature.symbol_mask |= std::uint64_t(1)
+                                         << (std::hash<std::string>{}(std::static_pointer_cast<ConstantDB>(term)->symbol()) % 64);
+                ++signature.symbol_count;
+                break;
+            case TermDB::TermKind::FUNCTION_APPLICATION:
+            {
+                auto app = std::static_pointer_cast<FunctionApplicationDB>(term);
+                signature.symbol_mask |= std::uint64_t(1) << (std::hash<std::string>{}(app->symbol()) % 64);
+                ++signature.symbol_count;
+                for (const auto &arg : app->arguments())
+                {
+                    summarize_term(arg, signature);
+                }
+                break;
+            }
+            default:
+                // Not first-order: make the signature match nothing but itself
+                hash_combine(signature.head, term->hash());
+                break;
+            }
         }
 
-        const auto &lit1 = c1->literals()[lit_idx];
+        /**
+         * Bindings of the subsuming clause's variables, in binding order so
+         * that a failed partial match is undone by truncating to a mark
+         */
+        using BindingTrail = std::vector<std::pair<std::size_t, TermDBPtr>>;
+
+        /**
+         * One-way matching: extend the trail so that pattern instantiated by
+         * it equals target. On failure the trail may contain partial
+         * bindings; the caller truncates it.
+         */
+        bool match_term(const TermDBPtr &pattern, const TermDBPtr &target, BindingTrail &trail)
+        {
+            switch (pattern->kind())
+            {
+            case TermDB::TermKind::VARIABLE:
+            {
+                std::size_t index = std::static_pointer_cast<VariableDB>(pattern)->index();
+                for (const auto &binding : trail)
+                {
+                    if (binding.first == index)
+                    {
+                        return binding.second == target || *binding.second == *target;
+                    }
+                }
+                trail.emplace_back(index, target);
+                return true;
+            }
+            case TermDB::TermKind::CONSTANT:
+                return target->kind() == TermDB::TermKind::CONSTANT &&
+                       std::static_pointer_cast<ConstantDB>(pattern)->symbol() ==
+                           std::static_pointer_cast<ConstantDB>(target)->symbol();
+            case TermDB::TermKind::FUNCTION_APPLICATION:
+            {
+                if (target->kind() != TermDB::TermKind::FUNCTION_APPLICATION)
+                {
+                    return false;
+                }
+                auto app1 = std::static_pointer_cast<FunctionApplicationDB>(pattern);
+                auto app2 = std::static_pointer_cast<FunctionApplicationDB>(target);
+                if (app1->symbol() != app2->symbol() || app1->arguments().size() != app2->arguments().size())
+                {
+                    return false;
+                }
+                for (std::size_t i = 0; i < app1->arguments().size(); ++i)
+                {
+                    if (!match_term(app1->arguments()[i], app2->arguments()[i], trail))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            default:
+                return *pattern == *target;
+            }
+        }
 
-        // Try mapping lit1 to each unused literal in c2
-        for (int i = 0; i < static_cast<int>(c2->size()); ++i)
+        struct SubsumptionSearch
         {
-            if (used[i])
-                continue;
+            ArrayView<Literal> general;
+            ArrayView<Literal> specific;
+            std::vector<std::size_t> order;                  // Literals of general, most constrained first
+            std::vector<std::vector<std::size_t>> candidates; // Possible images of each literal of general
+            std::vector<bool> used;
+            BindingTrail trail;
+            bool injective = true; // Distinct literals need distinct images
+
+            bool extend(std::size_t depth)
+            {
+                if (depth == order.size())
+                {
+                    return true;
+                }
 
-            const auto &lit2 = c2->literals()[i];
+                std::size_t i = order[depth];
+                for (std::size_t j : candidates[i])
+                {
+                    if (used[j])
+                    {
+                        continue;
+                    }
 
-            // Quick check: can these literals potentially unify?
-            if (!can_unify_literals(lit1, lit2))
-                continue;
+                    std::size_t mark = trail.size();
+                    if (match_term(general[i].atom(), specific[j].atom(), trail))
+                    {
+                        used[j] = injective;
+                        if (extend(depth + 1))
+                        {
+                            return true;
+                        }
+                        used[j] = false;
+                    }
+                    trail.resize(mark);
+                }
+                return false;
+            }
+        };
 
-            // Try this mapping
-            mapping[lit_idx] = i;
-            used[i] = true;
+    } // namespace
 
-            if (find_consistent_mapping(c1, c2, lit_idx + 1, mapping, used))
+    Clause::LiteralSignature Clause::literal_signature(const Literal &literal)
+    {
+        LiteralSignature signature;
+        const auto &atom = literal.atom();
+        if (atom->kind() == TermDB::TermKind::FUNCTION_APPLICATION)
+        {
+            auto app = std::static_pointer_cast<FunctionApplicationDB>(atom);
+            signature.head = SymbolTable::intern(app->symbol(), app->arguments().size());
+            for (const auto &arg : app->arguments())
             {
-                return true;
+                summarize_term(arg, signature);
             }
+        }
+        else if (atom->kind() == TermDB::TermKind::CONSTANT)
+        {
+            signature.head = SymbolTable::intern(std::static_pointer_cast<ConstantDB>(atom)->symbol(), 0);
+        }
+        else
+        {
+            summarize_term(atom, signature);
+        }
+        signature.positive = literal.is_positive();
+        return signature;
+    }
 
-            // Backtrack
-            used[i] = false;
+    Clause::ClauseSignature Clause::clause_signature() const
+    {
+        ClauseSignature signature;
+        for (const auto &literal : signatures())
+        {
+            signature.predicates |= std::uint64_t(1) << ((literal.head * 2 + literal.positive) % 64);
+            signature.symbols |= literal.symbol_mask;
         }
+        return signature;
+    }
 
-        return false;
+    bool Clause::literal_matches(const Literal &general, const Literal &specific)
+    {
+        BindingTrail trail;
+        return general.is_positive() == specific.is_positive() &&
+               match_term(general.atom(), specific.atom(), trail);
     }
 
-    bool Clause::check_substitution_consistency(const ClausePtr &c1, const ClausePtr &c2,
-                                                const std::vector<int> &mapping)
+    bool Clause::subsumes(const Clause &other) const
     {
-        SubstitutionMap global_substitution;
+        if (literals().size() > other.literals().size())
+            return false;
+        return maps_into(other, true);
+    }
 
-        // For each mapped pair of literals, check if they unify consistently
-        for (size_t i = 0; i < mapping.size(); ++i)
+    Clause Clause::condense() const
+    {
+        // A factor F = σ(C) is always subsumed by C; when some τ also maps F
+        // into C, the two are equivalent and F replaces C. Any condensing
+        // substitution merges some pair of literals, so it factors through
+        // that pair's mgu, and trying binary factors finds it.
+        Clause current = *this;
+        bool changed = true;
+        while (changed)
         {
-            const auto &lit1 = c1->literals()[i];
-            const auto &lit2 = c2->literals()[mapping[i]];
-
-            // Literals must have same polarity to unify
-            if (lit1.is_positive() != lit2.is_positive())
+            changed = false;
+            for (const auto &factor : ResolutionInference::factors(std::make_shared<Clause>(current)))
             {
-                return false;
+                if (factor->size() < current.size() && factor->maps_into(current, false))
+                {
+                    current = *factor;
+                    changed = true;
+                    break;
+                }
             }
+        }
+        return current;
+    }
 
-            // Try to unify the atoms
-            auto unif_result = Unifier::unify(lit1.atom(), lit2.atom());
-            if (!unif_result.success)
+    bool Clause::maps_into(const Clause &other, bool injective) const
+    {
+        if (literals().empty())
+            return true; // Empty clause subsumes everything
+
+        const auto &sigs1 = signatures();
+        const auto &sigs2 = other.signatures();
+
+        // Most checks fail on signatures alone; decide those before allocating
+        for (const auto &sig : sigs1)
+        {
+            if (std::none_of(sigs2.begin(), sigs2.end(), [&](const LiteralSignature &target)
+                             { return sig.may_match(target); }))
             {
                 return false;
             }
+        }
 
-            // Check if this unification is consistent with previous ones
-            for (const auto &[var, term] : unif_result.substitution)
+        // Candidate images per literal; a literal without one decides the
+        // check before any search
+        SubsumptionSearch search{literals(), other.literals(), {}, {}, {}, {}, injective};
+        search.candidates.resize(literals().size());
+        for (std::size_t i = 0; i < literals().size(); ++i)
+        {
+            for (std::size_t j = 0; j < other.literals().size(); ++j)
             {
-                auto existing_it = global_substitution.find(var);
-                if (existing_it != global_substitution.end())
+                if (!sigs1[i].may_match(sigs2[j]))
                 {
-                    // Variable already has a binding - check consistency
-                    if (!(*existing_it->second == *term))
-                    {
-                        return false; // Inconsistent bindings
-                    }
+                    continue;
                 }
-                else
+                BindingTrail probe;
+                if (match_term(literals()[i].atom(), other.literals()[j].atom(), probe))
                 {
-                    // New binding
-                    global_substitution[var] = term;
+                    search.candidates[i].push_back(j);
                 }
             }
+            if (search.candidates[i].empty())
+            {
+                return false;
+            }
         }
 
-        // All unifications are consistent
-        return true;
+        // Most constrained literals first: fewest candidates, then most
+        // symbols (binding more variables early)
+        search.order.resize(literals().size());
+        for (std::size_t i = 0; i < literals().size(); ++i)
+        {
+            search.order[i] = i;
+        }
+        std::sort(search.order.begin(), search.order.end(), [&](std::size_t a, std::size_t b)
+                  {
+                      if (search.candidates[a].size() != search.candidates[b].size())
+                          return search.candidates[a].size() < search.candidates[b].size();
+                      return sigs1[a].symbol_count > sigs1[b].symbol_count; });
+
+        search.used.assign(other.literals().size(), false);
+        return search.extend(0);
     }
 
-    bool Clause::can_unify_literals(const Literal &lit1, const Literal &lit2)
+    bool Clause::subsumes(const ClausePtr &c1, const ClausePtr &c2)
     {
-        // Literals must have same polarity
-        if (lit1.is_positive() != lit2.is_positive())
-        {
+        if (!c1 || !c2)
             return false;
-        }
-
-        // Quick unifiability check on atoms
-        return Unifier::unifiable(lit1.atom(), lit2.atom());
+        return c1->subsumes(*c2);
     }
 
     // ParamodulationInference implementation
@@ -528,6 +1143,12 @@ namespace theorem_prover
         // Get equality sides
         auto [left_side, right_side] = get_equality_sides(eq_literal.atom());
 
+        // The atom itself is not a term; only its proper subterms can be replaced
+        if (position.is_root())
+        {
+            return ResolutionResult::make_failure("Cannot paramodulate into an atom");
+        }
+
         // Get subterm at position in target literal
         auto subterm = RewriteSystem::subterm_at(target_literal.atom(), position);
         if (!subterm)
@@ -592,6 +1213,10 @@ namespace theorem_prover
         paramodulant_literals.push_back(new_target_literal);
 
         auto paramodulant = std::make_shared<Clause>(paramodulant_literals);
+        if (paramodulant->is_tautology())
+        {
+            return ResolutionResult::make_failure("Paramodulant is a tautology");
+        }
         paramodulant = std::make_shared<Clause>(paramodulant->simplify());
 
         return ResolutionResult::make_success(paramodulant);
@@ -610,7 +1235,13 @@ namespace theorem_prover
             std::function<void(const TermDBPtr &, const Position &)> find_positions =
                 [&](const TermDBPtr &term, const Position &pos)
             {
-                positions.emplace_back(i, pos, term);
+                // Skip the atom itself, which is not a term, and variables:
+                // an equation applies to an instance of a variable wherever
+                // that instance itself occurs
+                if (!pos.is_root() && term->kind() != TermDB::TermKind::VARIABLE)
+                {
+                    positions.emplace_back(i, pos, term);
+                }
 
                 // Recursively find positions in subterms
                 switch (term->kind())
@@ -642,11 +1273,10 @@ namespace theorem_prover
                                                                   const TermDBPtr &to_term,
                                                                   const SubstitutionMap &substitution)
     {
-        // Apply substitution to the replacement term
-        auto replacement = SubstitutionEngine::substitute(to_term, substitution);
-
-        // Use the rewrite system's replace_at function
-        return RewriteSystem::replace_at(term, position, replacement);
+        // Replace the subterm, then instantiate the whole atom: the unifier
+        // binds variables outside the replaced position too
+        auto replaced = RewriteSystem::replace_at(term, position, to_term);
+        return replaced ? SubstitutionEngine::substitute(replaced, substitution) : nullptr;
     }
 
     std::vector<ClausePtr> ResolutionWithParamodulation::resolve_with_paramodulation(
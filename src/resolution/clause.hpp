@@ -4,6 +4,9 @@
 #include "../term/unification.hpp"
 #include "../term/substitution.hpp"
 #include "../term/rewriting.hpp"
+#include "../term/symbol_table.hpp"
+#include "clause_pool.hpp"
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <string>
@@ -16,6 +19,10 @@ namespace theorem_prover
 
     using ClausePtr = std::shared_ptr<Clause>;
 
+    // Compact handle of a clause stored in a ClauseSet
+    using ClauseId = std::uint32_t;
+    constexpr ClauseId no_clause_id = static_cast<ClauseId>(-1);
+
     /**
      * Represents a literal in a clause (positive or negative)
      */
@@ -47,19 +54,66 @@ namespace theorem_prover
 
     using LiteralPtr = std::shared_ptr<Literal>;
 
+    /**
+     * Read-only view of an array stored inside a clause; valid while the
+     * clause lives. Converts to a std::vector for callers that need a copy.
+     */
+    template <typename T>
+    class ArrayView
+    {
+    public:
+        ArrayView(const T *data = nullptr, std::size_t size = 0) : data_(data), size_(size) {}
+
+        const T *begin() const { return data_; }
+        const T *end() const { return data_ + size_; }
+        std::size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        const T &operator[](std::size_t i) const { return data_[i]; }
+        const T &front() const { return data_[0]; }
+        const T &back() const { return data_[size_ - 1]; }
+
+        operator std::vector<T>() const { return std::vector<T>(begin(), end()); }
+
+    private:
+        const T *data_;
+        std::size_t size_;
+    };
+
     /**
      * Represents a clause (disjunction of literals)
+     *
+     * A clause is one heap block: a header with its size and features,
+     * followed by the literals and their signatures. Copies duplicate the
+     * block, moves hand it over.
      */
     class Clause
     {
     public:
         Clause(const std::vector<Literal> &literals = {});
+        Clause(std::vector<Literal> &&literals);
         Clause(const std::vector<LiteralPtr> &literals);
 
-        const std::vector<Literal> &literals() const { return literals_; }
-        std::size_t size() const { return literals_.size(); }
-        bool is_empty() const { return literals_.empty(); }
-        bool is_unit() const { return literals_.size() == 1; }
+        Clause(const Clause &other);
+        Clause(Clause &&other) noexcept = default;
+        Clause &operator=(Clause other) noexcept;
+        ~Clause() = default;
+
+        ArrayView<Literal> literals() const
+        {
+            return storage_ ? ArrayView<Literal>(storage_->literals(), storage_->size) : ArrayView<Literal>();
+        }
+        std::size_t size() const { return storage_ ? storage_->size : 0; }
+        bool is_empty() const { return !storage_; }
+        bool is_unit() const { return size() == 1; }
+
+        // Id in the clause set storing the clause; no_clause_id otherwise
+        ClauseId id() const { return storage_ ? storage_->id : no_clause_id; }
+
+        // Number of symbol and variable occurrences in all literals
+        std::size_t weight() const { return features() ? storage_->weight : 0; }
+
+        // One more than the largest variable index (0 for ground clauses)
+        std::size_t variable_bound() const { return features() ? storage_->variable_bound : 0; }
 
         // Check if clause is a tautology (contains complementary literals)
         bool is_tautology() const;
@@ -77,27 +131,175 @@ namespace theorem_prover
         bool equals(const Clause &other) const;
         std::size_t hash() const;
 
+        // Variants: clauses equal up to literal order and variable renaming
+
+        /**
+         * Hash that is the same for all variants of the clause
+         */
+        std::size_t variant_hash() const;
+
+        /**
+         * Check whether the clauses are variants of each other
+         * (a bijective variable renaming maps one onto the other)
+         */
+        bool is_variant(const Clause &other) const;
+
+        /**
+         * Normal form: literals sorted by their variant key, variables
+         * renumbered 0, 1, ... in order of first occurrence. Variants whose
+         * literals are distinguishable by key get identical normal forms;
+         * use is_variant to decide the general case.
+         */
+        Clause canonical() const;
+
+        /**
+         * Condensation: the smallest factor of the clause that still
+         * subsumes it (a proper subset of its instances up to renaming),
+         * e.g. P(X) ∨ P(a) ∨ Q(a) condenses to P(a) ∨ Q(a). The result is
+         * logically equivalent to the clause.
+         */
+        Clause condense() const;
+
         std::string to_string() const;
 
-        // Subsumption checking
+        /**
+         * Subsumption: some substitution σ maps the literals of this clause
+         * injectively onto literals of the other (one-way matching; the other
+         * clause's variables are treated as constants)
+         */
         bool subsumes(const Clause &other) const;
         static bool subsumes(const ClausePtr &c1, const ClausePtr &c2);
 
+        /**
+         * Cheap per-literal summary used to rule out matches before trying them
+         */
+        struct LiteralSignature
+        {
+            std::size_t head = 0;          // Interned predicate symbol and arity
+            bool positive = true;          // Polarity
+            std::uint64_t symbol_mask = 0; // One bit per function/constant symbol (hashed)
+            std::size_t symbol_count = 0;  // Number of non-variable symbol occurrences
+
+            /**
+             * Necessary condition for a literal with this signature to match
+             * onto a literal with the target signature
+             */
+            bool may_match(const LiteralSignature &target) const
+            {
+                return head == target.head && positive == target.positive &&
+                       (symbol_mask & ~target.symbol_mask) == 0 &&
+                       symbol_count <= target.symbol_count;
+            }
+
+            // Signature of the complementary literal
+            LiteralSignature complement() const
+            {
+                LiteralSignature flipped = *this;
+                flipped.positive = !positive;
+                return flipped;
+            }
+        };
+
+        ArrayView<LiteralSignature> signatures() const
+        {
+            return features() ? ArrayView<LiteralSignature>(storage_->signatures(), storage_->size)
+                              : ArrayView<LiteralSignature>();
+        }
+        static LiteralSignature literal_signature(const Literal &literal);
+
+        /**
+         * Bloom-style summary of a whole clause: the union of one bit per
+         * (predicate, polarity) and the symbol masks of all literals. If C
+         * subsumes D, every literal of C maps onto one of D with the same
+         * predicate and polarity and no other symbols, so the bits of C are
+         * a subset of those of D.
+         */
+        struct ClauseSignature
+        {
+            std::uint64_t predicates = 0;
+            std::uint64_t symbols = 0;
+
+            bool may_subsume(const ClauseSignature &other) const
+            {
+                return ((predicates & ~other.predicates) | (symbols & ~other.symbols)) == 0;
+            }
+
+            // Necessary for this clause to shorten the other by subsumption
+            // resolution: as above, except that the bit of the resolved
+            // literal may be missing
+            bool may_shorten(const ClauseSignature &other) const
+            {
+                std::uint64_t missing = predicates & ~other.predicates;
+                return (symbols & ~other.symbols) == 0 && (missing & (missing - 1)) == 0;
+            }
+        };
+
+        ClauseSignature clause_signature() const;
+
+        /**
+         * One-way matching of single literals: same polarity and some σ with
+         * σ(general) = specific
+         */
+        static bool literal_matches(const Literal &general, const Literal &specific);
+
     private:
-        std::vector<Literal> literals_;
-        mutable std::size_t hash_cache_;
-        mutable bool hash_computed_;
+        // Header of the clause block; the literal and signature arrays follow it
+        struct Storage
+        {
+            std::size_t size = 0;
+            mutable std::size_t weight = 0;
+            mutable std::size_t variable_bound = 0;
+            mutable std::size_t hash = 0;
+            mutable std::size_t variant_hash = 0;
+            ClausePool *pool = nullptr; // Pool the block came from, if any
+            ClauseId id = no_clause_id;
+            mutable bool hash_computed = false;
+            mutable bool variant_hash_computed = false;
+            mutable bool features_computed = false; // Weight, variable bound and signatures
+
+            Literal *literals() const
+            {
+                return reinterpret_cast<Literal *>(const_cast<Storage *>(this) + 1);
+            }
+            LiteralSignature *signatures() const
+            {
+                return reinterpret_cast<LiteralSignature *>(literals() + size);
+            }
+        };
+
+        struct StorageDeleter
+        {
+            void operator()(Storage *storage) const;
+        };
+
+        std::unique_ptr<Storage, StorageDeleter> storage_; // Null for the empty clause
+
+        // Uninitialized block for size literals, from the current pool if
+        // one is installed
+        static Storage *allocate(std::size_t size);
+        static std::size_t block_bytes(std::size_t size);
+
+        friend class ClauseSet; // Assigns ids
+
+        // Take over the literals
+        void build(std::vector<Literal> &&literals);
+
+        // Compute the features on first use; false for the empty clause
+        bool features() const
+        {
+            if (storage_ && !storage_->features_computed)
+            {
+                compute_features();
+            }
+            return storage_ != nullptr;
+        }
+        void compute_features() const;
 
         void compute_hash() const;
 
-        // Subsumption helpers
-        static bool try_all_literal_mappings(const ClausePtr &c1, const ClausePtr &c2);
-        static bool find_consistent_mapping(const ClausePtr &c1, const ClausePtr &c2,
-                                            int lit_idx, std::vector<int> &mapping,
-                                            std::vector<bool> &used);
-        static bool check_substitution_consistency(const ClausePtr &c1, const ClausePtr &c2,
-                                                   const std::vector<int> &mapping);
-        static bool can_unify_literals(const Literal &lit1, const Literal &lit2);
+        // Some σ maps every literal of this clause onto a literal of the
+        // other; with injective set, distinct literals onto distinct ones
+        bool maps_into(const Clause &other, bool injective) const;
     };
 
     /**
@@ -158,10 +360,34 @@ namespace theorem_prover
          * Apply factoring to a clause (remove duplicate literals after unification)
          *
          * @param clause The clause to factor
-         * @return Factored clause
+         * @return The first of its factors, or the clause itself if it has none
          */
         static ClausePtr factor(const ClausePtr &clause);
 
+        /**
+         * All binary factors of a clause: for each pair of literals of the
+         * same polarity whose atoms unify with mgu σ, the clause σ(C) with
+         * duplicate literals merged. Tautological factors and variants of
+         * earlier factors are left out.
+         *
+         * @param clause The clause to factor
+         * @return The factors (empty if no two literals unify)
+         */
+        static std::vector<ClausePtr> factors(const ClausePtr &clause);
+
+        /**
+         * Subsumption resolution (contextual literal cutting): if the clause
+         * is C ∨ L and the simplifier is D ∨ M with σ(D) ⊆ C and σ(M) = ¬L,
+         * the clause can be replaced by C. With a unit simplifier this is
+         * unit deletion.
+         *
+         * @param clause The clause to shorten
+         * @param simplifier The clause used to cut a literal
+         * @return The clause without the cut literal, or nullptr if the
+         *         simplifier does not apply
+         */
+        static ClausePtr subsumption_resolution(const ClausePtr &clause, const ClausePtr &simplifier);
+
     private:
         /**
          * Find the next available variable index for renaming
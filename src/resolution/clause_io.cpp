@@ -0,0 +1,131 @@
+#include "clause_io.hpp"
+
+namespace theorem_prover
+{
+    namespace clause_io
+    {
+        void write_clause(BinaryWriter &out, TermWriter &terms, const Clause &clause)
+        {
+            out.write_varint(clause.size());
+            for (const auto &literal : clause.literals())
+            {
+                out.write_bool(literal.is_positive());
+                terms.write(literal.atom());
+            }
+        }
+
+        ClausePtr read_clause(BinaryReader &in, TermReader &terms)
+        {
+            std::size_t size = in.read_count();
+            std::vector<Literal> literals;
+            literals.reserve(size);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                bool positive = in.read_bool();
+                literals.emplace_back(terms.read(), positive);
+            }
+            return std::make_shared<Clause>(std::move(literals));
+        }
+
+        void write_clauses(BinaryWriter &out, TermWriter &terms, const std::vector<ClausePtr> &clauses)
+        {
+            out.write_varint(clauses.size());
+            for (const auto &clause : clauses)
+            {
+                write_clause(out, terms, *clause);
+            }
+        }
+
+        std::vector<ClausePtr> read_clauses(BinaryReader &in, TermReader &terms)
+        {
+            std::vector<ClausePtr> clauses(in.read_count());
+            for (auto &clause : clauses)
+            {
+                clause = read_clause(in, terms);
+            }
+            return clauses;
+        }
+
+        void write_config(BinaryWriter &out, const ResolutionConfig &config)
+        {
+            out.write_varint(config.max_iterations);
+            out.write_double(config.max_time_ms);
+            out.write_varint(config.max_clauses);
+            for (bool flag : {config.use_subsumption, config.use_unit_deletion, config.use_subsumption_resolution,
+                              config.use_tautology_deletion, config.use_factoring, config.use_condensation,
+                              config.use_paramodulation, config.use_set_of_support, config.use_datalog,
+                              config.use_unit_equality, config.use_model_finder, config.use_auto_strategy,
+                              config.use_kb_preprocessing})
+            {
+                out.write_bool(flag);
+            }
+            out.write_varint(config.model_finder_max_domain);
+            out.write_double(config.model_finder_timeout);
+            out.write_varint(config.auto_strategy_threads);
+            out.write_double(config.kb_preprocessing_timeout);
+            out.write_varint(config.kb_max_rules);
+            out.write_varint(config.kb_max_equations);
+
+            const KBConfig &kb = config.kb_config;
+            out.write_varint(kb.max_iterations);
+            out.write_varint(kb.max_rules);
+            out.write_varint(kb.max_equations);
+            out.write_double(kb.max_time_seconds);
+            out.write_bool(kb.enable_simplification);
+            out.write_bool(kb.enable_subsumption);
+            out.write_bool(kb.fair_processing);
+            out.write_bool(kb.verbose);
+
+            out.write_varint(static_cast<std::uint64_t>(config.clause_retention));
+            out.write_varint(static_cast<std::uint64_t>(config.selection_strategy));
+            out.write_varint(static_cast<std::uint64_t>(config.inference_rule));
+        }
+
+        ResolutionConfig read_config(BinaryReader &in)
+        {
+            ResolutionConfig config;
+            config.max_iterations = in.read_varint();
+            config.max_time_ms = in.read_double();
+            config.max_clauses = in.read_varint();
+            for (bool *flag : {&config.use_subsumption, &config.use_unit_deletion, &config.use_subsumption_resolution,
+                               &config.use_tautology_deletion, &config.use_factoring, &config.use_condensation,
+                               &config.use_paramodulation, &config.use_set_of_support, &config.use_datalog,
+                               &config.use_unit_equality, &config.use_model_finder, &config.use_auto_strategy,
+                               &config.use_kb_preprocessing})
+            {
+                *flag = in.read_bool();
+            }
+            config.model_finder_max_domain = in.read_varint();
+            config.model_finder_timeout = in.read_double();
+            config.auto_strategy_threads = in.read_varint();
+            config.kb_preprocessing_timeout = in.read_double();
+            config.kb_max_rules = in.read_varint();
+            config.kb_max_equations = in.read_varint();
+
+            KBConfig &kb = config.kb_config;
+            kb.max_iterations = in.read_varint();
+            kb.max_rules = in.read_varint();
+            kb.max_equations = in.read_varint();
+            kb.max_time_seconds = in.read_double();
+            kb.enable_simplification = in.read_bool();
+            kb.enable_subsumption = in.read_bool();
+            kb.fair_processing = in.read_bool();
+            kb.verbose = in.read_bool();
+
+            std::uint64_t retention = in.read_varint();
+            std::uint64_t selection = in.read_varint();
+            std::uint64_t rule = in.read_varint();
+            if (retention > static_cast<std::uint64_t>(ResolutionConfig::ClauseRetention::FULL) ||
+                selection > static_cast<std::uint64_t>(ResolutionConfig::SelectionStrategy::NEGATIVE_SELECTION) ||
+                rule > static_cast<std::uint64_t>(ResolutionConfig::InferenceRule::UR_RESOLUTION))
+            {
+                throw SerializationError("Invalid resolution configuration");
+            }
+            config.clause_retention = static_cast<ResolutionConfig::ClauseRetention>(retention);
+            config.selection_strategy = static_cast<ResolutionConfig::SelectionStrategy>(selection);
+            config.inference_rule = static_cast<ResolutionConfig::InferenceRule>(rule);
+            return config;
+        }
+    }
+
+} // namespace theorem_prover
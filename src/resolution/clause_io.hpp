@@ -0,0 +1,32 @@
+#pragma once
+
+#include "resolution_prover.hpp"
+#include "../term/term_io.hpp"
+
+namespace theorem_prover
+{
+
+    /**
+     * Binary encoding of clauses and prover configurations, shared by
+     * search traces and checkpoints
+     */
+    namespace clause_io
+    {
+        /**
+         * A clause as its literal count, then each literal's polarity and atom
+         */
+        void write_clause(BinaryWriter &out, TermWriter &terms, const Clause &clause);
+        ClausePtr read_clause(BinaryReader &in, TermReader &terms);
+
+        void write_clauses(BinaryWriter &out, TermWriter &terms, const std::vector<ClausePtr> &clauses);
+        std::vector<ClausePtr> read_clauses(BinaryReader &in, TermReader &terms);
+
+        /**
+         * Every setting that shapes the search; the stop flag, the trace
+         * and checkpoint files and the completion cache settings are left out
+         */
+        void write_config(BinaryWriter &out, const ResolutionConfig &config);
+        ResolutionConfig read_config(BinaryReader &in);
+    }
+
+} // namespace theorem_prover
@@ -0,0 +1,81 @@
+#include "clause_pool.hpp"
+
+namespace theorem_prover
+{
+
+    namespace
+    {
+        thread_local ClausePool *current_pool = nullptr;
+    }
+
+    ClausePool::Handle ClausePool::create()
+    {
+        return Handle(new ClausePool());
+    }
+
+    ClausePool::Scope::Scope(ClausePool *pool) : previous_(current_pool)
+    {
+        current_pool = pool;
+    }
+
+    ClausePool::Scope::~Scope()
+    {
+        current_pool = previous_;
+    }
+
+    ClausePool *ClausePool::current()
+    {
+        return current_pool;
+    }
+
+    void *ClausePool::allocate(std::size_t literal_count, std::size_t bytes)
+    {
+        references_.fetch_add(1, std::memory_order_relaxed);
+
+        FreeBlock *&free_list = free_lists_[literal_count];
+        if (free_list)
+        {
+            FreeBlock *block = free_list;
+            free_list = block->next;
+            return block;
+        }
+
+        // Keep every block aligned like the slab itself
+        bytes = (bytes + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+        if (static_cast<std::size_t>(slab_end_ - slab_cursor_) < bytes)
+        {
+            // The unused tail of the old slab is abandoned
+            slabs_.emplace_back(new std::max_align_t[slab_bytes / sizeof(std::max_align_t)]);
+            slab_cursor_ = reinterpret_cast<char *>(slabs_.back().get());
+            slab_end_ = slab_cursor_ + slab_bytes;
+        }
+        void *block = slab_cursor_;
+        slab_cursor_ += bytes;
+        return block;
+    }
+
+    void ClausePool::deallocate(void *block, std::size_t literal_count)
+    {
+        // Only the thread the pool is installed on touches the free lists;
+        // elsewhere the block stays unused in its slab until the pool goes
+        if (current_pool != this)
+        {
+            release();
+            return;
+        }
+
+        FreeBlock *free_block = static_cast<FreeBlock *>(block);
+        free_block->next = free_lists_[literal_count];
+        free_lists_[literal_count] = free_block;
+        release();
+    }
+
+    void ClausePool::release()
+    {
+        if (references_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            delete this;
+        }
+    }
+
+} // namespace theorem_prover
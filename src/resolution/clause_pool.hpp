@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace theorem_prover
+{
+
+    /**
+     * Slab allocator for clause blocks
+     *
+     * Blocks are grouped into size classes by literal count. Each class keeps
+     * a free list of returned blocks and new blocks are carved from 64 KiB
+     * slabs, so the short-lived resolvents of a search reuse memory instead
+     * of going through the general allocator one at a time. Clauses longer
+     * than max_pooled_literals bypass the pool.
+     *
+     * A pool is installed on one thread at a time: clauses are allocated from
+     * the pool installed with a Scope. The pool stays alive while its owner or
+     * any block it handed out does, so clauses may outlive the owner and be
+     * freed on any thread. Blocks freed where the pool is not installed are
+     * not reused, only reclaimed with the pool's slabs.
+     */
+    class ClausePool
+    {
+    public:
+        static constexpr std::size_t max_pooled_literals = 16;
+
+        // Releases the owner's reference
+        struct Release
+        {
+            void operator()(ClausePool *pool) const { pool->release(); }
+        };
+        using Handle = std::unique_ptr<ClausePool, Release>;
+
+        static Handle create();
+
+        /**
+         * Makes a pool the current one of this thread for the lifetime of the
+         * scope; scopes nest
+         */
+        class Scope
+        {
+        public:
+            explicit Scope(ClausePool *pool);
+            ~Scope();
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+
+        private:
+            ClausePool *previous_;
+        };
+
+        // The pool installed on this thread, or nullptr
+        static ClausePool *current();
+
+        // Block of the given size for a clause of literal_count literals
+        void *allocate(std::size_t literal_count, std::size_t bytes);
+
+        /**
+         * Return a block obtained from allocate with the same literal count;
+         * it is reused only if this pool is installed on the calling thread
+         */
+        void deallocate(void *block, std::size_t literal_count);
+
+        std::size_t live_blocks() const { return references_.load(std::memory_order_relaxed) - 1; }
+
+        ClausePool(const ClausePool &) = delete;
+        ClausePool &operator=(const ClausePool &) = delete;
+
+    private:
+        static constexpr std::size_t slab_bytes = 64 * 1024;
+
+        struct FreeBlock
+        {
+            FreeBlock *next;
+        };
+
+        std::atomic<std::size_t> references_{1}; // Owner plus live blocks
+        FreeBlock *free_lists_[max_pooled_literals + 1] = {};
+        std::vector<std::unique_ptr<std::max_align_t[]>> slabs_;
+        char *slab_cursor_ = nullptr;
+        char *slab_end_ = nullptr;
+
+        ClausePool() = default;
+        ~ClausePool() = default;
+
+        void release();
+    };
+
+} // namespace theorem_prover
@@ -1,5 +1,4 @@
 #include "cnf_converter.hpp"
-#include "../utils/gensym.hpp"
 #include <algorithm>
 #include <sstream>
 #include <stack>
@@ -9,11 +8,26 @@ namespace theorem_prover
 
     std::vector<ClausePtr> CNFConverter::to_cnf(const TermDBPtr &formula)
     {
-        return to_cnf_with_renaming(formula, 0);
+        std::size_t skolem_counter = 0;
+        return to_cnf_with_renaming(formula, 0, skolem_counter);
+    }
+
+    std::vector<ClausePtr> CNFConverter::to_cnf(const TermDBPtr &formula,
+                                                std::size_t &skolem_counter)
+    {
+        return to_cnf_with_renaming(formula, 0, skolem_counter);
     }
 
     std::vector<ClausePtr> CNFConverter::to_cnf_with_renaming(const TermDBPtr &formula,
                                                               std::size_t variable_offset)
+    {
+        std::size_t skolem_counter = 0;
+        return to_cnf_with_renaming(formula, variable_offset, skolem_counter);
+    }
+
+    std::vector<ClausePtr> CNFConverter::to_cnf_with_renaming(const TermDBPtr &formula,
+                                                              std::size_t variable_offset,
+                                                              std::size_t &skolem_counter)
     {
         // Step 1: Eliminate implications
         auto step1 = eliminate_implications(formula);
@@ -21,17 +35,15 @@ namespace theorem_prover
         // Step 2: Move negations inward
         auto step2 = move_negations_inward(step1);
 
-        // Step 3: Standardize variables
-        std::size_t var_counter = variable_offset;
-        auto step3 = standardize_variables(step2, var_counter);
-
-        // Step 4: Convert to prenex form
-        auto step4 = to_prenex_form(step3);
-
-        // Step 5: Skolemize
-        std::size_t skolem_counter = 0;
-        std::vector<std::size_t> universal_vars;
-        auto step5 = skolemize(step4, universal_vars, skolem_counter);
+        // Steps 3-5: Standardize variables apart and Skolemize in one pass.
+        // Universally quantified variables become fresh clause variables and
+        // existentially quantified ones become Skolem terms over the enclosing
+        // universals. Free variables of the input keep their indices, so fresh
+        // variables start above them.
+        std::size_t var_counter = std::max(variable_offset, free_variable_bound(step2, 0));
+        std::vector<TermDBPtr> bindings;
+        std::vector<TermDBPtr> universals;
+        auto step5 = eliminate_quantifiers(step2, bindings, universals, var_counter, skolem_counter);
 
         // Step 6: Distribute OR over AND
         auto step6 = distribute_or_over_and(step5);
@@ -503,6 +515,168 @@ namespace theorem_prover
         return literals;
     }
 
+    TermDBPtr CNFConverter::eliminate_quantifiers(const TermDBPtr &formula,
+                                                  std::vector<TermDBPtr> &bindings,
+                                                  std::vector<TermDBPtr> &universals,
+                                                  std::size_t &variable_counter,
+                                                  std::size_t &skolem_counter)
+    {
+        switch (formula->kind())
+        {
+        case TermDB::TermKind::FORALL:
+        {
+            auto forall = std::dynamic_pointer_cast<ForallDB>(formula);
+            auto fresh = make_variable(variable_counter++);
+
+            bindings.push_back(fresh);
+            universals.push_back(fresh);
+            auto body = eliminate_quantifiers(forall->body(), bindings, universals, variable_counter, skolem_counter);
+            universals.pop_back();
+            bindings.pop_back();
+            return body;
+        }
+
+        case TermDB::TermKind::EXISTS:
+        {
+            auto exists = std::dynamic_pointer_cast<ExistsDB>(formula);
+
+            // Numbered per problem, not per process, so that a problem's
+            // clauses (and orderings that compare symbol names) do not
+            // depend on what was converted before it
+            std::string name = generate_skolem_name(skolem_counter++);
+            auto skolem_term = universals.empty() ? make_constant(name)
+                                                  : make_function_application(name, universals);
+
+            bindings.push_back(skolem_term);
+            auto body = eliminate_quantifiers(exists->body(), bindings, universals, variable_counter, skolem_counter);
+            bindings.pop_back();
+            return body;
+        }
+
+        case TermDB::TermKind::AND:
+        {
+            auto and_term = std::dynamic_pointer_cast<AndDB>(formula);
+            auto left = eliminate_quantifiers(and_term->left(), bindings, universals, variable_counter, skolem_counter);
+            auto right = eliminate_quantifiers(and_term->right(), bindings, universals, variable_counter, skolem_counter);
+            return make_and(left, right);
+        }
+
+        case TermDB::TermKind::OR:
+        {
+            auto or_term = std::dynamic_pointer_cast<OrDB>(formula);
+            auto left = eliminate_quantifiers(or_term->left(), bindings, universals, variable_counter, skolem_counter);
+            auto right = eliminate_quantifiers(or_term->right(), bindings, universals, variable_counter, skolem_counter);
+            return make_or(left, right);
+        }
+
+        case TermDB::TermKind::NOT:
+        {
+            auto not_term = std::dynamic_pointer_cast<NotDB>(formula);
+            return make_not(eliminate_quantifiers(not_term->body(), bindings, universals, variable_counter, skolem_counter));
+        }
+
+        case TermDB::TermKind::IMPLIES:
+        {
+            auto implies = std::dynamic_pointer_cast<ImpliesDB>(formula);
+            auto antecedent = eliminate_quantifiers(implies->antecedent(), bindings, universals, variable_counter, skolem_counter);
+            auto consequent = eliminate_quantifiers(implies->consequent(), bindings, universals, variable_counter, skolem_counter);
+            return make_implies(antecedent, consequent);
+        }
+
+        default:
+            return instantiate_bindings(formula, bindings);
+        }
+    }
+
+    TermDBPtr CNFConverter::instantiate_bindings(const TermDBPtr &term,
+                                                 const std::vector<TermDBPtr> &bindings)
+    {
+        switch (term->kind())
+        {
+        case TermDB::TermKind::VARIABLE:
+        {
+            auto var = std::dynamic_pointer_cast<VariableDB>(term);
+            std::size_t index = var->index();
+            if (index < bindings.size())
+            {
+                // De Bruijn index 0 refers to the innermost quantifier
+                return bindings[bindings.size() - 1 - index];
+            }
+            return bindings.empty() ? term : make_variable(index - bindings.size());
+        }
+
+        case TermDB::TermKind::FUNCTION_APPLICATION:
+        {
+            auto app = std::dynamic_pointer_cast<FunctionApplicationDB>(term);
+            std::vector<TermDBPtr> args;
+            args.reserve(app->arguments().size());
+            for (const auto &arg : app->arguments())
+            {
+                args.push_back(instantiate_bindings(arg, bindings));
+            }
+            return make_function_application(app->symbol(), args);
+        }
+
+        default:
+            return term;
+        }
+    }
+
+    std::size_t CNFConverter::free_variable_bound(const TermDBPtr &formula, std::size_t depth)
+    {
+        switch (formula->kind())
+        {
+        case TermDB::TermKind::VARIABLE:
+        {
+            auto index = std::dynamic_pointer_cast<VariableDB>(formula)->index();
+            return index >= depth ? index - depth + 1 : 0;
+        }
+
+        case TermDB::TermKind::FUNCTION_APPLICATION:
+        {
+            std::size_t result = 0;
+            for (const auto &arg : std::dynamic_pointer_cast<FunctionApplicationDB>(formula)->arguments())
+            {
+                result = std::max(result, free_variable_bound(arg, depth));
+            }
+            return result;
+        }
+
+        case TermDB::TermKind::FORALL:
+            return free_variable_bound(std::dynamic_pointer_cast<ForallDB>(formula)->body(), depth + 1);
+
+        case TermDB::TermKind::EXISTS:
+            return free_variable_bound(std::dynamic_pointer_cast<ExistsDB>(formula)->body(), depth + 1);
+
+        case TermDB::TermKind::AND:
+        {
+            auto and_term = std::dynamic_pointer_cast<AndDB>(formula);
+            return std::max(free_variable_bound(and_term->left(), depth),
+                            free_variable_bound(and_term->right(), depth));
+        }
+
+        case TermDB::TermKind::OR:
+        {
+            auto or_term = std::dynamic_pointer_cast<OrDB>(formula);
+            return std::max(free_variable_bound(or_term->left(), depth),
+                            free_variable_bound(or_term->right(), depth));
+        }
+
+        case TermDB::TermKind::NOT:
+            return free_variable_bound(std::dynamic_pointer_cast<NotDB>(formula)->body(), depth);
+
+        case TermDB::TermKind::IMPLIES:
+        {
+            auto implies = std::dynamic_pointer_cast<ImpliesDB>(formula);
+            return std::max(free_variable_bound(implies->antecedent(), depth),
+                            free_variable_bound(implies->consequent(), depth));
+        }
+
+        default:
+            return 0;
+        }
+    }
+
     std::string CNFConverter::generate_skolem_name(std::size_t counter)
     {
         return "sk" + std::to_string(counter);
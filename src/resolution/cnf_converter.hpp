@@ -25,15 +25,29 @@ namespace theorem_prover
     public:
         /**
          * Convert a formula to CNF and return set of clauses
+         * (Skolem symbols are numbered from sk0)
          */
         static std::vector<ClausePtr> to_cnf(const TermDBPtr &formula);
 
+        /**
+         * Convert a formula to CNF, numbering its Skolem symbols from
+         * skolem_counter on and advancing the counter past them. Formulas of
+         * one problem share a counter so that their Skolem symbols are
+         * distinct, and the same problem always gets the same names.
+         */
+        static std::vector<ClausePtr> to_cnf(const TermDBPtr &formula,
+                                             std::size_t &skolem_counter);
+
         /**
          * Convert a formula to CNF with variable renaming
          */
         static std::vector<ClausePtr> to_cnf_with_renaming(const TermDBPtr &formula,
                                                            std::size_t variable_offset = 0);
 
+        static std::vector<ClausePtr> to_cnf_with_renaming(const TermDBPtr &formula,
+                                                           std::size_t variable_offset,
+                                                           std::size_t &skolem_counter);
+
         // Make these public for testing
         /**
          * Step 1: Eliminate implications and biconditionals
@@ -84,6 +98,28 @@ namespace theorem_prover
          */
         static bool is_cnf(const TermDBPtr &formula);
 
+        /**
+         * Helper: Replace universally quantified variables by fresh clause
+         * variables and existentially quantified ones by Skolem terms
+         * (expects negation normal form)
+         */
+        static TermDBPtr eliminate_quantifiers(const TermDBPtr &formula,
+                                               std::vector<TermDBPtr> &bindings,
+                                               std::vector<TermDBPtr> &universals,
+                                               std::size_t &variable_counter,
+                                               std::size_t &skolem_counter);
+
+        /**
+         * Helper: Replace bound variables of a quantifier-free term by their bindings
+         */
+        static TermDBPtr instantiate_bindings(const TermDBPtr &term,
+                                              const std::vector<TermDBPtr> &bindings);
+
+        /**
+         * Helper: One past the largest free variable index in a formula (0 if closed)
+         */
+        static std::size_t free_variable_bound(const TermDBPtr &formula, std::size_t depth);
+
         /**
          * Helper: Generate Skolem function name
          */
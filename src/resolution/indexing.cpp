@@ -5,6 +5,8 @@
 namespace theorem_prover
 {
 
+    const std::vector<LiteralIndex::Entry> LiteralIndex::empty_bucket_;
+
     LiteralIndex::LiteralIndex() {}
 
     void LiteralIndex::insert_clause(ClausePtr clause)
@@ -13,13 +15,10 @@ namespace theorem_prover
             return;
 
         // Add this clause to the index for each of its literals
-        for (const auto &literal : clause->literals())
+        const auto &signatures = clause->signatures();
+        for (std::size_t i = 0; i < signatures.size(); ++i)
         {
-            bool polarity = literal.is_positive();
-            std::string pred_symbol = get_predicate_symbol(literal.atom());
-            size_t arity = get_arity(literal.atom());
-
-            index_[polarity][pred_symbol][arity].push_back(clause);
+            index_[signatures[i].positive][signatures[i].head].push_back({clause, i});
         }
     }
 
@@ -29,72 +28,74 @@ namespace theorem_prover
             return;
 
         // Remove this clause from the index for each of its literals
-        for (const auto &literal : clause->literals())
+        for (const auto &signature : clause->signatures())
         {
-            bool polarity = literal.is_positive();
-            std::string pred_symbol = get_predicate_symbol(literal.atom());
-            size_t arity = get_arity(literal.atom());
-
-            auto polarity_it = index_.find(polarity);
-            if (polarity_it != index_.end())
+            auto &buckets = index_[signature.positive];
+            auto bucket = buckets.find(signature.head);
+            if (bucket != buckets.end())
             {
-                auto pred_it = polarity_it->second.find(pred_symbol);
-                if (pred_it != polarity_it->second.end())
-                {
-                    auto arity_it = pred_it->second.find(arity);
-                    if (arity_it != pred_it->second.end())
-                    {
-                        remove_clause_from_bucket(arity_it->second, clause);
-                    }
-                }
+                auto &entries = bucket->second;
+                entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                             [&clause](const Entry &entry)
+                                             { return entry.clause == clause; }),
+                              entries.end());
             }
         }
     }
 
-    std::vector<ClausePtr> LiteralIndex::get_resolution_candidates(const Literal &literal)
+    void LiteralIndex::remove_clauses_if(const std::function<bool(const ClausePtr &)> &removed)
     {
-        // Look for literals with OPPOSITE polarity, SAME predicate, SAME arity
-        bool opposite_polarity = !literal.is_positive();
-        std::string pred_symbol = get_predicate_symbol(literal.atom());
-        size_t arity = get_arity(literal.atom());
-
-        auto polarity_it = index_.find(opposite_polarity);
-        if (polarity_it == index_.end())
+        for (auto &buckets : index_)
         {
-            return {};
+            for (auto &[head, entries] : buckets)
+            {
+                entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                             [&removed](const Entry &entry)
+                                             { return removed(entry.clause); }),
+                              entries.end());
+            }
         }
+    }
 
-        auto pred_it = polarity_it->second.find(pred_symbol);
-        if (pred_it == polarity_it->second.end())
-        {
-            return {};
-        }
+    LiteralIndex::CandidateRange LiteralIndex::resolution_candidates(const Literal &literal) const
+    {
+        return resolution_candidates(Clause::literal_signature(literal));
+    }
+
+    LiteralIndex::CandidateRange LiteralIndex::resolution_candidates(const Clause::LiteralSignature &signature) const
+    {
+        // Look for literals with OPPOSITE polarity, SAME predicate, SAME arity
+        const auto &buckets = index_[!signature.positive];
+        auto bucket = buckets.find(signature.head);
+        return CandidateRange(bucket == buckets.end() ? &empty_bucket_ : &bucket->second);
+    }
 
-        auto arity_it = pred_it->second.find(arity);
-        if (arity_it == pred_it->second.end())
+    std::vector<ClausePtr> LiteralIndex::get_resolution_candidates(const Literal &literal)
+    {
+        std::vector<ClausePtr> candidates;
+        for (const auto &entry : resolution_candidates(literal))
         {
-            return {};
+            candidates.push_back(entry.clause);
         }
-
-        return arity_it->second;
+        return candidates;
     }
 
     void LiteralIndex::clear()
     {
-        index_.clear();
+        for (auto &buckets : index_)
+        {
+            buckets.clear();
+        }
     }
 
     size_t LiteralIndex::size() const
     {
         size_t total = 0;
-        for (const auto &[polarity, pred_map] : index_)
+        for (const auto &buckets : index_)
         {
-            for (const auto &[pred_symbol, arity_map] : pred_map)
+            for (const auto &[head, entries] : buckets)
             {
-                for (const auto &[arity, clause_list] : arity_map)
-                {
-                    total += clause_list.size();
-                }
+                total += entries.size();
             }
         }
         return total;
@@ -105,73 +106,16 @@ namespace theorem_prover
         std::cout << "=== Literal Index Statistics ===" << std::endl;
         std::cout << "Total indexed literals: " << size() << std::endl;
 
-        for (const auto &[polarity, pred_map] : index_)
+        for (bool polarity : {true, false})
         {
             std::cout << "Polarity " << (polarity ? "positive" : "negative") << ":" << std::endl;
 
-            for (const auto &[pred_symbol, arity_map] : pred_map)
+            for (const auto &[head, entries] : index_[polarity])
             {
-                for (const auto &[arity, clause_list] : arity_map)
-                {
-                    std::cout << "  " << pred_symbol << "/" << arity
-                              << ": " << clause_list.size() << " clauses" << std::endl;
-                }
+                std::cout << "  " << SymbolTable::name(static_cast<SymbolId>(head))
+                          << ": " << entries.size() << " clauses" << std::endl;
             }
         }
     }
 
-    std::string LiteralIndex::get_predicate_symbol(const TermDBPtr &term) const
-    {
-        switch (term->kind())
-        {
-        case TermDB::TermKind::CONSTANT:
-        {
-            auto constant = std::dynamic_pointer_cast<ConstantDB>(term);
-            return constant->symbol();
-        }
-        case TermDB::TermKind::FUNCTION_APPLICATION:
-        {
-            auto func_app = std::dynamic_pointer_cast<FunctionApplicationDB>(term);
-            return func_app->symbol();
-        }
-        case TermDB::TermKind::VARIABLE:
-        {
-            return "_VAR_";
-        }
-        default:
-            return "_OTHER_";
-        }
-    }
-
-    size_t LiteralIndex::get_arity(const TermDBPtr &term) const
-    {
-        switch (term->kind())
-        {
-        case TermDB::TermKind::CONSTANT:
-        {
-            return 0; // Constants have arity 0
-        }
-        case TermDB::TermKind::FUNCTION_APPLICATION:
-        {
-            auto func_app = std::dynamic_pointer_cast<FunctionApplicationDB>(term);
-            return func_app->arguments().size();
-        }
-        case TermDB::TermKind::VARIABLE:
-        {
-            return 0; // Variables treated as arity 0 for indexing
-        }
-        default:
-            return 0;
-        }
-    }
-
-    void LiteralIndex::remove_clause_from_bucket(std::vector<ClausePtr> &bucket, ClausePtr clause)
-    {
-        bucket.erase(
-            std::remove_if(bucket.begin(), bucket.end(),
-                           [clause](const ClausePtr &c)
-                           { return c == clause; }),
-            bucket.end());
-    }
-
-} // namespace theorem_prover
\ No newline at end of file
+} // namespace theorem_prover
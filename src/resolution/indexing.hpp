@@ -1,6 +1,7 @@
 #pragma once
 
 #include "clause.hpp"
+#include <functional>
 #include <unordered_map>
 #include <vector>
 #include <string>
@@ -11,14 +12,75 @@ namespace theorem_prover
     class LiteralIndex
     {
     public:
+        // A clause and the position of one of its literals
+        struct Entry
+        {
+            ClausePtr clause;
+            std::size_t literal;
+        };
+
+        /**
+         * The entries of one bucket as of the query, without copying them
+         *
+         * Iteration reads through the bucket, so inserting clauses into the
+         * index while iterating is safe: it neither invalidates the range nor
+         * extends it. A reference to an entry does not survive an insertion;
+         * take what is needed from it first. Removing clauses invalidates the
+         * range.
+         */
+        class CandidateRange
+        {
+        public:
+            class iterator
+            {
+            public:
+                iterator(const std::vector<Entry> *bucket, std::size_t position)
+                    : bucket_(bucket), position_(position) {}
+
+                const Entry &operator*() const { return (*bucket_)[position_]; }
+                const Entry *operator->() const { return &(*bucket_)[position_]; }
+                iterator &operator++()
+                {
+                    ++position_;
+                    return *this;
+                }
+                bool operator!=(const iterator &other) const { return position_ != other.position_; }
+
+            private:
+                const std::vector<Entry> *bucket_;
+                std::size_t position_;
+            };
+
+            explicit CandidateRange(const std::vector<Entry> *bucket)
+                : bucket_(bucket), size_(bucket->size()) {}
+
+            iterator begin() const { return iterator(bucket_, 0); }
+            iterator end() const { return iterator(bucket_, size_); }
+            std::size_t size() const { return size_; }
+            bool empty() const { return size_ == 0; }
+
+        private:
+            const std::vector<Entry> *bucket_;
+            std::size_t size_;
+        };
+
         LiteralIndex();
 
         // Index management
         void insert_clause(ClausePtr clause);
         void remove_clause(ClausePtr clause);
+
+        // Drop the entries of every clause the predicate holds for, in one pass
+        void remove_clauses_if(const std::function<bool(const ClausePtr &)> &removed);
+
         void clear();
 
-        // Query interface
+        // Query interface: entries whose literal has the opposite polarity and
+        // the same predicate symbol and arity
+        CandidateRange resolution_candidates(const Literal &literal) const;
+        CandidateRange resolution_candidates(const Clause::LiteralSignature &signature) const;
+
+        // The candidate clauses as a copy, one per entry
         std::vector<ClausePtr> get_resolution_candidates(const Literal &literal);
 
         // Statistics
@@ -26,16 +88,10 @@ namespace theorem_prover
         void print_statistics() const;
 
     private:
-        // Index structure: polarity -> predicate_symbol -> arity -> list of clauses
-        std::unordered_map<bool,
-                           std::unordered_map<std::string,
-                                              std::unordered_map<size_t, std::vector<ClausePtr>>>>
-            index_;
-
-        // Helper functions
-        std::string get_predicate_symbol(const TermDBPtr &term) const;
-        size_t get_arity(const TermDBPtr &term) const;
-        void remove_clause_from_bucket(std::vector<ClausePtr> &bucket, ClausePtr clause);
+        // Index structure: polarity -> interned predicate symbol and arity -> entries
+        std::unordered_map<std::size_t, std::vector<Entry>> index_[2];
+
+        static const std::vector<Entry> empty_bucket_;
     };
 
-} // namespace theorem_prover
\ No newline at end of file
+} // namespace theorem_prover
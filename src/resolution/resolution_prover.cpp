@@ -1,66 +1,524 @@
 #include "resolution_prover.hpp"
 #include "indexing.hpp"
+#include "strategy.hpp"
+#include "search_trace.hpp"
+#include "clause_io.hpp"
+#include "../completion/completion_cache.hpp"
 #include "clause.hpp"
+#include "../completion/unit_equality.hpp"
+#include "../datalog/datalog_engine.hpp"
+#include "../term/substitution.hpp"
+#include "../term/unification.hpp"
 #include <algorithm>
 #include <chrono>
 #include <iostream>
+#include <limits>
 #include <unordered_map>
+#include <unordered_set>
 
 using namespace std::chrono;
 
 namespace theorem_prover
 {
 
+    namespace
+    {
+        /**
+         * Search for the simultaneous resolution steps of one nucleus: the
+         * literals at the clash positions are resolved away in order, each
+         * against a complementary literal of an electron, composing the
+         * unifiers as it goes. Only the conclusions are built.
+         */
+        class ClashSearch
+        {
+        public:
+            ClashSearch(const ClauseSet &clause_set, const ClausePtr &nucleus,
+                        std::function<bool(const ClausePtr &)> is_electron)
+                : clause_set_(clause_set), nucleus_(nucleus), is_electron_(std::move(is_electron)) {}
+
+            // Resolve the literal at this position against the given electron
+            // literal only, rather than against the index
+            void fix(std::size_t position, const ClausePtr &electron, std::size_t electron_literal)
+            {
+                fixed_position_ = position;
+                fixed_electron_ = electron;
+                fixed_literal_ = electron_literal;
+            }
+
+            // Add the conclusions of clashing the literals at these positions
+            void run(std::vector<std::size_t> positions, std::vector<ClausePtr> &conclusions)
+            {
+                // The fixed electron goes first: its bindings prune the others
+                auto fixed = std::find(positions.begin(), positions.end(), fixed_position_);
+                if (fixed != positions.end())
+                {
+                    std::rotate(positions.begin(), fixed, fixed + 1);
+                }
+                positions_ = &positions;
+                conclusions_ = &conclusions;
+                clashed_.assign(nucleus_->size(), false);
+                for (std::size_t position : positions)
+                {
+                    clashed_[position] = true;
+                }
+                std::vector<Literal> side_literals;
+                extend(0, SubstitutionMap(), side_literals, nucleus_->variable_bound());
+            }
+
+        private:
+            const ClauseSet &clause_set_;
+            ClausePtr nucleus_;
+            std::function<bool(const ClausePtr &)> is_electron_;
+            std::size_t fixed_position_ = static_cast<std::size_t>(-1);
+            ClausePtr fixed_electron_;
+            std::size_t fixed_literal_ = 0;
+            const std::vector<std::size_t> *positions_ = nullptr;
+            std::vector<ClausePtr> *conclusions_ = nullptr;
+            std::vector<bool> clashed_; // Nucleus literals resolved away
+
+            // Electrons are renamed apart from the nucleus and from each
+            // other, starting at offset
+            void extend(std::size_t step, const SubstitutionMap &substitution,
+                        std::vector<Literal> &side_literals, std::size_t offset)
+            {
+                if (step == positions_->size())
+                {
+                    conclude(substitution, side_literals);
+                    return;
+                }
+
+                std::size_t position = (*positions_)[step];
+                TermDBPtr atom = SubstitutionEngine::substitute(nucleus_->literals()[position].atom(), substitution);
+
+                auto clash = [&](const ClausePtr &electron, std::size_t electron_literal)
+                {
+                    // Ground electrons need no renaming
+                    std::optional<Clause> renamed_storage;
+                    const Clause *renamed = electron.get();
+                    if (electron->variable_bound() > 0)
+                    {
+                        renamed = &renamed_storage.emplace(electron->rename_variables(offset));
+                    }
+                    auto literals = renamed->literals();
+                    auto unifier = Unifier::unify(atom, literals[electron_literal].atom());
+                    if (!unifier.success)
+                    {
+                        return;
+                    }
+
+                    std::size_t mark = side_literals.size();
+                    for (std::size_t i = 0; i < literals.size(); ++i)
+                    {
+                        if (i != electron_literal)
+                        {
+                            side_literals.push_back(literals[i]);
+                        }
+                    }
+                    extend(step + 1, Unifier::compose_substitutions(substitution, unifier.substitution),
+                           side_literals, std::max(offset, renamed->variable_bound()));
+                    side_literals.erase(side_literals.begin() + mark, side_literals.end());
+                };
+
+                if (position == fixed_position_)
+                {
+                    clash(fixed_electron_, fixed_literal_);
+                    return;
+                }
+                for (const auto &entry : clause_set_.resolution_candidates(nucleus_->signatures()[position]))
+                {
+                    if (!clause_set_.is_removed(entry.clause) && is_electron_(entry.clause))
+                    {
+                        clash(entry.clause, entry.literal);
+                    }
+                }
+            }
+
+            void conclude(const SubstitutionMap &substitution, const std::vector<Literal> &side_literals)
+            {
+                std::vector<Literal> literals;
+                auto nucleus_literals = nucleus_->literals();
+                for (std::size_t i = 0; i < nucleus_literals.size(); ++i)
+                {
+                    if (!clashed_[i])
+                    {
+                        literals.emplace_back(SubstitutionEngine::substitute(nucleus_literals[i].atom(), substitution),
+                                              nucleus_literals[i].is_positive());
+                    }
+                }
+                for (const auto &literal : side_literals)
+                {
+                    literals.emplace_back(SubstitutionEngine::substitute(literal.atom(), substitution),
+                                          literal.is_positive());
+                }
+
+                Clause conclusion(std::move(literals));
+                if (!conclusion.is_tautology())
+                {
+                    conclusions_->push_back(std::make_shared<Clause>(conclusion.simplify()));
+                }
+            }
+        };
+
+        bool is_positive_clause(const ClausePtr &clause)
+        {
+            const auto &signatures = clause->signatures();
+            return std::all_of(signatures.begin(), signatures.end(),
+                               [](const Clause::LiteralSignature &signature)
+                               { return signature.positive; });
+        }
+
+        bool is_unit_clause(const ClausePtr &clause)
+        {
+            return clause->is_unit();
+        }
+
+        std::vector<std::size_t> negative_positions(const ClausePtr &clause)
+        {
+            std::vector<std::size_t> positions;
+            const auto &signatures = clause->signatures();
+            for (std::size_t i = 0; i < signatures.size(); ++i)
+            {
+                if (!signatures[i].positive)
+                {
+                    positions.push_back(i);
+                }
+            }
+            return positions;
+        }
+
+        // Every position of the clause but one, which stays; none is left
+        // out of a unit clause
+        std::vector<std::size_t> positions_except(const ClausePtr &clause, std::size_t kept)
+        {
+            std::vector<std::size_t> positions;
+            for (std::size_t i = 0; i < clause->size(); ++i)
+            {
+                if (i != kept || clause->is_unit())
+                {
+                    positions.push_back(i);
+                }
+            }
+            return positions;
+        }
+    } // namespace
+
     ClauseSet::ClauseSet(const ResolutionConfig &config)
-        : config_(config), next_clause_index_(0) {}
+        : pool_(ClausePool::create()), config_(config) {}
 
-    void ClauseSet::add_clause(ClausePtr clause)
+    void ClauseSet::add_clause(ClausePtr clause, bool supported)
+    {
+        ClausePool::Scope pool_scope(pool_.get());
+
+        // Clauses shortened by backward simplification are re-added through
+        // the same path, iteratively rather than recursively
+        std::vector<PendingClause> pending{{clause, supported}};
+        while (!pending.empty() && !has_empty_clause_)
+        {
+            PendingClause next = pending.back();
+            pending.pop_back();
+            insert_clause(next.first, next.second, pending);
+        }
+    }
+
+    ClausePtr ClauseSet::normalize(const Clause &clause) const
+    {
+        Clause simplified = clause.simplify();
+        if (config_.use_condensation)
+        {
+            simplified = simplified.condense();
+        }
+        return std::make_shared<Clause>(simplified.canonical());
+    }
+
+    void ClauseSet::insert_clause(ClausePtr clause, bool supported, std::vector<PendingClause> &pending)
     {
         if (!clause || clause->is_tautology())
         {
             return;
         }
 
-        auto simplified = std::make_shared<Clause>(clause->simplify());
+        // Store the normal form, so permuted or renamed copies of a clause
+        // are recognized as variants and not processed again. A supported
+        // clause dropped in favour of a stored one hands its support over,
+        // so the set of support never loses a clause's consequences.
+        auto simplified = normalize(*clause);
 
-        size_t clause_hash = simplified->hash();
-        if (clause_hashes_.find(clause_hash) != clause_hashes_.end())
+        if (auto variant = find_variant(simplified))
         {
+            if (supported)
+            {
+                support(variant);
+            }
             return;
         }
 
-        if (config_.use_subsumption && is_subsumed(simplified))
+        auto shortened = simplify_forward(simplified, supported);
+        if (shortened != simplified)
         {
-            return;
+            simplified = normalize(*shortened);
+            if (auto variant = find_variant(simplified))
+            {
+                if (supported)
+                {
+                    support(variant);
+                }
+                return;
+            }
         }
 
         if (config_.use_subsumption)
         {
-            remove_subsumed_clauses(simplified);
+            if (auto subsumer = find_subsumer(simplified))
+            {
+                if (supported)
+                {
+                    support(subsumer);
+                }
+                return;
+            }
+            if (remove_subsumed_clauses(simplified))
+            {
+                supported = true;
+            }
         }
 
         clauses_.push_back(simplified);
-        processing_queue_.push(simplified);
-        clause_hashes_.insert(clause_hash);
+        signatures_.push_back(simplified->clause_signature());
+        variant_index_.emplace(simplified->variant_hash(), simplified);
 
         // Add to index for efficient retrieval
         literal_index_.insert_clause(simplified);
+
+        if (simplified->is_empty())
+        {
+            has_empty_clause_ = true;
+            return;
+        }
+
+        ClauseId id = static_cast<ClauseId>(slots_.size());
+        simplified->storage_->id = id;
+        slots_.push_back(simplified);
+        positions_.push_back(clauses_.size() - 1);
+        supported_.push_back(supported);
+        if (supported)
+        {
+            processing_queue_.push(id);
+        }
+        if (simplified->is_unit())
+        {
+            unit_index_[simplified->signatures()[0].head].push_back(id);
+        }
+
+        simplify_backward(simplified, pending);
     }
 
-    bool ClauseSet::contains_empty_clause() const
+    ClausePtr ClauseSet::simplify_forward(ClausePtr clause, bool &supported)
     {
-        for (const auto &clause : clauses_)
+        bool changed = true;
+        while (changed && !clause->is_empty())
         {
-            if (clause->is_empty())
+            changed = false;
+
+            // Unit deletion: drop L if some unit is more general than ¬L
+            if (config_.use_unit_deletion && !unit_index_.empty())
             {
-                return true;
+                const auto &literals = clause->literals();
+                const auto &signatures = clause->signatures();
+                for (size_t i = 0; i < literals.size() && !changed; ++i)
+                {
+                    auto units = unit_index_.find(signatures[i].head);
+                    if (units == unit_index_.end())
+                    {
+                        continue;
+                    }
+                    Literal negated = literals[i].negate();
+                    for (ClauseId unit : units->second)
+                    {
+                        if (slots_[unit] && Clause::literal_matches(slots_[unit]->literals()[0], negated))
+                        {
+                            std::vector<Literal> rest = literals;
+                            rest.erase(rest.begin() + i);
+                            clause = std::make_shared<Clause>(rest);
+                            supported = supported || supported_[unit];
+                            changed = true;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            // Subsumption resolution: a simplifier has a literal complementary
+            // to one of ours, so it is among the resolution candidates
+            if (!changed && config_.use_subsumption_resolution)
+            {
+                Clause::ClauseSignature target = clause->clause_signature();
+                std::unordered_set<const Clause *> tried;
+                for (const auto &signature : clause->signatures())
+                {
+                    for (const auto &entry : resolution_candidates(signature))
+                    {
+                        const ClausePtr &candidate = entry.clause;
+                        if (candidate->is_unit() || candidate->size() > clause->size() || is_removed(candidate) ||
+                            !signatures_[positions_[candidate->id()]].may_shorten(target) ||
+                            !tried.insert(candidate.get()).second)
+                        {
+                            continue;
+                        }
+                        if (auto shortened = ResolutionInference::subsumption_resolution(clause, candidate))
+                        {
+                            clause = shortened;
+                            supported = supported || supported_[candidate->id()];
+                            changed = true;
+                            break;
+                        }
+                    }
+                    if (changed)
+                    {
+                        break;
+                    }
+                }
             }
         }
-        return false;
+        return clause;
+    }
+
+    void ClauseSet::simplify_backward(const ClausePtr &clause, std::vector<PendingClause> &pending)
+    {
+        bool enabled = clause->is_unit() ? config_.use_unit_deletion
+                                         : config_.use_subsumption_resolution;
+        if (!enabled)
+        {
+            return;
+        }
+
+        // Only clauses with a literal complementary to one of ours can be
+        // shortened; a clause shortened through one literal is removed and
+        // skipped for the others
+        Clause::ClauseSignature simplifier = clause->clause_signature();
+        for (const auto &signature : clause->signatures())
+        {
+            for (const auto &entry : resolution_candidates(signature))
+            {
+                const ClausePtr &candidate = entry.clause;
+                if (candidate == clause || candidate->size() < clause->size() || is_removed(candidate) ||
+                    !simplifier.may_shorten(signatures_[positions_[candidate->id()]]))
+                {
+                    continue;
+                }
+                if (auto shortened = ResolutionInference::subsumption_resolution(candidate, clause))
+                {
+                    bool supported = supported_[candidate->id()] || supported_[clause->id()];
+                    detach_clause(candidate);
+                    pending.emplace_back(shortened, supported);
+                }
+            }
+        }
+    }
+
+    void ClauseSet::detach_clause(ClausePtr clause)
+    {
+        erase_variant(clause);
+
+        // Move the last stored clause into the vacated position
+        std::size_t position = positions_[clause->id()];
+        if (position + 1 != clauses_.size())
+        {
+            clauses_[position] = std::move(clauses_.back());
+            signatures_[position] = signatures_.back();
+            if (clauses_[position]->id() != no_clause_id)
+            {
+                positions_[clauses_[position]->id()] = position;
+            }
+        }
+        clauses_.pop_back();
+        signatures_.pop_back();
+
+        // Entries in the literal and unit indexes and the queue stay behind
+        // until compaction; lookups skip them once the slot is empty. The
+        // clause itself is freed with the next batch.
+        retired_.push_back(clause);
+        slots_[clause->id()] = nullptr;
+        ++tombstones_;
+    }
+
+    ClausePtr ClauseSet::clause(ClauseId id) const
+    {
+        return id < slots_.size() ? slots_[id] : nullptr;
+    }
+
+    bool ClauseSet::is_removed(const ClausePtr &clause) const
+    {
+        return clause->id() != no_clause_id && !slots_[clause->id()];
+    }
+
+    bool ClauseSet::is_supported(const ClausePtr &clause) const
+    {
+        return clause->id() != no_clause_id && supported_[clause->id()];
+    }
+
+    void ClauseSet::support(const ClausePtr &clause)
+    {
+        // The empty clause has no id; the search is over once it is stored
+        if (clause->id() != no_clause_id && !supported_[clause->id()])
+        {
+            supported_[clause->id()] = true;
+            processing_queue_.push(clause->id());
+        }
+    }
+
+    void ClauseSet::reclaim()
+    {
+        ClausePool::Scope pool_scope(pool_.get());
+        retired_.clear();
+        if (tombstones_ > clauses_.size())
+        {
+            compact();
+        }
+    }
+
+    void ClauseSet::compact()
+    {
+        literal_index_.remove_clauses_if([this](const ClausePtr &clause)
+                                         { return is_removed(clause); });
+
+        for (auto &[head, units] : unit_index_)
+        {
+            units.erase(std::remove_if(units.begin(), units.end(),
+                                       [this](ClauseId id)
+                                       { return !slots_[id]; }),
+                        units.end());
+        }
+
+        std::queue<ClauseId> live;
+        while (!processing_queue_.empty())
+        {
+            if (slots_[processing_queue_.front()])
+            {
+                live.push(processing_queue_.front());
+            }
+            processing_queue_.pop();
+        }
+        processing_queue_.swap(live);
+
+        tombstones_ = 0;
+    }
+
+    void ClauseSet::skip_removed() const
+    {
+        while (!processing_queue_.empty() && !slots_[processing_queue_.front()])
+        {
+            processing_queue_.pop();
+        }
+    }
+
+    bool ClauseSet::contains_empty_clause() const
+    {
+        return has_empty_clause_;
     }
 
     ClausePtr ClauseSet::select_clause()
     {
+        skip_removed();
         if (processing_queue_.empty())
         {
             return nullptr;
@@ -70,9 +528,9 @@ namespace theorem_prover
         {
         case ResolutionConfig::SelectionStrategy::FIFO:
         {
-            auto clause = processing_queue_.front();
+            ClauseId id = processing_queue_.front();
             processing_queue_.pop();
-            return clause;
+            return slots_[id];
         }
 
         case ResolutionConfig::SelectionStrategy::SMALLEST_FIRST:
@@ -80,16 +538,20 @@ namespace theorem_prover
             // Find smallest clause in queue - safer implementation
             if (processing_queue_.size() == 1)
             {
-                auto clause = processing_queue_.front();
+                ClauseId id = processing_queue_.front();
                 processing_queue_.pop();
-                return clause;
+                return slots_[id];
             }
 
-            // Convert queue to vector for safer manipulation
-            std::vector<ClausePtr> queue_contents;
+            // Convert queue to vector for safer manipulation, dropping
+            // removed clauses on the way
+            std::vector<ClauseId> queue_contents;
             while (!processing_queue_.empty())
             {
-                queue_contents.push_back(processing_queue_.front());
+                if (slots_[processing_queue_.front()])
+                {
+                    queue_contents.push_back(processing_queue_.front());
+                }
                 processing_queue_.pop();
             }
 
@@ -100,39 +562,43 @@ namespace theorem_prover
 
             // Find smallest clause
             auto smallest_it = std::min_element(queue_contents.begin(), queue_contents.end(),
-                                                [](const ClausePtr &a, const ClausePtr &b)
+                                                [this](ClauseId a, ClauseId b)
                                                 {
-                                                    return a->size() < b->size();
+                                                    return slots_[a]->size() < slots_[b]->size();
                                                 });
 
-            ClausePtr smallest = *smallest_it;
+            ClauseId smallest = *smallest_it;
 
             // Put back all except the smallest
-            for (const auto &clause : queue_contents)
+            for (ClauseId id : queue_contents)
             {
-                if (clause != smallest)
+                if (id != smallest)
                 {
-                    processing_queue_.push(clause);
+                    processing_queue_.push(id);
                 }
             }
 
-            return smallest;
+            return slots_[smallest];
         }
 
         case ResolutionConfig::SelectionStrategy::UNIT_PREFERENCE:
         {
             if (processing_queue_.size() == 1)
             {
-                auto clause = processing_queue_.front();
+                ClauseId id = processing_queue_.front();
                 processing_queue_.pop();
-                return clause;
+                return slots_[id];
             }
 
-            // Convert queue to vector for safer manipulation
-            std::vector<ClausePtr> queue_contents;
+            // Convert queue to vector for safer manipulation, dropping
+            // removed clauses on the way
+            std::vector<ClauseId> queue_contents;
             while (!processing_queue_.empty())
             {
-                queue_contents.push_back(processing_queue_.front());
+                if (slots_[processing_queue_.front()])
+                {
+                    queue_contents.push_back(processing_queue_.front());
+                }
                 processing_queue_.pop();
             }
 
@@ -142,105 +608,264 @@ namespace theorem_prover
             }
 
             // Look for unit clauses first
-            ClausePtr unit_clause = nullptr;
-            for (const auto &clause : queue_contents)
+            ClauseId selected = queue_contents[0];
+            for (ClauseId id : queue_contents)
             {
-                if (clause->is_unit())
+                if (slots_[id]->is_unit())
                 {
-                    unit_clause = clause;
+                    selected = id;
                     break;
                 }
             }
 
-            ClausePtr selected = unit_clause ? unit_clause : queue_contents[0];
-
             // Put back all except the selected clause
-            for (const auto &clause : queue_contents)
+            for (ClauseId id : queue_contents)
             {
-                if (clause != selected)
+                if (id != selected)
                 {
-                    processing_queue_.push(clause);
+                    processing_queue_.push(id);
                 }
             }
 
-            return selected;
+            return slots_[selected];
         }
 
         case ResolutionConfig::SelectionStrategy::NEGATIVE_SELECTION:
         {
             // Just use FIFO for now - can implement proper negative selection later
-            auto clause = processing_queue_.front();
+            ClauseId id = processing_queue_.front();
             processing_queue_.pop();
-            return clause;
+            return slots_[id];
         }
 
         default:
         {
-            auto clause = processing_queue_.front();
+            ClauseId id = processing_queue_.front();
             processing_queue_.pop();
-            return clause;
+            return slots_[id];
+        }
+        }
+    }
+
+    void ClauseSet::save(BinaryWriter &out, TermWriter &terms) const
+    {
+        out.write_varint(slots_.size());
+        out.write_varint(std::count_if(slots_.begin(), slots_.end(), [](const ClausePtr &clause)
+                                       { return clause != nullptr; }));
+        for (ClauseId id = 0; id < slots_.size(); ++id)
+        {
+            if (slots_[id])
+            {
+                out.write_varint(id);
+                out.write_bool(supported_[id]);
+                clause_io::write_clause(out, terms, *slots_[id]);
+            }
+        }
+
+        // Inferences with paramodulation follow the store order
+        for (const auto &clause : clauses_)
+        {
+            if (clause->id() != no_clause_id)
+            {
+                out.write_varint(clause->id());
+            }
         }
+
+        std::vector<ClauseId> queued;
+        for (auto queue = processing_queue_; !queue.empty(); queue.pop())
+        {
+            if (slots_[queue.front()])
+            {
+                queued.push_back(queue.front());
+            }
+        }
+        out.write_varint(queued.size());
+        for (ClauseId id : queued)
+        {
+            out.write_varint(id);
         }
     }
 
+    void ClauseSet::restore(BinaryReader &in, TermReader &terms)
+    {
+        ClausePool::Scope pool_scope(pool_.get());
+        clear();
+
+        auto read_id = [&in, this]()
+        {
+            std::uint64_t id = in.read_varint();
+            if (id >= slots_.size())
+            {
+                throw SerializationError("Clause id out of range");
+            }
+            return static_cast<ClauseId>(id);
+        };
+
+        slots_.resize(in.read_varint());
+        positions_.resize(slots_.size());
+        supported_.resize(slots_.size());
+        std::size_t stored = in.read_varint();
+        for (std::size_t i = 0; i < stored; ++i)
+        {
+            ClauseId id = read_id();
+            supported_[id] = in.read_bool();
+            slots_[id] = clause_io::read_clause(in, terms);
+            slots_[id]->storage_->id = id;
+        }
+
+        for (std::size_t i = 0; i < stored; ++i)
+        {
+            ClauseId id = read_id();
+            if (!slots_[id])
+            {
+                throw SerializationError("Stored clause missing");
+            }
+            positions_[id] = clauses_.size();
+            clauses_.push_back(slots_[id]);
+            signatures_.push_back(slots_[id]->clause_signature());
+        }
+
+        for (const auto &clause : slots_)
+        {
+            if (clause)
+            {
+                variant_index_.emplace(clause->variant_hash(), clause);
+                literal_index_.insert_clause(clause);
+                if (clause->is_unit())
+                {
+                    unit_index_[clause->signatures()[0].head].push_back(clause->id());
+                }
+            }
+        }
+
+        for (std::size_t i = 0, queued = in.read_varint(); i < queued; ++i)
+        {
+            processing_queue_.push(read_id());
+        }
+    }
+
+    std::vector<ClausePtr> ClauseSet::release_clauses()
+    {
+        std::vector<ClausePtr> released = std::move(clauses_);
+        clear();
+        return released;
+    }
+
     bool ClauseSet::is_empty() const
     {
+        skip_removed();
         return processing_queue_.empty();
     }
 
     void ClauseSet::clear()
     {
         clauses_.clear();
+        signatures_.clear();
+        slots_.clear();
+        positions_.clear();
+        supported_.clear();
+        tombstones_ = 0;
+        retired_.clear();
         while (!processing_queue_.empty())
         {
             processing_queue_.pop();
         }
-        clause_hashes_.clear();
-        next_clause_index_ = 0;
+        variant_index_.clear();
+        unit_index_.clear();
+        has_empty_clause_ = false;
 
         // CLEAR INDEX
         literal_index_.clear();
     }
 
-    bool ClauseSet::is_subsumed(ClausePtr clause) const
+    ClausePtr ClauseSet::find_subsumer(const ClausePtr &clause) const
     {
-        // A clause is subsumed if any existing clause subsumes it
-        for (const auto &existing : clauses_)
+        // A clause is subsumed if any existing clause subsumes it; the
+        // signature scan rules out most of them without touching the clauses
+        Clause::ClauseSignature signature = clause->clause_signature();
+        for (std::size_t i = 0; i < signatures_.size(); ++i)
         {
-            if (Clause::subsumes(existing, clause))
+            if (signatures_[i].may_subsume(signature) && Clause::subsumes(clauses_[i], clause))
             {
-                return true;
+                return clauses_[i];
             }
         }
-        return false;
+        return nullptr;
     }
     std::vector<ClausePtr> ClauseSet::get_resolution_candidates(const Literal &literal)
     {
-        return literal_index_.get_resolution_candidates(literal);
+        std::vector<ClausePtr> candidates = literal_index_.get_resolution_candidates(literal);
+        if (tombstones_ > 0)
+        {
+            candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                            [this](const ClausePtr &candidate)
+                                            { return is_removed(candidate); }),
+                             candidates.end());
+        }
+        return candidates;
     }
 
-    void ClauseSet::remove_subsumed_clauses(ClausePtr clause)
+    bool ClauseSet::remove_subsumed_clauses(ClausePtr clause)
     {
-        // Remove clauses that are subsumed by the new clause
-        auto it = clauses_.begin();
-        while (it != clauses_.end())
+        // Remove clauses that are subsumed by the new clause; removal moves
+        // the last clause into position i, which is examined next
+        Clause::ClauseSignature signature = clause->clause_signature();
+        bool removed_supported = false;
+        std::size_t i = 0;
+        while (i < clauses_.size())
         {
-            if (Clause::subsumes(clause, *it))
+            if (signature.may_subsume(signatures_[i]) && Clause::subsumes(clause, clauses_[i]))
             {
-                clause_hashes_.erase((*it)->hash());
-                it = clauses_.erase(it);
+                removed_supported = removed_supported || is_supported(clauses_[i]);
+                detach_clause(clauses_[i]);
             }
             else
             {
-                ++it;
+                ++i;
             }
         }
+        return removed_supported;
     }
 
     bool ClauseSet::are_variants(ClausePtr clause1, ClausePtr clause2) const
     {
-        // Simplified variant check - would need proper variable renaming
-        return clause1->equals(*clause2);
+        return clause1->is_variant(*clause2);
+    }
+
+    ClausePtr ClauseSet::find_variant(const ClausePtr &clause) const
+    {
+        // Equal variant hashes are confirmed, so a collision never drops a clause
+        auto range = variant_index_.equal_range(clause->variant_hash());
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (are_variants(it->second, clause))
+            {
+                return it->second;
+            }
+        }
+        return nullptr;
+    }
+
+    void ClauseSet::erase_variant(const ClausePtr &clause)
+    {
+        auto range = variant_index_.equal_range(clause->variant_hash());
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second == clause)
+            {
+                variant_index_.erase(it);
+                return;
+            }
+        }
+    }
+
+    const resolution_utils::ClauseSetStats &ResolutionProofResult::final_clause_stats() const
+    {
+        if (!final_stats_)
+        {
+            final_stats_ = resolution_utils::analyze_clause_set(final_clauses);
+        }
+        return *final_stats_;
     }
 
     ResolutionProver::ResolutionProver(const ResolutionConfig &config)
@@ -252,89 +877,294 @@ namespace theorem_prover
         // Convert to refutation problem: Hypotheses ∪ {¬Goal} should be unsatisfiable
         auto refutation_formulas = setup_refutation_problem(goal, hypotheses);
 
+        // Convert to CNF; the negated goal comes last and forms the set of support
+        std::vector<ClausePtr> axioms;
+        std::vector<ClausePtr> support;
+        std::size_t skolems = 0;
+        for (size_t i = 0; i < refutation_formulas.size(); ++i)
+        {
+            auto cnf_clauses = CNFConverter::to_cnf(refutation_formulas[i], skolems);
+            auto &target = i + 1 == refutation_formulas.size() ? support : axioms;
+            target.insert(target.end(), cnf_clauses.begin(), cnf_clauses.end());
+        }
+
+        return refute(std::move(axioms), std::move(support));
+    }
+
+    ResolutionProofResult ResolutionProver::refute(std::vector<ClausePtr> all_clauses)
+    {
+        // Without a goal to tell them apart, every clause is supported
+        return refute({}, std::move(all_clauses));
+    }
+
+    ResolutionProofResult ResolutionProver::refute(std::vector<ClausePtr> axioms, std::vector<ClausePtr> support)
+    {
+        if (config_.use_auto_strategy)
+        {
+            return StrategyScheduler(config_).run(axioms, support);
+        }
+
+        // NEW: Optional KB preprocessing
+        if (config_.use_kb_preprocessing)
+        {
+            std::vector<ClausePtr> all_clauses = axioms;
+            all_clauses.insert(all_clauses.end(), support.begin(), support.end());
+            auto kb_result = try_kb_preprocessing(all_clauses);
+
+            // Log KB results for analysis
+            if (config_.kb_config.verbose && kb_result.status == KBResult::Status::SUCCESS)
+            {
+                std::cout << "KB preprocessing: " << kb_result.final_rules.size()
+                          << " rules generated in " << kb_result.elapsed_time_seconds
+                          << " seconds" << std::endl;
+            }
+
+            // Kept clauses stay on their side; the rules replacing the unit
+            // equalities are supported if the goal contributed an equation
+            std::unordered_set<const Clause *> axiom_members;
+            std::unordered_set<const Clause *> support_members;
+            for (const auto &clause : axioms)
+            {
+                axiom_members.insert(clause.get());
+            }
+            for (const auto &clause : support)
+            {
+                support_members.insert(clause.get());
+            }
+            bool support_equations = std::any_of(support.begin(), support.end(),
+                                                 [this](const ClausePtr &clause)
+                                                 { return is_unit_equality_clause(clause); });
+
+            axioms.clear();
+            support.clear();
+            for (const auto &clause : all_clauses)
+            {
+                bool supported = support_members.count(clause.get()) > 0 ||
+                                 (axiom_members.count(clause.get()) == 0 && support_equations);
+                (supported ? support : axioms).push_back(clause);
+            }
+        }
+
+        return prove_from_clauses(axioms, support);
+    }
+
+    ResolutionProofResult ResolutionProver::check_satisfiability(const std::vector<TermDBPtr> &formulas)
+    {
         // Convert to CNF
         std::vector<ClausePtr> all_clauses;
-        for (const auto &formula : refutation_formulas)
+        std::size_t skolems = 0;
+        for (const auto &formula : formulas)
+        {
+            auto cnf_clauses = CNFConverter::to_cnf(formula, skolems);
+            all_clauses.insert(all_clauses.end(), cnf_clauses.begin(), cnf_clauses.end());
+        }
+
+        // The scheduler takes over clause sets in auto mode
+        auto result = config_.use_auto_strategy ? StrategyScheduler(config_).run({}, all_clauses)
+                                                : prove_from_clauses(all_clauses);
+
+        // Flip the interpretation for satisfiability checking
+        if (result.status == ResolutionProofResult::Status::PROVED)
+        {
+            result.status = ResolutionProofResult::Status::DISPROVED;
+            result.explanation = "Formula set is unsatisfiable";
+        }
+        else if (result.status == ResolutionProofResult::Status::SATURATED ||
+                 result.status == ResolutionProofResult::Status::DISPROVED)
+        {
+            result.status = ResolutionProofResult::Status::PROVED;
+            result.explanation = "Formula set is satisfiable";
+        }
+
+        return result;
+    }
+
+    ResolutionProofResult ResolutionProver::prove_from_clauses(const std::vector<ClausePtr> &clauses)
+    {
+        return prove_from_clauses({}, clauses);
+    }
+
+    ResolutionProofResult ResolutionProver::prove_from_clauses(const std::vector<ClausePtr> &axioms,
+                                                               const std::vector<ClausePtr> &support)
+    {
+        if (config_.trace_file.empty())
+        {
+            return search(axioms, support);
+        }
+
+        SearchTrace trace;
+        trace.config = config_;
+        trace.config.trace_file.clear();
+        trace.config.stop = nullptr;
+        trace.axioms = axioms;
+        trace.support = support;
+
+        recording_ = &trace;
+        auto result = search(axioms, support);
+        recording_ = nullptr;
+
+        trace.status = result.status;
+        try
+        {
+            trace.save(config_.trace_file);
+        }
+        catch (const SerializationError &e)
         {
-            auto cnf_clauses = CNFConverter::to_cnf(formula);
-            all_clauses.insert(all_clauses.end(), cnf_clauses.begin(), cnf_clauses.end());
+            std::cerr << "Warning: search trace not saved: " << e.what() << std::endl;
         }
+        return result;
+    }
 
-        // NEW: Optional KB preprocessing
-        if (config_.use_kb_preprocessing)
-        {
-            auto kb_result = try_kb_preprocessing(all_clauses);
+    ResolutionProofResult ResolutionProver::replay(const SearchTrace &trace)
+    {
+        ResolutionConfig config = trace.config;
+        config.max_time_ms = std::numeric_limits<double>::infinity();
+        config.max_iterations = std::numeric_limits<size_t>::max();
 
-            // Log KB results for analysis
-            if (config_.kb_config.verbose && kb_result.status == KBResult::Status::SUCCESS)
-            {
-                std::cout << "KB preprocessing: " << kb_result.final_rules.size()
-                          << " rules generated in " << kb_result.elapsed_time_seconds
-                          << " seconds" << std::endl;
-            }
-        }
+        ResolutionProver prover(config);
+        prover.replaying_ = &trace;
+        return prover.search(trace.axioms, trace.support);
+    }
 
-        return prove_from_clauses(all_clauses);
+    namespace
+    {
+        const char checkpoint_magic[] = "TPCHKPT1";
     }
 
-    ResolutionProofResult ResolutionProver::check_satisfiability(const std::vector<TermDBPtr> &formulas)
+    void ResolutionProver::save_checkpoint(const ClauseSet &clause_set, size_t iterations, double elapsed_ms) const
     {
-        // Convert to CNF
-        std::vector<ClausePtr> all_clauses;
-        for (const auto &formula : formulas)
+        BinaryWriter out;
+        out.write_string(checkpoint_magic);
+        clause_io::write_config(out, config_);
+        out.write_varint(iterations);
+        out.write_double(elapsed_ms);
+        TermWriter terms(out);
+        clause_set.save(out, terms);
+        try
         {
-            auto cnf_clauses = CNFConverter::to_cnf(formula);
-            all_clauses.insert(all_clauses.end(), cnf_clauses.begin(), cnf_clauses.end());
+            write_binary_file(config_.checkpoint_file, out.data());
         }
+        catch (const SerializationError &e)
+        {
+            std::cerr << "Warning: checkpoint not saved: " << e.what() << std::endl;
+        }
+    }
 
-        auto result = prove_from_clauses(all_clauses);
-
-        // Flip the interpretation for satisfiability checking
-        if (result.status == ResolutionProofResult::Status::PROVED)
+    ResolutionProofResult ResolutionProver::resume(const std::string &checkpoint_file)
+    {
+        std::string data = read_binary_file(checkpoint_file);
+        BinaryReader in(data);
+        if (in.read_string() != checkpoint_magic)
         {
-            result.status = ResolutionProofResult::Status::DISPROVED;
-            result.explanation = "Formula set is unsatisfiable";
+            throw SerializationError(checkpoint_file + ": not a checkpoint");
         }
-        else if (result.status == ResolutionProofResult::Status::SATURATED)
+
+        ResolutionConfig config = clause_io::read_config(in);
+        config.max_iterations = config_.max_iterations;
+        config.max_time_ms = config_.max_time_ms;
+        config.clause_retention = config_.clause_retention;
+        config.stop = config_.stop;
+        config.checkpoint_file = config_.checkpoint_file;
+        config.checkpoint_interval_ms = config_.checkpoint_interval_ms;
+        ResolutionProver prover(config);
+
+        size_t iterations = in.read_varint();
+        double elapsed_ms = in.read_double();
+        ClauseSet clause_set(config);
+        TermReader terms(in);
+        clause_set.restore(in, terms);
+        if (!in.at_end())
         {
-            result.status = ResolutionProofResult::Status::PROVED;
-            result.explanation = "Formula set is satisfiable";
+            throw SerializationError(checkpoint_file + ": trailing data after the checkpoint");
         }
 
-        return result;
+        ClausePool::Scope pool_scope(clause_set.pool());
+        return prover.resolution_loop(clause_set, iterations, elapsed_ms);
     }
 
-    ResolutionProofResult ResolutionProver::prove_from_clauses(const std::vector<ClausePtr> &clauses)
+    ResolutionProofResult ResolutionProver::search(const std::vector<ClausePtr> &axioms,
+                                                   const std::vector<ClausePtr> &support)
     {
+        // Function-free Horn clause sets are decided by fact lookup in
+        // their least model, which bottom-up evaluation computes directly;
+        // a small countermodel settles a non-theorem before any search;
+        // pure unit equality problems need no clause-level inferences at all
+        bool try_datalog = config_.use_datalog && !config_.use_paramodulation;
+        bool try_unit_equality = config_.use_unit_equality && config_.use_paramodulation;
+        if (try_datalog || try_unit_equality || config_.use_model_finder)
+        {
+            std::vector<ClausePtr> all_clauses = axioms;
+            all_clauses.insert(all_clauses.end(), support.begin(), support.end());
+            if (try_datalog && DatalogEngine::is_datalog(all_clauses))
+            {
+                return prove_by_datalog(all_clauses);
+            }
+            if (config_.use_model_finder && ModelFinder::is_first_order(all_clauses))
+            {
+                auto result = prove_by_model_finding(all_clauses);
+                if (result.is_disproved())
+                {
+                    return result;
+                }
+            }
+            if (try_unit_equality && UnitEqualityProver::is_unit_equality(all_clauses))
+            {
+                return prove_by_unit_equality(all_clauses);
+            }
+        }
+
         ClauseSet clause_set(config_);
 
-        // Find the maximum variable index across all clauses to ensure fresh variables
-        std::size_t max_var_index = 0;
-        for (const auto &clause : clauses)
+        // Clauses built during the search come from the set's pool
+        ClausePool::Scope pool_scope(clause_set.pool());
+
+        // Start past the largest variable index across all clauses to ensure fresh variables
+        std::size_t var_offset = 0;
+        for (const auto *clauses : {&axioms, &support})
         {
-            for (const auto &lit : clause->literals())
+            for (const auto &clause : *clauses)
             {
-                auto clause_max = get_max_variable_index(lit.atom());
-                max_var_index = std::max(max_var_index, clause_max);
+                var_offset = std::max(var_offset, clause->variable_bound());
             }
         }
 
         // Add clauses with proper variable standardization
-        std::size_t var_offset = max_var_index + 1;
-        for (const auto &clause : clauses)
+        auto add_input_clause = [&](const ClausePtr &clause, bool supported)
         {
             // Rename variables to ensure disjoint variable spaces
             auto standardized_clause = std::make_shared<Clause>(
                 clause->rename_variables(var_offset));
 
-            clause_set.add_clause(standardized_clause);
+            clause_set.add_clause(standardized_clause, supported);
 
-            // Update offset for next clause
-            for (const auto &lit : standardized_clause->literals())
+            // Axioms outside the set of support are never selected, so
+            // their factors, which resolution still needs, are added now
+            if (!supported && config_.use_factoring)
             {
-                auto clause_max = get_max_variable_index(lit.atom());
-                var_offset = std::max(var_offset, clause_max + 1);
+                std::vector<ClausePtr> unfactored{standardized_clause};
+                while (!unfactored.empty())
+                {
+                    auto next = unfactored.back();
+                    unfactored.pop_back();
+                    for (const auto &factor : factor_clause(next))
+                    {
+                        clause_set.add_clause(factor, false);
+                        unfactored.push_back(factor);
+                    }
+                }
             }
+
+            // Update offset for next clause
+            var_offset = std::max(var_offset, standardized_clause->variable_bound());
+        };
+
+        for (const auto &clause : axioms)
+        {
+            add_input_clause(clause, !config_.use_set_of_support);
+        }
+        for (const auto &clause : support)
+        {
+            add_input_clause(clause, true);
         }
 
         // Check for immediate empty clause
@@ -342,25 +1172,37 @@ namespace theorem_prover
         {
             ResolutionProofResult result(ResolutionProofResult::Status::PROVED,
                                          "Empty clause found in initial clause set");
-            result.final_clauses = clause_set.clauses();
+            retain_final_clauses(result, clause_set);
             return result;
         }
 
         return resolution_loop(clause_set);
     }
 
-    ResolutionProofResult ResolutionProver::resolution_loop(ClauseSet &clause_set)
+    ResolutionProofResult ResolutionProver::resolution_loop(ClauseSet &clause_set, size_t iterations,
+                                                            double elapsed_before_ms)
     {
         auto start_time = high_resolution_clock::now();
-        size_t iterations = 0;
+        double last_checkpoint_ms = elapsed_before_ms;
 
         while (!clause_set.is_empty())
         {
             auto current_time = high_resolution_clock::now();
-            double elapsed_ms = duration_cast<microseconds>(current_time - start_time).count() / 1000.0;
+            double elapsed_ms = elapsed_before_ms +
+                                duration_cast<microseconds>(current_time - start_time).count() / 1000.0;
+
+            // Between iterations the loop state is the clause set and the
+            // counters, so this is where checkpoints are taken
+            bool terminate = should_terminate(iterations, elapsed_ms, clause_set.size());
+            if (!config_.checkpoint_file.empty() && !replaying_ &&
+                (terminate || elapsed_ms - last_checkpoint_ms >= config_.checkpoint_interval_ms))
+            {
+                save_checkpoint(clause_set, iterations, elapsed_ms);
+                last_checkpoint_ms = elapsed_ms;
+            }
 
             // Check termination conditions
-            if (should_terminate(iterations, elapsed_ms, clause_set.size()))
+            if (terminate)
             {
                 if (iterations >= config_.max_iterations)
                 {
@@ -368,7 +1210,7 @@ namespace theorem_prover
                                                  "Maximum iterations exceeded");
                     result.iterations = iterations;
                     result.time_elapsed_ms = elapsed_ms;
-                    result.final_clauses = clause_set.clauses();
+                    retain_final_clauses(result, clause_set);
                     return result;
                 }
                 if (elapsed_ms >= config_.max_time_ms)
@@ -377,7 +1219,7 @@ namespace theorem_prover
                                                  "Time limit exceeded");
                     result.iterations = iterations;
                     result.time_elapsed_ms = elapsed_ms;
-                    result.final_clauses = clause_set.clauses();
+                    retain_final_clauses(result, clause_set);
                     return result;
                 }
                 if (clause_set.size() >= config_.max_clauses)
@@ -386,109 +1228,201 @@ namespace theorem_prover
                                                  "Maximum clauses exceeded");
                     result.iterations = iterations;
                     result.time_elapsed_ms = elapsed_ms;
-                    result.final_clauses = clause_set.clauses();
+                    retain_final_clauses(result, clause_set);
                     return result;
                 }
+                ResolutionProofResult result(ResolutionProofResult::Status::TIMEOUT, "Search stopped");
+                result.iterations = iterations;
+                result.time_elapsed_ms = elapsed_ms;
+                retain_final_clauses(result, clause_set);
+                return result;
             }
 
-            // Select clause for resolution
-            auto selected_clause = clause_set.select_clause();
-            if (!selected_clause)
+            // Select clause for resolution; a replay takes the recorded one
+            ClausePtr selected_clause;
+            if (replaying_)
             {
-                break;
+                if (iterations == replaying_->selections.size())
+                {
+                    bool complete = replaying_->status != ResolutionProofResult::Status::PROVED;
+                    ResolutionProofResult result(complete ? replaying_->status : ResolutionProofResult::Status::UNKNOWN,
+                                                 complete ? "Replay finished" : "Replay ended without the recorded proof");
+                    result.iterations = iterations;
+                    result.time_elapsed_ms = elapsed_ms;
+                    retain_final_clauses(result, clause_set);
+                    return result;
+                }
+                selected_clause = clause_set.clause(replaying_->selections[iterations]);
+                if (!selected_clause)
+                {
+                    ResolutionProofResult result(ResolutionProofResult::Status::UNKNOWN,
+                                                 "Replay diverged at selection " + std::to_string(iterations));
+                    result.iterations = iterations;
+                    result.time_elapsed_ms = elapsed_ms;
+                    retain_final_clauses(result, clause_set);
+                    return result;
+                }
+            }
+            else
+            {
+                selected_clause = clause_set.select_clause();
             }
-
-            // Safety check
             if (!selected_clause)
             {
-                std::cout << "Warning: null clause selected" << std::endl;
                 break;
             }
+            if (recording_)
+            {
+                recording_->selections.push_back(selected_clause->id());
+            }
 
             // Try to resolve using INDEX instead of brute force
             bool new_clause_added = false;
 
-            // For each literal in the selected clause, find resolution candidates
-            for (const auto &literal : selected_clause->literals())
-            {
-                std::vector<ClausePtr> candidates;
+            // Stored clauses are in normal form, numbering their variables
+            // from 0, so partners are renamed apart from the selected clause
+            std::size_t rename_offset = selected_clause->variable_bound();
 
-                if (config_.use_paramodulation)
-                {
-                    // For paramodulation, we need to try ALL clauses, not just complementary ones
-                    candidates = clause_set.clauses();
-                }
-                else
+            // Add the conclusions of one inference; yields the result once
+            // the empty clause is derived
+            auto add_resolvents = [&](const std::vector<ClausePtr> &resolvents) -> std::optional<ResolutionProofResult>
+            {
+                for (const auto &resolvent : resolvents)
                 {
-                    candidates = clause_set.get_resolution_candidates(literal);
+                    if (!resolvent)
+                    {
+                        continue;
+                    }
+
+                    if (resolvent->is_empty())
+                    {
+                        // Found empty clause - proof complete!
+                        ResolutionProofResult result(ResolutionProofResult::Status::PROVED,
+                                                     "Empty clause derived - theorem proved");
+                        result.iterations = iterations;
+                        result.time_elapsed_ms = elapsed_ms;
+                        retain_final_clauses(result, clause_set);
+                        return result;
+                    }
+
+                    // Add new resolvent
+                    size_t old_size = clause_set.size();
+                    clause_set.add_clause(resolvent);
+                    if (clause_set.size() > old_size)
+                    {
+                        new_clause_added = true;
+                    }
+
+                    if (clause_set.contains_empty_clause())
+                    {
+                        // Simplification cut the last literal of some clause
+                        ResolutionProofResult result(ResolutionProofResult::Status::PROVED,
+                                                     "Empty clause derived by simplification - theorem proved");
+                        result.iterations = iterations;
+                        result.time_elapsed_ms = elapsed_ms;
+                        retain_final_clauses(result, clause_set);
+                        return result;
+                    }
                 }
+                return std::nullopt;
+            };
 
+            if (config_.use_paramodulation)
+            {
+                // For paramodulation, we need to try ALL clauses, not just
+                // complementary ones. The inferences between two clauses do
+                // not depend on a selected literal, so each pair is tried
+                // once; the store is copied as adding clauses reorders it.
+                std::vector<ClausePtr> candidates = clause_set.clauses();
                 for (const auto &candidate_clause : candidates)
                 {
-                    if (!candidate_clause || selected_clause == candidate_clause)
+                    // A clause subsumed or shortened by one of its own
+                    // conclusions has nothing more to contribute
+                    if (clause_set.is_removed(selected_clause))
+                    {
+                        break;
+                    }
+                    if (!candidate_clause || selected_clause == candidate_clause ||
+                        clause_set.is_removed(candidate_clause))
                     {
                         continue;
                     }
 
-                    // Attempt resolution (with or without paramodulation)
-                    std::vector<ClausePtr> resolvents;
-                    if (config_.use_paramodulation)
+                    auto partner = std::make_shared<Clause>(candidate_clause->rename_variables(rename_offset));
+                    if (auto result = add_resolvents(ResolutionWithParamodulation::resolve_with_paramodulation(
+                            selected_clause, partner)))
                     {
-
-                        resolvents = ResolutionWithParamodulation::resolve_with_paramodulation(
-                            selected_clause, candidate_clause);
+                        return *result;
                     }
-                    else
+
+                    // Safety check for infinite loops
+                    if (clause_set.size() > config_.max_clauses)
                     {
-                        auto single_resolvent = resolve_clauses(selected_clause, candidate_clause);
-                        resolvents.insert(resolvents.end(), single_resolvent.begin(), single_resolvent.end());
+                        break;
                     }
-
-                    for (auto resolvent : resolvents)
+                }
+            }
+            else if (config_.inference_rule != ResolutionConfig::InferenceRule::BINARY)
+            {
+                // Macro inferences: only their conclusions enter the clause set
+                auto conclusions = config_.inference_rule == ResolutionConfig::InferenceRule::HYPERRESOLUTION
+                                       ? hyperresolvents(selected_clause, clause_set)
+                                       : ur_resolvents(selected_clause, clause_set);
+                if (auto result = add_resolvents(conclusions))
+                {
+                    return *result;
+                }
+            }
+            else
+            {
+                // For each literal in the selected clause, resolve on it with
+                // each complementary literal the index finds
+                const auto &signatures = selected_clause->signatures();
+                for (std::size_t i = 0; i < signatures.size(); ++i)
+                {
+                    for (const auto &candidate : clause_set.resolution_candidates(signatures[i]))
                     {
-                        if (!resolvent)
+                        if (clause_set.is_removed(selected_clause))
+                        {
+                            break;
+                        }
+                        if (selected_clause == candidate.clause || clause_set.is_removed(candidate.clause))
                         {
                             continue;
                         }
 
-                        if (resolvent->is_empty())
+                        // The entry may move once a resolvent is added
+                        std::size_t partner_literal = candidate.literal;
+                        auto partner = std::make_shared<Clause>(candidate.clause->rename_variables(rename_offset));
+
+                        auto resolution = ResolutionInference::resolve_on_literals(selected_clause, partner,
+                                                                                   i, partner_literal);
+                        if (resolution.success)
                         {
-                            // Found empty clause - proof complete!
-                            ResolutionProofResult result(ResolutionProofResult::Status::PROVED,
-                                                         "Empty clause derived - theorem proved");
-                            result.iterations = iterations;
-                            result.time_elapsed_ms = elapsed_ms;
-                            result.final_clauses = clause_set.clauses();
-                            return result;
+                            if (auto result = add_resolvents({resolution.resolvent}))
+                            {
+                                return *result;
+                            }
                         }
 
-                        // Add new resolvent
-                        size_t old_size = clause_set.size();
-                        clause_set.add_clause(resolvent);
-                        if (clause_set.size() > old_size)
+                        // Safety check for infinite loops
+                        if (clause_set.size() > config_.max_clauses)
                         {
-                            new_clause_added = true;
+                            break;
                         }
                     }
 
-                    // Safety check for infinite loops
                     if (clause_set.size() > config_.max_clauses)
                     {
                         break;
                     }
                 }
-
-                if (clause_set.size() > config_.max_clauses)
-                {
-                    break;
-                }
             }
 
             // Apply factoring if enabled
-            if (config_.use_factoring)
+            if (config_.use_factoring && !clause_set.is_removed(selected_clause))
             {
-                auto factored = factor_clause(selected_clause);
-                if (factored && !factored->equals(*selected_clause))
+                for (const auto &factored : factor_clause(selected_clause))
                 {
                     size_t old_size = clause_set.size();
                     clause_set.add_clause(factored);
@@ -496,47 +1430,287 @@ namespace theorem_prover
                     {
                         new_clause_added = true;
                     }
+
+                    if (clause_set.contains_empty_clause())
+                    {
+                        ResolutionProofResult result(ResolutionProofResult::Status::PROVED,
+                                                     "Empty clause derived by simplification - theorem proved");
+                        result.iterations = iterations;
+                        result.time_elapsed_ms = elapsed_ms;
+                        retain_final_clauses(result, clause_set);
+                        return result;
+                    }
                 }
             }
 
+            // Clauses removed in this iteration are freed together
+            clause_set.reclaim();
+
             iterations++;
         }
 
         // No more clauses to process and no empty clause found
         auto end_time = high_resolution_clock::now();
-        double elapsed_ms = duration_cast<microseconds>(end_time - start_time).count() / 1000.0;
+        double elapsed_ms = elapsed_before_ms + duration_cast<microseconds>(end_time - start_time).count() / 1000.0;
 
         ResolutionProofResult result(ResolutionProofResult::Status::SATURATED,
                                      "Clause set is saturated - no new clauses can be derived");
         result.iterations = iterations;
         result.time_elapsed_ms = elapsed_ms;
-        result.final_clauses = clause_set.clauses();
+        retain_final_clauses(result, clause_set);
+        return result;
+    }
+
+    ResolutionProofResult ResolutionProver::prove_by_datalog(const std::vector<ClausePtr> &clauses) const
+    {
+        DatalogEngine engine(clauses);
+        auto evaluation = engine.evaluate(config_.max_clauses, config_.max_time_ms);
+
+        ResolutionProofResult result(ResolutionProofResult::Status::UNKNOWN);
+        switch (evaluation.status)
+        {
+        case DatalogResult::Status::REFUTED:
+            result = ResolutionProofResult(ResolutionProofResult::Status::PROVED,
+                                           "Goal holds in the least model - theorem proved by Datalog evaluation");
+            break;
+        case DatalogResult::Status::SATURATED:
+            result = ResolutionProofResult(ResolutionProofResult::Status::SATURATED,
+                                           "Least model computed by Datalog evaluation - no goal holds");
+            break;
+        case DatalogResult::Status::LIMIT:
+            result = ResolutionProofResult(ResolutionProofResult::Status::TIMEOUT,
+                                           evaluation.elapsed_time_ms >= config_.max_time_ms
+                                               ? "Time limit exceeded"
+                                               : "Maximum clauses exceeded");
+            break;
+        }
+        result.iterations = evaluation.rounds;
+        result.time_elapsed_ms = evaluation.elapsed_time_ms;
+
+        // The final clauses are the model's facts plus the rules and goals
+        std::vector<ClausePtr> rules;
+        for (const auto &clause : clauses)
+        {
+            if (clause->size() > 1 || clause->literals()[0].is_negative())
+            {
+                rules.push_back(clause);
+            }
+        }
+        result.final_clause_count = evaluation.facts + rules.size();
+        if (config_.clause_retention != ResolutionConfig::ClauseRetention::NONE)
+        {
+            std::vector<ClausePtr> final_clauses = engine.facts();
+            final_clauses.insert(final_clauses.end(), rules.begin(), rules.end());
+            if (config_.clause_retention == ResolutionConfig::ClauseRetention::SUMMARY)
+            {
+                result.set_final_clause_stats(resolution_utils::analyze_clause_set(final_clauses));
+            }
+            else
+            {
+                result.final_clauses = std::move(final_clauses);
+            }
+        }
+        return result;
+    }
+
+    ResolutionProofResult ResolutionProver::prove_by_unit_equality(const std::vector<ClausePtr> &clauses) const
+    {
+        UnitEqualityProver prover(clauses);
+        auto completion = prover.run(config_.max_clauses, config_.max_time_ms);
+
+        ResolutionProofResult result(ResolutionProofResult::Status::UNKNOWN);
+        switch (completion.status)
+        {
+        case UnitEqualityResult::Status::PROVED:
+            result = ResolutionProofResult(ResolutionProofResult::Status::PROVED,
+                                           "Goal sides rewrite to the same term - theorem proved by ordered completion");
+            break;
+        case UnitEqualityResult::Status::SATURATED:
+            result = ResolutionProofResult(ResolutionProofResult::Status::SATURATED,
+                                           "Ordered completion saturated - no goal is joinable");
+            break;
+        case UnitEqualityResult::Status::LIMIT:
+            result = ResolutionProofResult(ResolutionProofResult::Status::TIMEOUT,
+                                           completion.elapsed_time_ms >= config_.max_time_ms
+                                               ? "Time limit exceeded"
+                                               : "Maximum clauses exceeded");
+            break;
+        }
+        result.iterations = completion.iterations;
+        result.time_elapsed_ms = completion.elapsed_time_ms;
+
+        // The final clauses are the active equations plus the goals
+        auto equations = prover.active_equations();
+        std::size_t goals = std::count_if(clauses.begin(), clauses.end(), [](const ClausePtr &clause)
+                                          { return clause->literals()[0].is_negative(); });
+        result.final_clause_count = equations.size() + goals;
+        if (config_.clause_retention != ResolutionConfig::ClauseRetention::NONE)
+        {
+            std::vector<ClausePtr> final_clauses;
+            for (const auto &equation : equations)
+            {
+                final_clauses.push_back(std::make_shared<Clause>(std::vector<Literal>{
+                    Literal(make_function_application("=", {equation.lhs(), equation.rhs()}), true)}));
+            }
+            for (const auto &clause : clauses)
+            {
+                if (clause->literals()[0].is_negative())
+                {
+                    final_clauses.push_back(clause);
+                }
+            }
+            if (config_.clause_retention == ResolutionConfig::ClauseRetention::SUMMARY)
+            {
+                result.set_final_clause_stats(resolution_utils::analyze_clause_set(final_clauses));
+            }
+            else
+            {
+                result.final_clauses = std::move(final_clauses);
+            }
+        }
+        return result;
+    }
+
+    ResolutionProofResult ResolutionProver::prove_by_model_finding(const std::vector<ClausePtr> &clauses) const
+    {
+        ModelFinder finder(clauses);
+        auto search = finder.find(config_.model_finder_max_domain,
+                                  std::min(config_.model_finder_timeout * 1000.0, config_.max_time_ms));
+
+        if (search.status != ModelFinderResult::Status::FOUND)
+        {
+            return ResolutionProofResult(ResolutionProofResult::Status::UNKNOWN,
+                                         "No finite model with at most " + std::to_string(search.domain_size) +
+                                             " elements");
+        }
+
+        ResolutionProofResult result(ResolutionProofResult::Status::DISPROVED,
+                                     "Finite model with " + std::to_string(search.domain_size) +
+                                         " elements satisfies the clauses - theorem is false");
+        result.iterations = search.domain_size;
+        result.time_elapsed_ms = search.elapsed_time_ms;
+        result.countermodel = search.model;
+
+        // Nothing is derived; the final clauses are the input
+        result.final_clause_count = clauses.size();
+        if (config_.clause_retention == ResolutionConfig::ClauseRetention::SUMMARY)
+        {
+            result.set_final_clause_stats(resolution_utils::analyze_clause_set(clauses));
+        }
+        else if (config_.clause_retention == ResolutionConfig::ClauseRetention::FULL)
+        {
+            result.final_clauses = clauses;
+        }
         return result;
     }
 
-    std::vector<ClausePtr> ResolutionProver::resolve_clauses(ClausePtr clause1, ClausePtr clause2)
+    void ResolutionProver::retain_final_clauses(ResolutionProofResult &result, ClauseSet &clause_set) const
+    {
+        result.final_clause_count = clause_set.size();
+
+        switch (config_.clause_retention)
+        {
+        case ResolutionConfig::ClauseRetention::NONE:
+            break;
+
+        case ResolutionConfig::ClauseRetention::SUMMARY:
+            // One pass over the store; no shared_ptr copies
+            result.set_final_clause_stats(resolution_utils::analyze_clause_set(clause_set.clauses()));
+            break;
+
+        case ResolutionConfig::ClauseRetention::FULL:
+            // The clause set is discarded after the loop, so hand over its storage
+            result.final_clauses = clause_set.release_clauses();
+            break;
+        }
+    }
+
+    std::vector<ClausePtr> ResolutionProver::hyperresolvents(const ClausePtr &selected,
+                                                             const ClauseSet &clause_set) const
+    {
+        std::vector<ClausePtr> conclusions;
+        if (!is_positive_clause(selected))
+        {
+            // As nucleus: every negative literal against a positive clause
+            ClashSearch(clause_set, selected, is_positive_clause).run(negative_positions(selected), conclusions);
+            return conclusions;
+        }
+
+        // As electron: for each nucleus it clashes with, fix it at that
+        // literal and find electrons for the other negative literals
+        const auto &signatures = selected->signatures();
+        for (std::size_t i = 0; i < signatures.size(); ++i)
+        {
+            for (const auto &entry : clause_set.resolution_candidates(signatures[i]))
+            {
+                if (clause_set.is_removed(entry.clause))
+                {
+                    continue;
+                }
+                ClashSearch search(clause_set, entry.clause, is_positive_clause);
+                search.fix(entry.literal, selected, i);
+                search.run(negative_positions(entry.clause), conclusions);
+            }
+        }
+        return conclusions;
+    }
+
+    std::vector<ClausePtr> ResolutionProver::ur_resolvents(const ClausePtr &selected,
+                                                           const ClauseSet &clause_set) const
     {
-        std::vector<ClausePtr> resolvents;
+        std::vector<ClausePtr> conclusions;
 
-        auto resolution_result = ResolutionInference::resolve(clause1, clause2);
-        if (resolution_result.success)
+        // As nucleus: every literal but one against a unit clause
+        for (std::size_t kept = 0; kept < selected->size(); ++kept)
+        {
+            ClashSearch(clause_set, selected, is_unit_clause).run(positions_except(selected, kept), conclusions);
+            if (selected->is_unit())
+            {
+                break;
+            }
+        }
+        if (!selected->is_unit())
         {
-            resolvents.push_back(resolution_result.resolvent);
+            return conclusions;
         }
 
-        return resolvents;
+        // As electron: fixed at each nucleus literal it clashes with, while
+        // the other literals but one find units of their own
+        for (const auto &entry : clause_set.resolution_candidates(selected->signatures()[0]))
+        {
+            if (clause_set.is_removed(entry.clause))
+            {
+                continue;
+            }
+            for (std::size_t kept = 0; kept < entry.clause->size(); ++kept)
+            {
+                if (kept == entry.literal && !entry.clause->is_unit())
+                {
+                    continue;
+                }
+                ClashSearch search(clause_set, entry.clause, is_unit_clause);
+                search.fix(entry.literal, selected, 0);
+                search.run(positions_except(entry.clause, kept), conclusions);
+                if (entry.clause->is_unit())
+                {
+                    break;
+                }
+            }
+        }
+        return conclusions;
     }
 
-    ClausePtr ResolutionProver::factor_clause(ClausePtr clause)
+    std::vector<ClausePtr> ResolutionProver::factor_clause(ClausePtr clause)
     {
-        return ResolutionInference::factor(clause);
+        return ResolutionInference::factors(clause);
     }
 
     bool ResolutionProver::should_terminate(size_t iterations, double elapsed_ms, size_t clause_count) const
     {
         return iterations >= config_.max_iterations ||
                elapsed_ms >= config_.max_time_ms ||
-               clause_count >= config_.max_clauses;
+               clause_count >= config_.max_clauses ||
+               (config_.stop && config_.stop->load(std::memory_order_relaxed));
     }
 
     std::vector<TermDBPtr> ResolutionProver::setup_refutation_problem(const TermDBPtr &goal,
@@ -659,21 +1833,49 @@ namespace theorem_prover
         kb_config.max_rules = config_.kb_max_rules;
         kb_config.verbose = false; // Keep quiet during preprocessing
 
-        // Create term ordering and run KB completion
-        auto ordering = std::make_shared<LexicographicPathOrdering>();
-        KnuthBendixCompletion kb(ordering, kb_config);
+        // Problems over the same theory complete the same equations, so
+        // the result is looked up before running completion
+        std::string cache_key = CompletionCache::key(equations, "lpo", kb_config);
+        std::optional<KBResult> cached;
+        if (config_.use_kb_cache)
+        {
+            cached = CompletionCache::shared().find(cache_key, config_.kb_cache_directory);
+        }
+
+        KBResult result;
+        if (cached)
+        {
+            result = *cached;
+        }
+        else
+        {
+            // Create term ordering and run KB completion
+            auto ordering = std::make_shared<LexicographicPathOrdering>();
+            KnuthBendixCompletion kb(ordering, kb_config);
 
-        auto result = kb.complete(equations);
+            result = kb.complete(equations);
+            if (config_.use_kb_cache)
+            {
+                // Running out of time before the iteration limit depends on
+                // the machine's load, so such results are not kept on disk
+                bool out_of_time = result.status == KBResult::Status::TIMEOUT &&
+                                   result.iterations < kb_config.max_iterations;
+                CompletionCache::shared().store(cache_key, result,
+                                                out_of_time ? "" : config_.kb_cache_directory);
+            }
+        }
 
         if (result.status == KBResult::Status::SUCCESS && !result.final_rules.empty())
         {
             // KB succeeded - integrate rules back into clause set
-            auto original_clauses = clauses; // Save original for debugging
+            std::size_t original_count = clauses.size();
             clauses = integrate_kb_rules(clauses, result.final_rules);
 
-            // Simple debug output
-            std::cout << "KB Debug: " << original_clauses.size() << " -> " << clauses.size()
-                      << " clauses, " << result.final_rules.size() << " KB rules" << std::endl;
+            if (config_.kb_config.verbose)
+            {
+                std::cout << "KB Debug: " << original_count << " -> " << clauses.size()
+                          << " clauses, " << result.final_rules.size() << " KB rules" << std::endl;
+            }
         }
 
         return result;
@@ -705,9 +1907,13 @@ namespace theorem_prover
                                                                 const std::vector<TermRewriteRule> &kb_rules)
     {
         std::vector<ClausePtr> updated_clauses;
+        bool verbose = config_.kb_config.verbose;
 
-        std::cout << "  Integration Debug:" << std::endl;
-        std::cout << "    Original clauses: " << original_clauses.size() << std::endl;
+        if (verbose)
+        {
+            std::cout << "  Integration Debug:" << std::endl;
+            std::cout << "    Original clauses: " << original_clauses.size() << std::endl;
+        }
 
         // Add non-equality clauses unchanged
         size_t non_equality_count = 0;
@@ -718,30 +1924,39 @@ namespace theorem_prover
                 updated_clauses.push_back(clause);
                 non_equality_count++;
             }
-            else
+            else if (verbose)
             {
                 std::cout << "    Removing equality clause: " << clause->to_string() << std::endl;
             }
         }
-        std::cout << "    Non-equality clauses kept: " << non_equality_count << std::endl;
+        if (verbose)
+        {
+            std::cout << "    Non-equality clauses kept: " << non_equality_count << std::endl;
+            std::cout << "    KB rules to convert: " << kb_rules.size() << std::endl;
+        }
 
         // Convert KB rules to clauses and add them
-        std::cout << "    KB rules to convert: " << kb_rules.size() << std::endl;
         for (const auto &rule : kb_rules)
         {
             auto rule_clause = rule_to_clause(rule);
             if (rule_clause)
             {
                 updated_clauses.push_back(rule_clause);
-                std::cout << "    Added rule as clause: " << rule_clause->to_string() << std::endl;
+                if (verbose)
+                {
+                    std::cout << "    Added rule as clause: " << rule_clause->to_string() << std::endl;
+                }
             }
-            else
+            else if (verbose)
             {
                 std::cout << "    Failed to convert rule: " << rule.to_string() << std::endl;
             }
         }
 
-        std::cout << "    Final clause count: " << updated_clauses.size() << std::endl;
+        if (verbose)
+        {
+            std::cout << "    Final clause count: " << updated_clauses.size() << std::endl;
+        }
         return updated_clauses;
     }
 
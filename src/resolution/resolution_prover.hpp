@@ -4,16 +4,38 @@
 #include "cnf_converter.hpp"
 #include "../term/term_db.hpp"
 #include "../completion/knuth_bendix.hpp"
+#include "../model/model_finder.hpp"
 #include "indexing.hpp"
+#include "../term/term_io.hpp"
+#include <atomic>
 #include <vector>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include <queue>
 #include <functional>
+#include <optional>
 
 namespace theorem_prover
 {
 
+    struct SearchTrace;
+
+    namespace resolution_utils
+    {
+        /**
+         * Summary statistics about a clause set
+         */
+        struct ClauseSetStats
+        {
+            size_t total_clauses;
+            size_t unit_clauses;
+            size_t horn_clauses;
+            size_t max_clause_size;
+            double avg_clause_size;
+        };
+    }
+
     /**
      * Result of a resolution proof attempt
      */
@@ -30,18 +52,41 @@ namespace theorem_prover
 
         Status status;
         std::vector<ClausePtr> proof_clauses; // Clauses used in the proof
-        std::vector<ClausePtr> final_clauses; // All clauses at termination
+        std::vector<ClausePtr> final_clauses; // All clauses at termination (FULL retention only)
+        size_t final_clause_count;            // Size of the clause set at termination
         std::string explanation;
         size_t iterations;
         double time_elapsed_ms;
+        std::string strategy;                      // Strategy that produced the result, in auto mode
+        std::shared_ptr<FiniteModel> countermodel; // Model of the clauses, when disproved by model finding
 
         ResolutionProofResult(Status status, const std::string &explanation = "")
-            : status(status), explanation(explanation), iterations(0), time_elapsed_ms(0.0) {}
+            : status(status), final_clause_count(0), explanation(explanation),
+              iterations(0), time_elapsed_ms(0.0) {}
 
         bool is_proved() const { return status == Status::PROVED; }
         bool is_disproved() const { return status == Status::DISPROVED; }
         bool is_timeout() const { return status == Status::TIMEOUT; }
         bool is_conclusive() const { return is_proved() || is_disproved(); }
+
+        /**
+         * Statistics of the clause set at termination
+         *
+         * Computed on first use from final_clauses under FULL retention,
+         * precomputed under SUMMARY retention, empty under NONE.
+         */
+        const resolution_utils::ClauseSetStats &final_clause_stats() const;
+
+        /**
+         * Record precomputed statistics (used for SUMMARY retention)
+         */
+        void set_final_clause_stats(const resolution_utils::ClauseSetStats &stats)
+        {
+            final_stats_ = stats;
+        }
+
+    private:
+        mutable std::optional<resolution_utils::ClauseSetStats> final_stats_;
     };
 
     /**
@@ -53,17 +98,42 @@ namespace theorem_prover
         double max_time_ms = 30000.0; // 30 seconds
         size_t max_clauses = 100000;
         bool use_subsumption = true;
+        bool use_unit_deletion = true;          // Cut literals whose complement is an instance of a unit clause
+        bool use_subsumption_resolution = true; // Cut literals by subsumption resolution with non-unit clauses
         bool use_tautology_deletion = true;
         bool use_factoring = true;
+        bool use_condensation = true; // Replace clauses by their smallest subsuming factor
         bool use_paramodulation = false;
+        bool use_set_of_support = false; // No inferences between two clauses outside the negated goal's descendants
+        bool use_datalog = true;         // Evaluate function-free Horn clause sets bottom-up instead (without paramodulation)
+        bool use_unit_equality = true;   // Run unit equality problems through ordered completion instead (with paramodulation)
+        bool use_model_finder = false;   // Look for a finite model of the clauses before the loop
+        size_t model_finder_max_domain = 6;  // Largest domain size tried
+        double model_finder_timeout = 2.0;   // Max time for the model search (seconds)
+        bool use_auto_strategy = false;      // Choose and time-slice strategies by problem features (StrategyScheduler)
+        size_t auto_strategy_threads = 1;    // Strategies run at once in auto mode
+        const std::atomic<bool> *stop = nullptr; // Ends the search once set, e.g. by another strategy that finished
+        std::string trace_file;                  // Record the run here for replay (SearchTrace) when set
+        std::string checkpoint_file;             // Save the loop state here periodically, and when a limit ends the search
+        double checkpoint_interval_ms = 60000.0; // Time between checkpoints
         // NEW: KB preprocessing options
         bool use_kb_preprocessing = false;
         double kb_preprocessing_timeout = 5.0; // Max time for KB attempt (seconds)
         size_t kb_max_rules = 50;              // Max rules to accept from KB
         size_t kb_max_equations = 20;          // Max equations to send to KB
+        bool use_kb_cache = true;              // Reuse completions of the same equations (CompletionCache::shared)
+        std::string kb_cache_directory;        // Also keep completions in files here, across processes, when set
 
         KBConfig kb_config; // Full KB configuration
 
+        // What to keep of the clause set in ResolutionProofResult
+        enum class ClauseRetention
+        {
+            NONE,    // Only the final clause count
+            SUMMARY, // Count plus clause set statistics
+            FULL     // The whole clause store, moved into final_clauses
+        } clause_retention = ClauseRetention::FULL;
+
         // Clause selection strategy
         enum class SelectionStrategy
         {
@@ -72,6 +142,14 @@ namespace theorem_prover
             UNIT_PREFERENCE,   // Prefer unit clauses
             NEGATIVE_SELECTION // Prefer clauses with negative literals
         } selection_strategy = SelectionStrategy::UNIT_PREFERENCE;
+
+        // Inference rule applied to the selected clause (without paramodulation)
+        enum class InferenceRule
+        {
+            BINARY,          // Binary resolution
+            HYPERRESOLUTION, // Positive hyperresolution: every negative literal of a nucleus at once
+            UR_RESOLUTION    // Unit-resulting resolution: all literals but one against unit clauses
+        } inference_rule = InferenceRule::BINARY;
     };
 
     /**
@@ -82,8 +160,10 @@ namespace theorem_prover
     public:
         ClauseSet(const ResolutionConfig &config);
 
-        // Add a clause to the set
-        void add_clause(ClausePtr clause);
+        // Add a clause to the set, simplifying it against the stored clauses
+        // and the stored clauses against it. Only clauses in the set of
+        // support are queued for selection; the others serve as partners.
+        void add_clause(ClausePtr clause, bool supported = true);
 
         // Check if set contains empty clause
         bool contains_empty_clause() const;
@@ -94,6 +174,25 @@ namespace theorem_prover
         // Get all clauses
         const std::vector<ClausePtr> &clauses() const { return clauses_; }
 
+        // Stored clause with the given id, or nullptr once it was removed
+        ClausePtr clause(ClauseId id) const;
+
+        // Check if a clause taken from the set has been removed since
+        bool is_removed(const ClausePtr &clause) const;
+
+        // Check if a stored clause is in the set of support
+        bool is_supported(const ClausePtr &clause) const;
+
+        // Free the clauses removed since the last call, as one batch, and
+        // compact the indexes once they hold more removed entries than live ones
+        void reclaim();
+
+        // Pool the set allocates its clauses from
+        ClausePool *pool() const { return pool_.get(); }
+
+        // Move the clause store out and reset the set
+        std::vector<ClausePtr> release_clauses();
+
         // Check if no more clauses to process
         bool is_empty() const;
 
@@ -103,24 +202,87 @@ namespace theorem_prover
         // Clear all clauses
         void clear();
 
+        // Write the stored clauses with their ids and support, the store
+        // order and the queue
+        void save(BinaryWriter &out, TermWriter &terms) const;
+
+        // Replace the contents by a state written by save(). The indexes are
+        // rebuilt in id order, which is the order they were filled in, so
+        // the search goes on as it would have in the saved set.
+        void restore(BinaryReader &in, TermReader &terms);
+
         std::vector<ClausePtr> get_resolution_candidates(const Literal &literal);
 
+        // Index entries with a literal complementary to the one with this
+        // signature, without copying; removed clauses are not filtered out
+        LiteralIndex::CandidateRange resolution_candidates(const Clause::LiteralSignature &signature) const
+        {
+            return literal_index_.resolution_candidates(signature);
+        }
+
     private:
+        ClausePool::Handle pool_;
         std::vector<ClausePtr> clauses_;
-        std::queue<ClausePtr> processing_queue_;
-        std::unordered_set<size_t> clause_hashes_; // For duplicate detection
+        std::vector<Clause::ClauseSignature> signatures_; // Parallel to clauses_, for subsumption prefiltering
+        std::vector<ClausePtr> slots_;       // Stored clauses by id; null once removed
+        std::vector<std::size_t> positions_; // Position in clauses_ by id
+        std::vector<bool> supported_;        // Set of support membership by id
+        std::vector<ClausePtr> retired_; // Removed clauses awaiting reclaim()
+        mutable std::queue<ClauseId> processing_queue_;
+        std::unordered_multimap<size_t, ClausePtr> variant_index_; // Clauses by variant hash, for duplicate detection
         ResolutionConfig config_;
-        size_t next_clause_index_;
         LiteralIndex literal_index_;
+        std::unordered_map<size_t, std::vector<ClauseId>> unit_index_; // Unit clauses by literal head, for unit deletion
+        bool has_empty_clause_ = false;
+        std::size_t tombstones_ = 0; // Removed clauses still in the indexes and queue
 
-        // Check if clause is subsumed by existing clauses
-        bool is_subsumed(ClausePtr clause) const;
+        // Drop the entries of removed clauses from the literal and unit
+        // indexes and the queue
+        void compact();
 
-        // Remove clauses subsumed by the new clause
-        void remove_subsumed_clauses(ClausePtr clause);
+        // Pop the ids of removed clauses off the front of the queue
+        void skip_removed() const;
+
+        // The form a clause is stored in: condensed, without duplicate
+        // literals, variables renumbered
+        ClausePtr normalize(const Clause &clause) const;
+
+        // A clause waiting to be added, with its set of support membership
+        using PendingClause = std::pair<ClausePtr, bool>;
+
+        // Add one clause; clauses shortened by it are queued on pending
+        void insert_clause(ClausePtr clause, bool supported, std::vector<PendingClause> &pending);
+
+        // Apply unit deletion and subsumption resolution until neither
+        // applies; a clause shortened by a supported clause becomes supported
+        ClausePtr simplify_forward(ClausePtr clause, bool &supported);
+
+        // Remove the clauses the new clause shortens, queuing their shortened forms
+        void simplify_backward(const ClausePtr &clause, std::vector<PendingClause> &pending);
+
+        // Put a stored clause into the set of support and queue it, when a
+        // supported clause it subsumes or duplicates is dropped in its favour
+        void support(const ClausePtr &clause);
+
+        // Remove a stored clause in O(1): it leaves the store and the variant
+        // index, and becomes a tombstone in the literal and unit indexes and the
+        // queue until the next compaction
+        void detach_clause(ClausePtr clause);
+
+        // A stored clause subsuming the given one, or nullptr
+        ClausePtr find_subsumer(const ClausePtr &clause) const;
+
+        // Remove clauses subsumed by the new clause; true if one was supported
+        bool remove_subsumed_clauses(ClausePtr clause);
 
         // Check if two clauses are variants (same up to variable renaming)
         bool are_variants(ClausePtr clause1, ClausePtr clause2) const;
+
+        // A stored variant of the clause, or nullptr
+        ClausePtr find_variant(const ClausePtr &clause) const;
+
+        // Drop a clause from the variant index
+        void erase_variant(const ClausePtr &clause);
     };
 
     /**
@@ -157,23 +319,122 @@ namespace theorem_prover
          */
         ResolutionProofResult prove_from_clauses(const std::vector<ClausePtr> &clauses);
 
+        /**
+         * Prove from axioms and a set of support, e.g. the negated goal
+         *
+         * With use_set_of_support, every inference has a parent in the set
+         * of support or derived from it; this is complete when the axioms
+         * are satisfiable. Otherwise the two are simply joined.
+         *
+         * @param axioms Clauses not in the set of support
+         * @param support Clauses in the set of support
+         * @return ResolutionProofResult
+         */
+        ResolutionProofResult prove_from_clauses(const std::vector<ClausePtr> &axioms,
+                                                 const std::vector<ClausePtr> &support);
+
+        /**
+         * Refute a clause set, applying the configured preprocessing
+         * (KB completion) before the resolution loop, exactly as prove() does
+         *
+         * @param clauses The clause set, e.g. hypotheses plus negated goal in CNF
+         * @return ResolutionProofResult; PROVED means the set is unsatisfiable
+         */
+        ResolutionProofResult refute(std::vector<ClausePtr> clauses);
+
+        /**
+         * Refute axioms plus a set of support; see prove_from_clauses
+         */
+        ResolutionProofResult refute(std::vector<ClausePtr> axioms, std::vector<ClausePtr> support);
+
+        /**
+         * Repeat a recorded run: the loop takes each given clause from the
+         * trace instead of the selection strategy, with the time and
+         * iteration limits lifted, and stops where the recording stopped
+         *
+         * @param trace A trace recorded through ResolutionConfig::trace_file
+         * @return The recorded outcome, reached again; UNKNOWN if the run
+         *         diverged from the trace
+         */
+        static ResolutionProofResult replay(const SearchTrace &trace);
+
+        /**
+         * Continue a search from a checkpoint written through
+         * ResolutionConfig::checkpoint_file
+         *
+         * The search settings are those of the checkpointed run; the limits,
+         * clause retention, stop flag and checkpoint settings are this
+         * prover's. Iterations and time spent before the checkpoint count
+         * towards the limits, and the search continues exactly as it would
+         * have without the interruption.
+         *
+         * @param checkpoint_file A checkpoint; SerializationError if it cannot be read
+         * @return ResolutionProofResult of the whole search
+         */
+        ResolutionProofResult resume(const std::string &checkpoint_file);
+
     private:
         ResolutionConfig config_;
+        SearchTrace *recording_ = nullptr;       // Trace being recorded, during prove_from_clauses
+        const SearchTrace *replaying_ = nullptr; // Trace being replayed, during replay
+
+        /**
+         * prove_from_clauses without recording
+         */
+        ResolutionProofResult search(const std::vector<ClausePtr> &axioms, const std::vector<ClausePtr> &support);
 
         /**
-         * Main resolution loop
+         * Main resolution loop, from the given iteration and elapsed time
          */
-        ResolutionProofResult resolution_loop(ClauseSet &clause_set);
+        ResolutionProofResult resolution_loop(ClauseSet &clause_set, size_t iterations = 0,
+                                              double elapsed_before_ms = 0.0);
 
         /**
-         * Apply resolution between two clauses and return all resolvents
+         * Write the loop state to config_.checkpoint_file; a failure is reported, not raised
          */
-        std::vector<ClausePtr> resolve_clauses(ClausePtr clause1, ClausePtr clause2);
+        void save_checkpoint(const ClauseSet &clause_set, size_t iterations, double elapsed_ms) const;
 
         /**
-         * Apply factoring to a clause
+         * Decide a Datalog clause set by computing its least model
          */
-        ClausePtr factor_clause(ClausePtr clause);
+        ResolutionProofResult prove_by_datalog(const std::vector<ClausePtr> &clauses) const;
+
+        /**
+         * Decide a unit equality problem by ordered completion and goal rewriting
+         */
+        ResolutionProofResult prove_by_unit_equality(const std::vector<ClausePtr> &clauses) const;
+
+        /**
+         * Search for a finite model of the clauses; DISPROVED if one is found
+         */
+        ResolutionProofResult prove_by_model_finding(const std::vector<ClausePtr> &clauses) const;
+
+        /**
+         * Fill in the final clause information according to config_.clause_retention
+         */
+        void retain_final_clauses(ResolutionProofResult &result, ClauseSet &clause_set) const;
+
+        /**
+         * Positive hyperresolvents with the selected clause as nucleus or as
+         * electron. The negative literals of a nucleus are resolved away
+         * simultaneously against positive clauses found through the literal
+         * index, leaving a positive clause; no intermediate clause is built.
+         * Complete together with factoring.
+         */
+        std::vector<ClausePtr> hyperresolvents(const ClausePtr &selected, const ClauseSet &clause_set) const;
+
+        /**
+         * Unit-resulting resolvents with the selected clause as nucleus or as
+         * electron: all literals of a nucleus but one are resolved away
+         * simultaneously against unit clauses, leaving a unit clause, or the
+         * empty clause from a unit nucleus. Not refutation complete.
+         */
+        std::vector<ClausePtr> ur_resolvents(const ClausePtr &selected, const ClauseSet &clause_set) const;
+
+        /**
+         * All factors of a clause
+         */
+        std::vector<ClausePtr> factor_clause(ClausePtr clause);
 
         /**
          * Check if search should terminate due to limits
@@ -247,15 +508,6 @@ namespace theorem_prover
         /**
          * Generate statistics about a clause set
          */
-        struct ClauseSetStats
-        {
-            size_t total_clauses;
-            size_t unit_clauses;
-            size_t horn_clauses;
-            size_t max_clause_size;
-            double avg_clause_size;
-        };
-
         ClauseSetStats analyze_clause_set(const std::vector<ClausePtr> &clauses);
     }
 
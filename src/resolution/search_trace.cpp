@@ -0,0 +1,76 @@
+#include "search_trace.hpp"
+#include "clause_io.hpp"
+
+namespace theorem_prover
+{
+
+    namespace
+    {
+        const char trace_magic[] = "TPTRACE1";
+
+        // Signed differences as unsigned varints: 0, -1, 1, -2, ...
+        std::uint64_t zigzag(std::int64_t value)
+        {
+            return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+        }
+
+        std::int64_t unzigzag(std::uint64_t value)
+        {
+            return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+        }
+    }
+
+    void SearchTrace::save(const std::string &path) const
+    {
+        BinaryWriter out;
+        out.write_string(trace_magic);
+        clause_io::write_config(out, config);
+        TermWriter terms(out);
+        clause_io::write_clauses(out, terms, axioms);
+        clause_io::write_clauses(out, terms, support);
+        out.write_varint(static_cast<std::uint64_t>(status));
+        out.write_varint(selections.size());
+        std::int64_t previous = 0;
+        for (ClauseId id : selections)
+        {
+            out.write_varint(zigzag(static_cast<std::int64_t>(id) - previous));
+            previous = id;
+        }
+        write_binary_file(path, out.data());
+    }
+
+    SearchTrace SearchTrace::load(const std::string &path)
+    {
+        std::string data = read_binary_file(path);
+        BinaryReader in(data);
+        if (in.read_string() != trace_magic)
+        {
+            throw SerializationError(path + ": not a search trace");
+        }
+
+        SearchTrace trace;
+        trace.config = clause_io::read_config(in);
+        TermReader terms(in);
+        trace.axioms = clause_io::read_clauses(in, terms);
+        trace.support = clause_io::read_clauses(in, terms);
+        std::uint64_t status = in.read_varint();
+        if (status > static_cast<std::uint64_t>(ResolutionProofResult::Status::UNKNOWN))
+        {
+            throw SerializationError(path + ": invalid proof status");
+        }
+        trace.status = static_cast<ResolutionProofResult::Status>(status);
+        trace.selections.resize(in.read_count());
+        std::int64_t previous = 0;
+        for (auto &id : trace.selections)
+        {
+            previous += unzigzag(in.read_varint());
+            id = static_cast<ClauseId>(previous);
+        }
+        if (!in.at_end())
+        {
+            throw SerializationError(path + ": trailing data after the trace");
+        }
+        return trace;
+    }
+
+} // namespace theorem_prover
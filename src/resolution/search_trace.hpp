@@ -0,0 +1,42 @@
+#pragma once
+
+#include "resolution_prover.hpp"
+#include "../utils/binary_io.hpp"
+#include <string>
+#include <vector>
+
+namespace theorem_prover
+{
+
+    /**
+     * Recording of one run of the given-clause loop
+     *
+     * Holds the clauses the run started from, its configuration, and the id
+     * of every clause it selected, in order. Since everything else the loop
+     * does follows from these, ResolutionProver::replay repeats the run
+     * exactly, which makes a slow search reproducible for profiling and
+     * lets two builds be timed on the same sequence of inferences.
+     * Recorded when ResolutionConfig::trace_file is set.
+     */
+    struct SearchTrace
+    {
+        ResolutionConfig config;
+        std::vector<ClausePtr> axioms;
+        std::vector<ClausePtr> support;
+        std::vector<ClauseId> selections; // Ids of the given clauses, in order
+        ResolutionProofResult::Status status = ResolutionProofResult::Status::UNKNOWN; // Outcome of the run
+
+        /**
+         * Write the trace in its binary format; selections are stored as
+         * differences from the previous id, so most take one byte.
+         * Raises SerializationError if the file cannot be written.
+         */
+        void save(const std::string &path) const;
+
+        /**
+         * Read a trace written by save(); raises SerializationError
+         */
+        static SearchTrace load(const std::string &path);
+    };
+
+} // namespace theorem_prover
@@ -0,0 +1,388 @@
+#include "strategy.hpp"
+#include "../completion/unit_equality.hpp"
+#include "../datalog/datalog_engine.hpp"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <thread>
+
+namespace theorem_prover
+{
+
+    namespace
+    {
+        using Symbol = std::pair<std::string, std::size_t>;
+
+        struct SymbolSets
+        {
+            std::set<Symbol> predicates;
+            std::set<Symbol> functions;
+            std::set<std::string> constants;
+        };
+
+        // Depth of a term, collecting its symbols; false in ground if it has a variable
+        std::size_t term_depth(const TermDBPtr &term, SymbolSets &symbols, bool &ground)
+        {
+            switch (term->kind())
+            {
+            case TermDB::TermKind::VARIABLE:
+                ground = false;
+                return 1;
+            case TermDB::TermKind::CONSTANT:
+                symbols.constants.insert(std::static_pointer_cast<ConstantDB>(term)->symbol());
+                return 1;
+            case TermDB::TermKind::FUNCTION_APPLICATION:
+            {
+                auto application = std::static_pointer_cast<FunctionApplicationDB>(term);
+                symbols.functions.emplace(application->symbol(), application->arguments().size());
+                std::size_t depth = 0;
+                for (const auto &argument : application->arguments())
+                {
+                    depth = std::max(depth, term_depth(argument, symbols, ground));
+                }
+                return depth + 1;
+            }
+            default:
+                return 1;
+            }
+        }
+
+        double ratio(std::size_t part, std::size_t whole)
+        {
+            return whole == 0 ? 0.0 : static_cast<double>(part) / whole;
+        }
+
+        double elapsed_ms(std::chrono::steady_clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        // A proof or countermodel; a complete strategy's SATURATED as well
+        bool is_final(const ResolutionProofResult &result, const Strategy &strategy)
+        {
+            return result.is_conclusive() ||
+                   (strategy.complete && result.status == ResolutionProofResult::Status::SATURATED);
+        }
+    } // namespace
+
+    ProblemFeatures ProblemFeatures::analyze(const std::vector<ClausePtr> &clauses)
+    {
+        ProblemFeatures features;
+        features.clause_stats = resolution_utils::analyze_clause_set(clauses);
+
+        SymbolSets symbols;
+        std::size_t equalities = 0;
+        std::size_t ground_clauses = 0;
+        for (const auto &clause : clauses)
+        {
+            bool ground = true;
+            for (const auto &literal : clause->literals())
+            {
+                ++features.literals;
+                const auto &atom = literal.atom();
+                std::size_t depth = 0;
+                if (atom->kind() == TermDB::TermKind::CONSTANT)
+                {
+                    symbols.predicates.emplace(std::static_pointer_cast<ConstantDB>(atom)->symbol(), 0);
+                }
+                else if (atom->kind() == TermDB::TermKind::FUNCTION_APPLICATION)
+                {
+                    auto application = std::static_pointer_cast<FunctionApplicationDB>(atom);
+                    if (is_equality(atom))
+                    {
+                        ++equalities;
+                    }
+                    else
+                    {
+                        symbols.predicates.emplace(application->symbol(), application->arguments().size());
+                    }
+                    for (const auto &argument : application->arguments())
+                    {
+                        depth = std::max(depth, term_depth(argument, symbols, ground));
+                    }
+                }
+                features.max_term_depth = std::max(features.max_term_depth, depth);
+            }
+            ground_clauses += ground ? 1 : 0;
+        }
+
+        features.equality_ratio = ratio(equalities, features.literals);
+        features.ground_ratio = ratio(ground_clauses, clauses.size());
+        features.horn_ratio = ratio(features.clause_stats.horn_clauses, clauses.size());
+        features.predicate_symbols = symbols.predicates.size();
+        features.function_symbols = symbols.functions.size();
+        features.constant_symbols = symbols.constants.size();
+        features.datalog = DatalogEngine::is_datalog(clauses);
+        features.unit_equality = UnitEqualityProver::is_unit_equality(clauses);
+        return features;
+    }
+
+    std::string ProblemFeatures::to_string() const
+    {
+        std::ostringstream out;
+        out.precision(2);
+        out << std::fixed << clause_stats.total_clauses << " clauses, " << literals << " literals, equality "
+            << equality_ratio << ", ground " << ground_ratio << ", Horn " << horn_ratio << ", depth "
+            << max_term_depth << ", " << predicate_symbols << " predicates, " << function_symbols
+            << " functions, " << constant_symbols << " constants";
+        if (datalog)
+        {
+            out << ", Datalog";
+        }
+        if (unit_equality)
+        {
+            out << ", unit equality";
+        }
+        return out.str();
+    }
+
+    StrategyScheduler::StrategyScheduler(const ResolutionConfig &base)
+        : base_(base)
+    {
+        base_.use_auto_strategy = false;
+    }
+
+    std::vector<Strategy> StrategyScheduler::schedule(const ProblemFeatures &features) const
+    {
+        std::vector<Strategy> strategies;
+
+        // Strategies differ from the base configuration only in these fields
+        auto add = [&](const std::string &name, double share, bool complete,
+                       const std::function<void(ResolutionConfig &)> &configure)
+        {
+            ResolutionConfig config = base_;
+            config.use_paramodulation = features.has_equality();
+            config.use_datalog = true;
+            config.use_unit_equality = true;
+            config.use_set_of_support = false;
+            config.use_kb_preprocessing = false;
+            config.use_model_finder = false;
+            config.selection_strategy = ResolutionConfig::SelectionStrategy::UNIT_PREFERENCE;
+            config.inference_rule = ResolutionConfig::InferenceRule::BINARY;
+            configure(config);
+            strategies.push_back({name, config, share, complete});
+        };
+
+        // The first strategy opens with a model search over a tenth of the
+        // budget. A ground set without functions, if satisfiable, has a model
+        // no larger than its constants, so the search can settle it
+        bool small_models = features.ground_ratio == 1.0 && features.function_symbols == 0;
+        auto with_model_search = [&](ResolutionConfig &config)
+        {
+            config.use_model_finder = true;
+            config.model_finder_max_domain = small_models ? std::max<std::size_t>(1, features.constant_symbols) : 6;
+            config.model_finder_timeout = base_.max_time_ms * (small_models ? 0.3 : 0.1) / 1000.0;
+        };
+
+        if (features.datalog)
+        {
+            add("datalog", 1.0, true, [](ResolutionConfig &config)
+                { config.use_paramodulation = false; });
+        }
+        else if (features.unit_equality)
+        {
+            add("completion", 1.0, true, with_model_search);
+        }
+        else if (features.has_equality())
+        {
+            add("paramod_sos", 0.4, false, [&](ResolutionConfig &config)
+                {
+                    with_model_search(config);
+                    config.use_set_of_support = true;
+                });
+            add("paramod", 0.4, false, [](ResolutionConfig &) {});
+            add("paramod_smallest", 0.2, false, [](ResolutionConfig &config)
+                { config.selection_strategy = ResolutionConfig::SelectionStrategy::SMALLEST_FIRST; });
+        }
+        else if (features.horn_ratio == 1.0)
+        {
+            add("hyper", 0.4, true, [&](ResolutionConfig &config)
+                {
+                    with_model_search(config);
+                    config.inference_rule = ResolutionConfig::InferenceRule::HYPERRESOLUTION;
+                });
+            add("binary_sos", 0.3, false, [](ResolutionConfig &config)
+                { config.use_set_of_support = true; });
+            add("binary", 0.3, true, [](ResolutionConfig &) {});
+        }
+        else
+        {
+            add("binary_sos", 0.4, false, [&](ResolutionConfig &config)
+                {
+                    with_model_search(config);
+                    config.use_set_of_support = true;
+                });
+            add("binary", 0.4, true, [](ResolutionConfig &) {});
+            add("binary_smallest", 0.2, true, [](ResolutionConfig &config)
+                { config.selection_strategy = ResolutionConfig::SelectionStrategy::SMALLEST_FIRST; });
+        }
+        return strategies;
+    }
+
+    ResolutionProofResult StrategyScheduler::run(const std::vector<ClausePtr> &axioms,
+                                                 const std::vector<ClausePtr> &support) const
+    {
+        std::vector<ClausePtr> all_clauses = axioms;
+        all_clauses.insert(all_clauses.end(), support.begin(), support.end());
+        auto strategies = schedule(ProblemFeatures::analyze(all_clauses));
+
+        if (base_.auto_strategy_threads > 1 && strategies.size() > 1)
+        {
+            return run_parallel(strategies, axioms, support);
+        }
+        return run_sequential(strategies, axioms, support);
+    }
+
+    ResolutionProofResult StrategyScheduler::run_sequential(const std::vector<Strategy> &strategies,
+                                                            const std::vector<ClausePtr> &axioms,
+                                                            const std::vector<ClausePtr> &support) const
+    {
+        auto start = std::chrono::steady_clock::now();
+        ResolutionProofResult result(ResolutionProofResult::Status::TIMEOUT, "Time limit exceeded");
+        std::size_t iterations = 0;
+
+        double shares_left = 0.0;
+        for (const auto &strategy : strategies)
+        {
+            shares_left += strategy.time_share;
+        }
+
+        for (const auto &strategy : strategies)
+        {
+            double remaining = base_.max_time_ms - elapsed_ms(start);
+            if (remaining <= 0.0 || (base_.stop && base_.stop->load()))
+            {
+                break;
+            }
+
+            // Time left unused by earlier strategies is spread over the rest
+            ResolutionConfig config = strategy.config;
+            config.max_time_ms = remaining * std::min(1.0, strategy.time_share / shares_left);
+            shares_left -= strategy.time_share;
+
+            result = ResolutionProver(config).refute(axioms, support);
+            result.strategy = strategy.name;
+            iterations += result.iterations;
+            if (is_final(result, strategy))
+            {
+                break;
+            }
+        }
+
+        result.iterations = iterations;
+        result.time_elapsed_ms = elapsed_ms(start);
+        return result;
+    }
+
+    ResolutionProofResult StrategyScheduler::run_parallel(const std::vector<Strategy> &strategies,
+                                                          const std::vector<ClausePtr> &axioms,
+                                                          const std::vector<ClausePtr> &support) const
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::size_t threads = std::min(base_.auto_strategy_threads, strategies.size());
+
+        // Clauses compute their features lazily, so no two threads may share
+        // one: every strategy gets its own copies, made before any thread starts
+        auto copy = [](const std::vector<ClausePtr> &clauses)
+        {
+            std::vector<ClausePtr> copies;
+            copies.reserve(clauses.size());
+            for (const auto &clause : clauses)
+            {
+                copies.push_back(std::make_shared<Clause>(*clause));
+            }
+            return copies;
+        };
+        std::vector<std::pair<std::vector<ClausePtr>, std::vector<ClausePtr>>> inputs;
+        for (std::size_t i = 0; i < strategies.size(); ++i)
+        {
+            inputs.emplace_back(copy(axioms), copy(support));
+        }
+
+        std::atomic<bool> stop(false);
+        std::atomic<std::size_t> next(0);
+        std::atomic<std::size_t> finished(0);
+        std::mutex mutex;
+        std::vector<std::optional<ResolutionProofResult>> results(strategies.size());
+        std::optional<std::size_t> winner;
+
+        auto worker = [&]()
+        {
+            std::size_t i;
+            while ((i = next++) < strategies.size() && !stop.load())
+            {
+                double remaining = base_.max_time_ms - elapsed_ms(start);
+                if (remaining <= 0.0)
+                {
+                    break;
+                }
+
+                ResolutionConfig config = strategies[i].config;
+                config.max_time_ms = std::min(remaining, base_.max_time_ms * strategies[i].time_share * threads);
+                config.stop = &stop;
+                config.trace_file.clear(); // One file cannot hold concurrent runs
+                auto result = ResolutionProver(config).refute(std::move(inputs[i].first), std::move(inputs[i].second));
+                result.strategy = strategies[i].name;
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (is_final(result, strategies[i]) && !winner)
+                {
+                    winner = i;
+                    stop = true;
+                }
+                results[i] = std::move(result);
+            }
+            ++finished;
+        };
+
+        std::vector<std::thread> pool;
+        for (std::size_t t = 0; t < threads; ++t)
+        {
+            pool.emplace_back(worker);
+        }
+
+        // The strategies watch only the shared flag, so an outside stop is
+        // passed on to it
+        while (base_.stop && finished.load() < threads)
+        {
+            if (base_.stop->load())
+            {
+                stop = true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        for (auto &thread : pool)
+        {
+            thread.join();
+        }
+
+        // The winner, or else the last strategy to have run
+        std::size_t iterations = 0;
+        std::optional<std::size_t> chosen = winner;
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            if (results[i])
+            {
+                iterations += results[i]->iterations;
+                if (!winner)
+                {
+                    chosen = i;
+                }
+            }
+        }
+
+        ResolutionProofResult result(ResolutionProofResult::Status::TIMEOUT, "Time limit exceeded");
+        if (chosen)
+        {
+            result = std::move(*results[*chosen]);
+        }
+        result.iterations = iterations;
+        result.time_elapsed_ms = elapsed_ms(start);
+        return result;
+    }
+
+} // namespace theorem_prover
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "resolution_prover.hpp"
+#include <string>
+#include <vector>
+
+namespace theorem_prover
+{
+
+    /**
+     * Syntactic features of a clause set, used to pick strategies
+     */
+    struct ProblemFeatures
+    {
+        resolution_utils::ClauseSetStats clause_stats{};
+        size_t literals = 0;
+        double equality_ratio = 0.0; // Share of literals over "="
+        double ground_ratio = 0.0;   // Share of clauses without variables
+        double horn_ratio = 0.0;     // Share of clauses with at most one positive literal
+        size_t max_term_depth = 0;   // Of atoms; a constant or variable argument has depth 1
+        size_t predicate_symbols = 0;
+        size_t function_symbols = 0; // Arity above 0
+        size_t constant_symbols = 0;
+        bool datalog = false;       // Decided by DatalogEngine
+        bool unit_equality = false; // Decided by UnitEqualityProver
+
+        static ProblemFeatures analyze(const std::vector<ClausePtr> &clauses);
+
+        bool has_equality() const { return equality_ratio > 0.0; }
+
+        std::string to_string() const;
+    };
+
+    /**
+     * One entry of a schedule: a configuration and its share of the time
+     */
+    struct Strategy
+    {
+        std::string name;
+        ResolutionConfig config;
+        double time_share; // Of the time left when the strategy starts, relative to the shares left
+        bool complete;     // SATURATED means satisfiable, so the schedule can stop there
+    };
+
+    /**
+     * Automatic strategy selection ("auto" mode)
+     *
+     * The clause set is summarized by ProblemFeatures, which select a row of
+     * a fixed schedule table: Datalog programs and unit equality problems
+     * go to their decision procedures, Horn sets favour hyperresolution,
+     * equality problems paramodulation, and most schedules open with a short
+     * finite model search for non-theorems. The strategies then run one
+     * after another, each with its share of the time left, so time a
+     * strategy leaves unused goes to the ones after it. The first proof or
+     * countermodel ends the schedule. With several threads, that many
+     * strategies run at once on copies of the clauses, each with its share
+     * scaled by the thread count, and the first conclusive answer stops the
+     * others. The stop flag of the base configuration ends the whole
+     * schedule.
+     */
+    class StrategyScheduler
+    {
+    public:
+        /**
+         * @param base Limits and clause retention for every strategy; its
+         *        max_time_ms is the budget of the whole schedule
+         */
+        explicit StrategyScheduler(const ResolutionConfig &base);
+
+        /**
+         * The schedule table row for the given features
+         */
+        std::vector<Strategy> schedule(const ProblemFeatures &features) const;
+
+        /**
+         * Run the schedule for the clause set; see ResolutionProver::refute
+         */
+        ResolutionProofResult run(const std::vector<ClausePtr> &axioms, const std::vector<ClausePtr> &support) const;
+
+    private:
+        ResolutionConfig base_;
+
+        ResolutionProofResult run_sequential(const std::vector<Strategy> &strategies,
+                                             const std::vector<ClausePtr> &axioms,
+                                             const std::vector<ClausePtr> &support) const;
+        ResolutionProofResult run_parallel(const std::vector<Strategy> &strategies,
+                                           const std::vector<ClausePtr> &axioms,
+                                           const std::vector<ClausePtr> &support) const;
+    };
+
+} // namespace theorem_prover
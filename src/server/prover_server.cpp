@@ -0,0 +1,696 @@
+#include "prover_server.hpp"
+#include "../completion/completion_cache.hpp"
+#include "../resolution/cnf_converter.hpp"
+#include <cctype>
+#include <iomanip>
+#include <sstream>
+
+namespace theorem_prover
+{
+
+    namespace
+    {
+        std::string json_escape(const std::string &text)
+        {
+            std::ostringstream out;
+            for (unsigned char c : text)
+            {
+                switch (c)
+                {
+                case '"':
+                    out << "\\\"";
+                    break;
+                case '\\':
+                    out << "\\\\";
+                    break;
+                case '\n':
+                    out << "\\n";
+                    break;
+                case '\t':
+                    out << "\\t";
+                    break;
+                default:
+                    if (c < 0x20)
+                    {
+                        out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+                            << std::dec;
+                    }
+                    else
+                    {
+                        out << c;
+                    }
+                }
+            }
+            return out.str();
+        }
+
+        // One response line: a JSON object with the event and the fields
+        // added in order
+        class Response
+        {
+        public:
+            explicit Response(const std::string &event)
+            {
+                out_ << "{\"event\": \"" << event << "\"";
+            }
+
+            Response &add(const std::string &name, const std::string &value)
+            {
+                out_ << ", \"" << name << "\": \"" << json_escape(value) << "\"";
+                return *this;
+            }
+
+            Response &add(const std::string &name, std::size_t value)
+            {
+                out_ << ", \"" << name << "\": " << value;
+                return *this;
+            }
+
+            Response &add(const std::string &name, double value)
+            {
+                out_ << ", \"" << name << "\": " << std::fixed << std::setprecision(3) << value;
+                return *this;
+            }
+
+            std::string str() const { return out_.str() + "}"; }
+
+        private:
+            std::ostringstream out_;
+        };
+
+        std::string error_response(const std::string &id, const std::string &message)
+        {
+            Response response("error");
+            if (!id.empty())
+            {
+                response.add("id", id);
+            }
+            return response.add("message", message).str();
+        }
+
+        std::string status_name(ResolutionProofResult::Status status)
+        {
+            switch (status)
+            {
+            case ResolutionProofResult::Status::PROVED:
+                return "PROVED";
+            case ResolutionProofResult::Status::DISPROVED:
+                return "DISPROVED";
+            case ResolutionProofResult::Status::TIMEOUT:
+                return "TIMEOUT";
+            case ResolutionProofResult::Status::SATURATED:
+                return "SATURATED";
+            default:
+                return "UNKNOWN";
+            }
+        }
+
+        double elapsed_ms(std::chrono::steady_clock::time_point since)
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+        }
+
+        /**
+         * The configuration of a named strategy, as in bench_problems, or
+         * nullopt for an unknown name
+         */
+        std::optional<ResolutionConfig> strategy_config(const std::string &name, const ResolutionConfig &base)
+        {
+            ResolutionConfig config = base;
+            if (name == "auto")
+            {
+                // The pool already runs requests side by side
+                config.use_auto_strategy = true;
+                config.auto_strategy_threads = 1;
+            }
+            else if (name == "basic")
+            {
+                config.use_paramodulation = false;
+            }
+            else if (name == "paramod" || name == "kb" || name == "model")
+            {
+                config.use_paramodulation = true;
+                config.use_kb_preprocessing = name == "kb";
+                config.use_model_finder = name == "model";
+            }
+            else
+            {
+                return std::nullopt;
+            }
+            return config;
+        }
+
+        std::vector<std::string> split_words(const std::string &line)
+        {
+            std::istringstream in(line);
+            std::vector<std::string> words;
+            std::string word;
+            while (in >> word)
+            {
+                words.push_back(word);
+            }
+            return words;
+        }
+
+        std::string trim(const std::string &text)
+        {
+            std::size_t begin = 0;
+            std::size_t end = text.size();
+            while (begin < end && std::isspace(static_cast<unsigned char>(text[begin])))
+            {
+                ++begin;
+            }
+            while (end > begin && std::isspace(static_cast<unsigned char>(text[end - 1])))
+            {
+                --end;
+            }
+            return text.substr(begin, end - begin);
+        }
+
+        const char *const statuses[] = {"PROVED", "DISPROVED", "SATURATED", "TIMEOUT", "UNKNOWN", "CANCELLED", "ERROR"};
+    }
+
+    /**
+     * A client connection: its responder and the requests it has in flight
+     */
+    struct ProverServer::Session
+    {
+        Responder respond;
+        std::mutex mutex; // Serializes responses; guards active
+        std::condition_variable idle;
+        std::unordered_map<std::string, std::shared_ptr<Job>> active;
+
+        void send(const std::string &line)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            respond(line);
+        }
+    };
+
+    ProverServer::ProverServer(const ProverServerConfig &config)
+        : config_(config),
+          lemmas_(config.lemma_file.empty() ? std::make_shared<LemmaStore>()
+                                            : std::make_shared<LemmaStore>(config.lemma_file)),
+          started_(std::chrono::steady_clock::now())
+    {
+        for (std::size_t i = 0; i < std::max<std::size_t>(1, config_.threads); ++i)
+        {
+            workers_.emplace_back(&ProverServer::work, this);
+        }
+    }
+
+    ProverServer::~ProverServer()
+    {
+        cancel_all();
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            shutting_down_ = true;
+        }
+        queue_ready_.notify_all();
+        for (auto &worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    std::string ProverServer::add_theory(const std::string &id, const std::string &text, const std::string &source)
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto theory = std::make_shared<Theory>();
+        theory->id = id;
+        for (auto &formula : parse(text, source))
+        {
+            ++theory->formulas;
+            if (formula.role != TPTPFormula::Role::AXIOM)
+            {
+                throw std::runtime_error("theory " + id + ": conjectures belong in prove requests");
+            }
+            if (formula.language == TPTPFormula::Language::CNF)
+            {
+                theory->fof = false;
+                if (formula.clause)
+                {
+                    theory->clauses.push_back(formula.clause);
+                }
+                continue;
+            }
+            auto cnf = CNFConverter::to_cnf(formula.formula, theory->skolems);
+            theory->clauses.insert(theory->clauses.end(), cnf.begin(), cnf.end());
+            theory->hypotheses.emplace_back(formula.name, formula.formula);
+        }
+
+        std::string response = Response("theory")
+                                   .add("theory", id)
+                                   .add("formulas", theory->formulas)
+                                   .add("clauses", theory->clauses.size())
+                                   .add("time_ms", elapsed_ms(start))
+                                   .str();
+        std::lock_guard<std::mutex> lock(theories_mutex_);
+        theories_[id] = std::move(theory);
+        return response;
+    }
+
+    void ProverServer::serve(std::istream &in, const Responder &respond)
+    {
+        auto session = std::make_shared<Session>();
+        session->respond = respond;
+        {
+            std::lock_guard<std::mutex> lock(sessions_mutex_);
+            sessions_.erase(std::remove_if(sessions_.begin(), sessions_.end(),
+                                           [](const std::weak_ptr<Session> &s)
+                                           { return s.expired(); }),
+                            sessions_.end());
+            sessions_.push_back(session);
+        }
+
+        std::string line;
+        while (std::getline(in, line))
+        {
+            auto words = split_words(line);
+            if (words.empty() || words[0][0] == '%')
+            {
+                continue;
+            }
+            const std::string &command = words[0];
+            std::string id = words.size() > 1 ? words[1] : "";
+
+            // Bodies run up to a line "end"
+            std::string body;
+            if (command == "theory" || command == "prove")
+            {
+                bool ended = false;
+                while (std::getline(in, line))
+                {
+                    if (trim(line) == "end")
+                    {
+                        ended = true;
+                        break;
+                    }
+                    body += line;
+                    body += '\n';
+                }
+                if (!ended)
+                {
+                    session->send(error_response(id, command + " request without \"end\""));
+                    break;
+                }
+            }
+
+            if (command == "quit")
+            {
+                break;
+            }
+            if (command == "stats")
+            {
+                session->send(statistics());
+                continue;
+            }
+            if (id.empty())
+            {
+                session->send(error_response("", command + " needs an id"));
+                continue;
+            }
+
+            try
+            {
+                if (command == "theory")
+                {
+                    session->send(add_theory(id, body, "theory " + id));
+                }
+                else if (command == "forget")
+                {
+                    std::lock_guard<std::mutex> lock(theories_mutex_);
+                    if (!theories_.erase(id))
+                    {
+                        throw std::runtime_error("no theory " + id);
+                    }
+                    session->send(Response("forgotten").add("theory", id).str());
+                }
+                else if (command == "prove")
+                {
+                    std::unordered_map<std::string, std::string> arguments;
+                    for (std::size_t i = 2; i < words.size(); ++i)
+                    {
+                        auto separator = words[i].find('=');
+                        if (separator == std::string::npos)
+                        {
+                            throw std::runtime_error("expected key=value, got " + words[i]);
+                        }
+                        arguments[words[i].substr(0, separator)] = words[i].substr(separator + 1);
+                    }
+                    submit(make_job(session, id, arguments, body));
+                }
+                else if (command == "cancel")
+                {
+                    std::lock_guard<std::mutex> lock(session->mutex);
+                    auto it = session->active.find(id);
+                    if (it == session->active.end())
+                    {
+                        session->respond(error_response(id, "no request " + id + " in progress"));
+                    }
+                    else
+                    {
+                        it->second->stop = true;
+                    }
+                }
+                else
+                {
+                    throw std::runtime_error("unknown request " + command);
+                }
+            }
+            catch (const std::exception &e)
+            {
+                session->send(error_response(id, e.what()));
+            }
+        }
+
+        // Results of the requests still running go to the same responder
+        std::unique_lock<std::mutex> lock(session->mutex);
+        session->idle.wait(lock, [&session]()
+                           { return session->active.empty(); });
+    }
+
+    std::string ProverServer::statistics() const
+    {
+        Response response("stats");
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            response.add("requests", requests_).add("queued", queue_.size()).add("running", running_);
+            for (const char *status : statuses)
+            {
+                auto it = outcomes_.find(status);
+                std::string name = status;
+                std::transform(name.begin(), name.end(), name.begin(),
+                               [](unsigned char c)
+                               { return static_cast<char>(std::tolower(c)); });
+                response.add(name, it == outcomes_.end() ? std::size_t(0) : it->second);
+            }
+            response.add("lemma_answers", lemma_answers_).add("search_time_ms", search_time_ms_);
+        }
+        {
+            std::lock_guard<std::mutex> lock(theories_mutex_);
+            response.add("theories", theories_.size());
+        }
+        {
+            std::lock_guard<std::mutex> lock(parser_mutex_);
+            response.add("symbols", parser_.symbol_count());
+        }
+        const CompletionCache &cache = CompletionCache::shared();
+        return response.add("completions", cache.size())
+            .add("completion_hits", cache.hits())
+            .add("lemmas", lemmas_->size())
+            .add("uptime_ms", elapsed_ms(started_))
+            .str();
+    }
+
+    void ProverServer::cancel_all()
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        for (const auto &weak_session : sessions_)
+        {
+            if (auto session = weak_session.lock())
+            {
+                std::lock_guard<std::mutex> session_lock(session->mutex);
+                for (auto &[id, job] : session->active)
+                {
+                    job->stop = true;
+                }
+            }
+        }
+    }
+
+    void ProverServer::work()
+    {
+        for (;;)
+        {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(queue_mutex_);
+                queue_ready_.wait(lock, [this]()
+                                  { return shutting_down_ || !queue_.empty(); });
+                if (queue_.empty())
+                {
+                    return;
+                }
+                job = std::move(queue_.front());
+                queue_.pop_front();
+                ++running_;
+            }
+
+            run(job);
+
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            --running_;
+        }
+    }
+
+    void ProverServer::run(const std::shared_ptr<Job> &job)
+    {
+        auto start = std::chrono::steady_clock::now();
+        double queue_ms = std::chrono::duration<double, std::milli>(start - job->queued).count();
+        if (job->stop)
+        {
+            finish(job, Response("result").add("id", job->id).add("status", std::string("CANCELLED"))
+                            .add("queue_ms", queue_ms).str(),
+                   "CANCELLED", 0.0);
+            return;
+        }
+
+        // Provers compute clause features lazily, so the theory's clauses
+        // are never handed out, only copies
+        std::vector<ClausePtr> axioms;
+        if (job->theory)
+        {
+            axioms.reserve(job->theory->clauses.size() + job->axioms.size());
+            for (const auto &clause : job->theory->clauses)
+            {
+                axioms.push_back(std::make_shared<Clause>(*clause));
+            }
+        }
+        axioms.insert(axioms.end(), job->axioms.begin(), job->axioms.end());
+
+        try
+        {
+            ResolutionProver prover(job->config);
+            auto result = job->support.empty() ? prover.refute(std::move(axioms))
+                                               : prover.refute(std::move(axioms), std::move(job->support));
+            double time_ms = elapsed_ms(start);
+
+            std::string status = status_name(result.status);
+            if (job->stop && !result.is_conclusive())
+            {
+                status = "CANCELLED";
+            }
+            std::string strategy = result.strategy.empty() ? job->strategy : result.strategy;
+            if (result.is_proved() && job->goal)
+            {
+                lemmas_->add(job->goal, job->context, "proved by " + strategy + " for request " + job->id);
+            }
+
+            Response response("result");
+            response.add("id", job->id)
+                .add("status", status)
+                .add("strategy", strategy)
+                .add("time_ms", time_ms)
+                .add("queue_ms", queue_ms)
+                .add("iterations", result.iterations)
+                .add("final_clauses", result.final_clause_count)
+                .add("explanation", result.explanation);
+            if (result.countermodel)
+            {
+                response.add("countermodel", result.countermodel->to_string());
+            }
+            finish(job, response.str(), status, time_ms);
+        }
+        catch (const std::exception &e)
+        {
+            finish(job, error_response(job->id, e.what()), "ERROR", elapsed_ms(start));
+        }
+    }
+
+    std::shared_ptr<ProverServer::Job> ProverServer::make_job(
+        const std::shared_ptr<Session> &session, const std::string &id,
+        const std::unordered_map<std::string, std::string> &arguments, const std::string &text)
+    {
+        auto job = std::make_shared<Job>();
+        job->id = id;
+        job->session = session;
+        job->strategy = "auto";
+        double time_ms = config_.default_time_ms;
+        std::size_t iterations = config_.default_iterations;
+        for (const auto &[key, value] : arguments)
+        {
+            try
+            {
+                if (key == "theory")
+                {
+                    job->theory = theory(value);
+                    if (!job->theory)
+                    {
+                        throw std::runtime_error("no theory " + value);
+                    }
+                }
+                else if (key == "strategy")
+                    job->strategy = value;
+                else if (key == "timeout")
+                    time_ms = std::stod(value);
+                else if (key == "iterations")
+                    iterations = std::stoul(value);
+                else
+                    throw std::runtime_error("unknown argument " + key);
+            }
+            catch (const std::logic_error &)
+            {
+                // std::stod and std::stoul throw invalid_argument and out_of_range
+                throw std::runtime_error("invalid " + key + ": " + value);
+            }
+        }
+        if (!(time_ms > 0.0))
+        {
+            throw std::runtime_error("invalid timeout: " + std::to_string(time_ms));
+        }
+
+        ResolutionConfig base;
+        base.max_time_ms = std::min(time_ms, config_.max_time_ms);
+        base.max_iterations = iterations;
+        base.clause_retention = ResolutionConfig::ClauseRetention::NONE;
+        base.kb_cache_directory = config_.kb_cache_directory;
+        auto config = strategy_config(job->strategy, base);
+        if (!config)
+        {
+            throw std::runtime_error("unknown strategy " + job->strategy);
+        }
+        job->config = *config;
+        job->config.stop = &job->stop;
+
+        // Axioms go with the theory's, negated conjectures into the set of
+        // support. Lemmas can only state FOF formulas, so they apply when
+        // the theory and the request have nothing else
+        TPTPProblem problem;
+        problem.formulas = parse(text, "request " + id);
+        bool fof = !job->theory || job->theory->fof;
+        std::vector<Hypothesis> context;
+        std::size_t skolems = 0;
+        if (job->theory)
+        {
+            context = job->theory->hypotheses;
+            skolems = job->theory->skolems;
+        }
+        for (const auto &formula : problem.formulas)
+        {
+            if (formula.language == TPTPFormula::Language::CNF)
+            {
+                fof = false;
+                if (formula.clause)
+                {
+                    auto &target = formula.role == TPTPFormula::Role::NEGATED_CONJECTURE ? job->support : job->axioms;
+                    target.push_back(formula.clause);
+                }
+            }
+            else if (formula.role != TPTPFormula::Role::CONJECTURE)
+            {
+                auto cnf = CNFConverter::to_cnf(formula.formula, skolems);
+                auto &target = formula.role == TPTPFormula::Role::NEGATED_CONJECTURE ? job->support : job->axioms;
+                target.insert(target.end(), cnf.begin(), cnf.end());
+                context.emplace_back(formula.name, formula.formula);
+            }
+        }
+        if (auto goal = problem.conjecture())
+        {
+            auto cnf = CNFConverter::to_cnf(make_not(goal), skolems);
+            job->support.insert(job->support.end(), cnf.begin(), cnf.end());
+            if (fof)
+            {
+                job->goal = goal;
+                job->context = std::move(context);
+            }
+        }
+        return job;
+    }
+
+    void ProverServer::submit(const std::shared_ptr<Job> &job)
+    {
+        Session &session = *job->session;
+        {
+            std::lock_guard<std::mutex> lock(session.mutex);
+            if (session.active.count(job->id))
+            {
+                throw std::runtime_error("request " + job->id + " is already in progress");
+            }
+        }
+
+        std::optional<std::string> lemma;
+        if (job->goal)
+        {
+            lemma = lemmas_->find(job->goal, job->context);
+        }
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            ++requests_;
+            if (lemma)
+            {
+                ++lemma_answers_;
+            }
+        }
+        if (lemma)
+        {
+            finish(job, Response("result")
+                            .add("id", job->id)
+                            .add("status", std::string("PROVED"))
+                            .add("strategy", std::string("lemma"))
+                            .add("time_ms", 0.0)
+                            .add("lemma", *lemma)
+                            .str(),
+                   "PROVED", 0.0);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(session.mutex);
+            session.active[job->id] = job;
+        }
+        job->queued = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            queue_.push_back(job);
+        }
+        queue_ready_.notify_one();
+    }
+
+    void ProverServer::finish(const std::shared_ptr<Job> &job, const std::string &response,
+                              const std::string &status, double time_ms)
+    {
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            ++outcomes_[status];
+            search_time_ms_ += time_ms;
+        }
+
+        // The job may hold the last reference to its session
+        auto session = std::move(job->session);
+        std::lock_guard<std::mutex> lock(session->mutex);
+        session->respond(response);
+        session->active.erase(job->id);
+        if (session->active.empty())
+        {
+            session->idle.notify_all();
+        }
+    }
+
+    std::shared_ptr<const ProverServer::Theory> ProverServer::theory(const std::string &id) const
+    {
+        std::lock_guard<std::mutex> lock(theories_mutex_);
+        auto it = theories_.find(id);
+        return it == theories_.end() ? nullptr : it->second;
+    }
+
+    std::vector<TPTPFormula> ProverServer::parse(const std::string &text, const std::string &source)
+    {
+        std::vector<TPTPFormula> formulas;
+        std::lock_guard<std::mutex> lock(parser_mutex_);
+        parser_.stream_string(text, source, [&formulas](TPTPFormula &&formula)
+                              { formulas.push_back(std::move(formula)); });
+        return formulas;
+    }
+
+} // namespace theorem_prover
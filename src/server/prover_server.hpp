@@ -0,0 +1,191 @@
+#pragma once
+
+#include "../parser/tptp_parser.hpp"
+#include "../proof/lemma_store.hpp"
+#include "../resolution/resolution_prover.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace theorem_prover
+{
+
+    /**
+     * Settings of a ProverServer
+     */
+    struct ProverServerConfig
+    {
+        std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+        double default_time_ms = 10000.0; // Budget of requests that do not set one
+        double max_time_ms = 300000.0;    // Cap on the budget a request may ask for
+        std::size_t default_iterations = 10000;
+        std::string kb_cache_directory; // Keep completed rewrite systems here too, when set
+        std::string lemma_file;         // Keep lemmas in this file across restarts, when set
+    };
+
+    /**
+     * @brief A long-running prover that answers requests from clients
+     *
+     * Clients talk to the server in sessions over a line-based protocol
+     * (see serve). State that is costly to rebuild is kept across requests
+     * and sessions:
+     *
+     * - Theories: named axiom sets, parsed and converted to CNF once
+     * - Terms: one TPTPParser interns every symbol, so all requests share
+     *   term nodes
+     * - Completed rewrite systems: KB preprocessing goes through
+     *   CompletionCache::shared (optionally backed by a directory)
+     * - Lemmas: proved FOF goals are kept in a LemmaStore together with
+     *   their axioms, and answer later requests for the same goal under
+     *   those axioms or more without a search
+     *
+     * Proof requests run on a fixed pool of threads, each under its own
+     * time and iteration budget and stop flag. Results are written back as
+     * they finish, one JSON object per line, so a session can have many
+     * requests in flight.
+     */
+    class ProverServer
+    {
+    public:
+        // Receives one response line, without the newline
+        using Responder = std::function<void(const std::string &)>;
+
+        explicit ProverServer(const ProverServerConfig &config = ProverServerConfig{});
+
+        // Cancels the requests still queued or running and stops the pool
+        ~ProverServer();
+
+        ProverServer(const ProverServer &) = delete;
+        ProverServer &operator=(const ProverServer &) = delete;
+
+        /**
+         * Define a theory from TPTP text, replacing one of the same id.
+         * Requests already queued keep the version they were given.
+         *
+         * @return The "theory" response line describing it
+         * @throws TPTPParseError on malformed text
+         * @throws std::runtime_error if the text has conjectures
+         */
+        std::string add_theory(const std::string &id, const std::string &text,
+                               const std::string &source = "<theory>");
+
+        /**
+         * Answer the requests of one session until "quit" or the end of the
+         * input, then wait for its requests still running
+         *
+         * Requests are lines of words; those marked with a body are followed
+         * by TPTP text up to a line "end":
+         *
+         *   theory ID                      (body) Define theory ID
+         *   forget ID                      Drop theory ID
+         *   prove ID [theory=T] [strategy=S] [timeout=MS] [iterations=N]
+         *                                  (body) Prove the conjectures of the
+         *                                  body from its axioms and those of
+         *                                  theory T; S is auto (default),
+         *                                  basic, paramod, kb or model
+         *   cancel ID                      Stop request ID
+         *   stats                          Report server statistics
+         *   quit                           End the session
+         *
+         * Every response is a JSON object on one line with an "event" field:
+         * "theory", "forgotten", "result", "stats" or "error". Results carry
+         * the request id, status (PROVED, DISPROVED, SATURATED, TIMEOUT,
+         * UNKNOWN or CANCELLED) and search statistics. Several sessions may
+         * be served at once from different threads.
+         */
+        void serve(std::istream &in, const Responder &respond);
+
+        /**
+         * The "stats" response line
+         */
+        std::string statistics() const;
+
+        /**
+         * Stop every request queued or running, in all sessions. Each is
+         * answered as CANCELLED unless it concludes first.
+         */
+        void cancel_all();
+
+    private:
+        struct Theory
+        {
+            std::string id;
+            std::vector<ClausePtr> clauses;     // CNF of the axioms, copied for each request
+            std::vector<Hypothesis> hypotheses; // FOF axioms, as the context of lemmas
+            bool fof = true;                    // False if there are CNF clauses, which lemmas cannot state
+            std::size_t formulas = 0;
+            std::size_t skolems = 0; // Skolem symbols of the axioms; requests number theirs after them
+        };
+
+        struct Session;
+
+        struct Job
+        {
+            std::string id;
+            std::shared_ptr<Session> session;
+            std::shared_ptr<const Theory> theory; // May be null
+            std::vector<ClausePtr> axioms;        // Of the request itself
+            std::vector<ClausePtr> support;       // Negated conjectures
+            TermDBPtr goal;                       // Conjunction of the FOF conjectures, if lemmas apply
+            std::vector<Hypothesis> context;      // Axioms of the goal, if lemmas apply
+            std::string strategy;
+            ResolutionConfig config;
+            std::atomic<bool> stop{false};
+            std::chrono::steady_clock::time_point queued;
+        };
+
+        ProverServerConfig config_;
+        std::shared_ptr<LemmaStore> lemmas_;
+        std::chrono::steady_clock::time_point started_;
+
+        // Symbols are interned once for all requests; the parser is not
+        // thread-safe, so text is parsed under this lock
+        mutable std::mutex parser_mutex_;
+        TPTPParser parser_;
+
+        std::mutex sessions_mutex_;
+        std::vector<std::weak_ptr<Session>> sessions_;
+
+        mutable std::mutex theories_mutex_;
+        std::unordered_map<std::string, std::shared_ptr<const Theory>> theories_;
+
+        // Pool and statistics
+        mutable std::mutex queue_mutex_;
+        std::condition_variable queue_ready_;
+        std::deque<std::shared_ptr<Job>> queue_;
+        std::vector<std::thread> workers_;
+        bool shutting_down_ = false;
+        std::size_t running_ = 0;
+        std::size_t requests_ = 0;
+        std::size_t lemma_answers_ = 0;
+        std::unordered_map<std::string, std::size_t> outcomes_; // Results by status
+        double search_time_ms_ = 0.0;
+
+        void work();
+        void run(const std::shared_ptr<Job> &job);
+
+        // Parse a prove request into a job; errors throw std::runtime_error
+        // with the message for the client
+        std::shared_ptr<Job> make_job(const std::shared_ptr<Session> &session, const std::string &id,
+                                      const std::unordered_map<std::string, std::string> &arguments,
+                                      const std::string &text);
+        // Answer the job from a lemma, or queue it
+        void submit(const std::shared_ptr<Job> &job);
+        void finish(const std::shared_ptr<Job> &job, const std::string &response, const std::string &status,
+                    double time_ms);
+
+        std::shared_ptr<const Theory> theory(const std::string &id) const;
+        std::vector<TPTPFormula> parse(const std::string &text, const std::string &source);
+    };
+
+} // namespace theorem_prover
@@ -71,11 +71,15 @@ namespace theorem_prover
         if (f == g)
             return false;
 
-        // First check explicit precedence relation
-        if (greater(f, g))
-            return true;
-        if (greater(g, f))
-            return false;
+        // First check explicit precedence relation (skipped when there is
+        // none, so the common case builds no cache keys)
+        if (!precedence_graph_.empty())
+        {
+            if (greater(f, g))
+                return true;
+            if (greater(g, f))
+                return false;
+        }
 
         // Fallback to lexicographic comparison for totality
         return f > g;
@@ -383,6 +387,126 @@ namespace theorem_prover
         }
     }
 
+    KnuthBendixOrdering::KnuthBendixOrdering(std::shared_ptr<Precedence> precedence)
+        : precedence_(precedence) {}
+
+    KnuthBendixOrdering::KnuthBendixOrdering()
+        : precedence_(std::make_shared<Precedence>()) {}
+
+    bool KnuthBendixOrdering::greater(const TermDBPtr &s, const TermDBPtr &t) const
+    {
+        return kbo_greater(s, t);
+    }
+
+    void KnuthBendixOrdering::set_weight(const std::string &symbol, std::size_t weight)
+    {
+        weights_[symbol] = weight;
+    }
+
+    std::size_t KnuthBendixOrdering::symbol_weight(const std::string &symbol) const
+    {
+        auto it = weights_.find(symbol);
+        return it == weights_.end() ? 1 : it->second;
+    }
+
+    bool KnuthBendixOrdering::weigh(const TermDBPtr &term, long sign, long &balance,
+                                    std::unordered_map<std::size_t, long> &variables) const
+    {
+        switch (term->kind())
+        {
+        case TermDB::TermKind::VARIABLE:
+            balance += sign;
+            variables[std::static_pointer_cast<VariableDB>(term)->index()] += sign;
+            return true;
+
+        case TermDB::TermKind::CONSTANT:
+            balance += sign * static_cast<long>(symbol_weight(std::static_pointer_cast<ConstantDB>(term)->symbol()));
+            return true;
+
+        case TermDB::TermKind::FUNCTION_APPLICATION:
+        {
+            auto func_app = std::static_pointer_cast<FunctionApplicationDB>(term);
+            balance += sign * static_cast<long>(symbol_weight(func_app->symbol()));
+            for (const auto &arg : func_app->arguments())
+            {
+                if (!weigh(arg, sign, balance, variables))
+                    return false;
+            }
+            return true;
+        }
+
+        default:
+            return false;
+        }
+    }
+
+    bool KnuthBendixOrdering::kbo_greater(const TermDBPtr &s, const TermDBPtr &t) const
+    {
+        long balance = 0;
+        std::unordered_map<std::size_t, long> variables;
+        if (!weigh(s, 1, balance, variables) || !weigh(t, -1, balance, variables))
+        {
+            return false;
+        }
+
+        // Variable condition: no variable occurs more often in t than in s
+        for (const auto &[index, count] : variables)
+        {
+            if (count < 0)
+                return false;
+        }
+
+        if (balance != 0)
+        {
+            return balance > 0;
+        }
+
+        // Equal weights: s is a variable, so t is the same variable
+        if (s->kind() == TermDB::TermKind::VARIABLE)
+        {
+            return false;
+        }
+
+        // A variable t occurs in s by the variable condition; with equal
+        // weights s is t under unary symbols of weight 0
+        if (t->kind() == TermDB::TermKind::VARIABLE)
+        {
+            return true;
+        }
+
+        auto decompose = [](const TermDBPtr &term) -> std::pair<const std::string &, const std::vector<TermDBPtr> &>
+        {
+            static const std::vector<TermDBPtr> no_arguments;
+            if (term->kind() == TermDB::TermKind::CONSTANT)
+            {
+                return {static_cast<const ConstantDB &>(*term).symbol(), no_arguments};
+            }
+            const auto &func_app = static_cast<const FunctionApplicationDB &>(*term);
+            return {func_app.symbol(), func_app.arguments()};
+        };
+        auto [f, s_args] = decompose(s);
+        auto [g, t_args] = decompose(t);
+
+        if (f != g)
+        {
+            return precedence_->total_greater(f, g);
+        }
+        if (s_args.size() != t_args.size())
+        {
+            return s_args.size() > t_args.size();
+        }
+
+        // Same symbol: the first differing argument decides
+        for (std::size_t i = 0; i < s_args.size(); ++i)
+        {
+            if (!(*s_args[i] == *t_args[i]))
+            {
+                return kbo_greater(s_args[i], t_args[i]);
+            }
+        }
+        return false;
+    }
+
     // Factory functions
     std::shared_ptr<LexicographicPathOrdering> make_lpo()
     {
@@ -394,4 +518,14 @@ namespace theorem_prover
         return std::make_shared<LexicographicPathOrdering>(precedence);
     }
 
+    std::shared_ptr<KnuthBendixOrdering> make_kbo()
+    {
+        return std::make_shared<KnuthBendixOrdering>();
+    }
+
+    std::shared_ptr<KnuthBendixOrdering> make_kbo(std::shared_ptr<Precedence> precedence)
+    {
+        return std::make_shared<KnuthBendixOrdering>(precedence);
+    }
+
 } // namespace theorem_prover
\ No newline at end of file
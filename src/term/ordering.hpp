@@ -211,8 +211,72 @@ namespace theorem_prover
         decompose_term(const TermDBPtr &term) const;
     };
 
+    /**
+     * @brief Knuth-Bendix Ordering (KBO)
+     *
+     * Every symbol and variable has a weight (1 unless set), positive except
+     * possibly for one unary symbol greater than all others in precedence.
+     * s >_kbo t iff every variable occurs in s at least as often as in t, and:
+     * 1. w(s) > w(t), or
+     * 2. w(s) = w(t), s = f(s1,...,sn), t = g(t1,...,tm), and either
+     *    a) f >_prec g, or
+     *    b) f = g and (s1,...,sn) >_lex (t1,...,tm), or
+     * 3. w(s) = w(t) and t is a variable occurring in s, s ≠ t
+     *
+     * Unlike LPO, a term is only greater than the variables occurring in
+     * it, so the ordering stays stable under substitution for non-ground
+     * terms. A comparison costs one pass over both terms per lexicographic
+     * step. Only first-order terms (variables, constants, applications)
+     * are comparable.
+     */
+    class KnuthBendixOrdering : public TermOrdering
+    {
+    public:
+        /**
+         * @brief Construct KBO with given precedence
+         * @param precedence Precedence relation on function symbols
+         */
+        explicit KnuthBendixOrdering(std::shared_ptr<Precedence> precedence);
+
+        /**
+         * @brief Construct KBO with default precedence (lexicographic on symbol names)
+         */
+        KnuthBendixOrdering();
+
+        bool greater(const TermDBPtr &s, const TermDBPtr &t) const override;
+
+        /**
+         * @brief Set the weight of a function symbol or constant
+         * @param symbol Symbol name
+         * @param weight Weight; 0 only for a unary symbol greater than all
+         *               others in precedence, or the ordering is not well-founded
+         */
+        void set_weight(const std::string &symbol, std::size_t weight);
+
+        /**
+         * @brief Get the precedence relation
+         * @return Shared pointer to the precedence
+         */
+        std::shared_ptr<Precedence> get_precedence() const { return precedence_; }
+
+    private:
+        std::shared_ptr<Precedence> precedence_;
+        std::unordered_map<std::string, std::size_t> weights_;
+
+        bool kbo_greater(const TermDBPtr &s, const TermDBPtr &t) const;
+
+        // Add sign * weight of the term to balance and sign * occurrences
+        // of each variable to variables; false if the term is not first-order
+        bool weigh(const TermDBPtr &term, long sign, long &balance,
+                   std::unordered_map<std::size_t, long> &variables) const;
+
+        std::size_t symbol_weight(const std::string &symbol) const;
+    };
+
     // Factory functions
     std::shared_ptr<LexicographicPathOrdering> make_lpo();
     std::shared_ptr<LexicographicPathOrdering> make_lpo(std::shared_ptr<Precedence> precedence);
+    std::shared_ptr<KnuthBendixOrdering> make_kbo();
+    std::shared_ptr<KnuthBendixOrdering> make_kbo(std::shared_ptr<Precedence> precedence);
 
 } // namespace theorem_prover
\ No newline at end of file
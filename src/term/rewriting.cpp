@@ -4,6 +4,7 @@
 #include "../utils/gensym.hpp"
 #include <sstream>
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 
 namespace theorem_prover
@@ -661,7 +662,8 @@ namespace theorem_prover
 
     std::string RewriteSystem::generate_rule_name() const
     {
-        static int counter = 0;
+        // Shared by provers running on different threads
+        static std::atomic<int> counter{0};
         return "rule_" + std::to_string(counter++);
     }
 
@@ -0,0 +1,82 @@
+#include "symbol_table.hpp"
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace theorem_prover
+{
+
+    namespace
+    {
+        struct Table
+        {
+            std::shared_mutex mutex;
+            // Symbol -> (arity, id) for each arity it is used with
+            std::unordered_map<std::string, std::vector<std::pair<std::size_t, SymbolId>>> ids;
+            std::vector<std::string> names{"_none_/0"}; // By id
+        };
+
+        Table &table()
+        {
+            static Table instance;
+            return instance;
+        }
+
+        SymbolId find(const std::vector<std::pair<std::size_t, SymbolId>> &arities, std::size_t arity)
+        {
+            for (const auto &[known_arity, id] : arities)
+            {
+                if (known_arity == arity)
+                {
+                    return id;
+                }
+            }
+            return SymbolTable::no_symbol;
+        }
+    } // namespace
+
+    SymbolId SymbolTable::intern(const std::string &symbol, std::size_t arity)
+    {
+        Table &symbols = table();
+        {
+            std::shared_lock<std::shared_mutex> lock(symbols.mutex);
+            auto it = symbols.ids.find(symbol);
+            if (it != symbols.ids.end())
+            {
+                if (SymbolId id = find(it->second, arity))
+                {
+                    return id;
+                }
+            }
+        }
+
+        // Another thread may have interned it between the two locks
+        std::unique_lock<std::shared_mutex> lock(symbols.mutex);
+        auto &arities = symbols.ids[symbol];
+        if (SymbolId id = find(arities, arity))
+        {
+            return id;
+        }
+        SymbolId id = static_cast<SymbolId>(symbols.names.size());
+        arities.emplace_back(arity, id);
+        symbols.names.push_back(symbol + "/" + std::to_string(arity));
+        return id;
+    }
+
+    std::string SymbolTable::name(SymbolId id)
+    {
+        Table &symbols = table();
+        std::shared_lock<std::shared_mutex> lock(symbols.mutex);
+        return id < symbols.names.size() ? symbols.names[id] : "_unknown_";
+    }
+
+    std::size_t SymbolTable::size()
+    {
+        Table &symbols = table();
+        std::shared_lock<std::shared_mutex> lock(symbols.mutex);
+        return symbols.names.size() - 1;
+    }
+
+} // namespace theorem_prover
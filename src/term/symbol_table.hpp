@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace theorem_prover
+{
+
+    using SymbolId = std::uint32_t;
+
+    /**
+     * @brief Process-wide interning of (symbol, arity) pairs
+     *
+     * Terms keep their symbols as strings. Indexes key on the interned id
+     * instead, so a lookup neither builds nor compares strings. Ids are
+     * dense, start at 1 and are never reused; 0 stands for "no symbol".
+     * All members are thread-safe.
+     */
+    class SymbolTable
+    {
+    public:
+        static constexpr SymbolId no_symbol = 0;
+
+        /**
+         * @brief Id of a symbol used with the given arity, assigned on first use
+         */
+        static SymbolId intern(const std::string &symbol, std::size_t arity);
+
+        /**
+         * @brief Symbol of an interned id, as "name/arity"
+         */
+        static std::string name(SymbolId id);
+
+        /**
+         * @brief Number of interned symbols
+         */
+        static std::size_t size();
+    };
+
+} // namespace theorem_prover
@@ -2,6 +2,7 @@
 #include "../utils/hash.hpp"
 #include <set>
 #include <functional>
+#include <stdexcept>
 
 namespace theorem_prover
 {
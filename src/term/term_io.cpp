@@ -0,0 +1,146 @@
+#include "term_io.hpp"
+
+namespace theorem_prover
+{
+
+    void TermWriter::write(const TermDBPtr &term)
+    {
+        out_.write_varint(static_cast<std::uint64_t>(term->kind()));
+        switch (term->kind())
+        {
+        case TermDB::TermKind::VARIABLE:
+            out_.write_varint(std::static_pointer_cast<VariableDB>(term)->index());
+            break;
+        case TermDB::TermKind::CONSTANT:
+            write_symbol(std::static_pointer_cast<ConstantDB>(term)->symbol());
+            break;
+        case TermDB::TermKind::FUNCTION_APPLICATION:
+        {
+            auto application = std::static_pointer_cast<FunctionApplicationDB>(term);
+            write_symbol(application->symbol());
+            out_.write_varint(application->arguments().size());
+            for (const auto &argument : application->arguments())
+            {
+                write(argument);
+            }
+            break;
+        }
+        case TermDB::TermKind::AND:
+        {
+            auto conjunction = std::static_pointer_cast<AndDB>(term);
+            write(conjunction->left());
+            write(conjunction->right());
+            break;
+        }
+        case TermDB::TermKind::OR:
+        {
+            auto disjunction = std::static_pointer_cast<OrDB>(term);
+            write(disjunction->left());
+            write(disjunction->right());
+            break;
+        }
+        case TermDB::TermKind::NOT:
+            write(std::static_pointer_cast<NotDB>(term)->body());
+            break;
+        case TermDB::TermKind::IMPLIES:
+        {
+            auto implication = std::static_pointer_cast<ImpliesDB>(term);
+            write(implication->antecedent());
+            write(implication->consequent());
+            break;
+        }
+        case TermDB::TermKind::FORALL:
+        {
+            auto forall = std::static_pointer_cast<ForallDB>(term);
+            out_.write_string(forall->variable_hint());
+            write(forall->body());
+            break;
+        }
+        case TermDB::TermKind::EXISTS:
+        {
+            auto exists = std::static_pointer_cast<ExistsDB>(term);
+            out_.write_string(exists->variable_hint());
+            write(exists->body());
+            break;
+        }
+        default:
+            throw SerializationError("Unsupported term kind in serialization");
+        }
+    }
+
+    void TermWriter::write_symbol(const std::string &symbol)
+    {
+        auto [it, inserted] = symbols_.emplace(symbol, static_cast<std::uint32_t>(symbols_.size()));
+        out_.write_varint(it->second);
+        if (inserted)
+        {
+            out_.write_string(symbol);
+        }
+    }
+
+    TermDBPtr TermReader::read()
+    {
+        auto kind = static_cast<TermDB::TermKind>(in_.read_varint());
+        switch (kind)
+        {
+        case TermDB::TermKind::VARIABLE:
+            return make_variable(in_.read_varint());
+        case TermDB::TermKind::CONSTANT:
+            return make_constant(read_symbol());
+        case TermDB::TermKind::FUNCTION_APPLICATION:
+        {
+            std::string symbol = read_symbol();
+            std::vector<TermDBPtr> arguments(in_.read_count());
+            for (auto &argument : arguments)
+            {
+                argument = read();
+            }
+            return make_function_application(symbol, arguments);
+        }
+        case TermDB::TermKind::AND:
+        {
+            auto left = read();
+            return make_and(left, read());
+        }
+        case TermDB::TermKind::OR:
+        {
+            auto left = read();
+            return make_or(left, read());
+        }
+        case TermDB::TermKind::NOT:
+            return make_not(read());
+        case TermDB::TermKind::IMPLIES:
+        {
+            auto antecedent = read();
+            return make_implies(antecedent, read());
+        }
+        case TermDB::TermKind::FORALL:
+        {
+            std::string hint = in_.read_string();
+            return make_forall(hint, read());
+        }
+        case TermDB::TermKind::EXISTS:
+        {
+            std::string hint = in_.read_string();
+            return make_exists(hint, read());
+        }
+        default:
+            throw SerializationError("Unknown term kind in serialized data");
+        }
+    }
+
+    std::string TermReader::read_symbol()
+    {
+        std::uint64_t id = in_.read_varint();
+        if (id == symbols_.size())
+        {
+            symbols_.push_back(in_.read_string());
+        }
+        else if (id > symbols_.size())
+        {
+            throw SerializationError("Unknown symbol in serialized data");
+        }
+        return symbols_[id];
+    }
+
+} // namespace theorem_prover
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "term_db.hpp"
+#include "../utils/binary_io.hpp"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace theorem_prover
+{
+
+    /**
+     * @brief Writes terms in a compact binary form
+     *
+     * A term is its kind followed by its parts in prefix order. Symbol
+     * names are written once per writer and referred to by number after
+     * that, so a clause set costs little more than its term structure.
+     * Type annotations are not kept.
+     */
+    class TermWriter
+    {
+    public:
+        explicit TermWriter(BinaryWriter &out) : out_(out) {}
+
+        void write(const TermDBPtr &term);
+
+    private:
+        BinaryWriter &out_;
+        std::unordered_map<std::string, std::uint32_t> symbols_;
+
+        void write_symbol(const std::string &symbol);
+    };
+
+    /**
+     * @brief Reads terms written by a TermWriter, in the same order
+     *
+     * Malformed data raises SerializationError.
+     */
+    class TermReader
+    {
+    public:
+        explicit TermReader(BinaryReader &in) : in_(in) {}
+
+        TermDBPtr read();
+
+    private:
+        BinaryReader &in_;
+        std::vector<std::string> symbols_;
+
+        std::string read_symbol();
+    };
+
+} // namespace theorem_prover
@@ -3,6 +3,7 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <stdexcept>
 #include "term_db.hpp"
 
 namespace theorem_prover
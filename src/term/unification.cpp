@@ -63,7 +63,7 @@ namespace theorem_prover
                 }
 
                 // Add binding to substitution
-                substitution[var1->index() - depth] = subst_term2;
+                bind(var1->index() - depth, subst_term2, substitution);
                 return true;
             }
         }
@@ -81,7 +81,7 @@ namespace theorem_prover
                 }
 
                 // Add binding to substitution
-                substitution[var2->index() - depth] = subst_term1;
+                bind(var2->index() - depth, subst_term1, substitution);
                 return true;
             }
         }
@@ -270,6 +270,16 @@ namespace theorem_prover
         return var_index >= depth;
     }
 
+    void Unifier::bind(std::size_t index, const TermDBPtr &term, SubstitutionMap &substitution)
+    {
+        SubstitutionMap binding{{index, term}};
+        for (auto &entry : substitution)
+        {
+            entry.second = SubstitutionEngine::substitute(entry.second, binding, 0);
+        }
+        substitution[index] = term;
+    }
+
     SubstitutionMap Unifier::compose_substitutions(const SubstitutionMap &subst1,
                                                    const SubstitutionMap &subst2)
     {
@@ -109,6 +109,17 @@ namespace theorem_prover
          * @return true if variable is free
          */
         static bool is_free_variable(std::size_t var_index, std::size_t depth);
+
+        /**
+         * Add a binding, applying it to the existing bindings so that the
+         * substitution stays idempotent (one pass of substitute() applies it
+         * fully, and no binding can refer back to a bound variable)
+         *
+         * @param index Free variable index to bind
+         * @param term Term with the current substitution already applied
+         * @param substitution Current substitution (modified in-place)
+         */
+        static void bind(std::size_t index, const TermDBPtr &term, SubstitutionMap &substitution);
     };
 
 } // namespace theorem_prover
\ No newline at end of file
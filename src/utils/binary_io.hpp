@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+namespace theorem_prover
+{
+
+    /**
+     * Error raised for truncated or malformed binary data, and for files
+     * that cannot be read or written
+     */
+    class SerializationError : public std::runtime_error
+    {
+    public:
+        explicit SerializationError(const std::string &message)
+            : std::runtime_error(message) {}
+    };
+
+    /**
+     * Appends values to a byte buffer
+     *
+     * Integers are LEB128 varints, so small counts and ids take one byte;
+     * doubles are their 8 IEEE bytes, little-endian.
+     */
+    class BinaryWriter
+    {
+    public:
+        void write_u8(std::uint8_t value) { buffer_.push_back(static_cast<char>(value)); }
+
+        void write_bool(bool value) { write_u8(value ? 1 : 0); }
+
+        void write_varint(std::uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                write_u8(static_cast<std::uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            write_u8(static_cast<std::uint8_t>(value));
+        }
+
+        void write_double(double value)
+        {
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof bits);
+            for (int i = 0; i < 8; ++i)
+            {
+                write_u8(static_cast<std::uint8_t>(bits >> (8 * i)));
+            }
+        }
+
+        void write_string(const std::string &value)
+        {
+            write_varint(value.size());
+            buffer_.append(value);
+        }
+
+        const std::string &data() const { return buffer_; }
+
+    private:
+        std::string buffer_;
+    };
+
+    /**
+     * Reads values written by BinaryWriter, in the same order
+     */
+    class BinaryReader
+    {
+    public:
+        explicit BinaryReader(const std::string &data) : data_(data) {}
+
+        std::uint8_t read_u8()
+        {
+            if (position_ >= data_.size())
+            {
+                throw SerializationError("Unexpected end of data");
+            }
+            return static_cast<std::uint8_t>(data_[position_++]);
+        }
+
+        bool read_bool() { return read_u8() != 0; }
+
+        std::uint64_t read_varint()
+        {
+            std::uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                std::uint8_t byte = read_u8();
+                value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+                if (!(byte & 0x80))
+                {
+                    return value;
+                }
+            }
+            throw SerializationError("Malformed varint");
+        }
+
+        /**
+         * Read the number of items that follow. Each item takes at least one
+         * byte, so a count beyond the remaining data is rejected before
+         * anything is allocated for it.
+         */
+        std::size_t read_count()
+        {
+            std::uint64_t count = read_varint();
+            if (count > data_.size() - position_)
+            {
+                throw SerializationError("Item count exceeds the remaining data");
+            }
+            return static_cast<std::size_t>(count);
+        }
+
+        double read_double()
+        {
+            std::uint64_t bits = 0;
+            for (int i = 0; i < 8; ++i)
+            {
+                bits |= static_cast<std::uint64_t>(read_u8()) << (8 * i);
+            }
+            double value;
+            std::memcpy(&value, &bits, sizeof value);
+            return value;
+        }
+
+        std::string read_string()
+        {
+            std::uint64_t size = read_varint();
+            if (size > data_.size() - position_)
+            {
+                throw SerializationError("Unexpected end of data");
+            }
+            std::string value = data_.substr(position_, size);
+            position_ += size;
+            return value;
+        }
+
+        bool at_end() const { return position_ == data_.size(); }
+
+    private:
+        const std::string &data_;
+        std::size_t position_ = 0;
+    };
+
+    /**
+     * Whole contents of a file
+     */
+    inline std::string read_binary_file(const std::string &path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+        {
+            throw SerializationError(path + ": cannot open file");
+        }
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    /**
+     * Replace a file by the data; written to a temporary file first and
+     * renamed over the target, so readers never see a partial file
+     */
+    inline void write_binary_file(const std::string &path, const std::string &data)
+    {
+        std::string temporary = path + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            out.write(data.data(), static_cast<std::streamsize>(data.size()));
+            if (!out)
+            {
+                throw SerializationError(temporary + ": cannot write file");
+            }
+        }
+        if (std::rename(temporary.c_str(), path.c_str()) != 0)
+        {
+            std::remove(temporary.c_str());
+            throw SerializationError(path + ": cannot replace file");
+        }
+    }
+
+} // namespace theorem_prover
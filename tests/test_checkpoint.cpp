@@ -0,0 +1,149 @@
+// tests/test_checkpoint.cpp
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include "../src/resolution/resolution_prover.hpp"
+#include "../src/completion/knuth_bendix.hpp"
+#include "../src/term/term_db.hpp"
+#include "test_helpers.hpp"
+
+using namespace theorem_prover;
+using namespace test_helpers;
+
+namespace {
+
+// f(x) = g(x), g(g(x)) = h(x), p(f(f(a))), not p(h(a)), and some clutter
+std::vector<ClausePtr> equational() {
+    auto x = make_variable(0);
+    auto a = make_constant("a");
+    auto f = [](const TermDBPtr &t) { return make_function_application("f", {t}); };
+    auto g = [](const TermDBPtr &t) { return make_function_application("g", {t}); };
+    auto h = [](const TermDBPtr &t) { return make_function_application("h", {t}); };
+    auto eq = [](const TermDBPtr &l, const TermDBPtr &r) { return atom("=", {l, r}); };
+    return {clause({Literal(eq(f(x), g(x)), true)}),
+            clause({Literal(eq(g(g(x)), h(x)), true)}),
+            clause({Literal(atom("q", {x}), false), Literal(atom("q", {f(x)}), true)}),
+            clause({Literal(atom("q", {a}), true)}),
+            clause({Literal(atom("p", {f(f(a))}), true)}),
+            clause({Literal(atom("p", {h(a)}), false)})};
+}
+
+} // namespace
+
+void test_resolution_resume() {
+    std::cout << "Testing resolution checkpoint and resume..." << std::endl;
+
+    std::string path = temporary_path("test_checkpoint", "resolution.checkpoint");
+    ResolutionConfig config;
+    config.use_datalog = false;
+    config.clause_retention = ResolutionConfig::ClauseRetention::NONE;
+
+    for (auto strategy : {ResolutionConfig::SelectionStrategy::FIFO, ResolutionConfig::SelectionStrategy::SMALLEST_FIRST,
+                          ResolutionConfig::SelectionStrategy::UNIT_PREFERENCE}) {
+        for (bool paramodulation : {false, true}) {
+            config.selection_strategy = strategy;
+            config.use_paramodulation = paramodulation;
+            auto problem = paramodulation ? equational() : chain(6);
+
+            config.checkpoint_file.clear();
+            config.max_iterations = 10000;
+            auto uninterrupted = ResolutionProver(config).refute(problem);
+            assert(uninterrupted.is_proved());
+            assert(uninterrupted.iterations > 2);
+
+            // Stopped by the iteration limit, then resumed with a higher one
+            config.checkpoint_file = path;
+            config.max_iterations = uninterrupted.iterations / 2;
+            auto stopped = ResolutionProver(config).refute(problem);
+            assert(stopped.is_timeout() && stopped.iterations == config.max_iterations);
+
+            config.max_iterations = 10000;
+            auto resumed = ResolutionProver(config).resume(path);
+            assert(resumed.is_proved());
+            assert(resumed.iterations == uninterrupted.iterations);
+            assert(resumed.final_clause_count == uninterrupted.final_clause_count);
+        }
+    }
+
+    // A resumed search is bound by the resuming prover's limits
+    config.use_paramodulation = false;
+    config.selection_strategy = ResolutionConfig::SelectionStrategy::FIFO;
+    config.max_iterations = 2;
+    assert(ResolutionProver(config).refute(chain(6)).is_timeout());
+    config.max_iterations = 3;
+    auto limited = ResolutionProver(config).resume(path);
+    assert(limited.is_timeout() && limited.iterations == 3);
+
+    // Periodic checkpoints while a proof is found
+    config.max_iterations = 10000;
+    config.checkpoint_interval_ms = 0.0;
+    auto proved = ResolutionProver(config).refute(chain(6));
+    assert(proved.is_proved());
+    auto again = ResolutionProver(config).resume(path);
+    assert(again.is_proved() && again.iterations == proved.iterations);
+
+    // Files that are not checkpoints
+    std::remove(path.c_str());
+    assert(throws_serialization_error([&] { ResolutionProver(config).resume(path); }));
+    BinaryWriter junk;
+    junk.write_string("not a checkpoint");
+    write_binary_file(path, junk.data());
+    assert(throws_serialization_error([&] { ResolutionProver(config).resume(path); }));
+
+    std::remove(path.c_str());
+    std::cout << "Resolution checkpoint tests passed!" << std::endl;
+}
+
+void test_completion_resume() {
+    std::cout << "Testing completion checkpoint and resume..." << std::endl;
+
+    std::string path = temporary_path("test_checkpoint", "completion.checkpoint");
+    auto x = make_variable(0);
+    auto y = make_variable(1);
+    auto z = make_variable(2);
+    auto e = make_constant("e");
+    auto f = [](const TermDBPtr &l, const TermDBPtr &r) { return make_function_application("f", {l, r}); };
+    auto i = [](const TermDBPtr &t) { return make_function_application("i", {t}); };
+    std::vector<Equation> group = {Equation(f(f(x, y), z), f(x, f(y, z)), "associativity"),
+                                   Equation(f(e, x), x, "left_identity"),
+                                   Equation(f(i(x), x), e, "left_inverse")};
+    auto ordering = std::make_shared<LexicographicPathOrdering>();
+
+    for (bool fair : {true, false}) {
+        KBConfig config;
+        config.fair_processing = fair;
+        config.max_iterations = 40;
+        auto uninterrupted = KnuthBendixCompletion(ordering, config).complete(group);
+        assert(uninterrupted.iterations > 10);
+
+        config.checkpoint_file = path;
+        config.max_iterations = 10;
+        auto stopped = KnuthBendixCompletion(ordering, config).complete(group);
+        assert(stopped.status == KBResult::Status::TIMEOUT && stopped.iterations == 10);
+
+        config.max_iterations = 40;
+        KnuthBendixCompletion kb(ordering, config);
+        auto resumed = kb.resume(path);
+        assert(resumed.status == uninterrupted.status);
+        assert(resumed.iterations == uninterrupted.iterations);
+        assert(same_rules(resumed.final_rules, uninterrupted.final_rules));
+        assert(resumed.total_equations_processed == uninterrupted.total_equations_processed);
+        assert(resumed.total_critical_pairs_computed == uninterrupted.total_critical_pairs_computed);
+    }
+
+    std::remove(path.c_str());
+    KnuthBendixCompletion kb(ordering);
+    assert(throws_serialization_error([&] { kb.resume(path); }));
+
+    std::cout << "Completion checkpoint tests passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "===== Running Checkpoint Tests =====" << std::endl;
+
+    test_resolution_resume();
+    test_completion_resume();
+
+    std::cout << "\n===== All Checkpoint Tests Passed! =====" << std::endl;
+    return 0;
+}
@@ -245,6 +245,13 @@ void test_resolution_failure_cases() {
     result = ResolutionInference::resolve(clause1, clause3);
     assert(!result.success);
     
+    // Test resolving P ∨ Q with ¬P ∨ ¬Q: the resolvent Q ∨ ¬Q is a
+    // tautology, not the empty clause
+    auto p_or_q = std::make_shared<Clause>(std::vector<Literal>{Literal(atom_p, true), Literal(atom_q, true)});
+    auto not_p_or_not_q = std::make_shared<Clause>(std::vector<Literal>{Literal(atom_p, false), Literal(atom_q, false)});
+    result = ResolutionInference::resolve_on_literals(p_or_q, not_p_or_not_q, 0, 0);
+    assert(!result.success);
+    
     std::cout << "Resolution failure case tests passed!" << std::endl;
 }
 
@@ -288,6 +295,125 @@ void test_factoring() {
     std::cout << "Factoring tests passed!" << std::endl;
 }
 
+void test_all_factors_and_condensation() {
+    std::cout << "Testing all factors and condensation..." << std::endl;
+    
+    auto x = make_variable(0);
+    auto y = make_variable(1);
+    auto z = make_variable(2);
+    auto a = make_constant("a");
+    auto p = [](TermDBPtr t) { return make_function_application("P", {t}); };
+    auto p2 = [](TermDBPtr s, TermDBPtr t) { return make_function_application("P", {s, t}); };
+    auto q = [](TermDBPtr t) { return make_function_application("Q", {t}); };
+    
+    // The mgu applies to the whole clause: P(X) ∨ P(a) ∨ Q(X) gives P(a) ∨ Q(a)
+    auto mixed = std::make_shared<Clause>(std::vector<Literal>{
+        Literal(p(x), true), Literal(p(a), true), Literal(q(x), true)});
+    auto mixed_factors = ResolutionInference::factors(mixed);
+    assert(mixed_factors.size() == 1);
+    assert(mixed_factors[0]->equals(Clause({Literal(p(a), true), Literal(q(a), true)})));
+    
+    // Every unifiable pair yields a factor; variants are reported once
+    auto three = std::make_shared<Clause>(std::vector<Literal>{
+        Literal(p(x), true), Literal(p(y), true), Literal(p(z), true)});
+    assert(ResolutionInference::factors(three).size() == 1);
+    auto pairs = std::make_shared<Clause>(std::vector<Literal>{
+        Literal(p(x), true), Literal(p(a), true), Literal(q(x), true), Literal(q(y), true)});
+    assert(ResolutionInference::factors(pairs).size() == 2);
+    
+    // Literals of opposite polarity are never merged
+    auto opposite = std::make_shared<Clause>(std::vector<Literal>{Literal(p(x), true), Literal(p(a), false)});
+    assert(ResolutionInference::factors(opposite).empty());
+    
+    // P(X) ∨ P(a) ∨ Q(a) condenses to P(a) ∨ Q(a); P(X) ∨ P(a) ∨ Q(X) does not condense
+    Clause condensable({Literal(p(x), true), Literal(p(a), true), Literal(q(a), true)});
+    assert(condensable.condense().size() == 2);
+    assert(mixed->condense().size() == 3);
+    
+    // P(X, Y) ∨ P(Y, X) ∨ P(a, a) condenses to P(a, a), which needs two
+    // literals mapped onto the same one
+    Clause symmetric({Literal(p2(x, y), true), Literal(p2(y, x), true), Literal(p2(a, a), true)});
+    assert(symmetric.condense().equals(Clause({Literal(p2(a, a), true)})));
+    
+    std::cout << "All factors and condensation tests passed!" << std::endl;
+}
+
+void test_clause_features() {
+    std::cout << "Testing clause features..." << std::endl;
+    
+    // P(X3, f(a)) ∨ ¬Q: five symbol and variable occurrences, variables below 4
+    auto p = make_function_application("P", {make_variable(3), make_function_application("f", {make_constant("a")})});
+    Clause clause({Literal(p, true), Literal(make_constant("Q"), false)});
+    assert(clause.weight() == 5);
+    assert(clause.variable_bound() == 4);
+    assert(clause.signatures().size() == 2);
+    assert(!clause.signatures()[1].positive);
+    
+    Clause ground({Literal(make_constant("Q"), true)});
+    assert(ground.variable_bound() == 0);
+    
+    Clause empty;
+    assert(empty.is_empty() && empty.weight() == 0 && empty.literals().empty());
+    
+    // Copies own their literals; assignment replaces them
+    Clause copy = clause;
+    assert(copy.equals(clause) && copy.hash() == clause.hash() && copy.weight() == 5);
+    copy = ground;
+    assert(copy.size() == 1 && clause.size() == 2);
+    copy = empty;
+    assert(copy.is_empty());
+    
+    // Literals convert to a vector that can be edited freely
+    std::vector<Literal> literals = clause.literals();
+    literals.pop_back();
+    assert(literals.size() == 1 && clause.size() == 2);
+    
+    std::cout << "Clause feature tests passed!" << std::endl;
+}
+
+void test_clause_variants() {
+    std::cout << "Testing clause variants..." << std::endl;
+    
+    auto x = make_variable(0);
+    auto y = make_variable(1);
+    auto z = make_variable(5);
+    auto w = make_variable(7);
+    auto p = [](TermDBPtr a, TermDBPtr b) { return make_function_application("P", {a, b}); };
+    auto q = [](TermDBPtr a) { return make_function_application("Q", {a}); };
+    
+    // P(X, Y) ∨ ¬Q(X) and ¬Q(W) ∨ P(W, Z) are variants
+    Clause c1({Literal(p(x, y), true), Literal(q(x), false)});
+    Clause c2({Literal(q(w), false), Literal(p(w, z), true)});
+    assert(c1.is_variant(c2) && c2.is_variant(c1));
+    assert(c1.variant_hash() == c2.variant_hash());
+    
+    // Their normal forms coincide, with variables numbered from 0
+    auto n1 = c1.canonical();
+    auto n2 = c2.canonical();
+    assert(n1.literals()[0].atom()->equals(*n2.literals()[0].atom()));
+    assert(n1.literals()[1].atom()->equals(*n2.literals()[1].atom()));
+    assert(n2.is_variant(c2));
+    
+    // Different variable sharing: not variants
+    Clause c3({Literal(p(x, y), true), Literal(q(y), false)});
+    Clause c4({Literal(p(x, x), true), Literal(q(x), false)});
+    assert(!c1.is_variant(c3));
+    assert(!c1.is_variant(c4));
+    
+    // Renaming must be a bijection: P(X, Y) is no variant of P(X, X)
+    Clause c5({Literal(p(x, y), true)});
+    Clause c6({Literal(p(z, z), true)});
+    assert(!c5.is_variant(c6) && !c6.is_variant(c5));
+    
+    // Literals with equal keys need backtracking:
+    // P(X, Y) ∨ P(Y, Z) vs P(Z, W) ∨ P(X, Z)
+    Clause c7({Literal(p(x, y), true), Literal(p(y, z), true)});
+    Clause c8({Literal(p(z, w), true), Literal(p(x, z), true)});
+    assert(c7.is_variant(c8));
+    
+    std::cout << "Clause variant tests passed!" << std::endl;
+}
+
 int main() {
     std::cout << "===== Running Clause Tests =====" << std::endl;
     
@@ -296,12 +422,15 @@ int main() {
     test_clause_creation();
     test_clause_tautology();
     test_clause_simplification();
+    test_clause_features();
+    test_clause_variants();
     test_clause_substitution();
     test_resolution_basic();
     test_resolution_with_unification();
     test_resolution_failure_cases();
     test_empty_clause_resolution();
     test_factoring();
+    test_all_factors_and_condensation();
     
     std::cout << "\n===== All Clause Tests Passed! =====" << std::endl;
     return 0;
@@ -248,6 +248,41 @@ void test_cnf_edge_cases() {
     std::cout << "CNF conversion edge case tests passed!" << std::endl;
 }
 
+void test_quantifier_elimination() {
+    std::cout << "Testing quantifier elimination..." << std::endl;
+    
+    // ∀x.∀y.P(x,y) must keep x and y distinct
+    auto p_xy = make_function_application("P", {make_variable(1), make_variable(0)});
+    auto clauses = CNFConverter::to_cnf(make_forall("x", make_forall("y", p_xy)));
+    assert(clauses.size() == 1);
+    auto atom = std::dynamic_pointer_cast<FunctionApplicationDB>(clauses[0]->literals()[0].atom());
+    assert(atom->arguments()[0]->kind() == TermDB::TermKind::VARIABLE);
+    assert(atom->arguments()[1]->kind() == TermDB::TermKind::VARIABLE);
+    assert(!atom->arguments()[0]->equals(*atom->arguments()[1]));
+    
+    // ∀x.∃y.P(x,y) becomes P(X, sk(X))
+    clauses = CNFConverter::to_cnf(make_forall("x", make_exists("y", p_xy)));
+    atom = std::dynamic_pointer_cast<FunctionApplicationDB>(clauses[0]->literals()[0].atom());
+    auto skolem = std::dynamic_pointer_cast<FunctionApplicationDB>(atom->arguments()[1]);
+    assert(skolem && skolem->arguments().size() == 1);
+    assert(skolem->arguments()[0]->equals(*atom->arguments()[0]));
+    
+    // Skolem symbols of conversions sharing a counter must not clash
+    auto exists_p = make_exists("x", make_function_application("P", {make_variable(0)}));
+    std::size_t skolems = 0;
+    auto first = CNFConverter::to_cnf(exists_p, skolems);
+    auto second = CNFConverter::to_cnf(exists_p, skolems);
+    assert(skolems == 2);
+    assert(!first[0]->literals()[0].atom()->equals(*second[0]->literals()[0].atom()));
+    
+    // The names depend on the problem alone, not on earlier conversions
+    std::size_t again = 0;
+    auto repeated = CNFConverter::to_cnf(exists_p, again);
+    assert(repeated[0]->literals()[0].atom()->equals(*first[0]->literals()[0].atom()));
+    
+    std::cout << "Quantifier elimination tests passed!" << std::endl;
+}
+
 int main() {
     std::cout << "===== Running CNF Converter Tests =====" << std::endl;
     
@@ -259,6 +294,7 @@ int main() {
     test_extract_clauses();
     test_full_cnf_conversion();
     test_cnf_with_quantifiers();
+    test_quantifier_elimination();
     test_cnf_edge_cases();
     
     std::cout << "\n===== All CNF Converter Tests Passed! =====" << std::endl;
@@ -0,0 +1,187 @@
+// tests/test_completion_cache.cpp
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../src/completion/completion_cache.hpp"
+#include "../src/resolution/resolution_prover.hpp"
+#include "../src/term/term_db.hpp"
+#include "test_helpers.hpp"
+
+using namespace theorem_prover;
+using namespace test_helpers;
+
+namespace {
+
+TermDBPtr f(const TermDBPtr &l, const TermDBPtr &r) { return make_function_application("f", {l, r}); }
+TermDBPtr i(const TermDBPtr &t) { return make_function_application("i", {t}); }
+
+std::vector<Equation> group() {
+    auto x = make_variable(0);
+    auto y = make_variable(1);
+    auto z = make_variable(2);
+    auto e = make_constant("e");
+    return {Equation(f(f(x, y), z), f(x, f(y, z)), "associativity"),
+            Equation(f(e, x), x, "left_identity"),
+            Equation(f(i(x), x), e, "left_inverse")};
+}
+
+std::string temporary_directory() {
+    std::string directory = "/tmp/test_completion_cache_" + std::to_string(getpid());
+    mkdir(directory.c_str(), 0700);
+    return directory;
+}
+
+std::vector<std::string> files_in(const std::string &directory) {
+    std::vector<std::string> files;
+    if (DIR *dir = opendir(directory.c_str())) {
+        while (dirent *entry = readdir(dir)) {
+            if (entry->d_name[0] != '.') {
+                files.push_back(directory + "/" + entry->d_name);
+            }
+        }
+        closedir(dir);
+    }
+    return files;
+}
+
+} // namespace
+
+void test_cache_keys() {
+    std::cout << "Testing completion cache keys..." << std::endl;
+
+    KBConfig config;
+    auto equations = group();
+    std::string key = CompletionCache::key(equations, "lpo", config);
+
+    // Order and names of the equations do not matter
+    std::vector<Equation> reordered = {Equation(equations[2].lhs(), equations[2].rhs(), "inverse"),
+                                       equations[0], equations[1]};
+    assert(CompletionCache::key(reordered, "lpo", config) == key);
+
+    // Equations, ordering and limits do
+    std::vector<Equation> fewer(equations.begin(), equations.begin() + 2);
+    assert(CompletionCache::key(fewer, "lpo", config) != key);
+    assert(CompletionCache::key(equations, "kbo", config) != key);
+    KBConfig other = config;
+    other.max_rules = 10;
+    assert(CompletionCache::key(equations, "lpo", other) != key);
+    other = config;
+    other.fair_processing = false;
+    assert(CompletionCache::key(equations, "lpo", other) != key);
+
+    // But not the output settings
+    other = config;
+    other.verbose = true;
+    other.checkpoint_file = "completion.ckpt";
+    assert(CompletionCache::key(equations, "lpo", other) == key);
+
+    std::cout << "Completion cache key tests passed!" << std::endl;
+}
+
+void test_cache_storage() {
+    std::cout << "Testing completion cache storage..." << std::endl;
+
+    KBConfig config;
+    config.max_iterations = 30;
+    auto ordering = std::make_shared<LexicographicPathOrdering>();
+    auto result = KnuthBendixCompletion(ordering, config).complete(group());
+    assert(!result.final_rules.empty());
+    std::string key = CompletionCache::key(group(), "lpo", config);
+
+    // In memory
+    CompletionCache cache;
+    assert(!cache.find(key) && cache.misses() == 1);
+    cache.store(key, result);
+    auto found = cache.find(key);
+    assert(found && cache.hits() == 1 && cache.size() == 1);
+    assert(found->status == result.status && found->iterations == result.iterations);
+    assert(same_rules(found->final_rules, result.final_rules));
+
+    // On disk, for another cache
+    std::string directory = temporary_directory();
+    cache.store(key, result, directory);
+    CompletionCache later;
+    found = later.find(key, directory);
+    assert(found && later.hits() == 1);
+    assert(found->status == result.status && found->message == result.message);
+    assert(found->iterations == result.iterations);
+    assert(found->total_critical_pairs_computed == result.total_critical_pairs_computed);
+    assert(same_rules(found->final_rules, result.final_rules));
+    assert(!later.find(CompletionCache::key({group()[0]}, "lpo", config), directory));
+
+    // A damaged file is a miss
+    std::string file = CompletionCache::file_path(directory, key);
+    BinaryWriter junk;
+    junk.write_string("damaged");
+    write_binary_file(file, junk.data());
+    later.clear();
+    assert(!later.find(key, directory) && later.misses() == 1);
+
+    std::remove(file.c_str());
+    rmdir(directory.c_str());
+    std::cout << "Completion cache storage tests passed!" << std::endl;
+}
+
+void test_prover_reuses_completion() {
+    std::cout << "Testing completion reuse across proofs..." << std::endl;
+
+    auto x = make_variable(0);
+    auto a = make_constant("a");
+    auto b = make_constant("b");
+    auto g = [](const TermDBPtr &t) { return make_function_application("g", {t}); };
+    auto eq = [](const TermDBPtr &l, const TermDBPtr &r) { return make_function_application("=", {l, r}); };
+    auto unit = [](const TermDBPtr &atom, bool positive) {
+        return std::make_shared<Clause>(std::vector<Literal>{Literal(atom, positive)});
+    };
+    std::vector<ClausePtr> theory = {unit(eq(g(g(x)), x), true), unit(eq(g(a), b), true)};
+
+    ResolutionConfig config;
+    config.use_kb_preprocessing = true;
+    config.use_paramodulation = true;
+    config.use_datalog = false;
+    CompletionCache &cache = CompletionCache::shared();
+    cache.clear();
+
+    // Two goals over the same theory complete it once
+    auto first = ResolutionProver(config).refute(theory, {unit(eq(g(b), a), false)});
+    assert(cache.misses() == 1 && cache.hits() == 0 && cache.size() == 1);
+    ResolutionProver(config).refute(theory, {unit(eq(g(g(b)), b), false)});
+    assert(cache.misses() == 1 && cache.hits() == 1);
+
+    // Unless the cache is turned off; the outcome is the same either way
+    config.use_kb_cache = false;
+    auto uncached = ResolutionProver(config).refute(theory, {unit(eq(g(b), a), false)});
+    assert(cache.hits() == 1 && cache.misses() == 1);
+    assert(uncached.status == first.status && uncached.iterations == first.iterations);
+
+    // Completions that run out of time are not written to the directory;
+    // those that end within their limits are
+    cache.clear();
+    config.use_kb_cache = true;
+    config.kb_cache_directory = temporary_directory();
+    config.kb_preprocessing_timeout = -1.0;
+    ResolutionProver(config).refute(theory, {unit(eq(g(b), a), false)});
+    assert(cache.size() == 1 && files_in(config.kb_cache_directory).empty());
+    config.kb_preprocessing_timeout = 10.0;
+    ResolutionProver(config).refute(theory, {unit(eq(g(b), a), false)});
+    auto files = files_in(config.kb_cache_directory);
+    assert(cache.size() == 2 && files.size() == 1);
+    std::remove(files[0].c_str());
+    rmdir(config.kb_cache_directory.c_str());
+    cache.clear();
+    std::cout << "Completion reuse tests passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "===== Running Completion Cache Tests =====" << std::endl;
+
+    test_cache_keys();
+    test_cache_storage();
+    test_prover_reuses_completion();
+
+    std::cout << "\n===== All Completion Cache Tests Passed! =====" << std::endl;
+    return 0;
+}
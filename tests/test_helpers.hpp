@@ -0,0 +1,99 @@
+// tests/test_helpers.hpp
+// Clause builders, sample problems and checks shared by the tests
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "../src/resolution/clause.hpp"
+#include "../src/term/rewriting.hpp"
+#include "../src/term/term_db.hpp"
+#include "../src/utils/binary_io.hpp"
+
+namespace test_helpers {
+
+using namespace theorem_prover;
+
+inline TermDBPtr atom(const std::string &predicate, std::vector<TermDBPtr> arguments) {
+    return make_function_application(predicate, arguments);
+}
+
+inline ClausePtr clause(std::vector<Literal> literals) {
+    return std::make_shared<Clause>(literals);
+}
+
+inline TermDBPtr eq(const TermDBPtr &left, const TermDBPtr &right) {
+    return make_function_application("=", {left, right});
+}
+
+inline TermDBPtr mult(const TermDBPtr &a, const TermDBPtr &b) {
+    return make_function_application("mult", {a, b});
+}
+
+inline TermDBPtr inv(const TermDBPtr &a) {
+    return make_function_application("inv", {a});
+}
+
+// Left identity, left inverse and associativity
+inline std::vector<ClausePtr> group_axioms() {
+    auto x = make_variable(0);
+    auto y = make_variable(1);
+    auto z = make_variable(2);
+    auto e = make_constant("e");
+    return {clause({Literal(eq(mult(e, x), x), true)}), clause({Literal(eq(mult(inv(x), x), e), true)}),
+            clause({Literal(eq(mult(mult(x, y), z), mult(x, mult(y, z))), true)})};
+}
+
+// The group axioms plus a*b != b*a
+inline std::vector<ClausePtr> non_abelian_group() {
+    auto a = make_constant("a");
+    auto b = make_constant("b");
+    auto clauses = group_axioms();
+    clauses.push_back(clause({Literal(eq(mult(a, b), mult(b, a)), false)}));
+    return clauses;
+}
+
+// p0(a), p_i(x) -> p_{i+1}(x) | r(x), r(x) -> p_{i+1}(x), not p_n(a)
+inline std::vector<ClausePtr> chain(std::size_t length) {
+    auto x = make_variable(0);
+    auto a = make_constant("a");
+    auto p = [](std::size_t i, const TermDBPtr &t) { return atom("p" + std::to_string(i), {t}); };
+    std::vector<ClausePtr> clauses = {clause({Literal(p(0, a), true)})};
+    for (std::size_t i = 0; i < length; ++i) {
+        clauses.push_back(clause({Literal(p(i, x), false), Literal(p(i + 1, x), true), Literal(atom("r", {x}), true)}));
+        clauses.push_back(clause({Literal(atom("r", {x}), false), Literal(p(i + 1, x), true)}));
+    }
+    clauses.push_back(clause({Literal(p(length, a), false)}));
+    return clauses;
+}
+
+inline bool throws_serialization_error(const std::function<void()> &action) {
+    try {
+        action();
+    } catch (const SerializationError &) {
+        return true;
+    }
+    return false;
+}
+
+// A file name in /tmp that is private to this test process
+inline std::string temporary_path(const std::string &test, const std::string &name) {
+    return "/tmp/" + test + "_" + std::to_string(getpid()) + "_" + name;
+}
+
+// Same rules, names and order
+inline bool same_rules(const std::vector<TermRewriteRule> &a, const std::vector<TermRewriteRule> &b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].name() != b[i].name() || !(*a[i].lhs() == *b[i].lhs()) || !(*a[i].rhs() == *b[i].rhs())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace test_helpers
@@ -2,6 +2,7 @@
 #include <cassert>
 #include <chrono>
 #include "../src/resolution/resolution_prover.hpp"
+#include "../src/resolution/indexing.hpp"
 #include "../src/term/term_db.hpp"
 
 using namespace theorem_prover;
@@ -172,11 +173,55 @@ void test_scaling_behavior()
     }
 }
 
+void test_candidate_ranges()
+{
+    std::cout << "Testing candidate ranges with literal positions..." << std::endl;
+
+    // Symbols are interned per name and arity
+    assert(SymbolTable::intern("P", 1) == SymbolTable::intern("P", 1));
+    assert(SymbolTable::intern("P", 1) != SymbolTable::intern("P", 2));
+    assert(SymbolTable::name(SymbolTable::intern("P", 2)) == "P/2");
+
+    auto a = make_constant("a");
+    auto b = make_constant("b");
+    auto p = [](TermDBPtr t) { return make_function_application("P", {t}); };
+    auto q = [](TermDBPtr t) { return make_function_application("Q", {t}); };
+
+    // P(a) ∨ ¬Q(b) ∨ P(X): a query ¬P(b) meets the literals at 0 and 2
+    auto clause = std::make_shared<Clause>(std::vector<Literal>{
+        Literal(p(a), true), Literal(q(b), false), Literal(p(make_variable(0)), true)});
+    LiteralIndex index;
+    index.insert_clause(clause);
+
+    Literal query(p(b), false);
+    auto candidates = index.resolution_candidates(query);
+    assert(candidates.size() == 2);
+    std::vector<std::size_t> positions;
+    for (const auto &entry : candidates)
+    {
+        assert(entry.clause == clause);
+        positions.push_back(entry.literal);
+
+        // Inserting while iterating neither invalidates nor extends the range
+        index.insert_clause(std::make_shared<Clause>(std::vector<Literal>{Literal(p(b), true)}));
+    }
+    assert((positions == std::vector<std::size_t>{0, 2}));
+    assert(index.resolution_candidates(query).size() == 4);
+
+    // Polarity and arity are part of the key
+    assert(index.resolution_candidates(Literal(p(b), true)).empty());
+    assert(index.resolution_candidates(Literal(q(b), true)).size() == 1);
+    assert(index.resolution_candidates(Literal(make_function_application("P", {a, b}), false)).empty());
+
+    std::cout << "  Candidate ranges report literal positions" << std::endl;
+}
+
 int main()
 {
     std::cout << "===== Running Indexing Performance Tests =====" << std::endl;
 
     test_indexing_correctness();
+    test_candidate_ranges();
     test_no_false_positives();
     test_complex_resolution_with_indexing();
     test_indexing_with_quantifiers();
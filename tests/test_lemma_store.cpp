@@ -0,0 +1,251 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include "../src/proof/goal_manager.hpp"
+#include "../src/proof/lemma_store.hpp"
+#include "../src/term/term_db.hpp"
+#include "test_helpers.hpp"
+
+using namespace theorem_prover;
+using namespace test_helpers;
+
+namespace
+{
+    // A state proving nothing yet, with the given hypotheses and goal
+    ProofStatePtr state_with(ProofContext &context, const std::vector<Hypothesis> &hypotheses, const TermDBPtr &goal)
+    {
+        return context.apply_rule(context.create_initial_state(goal), "assume", {}, hypotheses, goal);
+    }
+}
+
+// Test canonical keys of formulas
+void test_formula_keys()
+{
+    std::cout << "\n=== Testing lemma keys ===\n"
+              << std::endl;
+
+    auto a = make_constant("a");
+    auto x = make_variable(0);
+
+    // Alpha-equivalent formulas share a key
+    auto p_x = make_function_application("P", {x});
+    assert(LemmaStore::formula_key(make_forall("x", p_x)) == LemmaStore::formula_key(make_forall("y", p_x)));
+    assert(LemmaStore::formula_key(make_exists("x", p_x)) != LemmaStore::formula_key(make_forall("x", p_x)));
+
+    // Different formulas do not
+    auto p_a = make_function_application("P", {a});
+    auto q_a = make_function_application("Q", {a});
+    assert(LemmaStore::formula_key(make_and(p_a, q_a)) != LemmaStore::formula_key(make_and(q_a, p_a)));
+    assert(LemmaStore::formula_key(make_or(p_a, q_a)) != LemmaStore::formula_key(make_and(p_a, q_a)));
+    assert(LemmaStore::formula_key(make_function_application("P", {a, a})) !=
+           LemmaStore::formula_key(make_function_application("P", {make_function_application("a", {a})})));
+    assert(LemmaStore::formula_key(make_constant("ab")) != LemmaStore::formula_key(make_constant("a")));
+
+    std::cout << "Lemma key tests passed!" << std::endl;
+}
+
+// Test which contexts a lemma applies in
+void test_lemma_contexts()
+{
+    std::cout << "\n=== Testing lemma contexts ===\n"
+              << std::endl;
+
+    auto a = make_constant("a");
+    auto p_a = make_function_application("P", {a});
+    auto q_a = make_function_application("Q", {a});
+    auto r_a = make_function_application("R", {a});
+
+    LemmaStore store;
+    assert(store.add(p_a, {Hypothesis("h", q_a)}, "from Q(a)"));
+
+    // Any context with the lemma's hypotheses, whatever their names
+    assert(store.find(p_a, {Hypothesis("other", r_a), Hypothesis("q", q_a)}) == std::string("from Q(a)"));
+    assert(!store.find(p_a, {Hypothesis("r", r_a)}));
+    assert(!store.find(q_a, {Hypothesis("q", q_a)}));
+    assert(store.hits() == 1);
+
+    // Lemmas covered by a weaker one are not kept
+    assert(!store.add(p_a, {Hypothesis("h", q_a), Hypothesis("r", r_a)}, "from Q(a) and R(a)"));
+    assert(store.add(p_a, {}, "outright"));
+    assert(store.size() == 1);
+    assert(store.find(p_a, {Hypothesis("r", r_a)}) == std::string("outright"));
+
+    // A formula among its own hypotheses proves nothing worth keeping
+    assert(!store.add(q_a, {Hypothesis("q", q_a)}, "assumption"));
+
+    // Closing a goal
+    ProofContext context;
+    auto open = state_with(context, {Hypothesis("r", r_a)}, p_a);
+    auto closed = store.close_goal(context, open);
+    assert(closed && closed->is_proved() && *closed->goal() == *p_a);
+    assert(!store.close_goal(context, state_with(context, {}, q_a)));
+
+    std::cout << "Lemma context tests passed!" << std::endl;
+}
+
+// Test that a file-backed store keeps its lemmas
+void test_persistent_store()
+{
+    std::cout << "\n=== Testing persistent lemma store ===\n"
+              << std::endl;
+
+    std::string path = temporary_path("test_lemma_store", "lemmas");
+    auto a = make_constant("a");
+    auto x = make_variable(0);
+    auto p_a = make_function_application("P", {a});
+    auto all_q = make_forall("x", make_function_application("Q", {x}));
+    {
+        LemmaStore store(path);
+        assert(store.size() == 0);
+        assert(store.add(p_a, {Hypothesis("q", all_q)}, "by instantiation"));
+        assert(store.add(all_q, {}, "axiom"));
+    }
+
+    LemmaStore reopened(path);
+    assert(reopened.size() == 2);
+    assert(reopened.find(p_a, {Hypothesis("all", make_forall("y", make_function_application("Q", {x})))}));
+    assert(reopened.find(all_q, {}) == std::string("axiom"));
+
+    // A record cut short at the end is dropped
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        out.put(static_cast<char>(40));
+        out.write("partial", 7);
+    }
+    assert(LemmaStore(path).size() == 2);
+
+    // Files that are not lemma stores
+    BinaryWriter junk;
+    junk.write_string("not lemmas");
+    write_binary_file(path, junk.data());
+    bool rejected = false;
+    try
+    {
+        LemmaStore store(path);
+    }
+    catch (const SerializationError &)
+    {
+        rejected = true;
+    }
+    assert(rejected);
+
+    // A record claiming more hypotheses than it holds
+    BinaryWriter record;
+    record.write_string("key");
+    record.write_varint(UINT64_MAX);
+    BinaryWriter damaged;
+    damaged.write_string("TPLEMMA1");
+    damaged.write_string(record.data());
+    write_binary_file(path, damaged.data());
+    rejected = false;
+    try
+    {
+        LemmaStore store(path);
+    }
+    catch (const SerializationError &)
+    {
+        rejected = true;
+    }
+    assert(rejected);
+
+    std::remove(path.c_str());
+    std::cout << "Persistent lemma store tests passed!" << std::endl;
+}
+
+// Test lemma reuse between goal managers and by tactics
+void test_lemma_reuse()
+{
+    std::cout << "\n=== Testing lemma reuse across proofs ===\n"
+              << std::endl;
+
+    auto a = make_constant("a");
+    auto b = make_constant("b");
+    auto p_a = make_function_application("P", {a});
+    auto q_b = make_function_application("Q", {b});
+    auto conj_goal = make_and(p_a, q_b);
+    auto store = std::make_shared<LemmaStore>();
+
+    // The first manager proves P(a) ∧ Q(b) from its parts
+    {
+        ProofContext context;
+        GoalManager goal_manager(store);
+        auto initial_state = state_with(context, {Hypothesis("p", p_a), Hypothesis("q", q_b)}, conj_goal);
+        auto subgoal_states = goal_manager.decompose_goal(context, initial_state);
+        assert(subgoal_states.size() == 2);
+
+        std::optional<ConstraintViolation> violation;
+        auto register_tactic = register_proven_subgoal(goal_manager);
+        for (const auto &state : subgoal_states)
+        {
+            assert(register_tactic(context, state, violation)[0]->is_proved());
+        }
+        assert(goal_manager.try_recombine(context, initial_state, conj_goal)->is_proved());
+        assert(store->size() == 1);
+    }
+
+    // A second one, in a new context, closes the goal without decomposing it
+    {
+        ProofContext context;
+        GoalManager goal_manager(store);
+        auto states = goal_manager.decompose_goal(
+            context, state_with(context, {Hypothesis("h1", q_b), Hypothesis("h2", p_a)}, conj_goal));
+        assert(states.size() == 1 && states[0]->is_proved());
+
+        // But only where the hypotheses hold
+        states = goal_manager.decompose_goal(context, state_with(context, {Hypothesis("h", p_a)}, conj_goal));
+        assert(states.size() == 2);
+    }
+
+    // Tactics populate the store on success and consult it before searching
+    std::size_t searches = 0;
+    Tactic counted = [&searches](ProofContext &context, const ProofStatePtr &state,
+                                 std::optional<ConstraintViolation> &violation)
+    {
+        ++searches;
+        return direct_proof()(context, state, violation);
+    };
+    auto lemmas = std::make_shared<LemmaStore>();
+
+    // A goal proven from itself is searched every time, as nothing is stored
+    for (int run = 0; run < 2; ++run)
+    {
+        ProofContext context;
+        std::optional<ConstraintViolation> violation;
+        auto results = with_lemmas(lemmas, counted)(
+            context, state_with(context, {Hypothesis("p", p_a)}, p_a), violation);
+        assert(!results.empty());
+    }
+    assert(searches == 2 && lemmas->size() == 0);
+
+    // Proved states are recorded and reused
+    std::size_t before = searches;
+    ProofContext context;
+    std::optional<ConstraintViolation> violation;
+    auto proved = state_with(context, {}, q_b);
+    proved->mark_as_proved(ProofCertification::Status::PROVED_BY_RULE, "by hand");
+    with_lemmas(lemmas, counted)(context, proved, violation);
+    auto results = with_lemmas(lemmas, counted)(context, state_with(context, {Hypothesis("p", p_a)}, q_b), violation);
+    assert(results.size() == 1 && results[0]->is_proved());
+    assert(searches == before + 1);
+    assert(use_lemmas(lemmas)(context, state_with(context, {}, q_b), violation)[0]->is_proved());
+
+    std::cout << "Lemma reuse tests passed!" << std::endl;
+}
+
+int main()
+{
+    std::cout << "===== Running Lemma Store Tests =====\n"
+              << std::endl;
+
+    test_formula_keys();
+    test_lemma_contexts();
+    test_persistent_store();
+    test_lemma_reuse();
+
+    std::cout << "\n===== Lemma Store Tests Complete =====\n"
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,204 @@
+// tests/test_model_finder.cpp
+#include <iostream>
+#include <cassert>
+#include "../src/model/model_finder.hpp"
+#include "../src/model/sat_solver.hpp"
+#include "../src/resolution/resolution_prover.hpp"
+#include "../src/term/term_db.hpp"
+#include "test_helpers.hpp"
+
+using namespace theorem_prover;
+using namespace test_helpers;
+
+namespace {
+
+bool satisfies_all(const FiniteModel &model, const std::vector<ClausePtr> &clauses) {
+    for (const auto &c : clauses) {
+        if (!model.satisfies(*c)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+void test_sat_solver() {
+    std::cout << "Testing SAT solver..." << std::endl;
+
+    using Lit = SatSolver::Lit;
+    auto pos = SatSolver::positive;
+    auto neg = SatSolver::negative;
+
+    // (a | b) & (!a | c) & (!b | !c) & (a | !c)
+    SatSolver solver;
+    auto a = solver.new_variable();
+    auto b = solver.new_variable();
+    auto c = solver.new_variable();
+    std::vector<std::vector<Lit>> clauses = {
+        {pos(a), pos(b)}, {neg(a), pos(c)}, {neg(b), neg(c)}, {pos(a), neg(c)}};
+    for (const auto &literals : clauses) {
+        assert(solver.add_clause(literals));
+    }
+    assert(solver.solve(1000.0) == SatSolver::Result::SATISFIABLE);
+    for (const auto &literals : clauses) {
+        bool satisfied = false;
+        for (Lit literal : literals) {
+            satisfied = satisfied || solver.value(SatSolver::variable_of(literal)) == !(literal & 1);
+        }
+        assert(satisfied);
+    }
+
+    // Five pigeons do not fit in four holes
+    SatSolver pigeonhole;
+    const std::size_t pigeons = 5, holes = 4;
+    auto in = [&](std::size_t p, std::size_t h) { return static_cast<SatSolver::Variable>(p * holes + h); };
+    for (std::size_t i = 0; i < pigeons * holes; ++i) {
+        pigeonhole.new_variable();
+    }
+    for (std::size_t p = 0; p < pigeons; ++p) {
+        std::vector<Lit> somewhere;
+        for (std::size_t h = 0; h < holes; ++h) {
+            somewhere.push_back(pos(in(p, h)));
+        }
+        pigeonhole.add_clause(somewhere);
+    }
+    for (std::size_t h = 0; h < holes; ++h) {
+        for (std::size_t p = 0; p < pigeons; ++p) {
+            for (std::size_t q = p + 1; q < pigeons; ++q) {
+                pigeonhole.add_clause({neg(in(p, h)), neg(in(q, h))});
+            }
+        }
+    }
+    assert(pigeonhole.solve(10000.0) == SatSolver::Result::UNSATISFIABLE);
+    assert(pigeonhole.conflicts() > 0);
+
+    // Contradictory units, and the empty clause
+    SatSolver units;
+    auto x = units.new_variable();
+    assert(units.add_clause({pos(x), pos(x)}));
+    assert(units.add_clause({neg(x)}));
+    assert(units.solve(1000.0) == SatSolver::Result::UNSATISFIABLE);
+    SatSolver empty;
+    assert(!empty.add_clause({}));
+    assert(empty.solve(1000.0) == SatSolver::Result::UNSATISFIABLE);
+
+    std::cout << "SAT solver tests passed!" << std::endl;
+}
+
+void test_finite_models() {
+    std::cout << "Testing finite model search..." << std::endl;
+
+    auto x = make_variable(0);
+    auto a = make_constant("a");
+    auto b = make_constant("b");
+    auto p = [](const TermDBPtr &t) { return make_function_application("p", {t}); };
+    auto q = [](const TermDBPtr &t) { return make_function_application("q", {t}); };
+
+    // p(a), p(x) -> q(x), not q(b): a and b must differ
+    std::vector<ClausePtr> clauses = {clause({Literal(p(a), true)}),
+                                      clause({Literal(p(x), false), Literal(q(x), true)}),
+                                      clause({Literal(q(b), false)})};
+    assert(ModelFinder::is_first_order(clauses));
+    auto result = ModelFinder(clauses).find(4, 1000.0);
+    assert(result.status == ModelFinderResult::Status::FOUND);
+    assert(result.domain_size == 2 && result.model->domain_size == 2);
+    assert(satisfies_all(*result.model, clauses));
+    assert(result.model->evaluate(a, {}) != result.model->evaluate(b, {}));
+    std::cout << "  " << result.model->to_string() << std::endl;
+
+    // A contradiction has no model of any size
+    std::vector<ClausePtr> contradiction = {clause({Literal(p(a), true)}), clause({Literal(p(x), false)})};
+    result = ModelFinder(contradiction).find(3, 1000.0);
+    assert(result.status == ModelFinderResult::Status::NO_MODEL && !result.model);
+
+    // An injective, non-surjective function needs an infinite domain
+    auto y = make_variable(1);
+    auto zero = make_constant("zero");
+    auto s = [](const TermDBPtr &t) { return make_function_application("s", {t}); };
+    std::vector<ClausePtr> successor = {clause({Literal(eq(s(x), s(y)), false), Literal(eq(x, y), true)}),
+                                        clause({Literal(eq(s(x), zero), false)})};
+    assert(ModelFinder(successor).find(4, 1000.0).status == ModelFinderResult::Status::NO_MODEL);
+
+    // Sizes whose grounding exceeds the limit are not tried
+    assert(ModelFinder(successor).find(4, 1000.0, 3).status == ModelFinderResult::Status::LIMIT);
+
+    // Quantified atoms are outside the fragment
+    assert(!ModelFinder::is_first_order({clause({Literal(make_forall("x", p(make_variable(0))), true)})}));
+
+    std::cout << "Finite model search tests passed!" << std::endl;
+}
+
+void test_group_countermodels() {
+    std::cout << "Testing group countermodels..." << std::endl;
+
+    auto a = make_constant("a");
+    auto b = make_constant("b");
+    auto e = make_constant("e");
+
+    // Groups are not abelian: the smallest counterexample is S3
+    auto clauses = group_axioms();
+    clauses.push_back(clause({Literal(eq(mult(a, b), mult(b, a)), false)}));
+    auto result = ModelFinder(clauses).find(6, 30000.0);
+    assert(result.status == ModelFinderResult::Status::FOUND);
+    assert(result.domain_size == 6);
+    assert(satisfies_all(*result.model, clauses));
+    std::cout << "  Size " << result.domain_size << " with " << result.sat_variables << " variables and "
+              << result.sat_clauses << " clauses in " << result.elapsed_time_ms << " ms" << std::endl;
+
+    // A theorem has no countermodel
+    clauses = group_axioms();
+    clauses.push_back(clause({Literal(eq(mult(a, e), a), false)}));
+    assert(ModelFinder(clauses).find(4, 30000.0).status == ModelFinderResult::Status::NO_MODEL);
+
+    std::cout << "Group countermodel tests passed!" << std::endl;
+}
+
+void test_prover_integration() {
+    std::cout << "Testing model finding in the resolution prover..." << std::endl;
+
+    auto a = make_constant("a");
+    auto b = make_constant("b");
+    auto clauses = group_axioms();
+    clauses.push_back(clause({Literal(eq(mult(a, b), mult(b, a)), false)}));
+
+    // Off by default
+    ResolutionConfig config;
+    config.use_paramodulation = true;
+    config.max_time_ms = 2000.0;
+    config.max_iterations = 200;
+    auto result = ResolutionProver(config).prove_from_clauses(clauses);
+    assert(!result.is_disproved() && !result.countermodel);
+
+    config.use_model_finder = true;
+    config.model_finder_timeout = 30.0;
+    result = ResolutionProver(config).prove_from_clauses(clauses);
+    assert(result.is_disproved());
+    assert(result.countermodel && result.countermodel->domain_size == 6);
+    assert(result.final_clause_count == clauses.size());
+
+    // A formula with a model is satisfiable
+    auto p = make_function_application("p", {a});
+    auto satisfiable = ResolutionProver(config).check_satisfiability({make_and(p, make_not(make_function_application("p", {b})))});
+    assert(satisfiable.is_proved() && satisfiable.countermodel);
+
+    // Theorems go on to the search
+    clauses = group_axioms();
+    clauses.push_back(clause({Literal(eq(mult(a, make_constant("e")), a), false)}));
+    config.model_finder_max_domain = 3;
+    assert(ResolutionProver(config).prove_from_clauses(clauses).is_proved());
+
+    std::cout << "Prover integration tests passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "===== Running Model Finder Tests =====" << std::endl;
+
+    test_sat_solver();
+    test_finite_models();
+    test_group_countermodels();
+    test_prover_integration();
+
+    std::cout << "\n===== All Model Finder Tests Passed! =====" << std::endl;
+    return 0;
+}
@@ -392,6 +392,53 @@ void test_performance()
     std::cout << "Performance tests passed!" << std::endl;
 }
 
+void test_knuth_bendix_ordering()
+{
+    std::cout << "Testing Knuth-Bendix ordering..." << std::endl;
+
+    auto precedence = std::make_shared<Precedence>();
+    precedence->set_greater("i", "*");
+    precedence->set_greater("*", "e");
+    auto kbo = make_kbo(precedence);
+
+    auto x = make_variable(0);
+    auto y = make_variable(1);
+    auto z = make_variable(2);
+    auto a = make_constant("a");
+    auto e = make_constant("e");
+    auto mult = [](const TermDBPtr &s, const TermDBPtr &t)
+    { return make_function_application("*", {s, t}); };
+    auto inv = [](const TermDBPtr &s)
+    { return make_function_application("i", {s}); };
+
+    // Heavier terms are greater, provided they hold all the variables
+    assert(kbo->greater(mult(x, e), x));
+    assert(kbo->greater(mult(inv(x), x), e));
+    assert(!kbo->greater(a, x));
+    assert(!kbo->greater(mult(x, a), y));
+
+    // Equal weight: associativity is oriented by the first argument
+    auto left = mult(mult(x, y), z);
+    auto right = mult(x, mult(y, z));
+    assert(kbo->greater(left, right));
+    assert(!kbo->greater(right, left));
+
+    // Commutativity is not orientable, only its ground instances
+    assert(!kbo->greater(mult(x, y), mult(y, x)));
+    assert(!kbo->greater(mult(y, x), mult(x, y)));
+    auto b = make_constant("b");
+    assert(kbo->greater(mult(b, a), mult(a, b)) != kbo->greater(mult(a, b), mult(b, a)));
+
+    // With i weighing 0 and greatest, i(x * y) > i(y) * i(x) despite the extra i
+    assert(!kbo->greater(inv(mult(x, y)), mult(inv(y), inv(x))));
+    kbo->set_weight("i", 0);
+    assert(kbo->greater(inv(mult(x, y)), mult(inv(y), inv(x))));
+    assert(kbo->greater(inv(inv(x)), x));
+    assert(!kbo->greater(x, inv(x)));
+
+    std::cout << "Knuth-Bendix ordering tests passed!" << std::endl;
+}
+
 int main()
 {
     std::cout << "===== Running Ordering Tests =====" << std::endl;
@@ -406,6 +453,7 @@ int main()
     test_complex_nesting();
     test_edge_cases();
     test_argument_status();
+    test_knuth_bendix_ordering();
     test_performance();
 
     std::cout << "\n===== All Ordering Tests Passed! =====" << std::endl;
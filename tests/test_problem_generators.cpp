@@ -0,0 +1,98 @@
+// tests/test_problem_generators.cpp
+#include <iostream>
+#include <cassert>
+#include <sstream>
+#include "../bench/problem_generators.hpp"
+
+using namespace theorem_prover;
+using namespace theorem_prover::bench;
+
+namespace {
+
+std::string tptp(const TPTPProblem &problem) {
+    std::ostringstream out;
+    write_tptp(out, problem);
+    return out.str();
+}
+
+} // namespace
+
+// The expected texts pin the generators to their seeds: any standard
+// library must produce exactly these problems
+void test_pinned_problems() {
+    std::cout << "Testing generated problems for fixed seeds..." << std::endl;
+
+    RandomCNFConfig config;
+    config.clauses = 4;
+    config.min_literals = 1;
+    config.max_literals = 3;
+    config.predicates = 3;
+    config.functions = 2;
+    config.constants = 2;
+    config.variables = 2;
+    config.max_depth = 2;
+    config.seed = 7;
+    assert(tptp(random_cnf(config)) ==
+           "% Problem    : random_cnf_4_3_s7\n"
+           "% Status     : Unknown\n"
+           "cnf(c0, axiom, ~ p2(X1, X1) | ~ p2(f0(f1(c0, c0)), X0)).\n"
+           "cnf(c1, axiom, p1(c1, f1(f0(X0), c1)) | p1(X1, X1)).\n"
+           "cnf(c2, axiom, p1(X1, c1) | p0(f1(X1, f1(X1, X1)), c1)).\n"
+           "cnf(c3, axiom, p0(c1, f1(f1(X1, c0), c1)) | p0(c1, f0(f1(c0, c1)))).\n");
+
+    assert(tptp(group_word_problem(2, 3, 5)) ==
+           "% Problem    : group_word_2_3_s5\n"
+           "% Status     : Unsatisfiable\n"
+           "cnf(left_identity, axiom, mult(e, X0) = X0).\n"
+           "cnf(left_inverse, axiom, mult(inv(X0), X0) = e).\n"
+           "cnf(associativity, axiom, mult(mult(X0, X1), X2) = mult(X0, mult(X1, X2))).\n"
+           "cnf(goal, negated_conjecture, mult(mult(inv(a0), mult(a1, inv(a0))), "
+           "mult(a0, mult(inv(a1), a0))) != e).\n");
+
+    assert(tptp(implication_chain(2, 1, 3)) ==
+           "% Problem    : implication_chain_2_1_s3\n"
+           "% Status     : Unsatisfiable\n"
+           "cnf(link_1, axiom, ~ p1(X0) | p2(X0)).\n"
+           "cnf(link_0, axiom, ~ p0(X0) | p1(X0)).\n"
+           "cnf(dead_end_0_0, axiom, ~ p0(X0) | q0_0(X0)).\n"
+           "cnf(goal, negated_conjecture, ~ p2(a)).\n"
+           "cnf(dead_end_1_0, axiom, ~ p1(X0) | q1_0(X0)).\n"
+           "cnf(start, axiom, p0(a)).\n");
+
+    std::cout << "Pinned problem tests passed!" << std::endl;
+}
+
+void test_problem_sizes() {
+    std::cout << "Testing generated problem sizes..." << std::endl;
+
+    auto fixed = generate_problem("random_cnf:clauses=1000,k=3,seed=11");
+    assert(fixed.formulas.size() == 1000);
+    for (const auto &formula : fixed.formulas) {
+        assert(formula.clause->size() == 3);
+    }
+
+    std::size_t literals = 0;
+    for (const auto &formula : generate_problem("random_cnf:clauses=1000,min_literals=1,max_literals=5,seed=11").formulas) {
+        assert(formula.clause->size() >= 1 && formula.clause->size() <= 5);
+        literals += formula.clause->size();
+    }
+    assert(literals == 2929);
+
+    // holes + 1 pigeon clauses, holes * C(holes + 1, 2) exclusions
+    assert(pigeonhole(3).formulas.size() == 4 + 3 * 6);
+    assert(implication_chain(10, 2, 1).formulas.size() == 2 + 10 * 3);
+    assert(tptp(generate_problem("group_word:generators=3,length=6,seed=2")) ==
+           tptp(group_word_problem(3, 6, 2)));
+
+    std::cout << "Problem size tests passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "===== Running Problem Generator Tests =====" << std::endl;
+
+    test_pinned_problems();
+    test_problem_sizes();
+
+    std::cout << "\n===== All Problem Generator Tests Passed! =====" << std::endl;
+    return 0;
+}
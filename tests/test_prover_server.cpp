@@ -0,0 +1,238 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/server/prover_server.hpp"
+
+using namespace theorem_prover;
+
+namespace
+{
+    // Responses of one session
+    struct Transcript
+    {
+        std::mutex mutex;
+        std::vector<std::string> lines;
+
+        ProverServer::Responder responder()
+        {
+            return [this](const std::string &line)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                lines.push_back(line);
+            };
+        }
+
+        // The response for a request id, or "" if there is none
+        std::string find(const std::string &event, const std::string &id) const
+        {
+            for (const auto &line : lines)
+            {
+                if (line.find("\"event\": \"" + event + "\"") != std::string::npos &&
+                    line.find("\"id\": \"" + id + "\"") != std::string::npos)
+                {
+                    return line;
+                }
+            }
+            return "";
+        }
+    };
+
+    bool contains(const std::string &line, const std::string &text)
+    {
+        return line.find(text) != std::string::npos;
+    }
+
+    void serve(ProverServer &server, const std::string &input, Transcript &transcript)
+    {
+        std::istringstream in(input);
+        server.serve(in, transcript.responder());
+    }
+
+    // Strict order with a successor above every element
+    const char *order_axioms =
+        "fof(transitive, axiom, ![X, Y, Z]: ((less(X, Y) & less(Y, Z)) => less(X, Z))).\n"
+        "fof(irreflexive, axiom, ![X]: ~less(X, X)).\n"
+        "fof(successor, axiom, ![X]: less(X, s(X))).\n";
+
+    // Saturation never ends, and there is no finite model to stop it
+    const char *endless_goal = "fof(goal, conjecture, q(a)).\n";
+}
+
+// Test proofs against a theory and their reuse as lemmas
+void test_theories_and_lemmas()
+{
+    std::cout << "\n=== Testing theories and lemmas ===\n"
+              << std::endl;
+
+    ProverServerConfig config;
+    config.threads = 2;
+    ProverServer server(config);
+
+    Transcript first;
+    serve(server,
+          "theory order\n" + std::string(order_axioms) + "end\n" +
+              "prove two theory=order\n"
+              "fof(goal, conjecture, less(a, s(s(a)))).\n"
+              "end\n"
+              "prove alone\n"
+              "fof(p_a, axiom, p(a)).\n"
+              "fof(implies, axiom, ![X]: (p(X) => q(X))).\n"
+              "fof(goal, conjecture, q(a)).\n"
+              "end\n"
+              "quit\n",
+          first);
+    assert(contains(first.lines[0], "\"event\": \"theory\"") && contains(first.lines[0], "\"formulas\": 3"));
+    std::string two = first.find("result", "two");
+    assert(contains(two, "\"status\": \"PROVED\""));
+    assert(contains(first.find("result", "alone"), "\"status\": \"PROVED\""));
+
+    // A later session is answered from the lemma, also with more axioms
+    // and bound variables renamed
+    Transcript second;
+    serve(server,
+          "prove again theory=order\n"
+          "fof(goal, conjecture, less(a, s(s(a)))).\n"
+          "end\n"
+          "prove more theory=order\n"
+          "fof(extra, axiom, p(b)).\n"
+          "fof(goal, conjecture, less(a, s(s(a)))).\n"
+          "end\n"
+          "prove renamed\n"
+          "fof(implies, axiom, ![Y]: (p(Y) => q(Y))).\n"
+          "fof(p_a, axiom, p(a)).\n"
+          "fof(goal, conjecture, q(a)).\n"
+          "end\n"
+          "stats\n",
+          second);
+    for (const char *id : {"again", "more", "renamed"})
+    {
+        std::string line = second.find("result", id);
+        assert(contains(line, "\"status\": \"PROVED\"") && contains(line, "\"lemma\": "));
+    }
+    assert(contains(second.lines.back(), "\"event\": \"stats\""));
+    assert(contains(second.lines.back(), "\"requests\": 5") && contains(second.lines.back(), "\"lemma_answers\": 3"));
+    assert(contains(second.lines.back(), "\"theories\": 1"));
+
+    // Without the axiom the lemma needs, the goal is searched for
+    Transcript third;
+    serve(server,
+          "theory bare\n"
+          "fof(successor, axiom, ![X]: less(X, s(X))).\n"
+          "end\n"
+          "prove weaker theory=bare strategy=basic timeout=500\n"
+          "fof(goal, conjecture, less(a, s(s(a)))).\n"
+          "end\n",
+          third);
+    std::string weaker = third.find("result", "weaker");
+    assert(!weaker.empty() && !contains(weaker, "\"lemma\": "));
+
+    std::cout << "Theory and lemma tests passed!" << std::endl;
+}
+
+// Test budgets and cancellation
+void test_budgets()
+{
+    std::cout << "\n=== Testing request budgets ===\n"
+              << std::endl;
+
+    ProverServerConfig config;
+    config.threads = 2;
+    config.max_time_ms = 60000.0;
+    ProverServer server(config);
+    server.add_theory("order", order_axioms);
+
+    // A budget ends the search
+    auto start = std::chrono::steady_clock::now();
+    Transcript timed;
+    serve(server,
+          std::string("prove short theory=order strategy=basic timeout=300\n") + endless_goal + "end\n",
+          timed);
+    assert(contains(timed.find("result", "short"), "\"status\": \"TIMEOUT\""));
+
+    // Cancelled before it starts, and while it runs: the pool has two
+    // threads, so the third request waits
+    Transcript cancelled;
+    serve(server,
+          std::string("prove one theory=order timeout=100000\n") + endless_goal + "end\n" +
+              "prove two theory=order strategy=basic timeout=100000\n" + endless_goal + "end\n" +
+              "prove three theory=order timeout=100000\n" + endless_goal + "end\n" +
+              "cancel three\n"
+              "cancel one\n"
+              "cancel two\n",
+          cancelled);
+    for (const char *id : {"one", "two", "three"})
+    {
+        assert(contains(cancelled.find("result", id), "\"status\": \"CANCELLED\""));
+    }
+
+    // Cancelling every request, from another thread
+    Transcript stopped;
+    std::thread session([&server, &stopped]()
+                        { serve(server, std::string("prove long theory=order timeout=100000\n") + endless_goal + "end\n",
+                                stopped); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    server.cancel_all();
+    session.join();
+    assert(contains(stopped.find("result", "long"), "\"status\": \"CANCELLED\""));
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    assert(elapsed < 30.0);
+
+    std::cout << "Budget tests passed!" << std::endl;
+}
+
+// Test malformed requests
+void test_errors()
+{
+    std::cout << "\n=== Testing request errors ===\n"
+              << std::endl;
+
+    ProverServerConfig config;
+    config.threads = 1;
+    ProverServer server(config);
+
+    Transcript transcript;
+    serve(server,
+          "prove a theory=missing\nfof(goal, conjecture, p).\nend\n"
+          "prove b strategy=fastest\nfof(goal, conjecture, p).\nend\n"
+          "prove c timeout=soon\nfof(goal, conjecture, p).\nend\n"
+          "prove d\nfof(goal, conjecture, p(.\nend\n"
+          "theory e\nfof(goal, conjecture, p).\nend\n"
+          "forget f\n"
+          "cancel g\n"
+          "launch h\n"
+          "prove i\nfof(goal, conjecture, p).\n",
+          transcript);
+
+    assert(contains(transcript.find("error", "a"), "no theory missing"));
+    assert(contains(transcript.find("error", "b"), "unknown strategy fastest"));
+    assert(contains(transcript.find("error", "c"), "invalid timeout"));
+    assert(!transcript.find("error", "d").empty());
+    assert(contains(transcript.find("error", "e"), "conjectures belong in prove requests"));
+    assert(contains(transcript.find("error", "f"), "no theory f"));
+    assert(contains(transcript.find("error", "g"), "no request g"));
+    assert(contains(transcript.find("error", "h"), "unknown request launch"));
+    assert(contains(transcript.find("error", "i"), "without \\\"end\\\""));
+    assert(transcript.lines.size() == 9);
+
+    std::cout << "Request error tests passed!" << std::endl;
+}
+
+int main()
+{
+    std::cout << "===== Running Prover Server Tests =====\n"
+              << std::endl;
+
+    test_theories_and_lemmas();
+    test_budgets();
+    test_errors();
+
+    std::cout << "\n===== Prover Server Tests Complete =====\n"
+              << std::endl;
+    return 0;
+}
@@ -1,6 +1,7 @@
 // tests/test_resolution_prover.cpp
 #include <iostream>
 #include <cassert>
+#include <thread>
 #include "../src/resolution/resolution_prover.hpp"
 #include "../src/term/term_db.hpp"
 
@@ -225,6 +226,7 @@ void test_clause_selection_strategies() {
     
     // Test FIFO strategy
     ResolutionConfig fifo_config;
+    fifo_config.use_datalog = false; // Horn and function-free: keep it on the resolution loop
     fifo_config.selection_strategy = ResolutionConfig::SelectionStrategy::FIFO;
     ResolutionProver fifo_prover(fifo_config);
     auto fifo_result = fifo_prover.prove(r, hypotheses);
@@ -233,6 +235,7 @@ void test_clause_selection_strategies() {
     
     // Test SMALLEST_FIRST strategy
     ResolutionConfig smallest_config;
+    smallest_config.use_datalog = false;
     smallest_config.selection_strategy = ResolutionConfig::SelectionStrategy::SMALLEST_FIRST;
     ResolutionProver smallest_prover(smallest_config);
     auto smallest_result = smallest_prover.prove(r, hypotheses);
@@ -241,6 +244,7 @@ void test_clause_selection_strategies() {
     
     // Test UNIT_PREFERENCE strategy
     ResolutionConfig unit_config;
+    unit_config.use_datalog = false;
     unit_config.selection_strategy = ResolutionConfig::SelectionStrategy::UNIT_PREFERENCE;
     ResolutionProver unit_prover(unit_config);
     auto unit_result = unit_prover.prove(r, hypotheses);
@@ -326,6 +330,9 @@ void test_timeout_and_limits() {
     iteration_limit_config.max_iterations = 3;
     iteration_limit_config.max_time_ms = 10000.0; // High time limit
     iteration_limit_config.max_clauses = 1000;    // High clause limit
+    // Unit deletion alone refutes the chain before the first iteration
+    iteration_limit_config.use_unit_deletion = false;
+    iteration_limit_config.use_subsumption_resolution = false;
     
     ResolutionProver iteration_prover(iteration_limit_config);
     
@@ -394,6 +401,10 @@ void test_clause_set_operations() {
     clause_set.add_clause(clause1);
     assert(clause_set.size() == 1);
     
+    // Test adding a permuted copy (should be ignored as a variant)
+    clause_set.add_clause(std::make_shared<Clause>(std::vector<Literal>{Literal(q, true), Literal(p, true)}));
+    assert(clause_set.size() == 1);
+    
     // Test adding tautology P ∨ ¬P (should be ignored)
     std::vector<Literal> taut_literals = {Literal(p, true), Literal(p, false)};
     auto taut_clause = std::make_shared<Clause>(taut_literals);
@@ -408,6 +419,333 @@ void test_clause_set_operations() {
     std::cout << "Clause set operations tests passed!" << std::endl;
 }
 
+bool has_literal(const ClausePtr &clause, const Literal &literal) {
+    for (const auto &lit : clause->literals()) {
+        if (lit.equals(literal)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void test_clause_set_simplification() {
+    std::cout << "Testing clause set simplification..." << std::endl;
+    
+    auto x = make_variable(0);
+    auto a = make_constant("a");
+    auto p = [](TermDBPtr t) { return make_function_application("P", {t}); };
+    auto q = [](TermDBPtr t) { return make_function_application("Q", {t}); };
+    auto r = make_constant("R");
+    
+    // Forward: the unit P(X) deletes ¬P(a) from a new ¬P(a) ∨ Q(a)
+    ClauseSet forward_set{ResolutionConfig()};
+    forward_set.add_clause(std::make_shared<Clause>(std::vector<Literal>{Literal(p(x), true)}));
+    forward_set.add_clause(std::make_shared<Clause>(std::vector<Literal>{Literal(p(a), false), Literal(q(a), true)}));
+    assert(forward_set.size() == 2);
+    assert(forward_set.clauses().back()->size() == 1);
+    assert(has_literal(forward_set.clauses().back(), Literal(q(a), true)));
+    
+    // Backward: a new P(X) ∨ R shortens the stored ¬P(a) ∨ Q(a) ∨ R to Q(a) ∨ R
+    ClauseSet backward_set{ResolutionConfig()};
+    backward_set.add_clause(std::make_shared<Clause>(std::vector<Literal>{
+        Literal(p(a), false), Literal(q(a), true), Literal(r, true)}));
+    backward_set.add_clause(std::make_shared<Clause>(std::vector<Literal>{Literal(p(x), true), Literal(r, true)}));
+    assert(backward_set.size() == 2);
+    for (const auto &clause : backward_set.clauses()) {
+        assert(clause->size() == 2);
+        assert(!has_literal(clause, Literal(p(a), false)));
+    }
+    
+    // Cutting the last literal of a clause yields the empty clause
+    backward_set.add_clause(std::make_shared<Clause>(std::vector<Literal>{Literal(r, false)}));
+    backward_set.add_clause(std::make_shared<Clause>(std::vector<Literal>{Literal(q(a), false)}));
+    assert(backward_set.contains_empty_clause());
+    
+    // Disabled, both clauses are kept as given
+    ResolutionConfig plain_config;
+    plain_config.use_unit_deletion = false;
+    plain_config.use_subsumption_resolution = false;
+    ClauseSet plain_set(plain_config);
+    plain_set.add_clause(std::make_shared<Clause>(std::vector<Literal>{Literal(p(x), true)}));
+    plain_set.add_clause(std::make_shared<Clause>(std::vector<Literal>{Literal(p(a), false), Literal(q(a), true)}));
+    assert(plain_set.clauses().back()->size() == 2);
+    
+    std::cout << "Clause set simplification tests passed!" << std::endl;
+}
+
+void test_clause_ids_and_pool() {
+    std::cout << "Testing clause ids, removal and the clause pool..." << std::endl;
+    
+    auto x = make_variable(0);
+    auto a = make_constant("a");
+    auto b = make_constant("b");
+    auto c = make_constant("c");
+    auto p = [](TermDBPtr t) { return make_function_application("P", {t}); };
+    auto q = make_constant("Q");
+    
+    ClausePtr survivor;
+    {
+        ClauseSet clause_set{ResolutionConfig()};
+        clause_set.add_clause(std::make_shared<Clause>(std::vector<Literal>{Literal(p(a), true), Literal(q, true)}));
+        clause_set.add_clause(std::make_shared<Clause>(std::vector<Literal>{Literal(p(b), true), Literal(q, true)}));
+        
+        // Stored clauses get consecutive ids and come from the set's pool
+        ClausePtr first = clause_set.clauses()[0];
+        assert(first->id() == 0 && clause_set.clause(0) == first);
+        assert(clause_set.clause(1)->id() == 1);
+        assert(clause_set.pool()->live_blocks() >= 2);
+        
+        // P(X) subsumes both; they leave the store at once and are skipped
+        // by candidate lookup and selection before any compaction
+        clause_set.add_clause(std::make_shared<Clause>(std::vector<Literal>{Literal(p(x), true)}));
+        assert(clause_set.size() == 1);
+        assert(clause_set.clause(0) == nullptr && clause_set.clause(1) == nullptr);
+        assert(clause_set.is_removed(first));
+        assert(clause_set.get_resolution_candidates(Literal(p(c), false)).size() == 1);
+        assert(clause_set.select_clause()->id() == 2);
+        assert(clause_set.is_empty());
+        
+        // With more removed clauses than live ones, reclaim() compacts the
+        // indexes and frees the retired clauses together
+        std::size_t live = clause_set.pool()->live_blocks();
+        first.reset();
+        clause_set.reclaim();
+        assert(clause_set.pool()->live_blocks() == live - 2);
+        
+        survivor = clause_set.clause(2);
+    }
+    
+    // Clauses stay valid after the set and its pool handle are gone
+    assert(survivor->size() == 1 && has_literal(survivor, Literal(p(x), true)));
+
+    // Blocks freed on the pool's thread are reused; those freed on another
+    // thread are only given back with the pool
+    auto pool = ClausePool::create();
+    ClausePool::Scope scope(pool.get());
+    void *block = pool->allocate(1, 64);
+    pool->deallocate(block, 1);
+    assert(pool->allocate(1, 64) == block && pool->live_blocks() == 1);
+    std::thread([&] { pool->deallocate(block, 1); }).join();
+    assert(pool->live_blocks() == 0);
+    void *other = pool->allocate(1, 64);
+    assert(other != block);
+    pool->deallocate(other, 1);
+    
+    std::cout << "Clause id, removal and pool tests passed!" << std::endl;
+}
+
+void test_factoring_completeness() {
+    std::cout << "Testing factoring completeness..." << std::endl;
+    
+    // P(X) ∨ P(Y) and ¬P(U) ∨ ¬P(V) are refutable only through factors
+    auto p = [](TermDBPtr t) { return make_function_application("P", {t}); };
+    std::vector<ClausePtr> clauses = {
+        std::make_shared<Clause>(std::vector<Literal>{Literal(p(make_variable(0)), true), Literal(p(make_variable(1)), true)}),
+        std::make_shared<Clause>(std::vector<Literal>{Literal(p(make_variable(0)), false), Literal(p(make_variable(1)), false)})};
+    
+    // Condensation reduces both clauses to units on input
+    ResolutionProver condensing_prover;
+    assert(condensing_prover.refute(clauses).is_proved());
+    
+    ResolutionConfig factoring_config;
+    factoring_config.use_condensation = false;
+    ResolutionProver factoring_prover(factoring_config);
+    assert(factoring_prover.refute(clauses).is_proved());
+    
+    std::cout << "Factoring completeness tests passed!" << std::endl;
+}
+
+void test_clauses_renamed_apart() {
+    std::cout << "Testing that clauses are renamed apart..." << std::endl;
+    
+    // P(X) and ¬P(f(X)) use the same variable name but are refutable:
+    // the X of each clause is its own
+    auto x = make_variable(0);
+    auto p_x = make_function_application("P", {x});
+    auto p_fx = make_function_application("P", {make_function_application("f", {x})});
+    
+    ResolutionProver prover;
+    auto result = prover.refute({std::make_shared<Clause>(std::vector<Literal>{Literal(p_x, true)}),
+                                 std::make_shared<Clause>(std::vector<Literal>{Literal(p_fx, false)})});
+    assert(result.is_proved());
+    
+    std::cout << "Renaming apart tests passed!" << std::endl;
+}
+
+void test_set_of_support() {
+    std::cout << "Testing the set of support strategy..." << std::endl;
+    
+    auto x = make_variable(0);
+    auto a = make_constant("a");
+    auto b = make_constant("b");
+    auto p = [](TermDBPtr t) { return make_function_application("P", {t}); };
+    auto q = [](TermDBPtr t) { return make_function_application("Q", {t}); };
+    auto r = [](TermDBPtr t) { return make_function_application("R", {t}); };
+    auto f = [](TermDBPtr t) { return make_function_application("f", {t}); };
+    auto clause = [](std::vector<Literal> literals) { return std::make_shared<Clause>(literals); };
+    
+    ResolutionConfig config;
+    config.use_set_of_support = true;
+    config.use_datalog = false;
+    
+    {
+        // Only supported clauses are selected; the others serve as partners
+        ClauseSet clause_set(config);
+        clause_set.add_clause(clause({Literal(p(a), true)}), false);
+        clause_set.add_clause(clause({Literal(q(a), true), Literal(r(a), true)}), true);
+        assert(!clause_set.is_supported(clause_set.clauses()[0]));
+        assert(clause_set.is_supported(clause_set.clauses()[1]));
+        assert(clause_set.select_clause() == clause_set.clauses()[1]);
+        assert(clause_set.is_empty());
+        
+        // An axiom subsuming a supported clause takes over its support
+        clause_set.add_clause(clause({Literal(q(x), true)}), false);
+        assert(clause_set.size() == 2);
+        ClausePtr subsumer = clause_set.clauses()[1];
+        assert(clause_set.is_supported(subsumer));
+        assert(clause_set.select_clause() == subsumer);
+    }
+    
+    // P(a) and P(X) → P(f(X)) saturate forever among themselves; the goal
+    // Q(b) follows from R(b) and R(b) → Q(b) alone
+    std::vector<ClausePtr> axioms = {
+        clause({Literal(p(a), true)}),
+        clause({Literal(p(x), false), Literal(p(f(x)), true)}),
+        clause({Literal(r(b), true)}),
+        clause({Literal(r(b), false), Literal(q(b), true)})};
+    std::vector<ClausePtr> negated_goal = {clause({Literal(q(b), false)})};
+    
+    // Simplification alone would close the proof while adding the clauses
+    config.use_unit_deletion = false;
+    config.use_subsumption_resolution = false;
+    auto result = ResolutionProver(config).prove_from_clauses(axioms, negated_goal);
+    assert(result.is_proved() && result.iterations > 0);
+    for (const auto &final_clause : result.final_clauses) {
+        assert(!has_literal(final_clause, Literal(p(f(a)), true)));
+    }
+    
+    config.use_set_of_support = false;
+    auto unrestricted = ResolutionProver(config).prove_from_clauses(axioms, negated_goal);
+    assert(unrestricted.is_proved());
+    bool saturated_axioms = false;
+    for (const auto &final_clause : unrestricted.final_clauses) {
+        saturated_axioms = saturated_axioms || has_literal(final_clause, Literal(p(f(a)), true));
+    }
+    assert(saturated_axioms);
+    config.use_set_of_support = true;
+    
+    // Without a goal to tell them apart every clause is supported
+    assert(ResolutionProver(config).prove_from_clauses(negated_goal).status ==
+           ResolutionProofResult::Status::SATURATED);
+    assert(ResolutionProver(config).prove(make_implies(p(a), p(a))).is_proved());
+    
+    std::cout << "  Proved in " << result.iterations << " iterations, "
+              << unrestricted.iterations << " without the set of support" << std::endl;
+    std::cout << "Set of support tests passed!" << std::endl;
+}
+
+void test_macro_inferences() {
+    std::cout << "Testing hyperresolution and UR-resolution..." << std::endl;
+    
+    auto x = make_variable(0);
+    auto a = make_constant("a");
+    auto b = make_constant("b");
+    auto atom = [](const std::string &predicate, TermDBPtr t) { return make_function_application(predicate, {t}); };
+    auto clause = [](std::vector<Literal> literals) { return std::make_shared<Clause>(literals); };
+    
+    // P(a), Q(a), P(X) ∧ Q(X) → R(X), R(X) → S(X), P(b) ⊢ S(a)
+    std::vector<ClausePtr> clauses = {
+        clause({Literal(atom("P", a), true)}),
+        clause({Literal(atom("Q", a), true)}),
+        clause({Literal(atom("P", x), false), Literal(atom("Q", x), false), Literal(atom("R", x), true)}),
+        clause({Literal(atom("R", x), false), Literal(atom("S", x), true)}),
+        clause({Literal(atom("P", b), true)}),
+        clause({Literal(atom("S", a), false)})};
+    
+    // Simplification alone would shorten the nuclei while adding them, and
+    // the Datalog engine would take the whole function-free Horn problem
+    ResolutionConfig config;
+    config.use_datalog = false;
+    config.use_unit_deletion = false;
+    config.use_subsumption_resolution = false;
+    
+    // Hyperresolvents are positive: no clause with a negative literal is
+    // derived, such as the binary resolvent ¬Q(a) ∨ R(a)
+    config.inference_rule = ResolutionConfig::InferenceRule::HYPERRESOLUTION;
+    auto hyper = ResolutionProver(config).prove_from_clauses(clauses);
+    assert(hyper.is_proved());
+    std::size_t non_positive = 0;
+    for (const auto &final_clause : hyper.final_clauses) {
+        for (const auto &literal : final_clause->literals()) {
+            if (literal.is_negative()) {
+                ++non_positive;
+                break;
+            }
+        }
+    }
+    assert(non_positive <= 3); // The two nuclei and ¬S(a)
+    
+    // UR-resolvents are units: the only other clauses are the two nuclei
+    config.inference_rule = ResolutionConfig::InferenceRule::UR_RESOLUTION;
+    auto unit_resulting = ResolutionProver(config).prove_from_clauses(clauses);
+    assert(unit_resulting.is_proved());
+    std::size_t non_unit = 0;
+    for (const auto &final_clause : unit_resulting.final_clauses) {
+        non_unit += final_clause->is_unit() ? 0 : 1;
+    }
+    assert(non_unit <= 2);
+    
+    // Both agree with binary resolution on a satisfiable set
+    clauses.pop_back();
+    config.inference_rule = ResolutionConfig::InferenceRule::HYPERRESOLUTION;
+    assert(ResolutionProver(config).prove_from_clauses(clauses).status == ResolutionProofResult::Status::SATURATED);
+    config.inference_rule = ResolutionConfig::InferenceRule::UR_RESOLUTION;
+    assert(ResolutionProver(config).prove_from_clauses(clauses).status == ResolutionProofResult::Status::SATURATED);
+    
+    std::cout << "  Hyperresolution: " << hyper.iterations << " iterations, "
+              << hyper.final_clause_count << " clauses; UR-resolution: "
+              << unit_resulting.iterations << " iterations, "
+              << unit_resulting.final_clause_count << " clauses" << std::endl;
+    std::cout << "Hyperresolution and UR-resolution tests passed!" << std::endl;
+}
+
+void test_final_clause_retention() {
+    std::cout << "Testing final clause retention..." << std::endl;
+    
+    // P ∨ Q, ¬P ∨ R, ¬Q ∨ R ⊬ S saturates with a non-trivial clause set
+    auto p = make_constant("P");
+    auto q = make_constant("Q");
+    auto r = make_constant("R");
+    auto s = make_constant("S");
+    std::vector<TermDBPtr> hypotheses = {make_or(p, q), make_implies(p, r), make_implies(q, r)};
+    
+    ResolutionConfig full_config;
+    full_config.clause_retention = ResolutionConfig::ClauseRetention::FULL;
+    auto full_result = ResolutionProver(full_config).prove(s, hypotheses);
+    assert(!full_result.is_proved());
+    assert(full_result.final_clause_count > 0);
+    assert(full_result.final_clauses.size() == full_result.final_clause_count);
+    assert(full_result.final_clause_stats().total_clauses == full_result.final_clause_count);
+    
+    ResolutionConfig summary_config;
+    summary_config.clause_retention = ResolutionConfig::ClauseRetention::SUMMARY;
+    auto summary_result = ResolutionProver(summary_config).prove(s, hypotheses);
+    assert(summary_result.final_clauses.empty());
+    assert(summary_result.final_clause_count == full_result.final_clause_count);
+    assert(summary_result.final_clause_stats().total_clauses == full_result.final_clause_count);
+    assert(summary_result.final_clause_stats().unit_clauses == full_result.final_clause_stats().unit_clauses);
+    
+    ResolutionConfig none_config;
+    none_config.clause_retention = ResolutionConfig::ClauseRetention::NONE;
+    auto none_result = ResolutionProver(none_config).prove(s, hypotheses);
+    assert(none_result.final_clauses.empty());
+    assert(none_result.final_clause_count == full_result.final_clause_count);
+    assert(none_result.iterations == full_result.iterations);
+    
+    std::cout << "  Final clause count: " << full_result.final_clause_count << std::endl;
+    std::cout << "Final clause retention tests passed!" << std::endl;
+}
+
 void test_resolution_utils() {
     std::cout << "Testing resolution utilities..." << std::endl;
     
@@ -459,6 +797,13 @@ int main() {
     test_complex_reasoning();
     test_timeout_and_limits();
     test_clause_set_operations();
+    test_clause_set_simplification();
+    test_clause_ids_and_pool();
+    test_factoring_completeness();
+    test_clauses_renamed_apart();
+    test_set_of_support();
+    test_macro_inferences();
+    test_final_clause_retention();
     test_resolution_utils();
     
     std::cout << "\n===== All Resolution Prover Tests Passed! =====" << std::endl;
@@ -0,0 +1,201 @@
+// tests/test_search_trace.cpp
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include "../src/resolution/search_trace.hpp"
+#include "../src/resolution/clause_io.hpp"
+#include "../src/term/term_db.hpp"
+#include "test_helpers.hpp"
+
+using namespace theorem_prover;
+using namespace test_helpers;
+
+void test_binary_encoding() {
+    std::cout << "Testing binary encoding..." << std::endl;
+
+    BinaryWriter out;
+    out.write_varint(0);
+    out.write_varint(127);
+    out.write_varint(128);
+    out.write_varint(UINT64_MAX);
+    out.write_double(-2.5);
+    out.write_string("symbol");
+    out.write_bool(true);
+    assert(out.data().size() == 1 + 1 + 2 + 10 + 8 + 7 + 1);
+
+    BinaryReader in(out.data());
+    assert(in.read_varint() == 0 && in.read_varint() == 127 && in.read_varint() == 128);
+    assert(in.read_varint() == UINT64_MAX);
+    assert(in.read_double() == -2.5);
+    assert(in.read_string() == "symbol");
+    assert(in.read_bool() && in.at_end());
+    assert(throws_serialization_error([&] { in.read_u8(); }));
+
+    // Terms, with quantifiers and repeated symbols
+    auto x = make_variable(0);
+    auto a = make_constant("a");
+    auto f = make_function_application("f", {a, make_function_application("f", {x, a})});
+    auto formula = make_forall("x", make_implies(atom("p", {f}), make_not(make_exists("y", atom("p", {x})))));
+    BinaryWriter terms_out;
+    TermWriter writer(terms_out);
+    writer.write(formula);
+    std::size_t first = terms_out.data().size();
+    writer.write(formula);
+    assert(terms_out.data().size() - first < first); // Symbols are written out once
+
+    BinaryReader terms_in(terms_out.data());
+    TermReader reader(terms_in);
+    assert(*reader.read() == *formula && *reader.read() == *formula && terms_in.at_end());
+
+    // Truncated data is rejected
+    std::string truncated = terms_out.data().substr(0, first - 1);
+    BinaryReader short_in(truncated);
+    TermReader short_reader(short_in);
+    assert(throws_serialization_error([&] { short_reader.read(); }));
+
+    // Configurations keep every search setting
+    ResolutionConfig config;
+    config.max_iterations = 1234;
+    config.max_time_ms = 56.5;
+    config.use_paramodulation = true;
+    config.use_condensation = false;
+    config.model_finder_max_domain = 3;
+    config.kb_config.max_rules = 77;
+    config.selection_strategy = ResolutionConfig::SelectionStrategy::SMALLEST_FIRST;
+    config.inference_rule = ResolutionConfig::InferenceRule::HYPERRESOLUTION;
+    BinaryWriter config_out;
+    clause_io::write_config(config_out, config);
+    BinaryReader config_in(config_out.data());
+    auto copy = clause_io::read_config(config_in);
+    assert(copy.max_iterations == 1234 && copy.max_time_ms == 56.5);
+    assert(copy.use_paramodulation && !copy.use_condensation && copy.use_subsumption);
+    assert(copy.model_finder_max_domain == 3 && copy.kb_config.max_rules == 77);
+    assert(copy.selection_strategy == ResolutionConfig::SelectionStrategy::SMALLEST_FIRST);
+    assert(copy.inference_rule == ResolutionConfig::InferenceRule::HYPERRESOLUTION);
+
+    // Counts and enumerations read from damaged data are checked before use
+    BinaryWriter huge;
+    huge.write_varint(UINT64_MAX);
+    BinaryReader huge_in(huge.data());
+    TermReader huge_terms(huge_in);
+    assert(throws_serialization_error([&] { clause_io::read_clauses(huge_in, huge_terms); }));
+    BinaryWriter huge_arguments;
+    huge_arguments.write_varint(static_cast<std::uint64_t>(TermDB::TermKind::FUNCTION_APPLICATION));
+    huge_arguments.write_varint(0);
+    huge_arguments.write_string("f");
+    huge_arguments.write_varint(1000000);
+    BinaryReader arguments_in(huge_arguments.data());
+    TermReader arguments_reader(arguments_in);
+    assert(throws_serialization_error([&] { arguments_reader.read(); }));
+    std::string bad_rule = config_out.data();
+    bad_rule.back() = 42;
+    BinaryReader bad_rule_in(bad_rule);
+    assert(throws_serialization_error([&] { clause_io::read_config(bad_rule_in); }));
+
+    std::cout << "Binary encoding tests passed!" << std::endl;
+}
+
+void test_record_and_replay() {
+    std::cout << "Testing recording and replay..." << std::endl;
+
+    std::string path = temporary_path("test_search_trace", "chain.trace");
+    ResolutionConfig config;
+    config.use_datalog = false;
+    config.trace_file = path;
+    config.clause_retention = ResolutionConfig::ClauseRetention::NONE;
+
+    for (auto strategy : {ResolutionConfig::SelectionStrategy::FIFO, ResolutionConfig::SelectionStrategy::SMALLEST_FIRST,
+                          ResolutionConfig::SelectionStrategy::UNIT_PREFERENCE}) {
+        config.selection_strategy = strategy;
+        auto result = ResolutionProver(config).refute(chain(6));
+        assert(result.is_proved());
+
+        auto trace = SearchTrace::load(path);
+        assert(trace.status == ResolutionProofResult::Status::PROVED);
+        assert(trace.selections.size() == result.iterations + 1);
+        assert(trace.axioms.empty() && trace.support.size() == chain(6).size());
+        assert(trace.config.selection_strategy == strategy && trace.config.trace_file.empty());
+
+        auto replayed = ResolutionProver::replay(trace);
+        assert(replayed.is_proved());
+        assert(replayed.iterations == result.iterations);
+        assert(replayed.final_clause_count == result.final_clause_count);
+    }
+
+    // Runs cut short by a limit replay to the same point
+    auto x = make_variable(0);
+    auto a = make_constant("a");
+    config.max_iterations = 40;
+    auto result = ResolutionProver(config).refute(
+        {clause({Literal(atom("p", {a}), true)}),
+         clause({Literal(atom("p", {x}), false), Literal(atom("p", {make_function_application("s", {x})}), true)}),
+         clause({Literal(atom("q", {a}), false)})});
+    assert(result.is_timeout() && result.iterations == 40);
+    auto trace = SearchTrace::load(path);
+    auto replayed = ResolutionProver::replay(trace);
+    assert(replayed.is_timeout() && replayed.iterations == 40);
+    assert(replayed.final_clause_count == result.final_clause_count);
+
+    // Saturated runs too
+    config.max_iterations = 10000;
+    result = ResolutionProver(config).refute(
+        {clause({Literal(atom("p", {a}), true)}),
+         clause({Literal(atom("p", {x}), false), Literal(atom("q", {x}), true)})});
+    assert(result.status == ResolutionProofResult::Status::SATURATED);
+    replayed = ResolutionProver::replay(SearchTrace::load(path));
+    assert(replayed.status == ResolutionProofResult::Status::SATURATED);
+    assert(replayed.iterations == result.iterations);
+
+    std::remove(path.c_str());
+    std::cout << "Recording and replay tests passed!" << std::endl;
+}
+
+void test_replay_divergence() {
+    std::cout << "Testing replay divergence..." << std::endl;
+
+    std::string path = temporary_path("test_search_trace", "divergence.trace");
+    ResolutionConfig config;
+    config.use_datalog = false;
+    config.trace_file = path;
+    assert(ResolutionProver(config).refute(chain(4)).is_proved());
+    auto trace = SearchTrace::load(path);
+
+    // A clause that was never stored
+    auto diverged = trace;
+    diverged.selections[1] = 100000;
+    auto result = ResolutionProver::replay(diverged);
+    assert(result.status == ResolutionProofResult::Status::UNKNOWN);
+    assert(result.explanation.find("diverged at selection 1") != std::string::npos);
+
+    // A proof that the selections no longer reach
+    diverged = trace;
+    diverged.selections.resize(1);
+    assert(ResolutionProver::replay(diverged).status == ResolutionProofResult::Status::UNKNOWN);
+
+    // Files that are not traces
+    std::remove(path.c_str());
+    assert(throws_serialization_error([&] { SearchTrace::load(path); }));
+    BinaryWriter junk;
+    junk.write_string("not a trace");
+    write_binary_file(path, junk.data());
+    assert(throws_serialization_error([&] { SearchTrace::load(path); }));
+
+    // A trace with an unknown status
+    trace.status = static_cast<ResolutionProofResult::Status>(9);
+    trace.save(path);
+    assert(throws_serialization_error([&] { SearchTrace::load(path); }));
+
+    std::remove(path.c_str());
+    std::cout << "Replay divergence tests passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "===== Running Search Trace Tests =====" << std::endl;
+
+    test_binary_encoding();
+    test_record_and_replay();
+    test_replay_divergence();
+
+    std::cout << "\n===== All Search Trace Tests Passed! =====" << std::endl;
+    return 0;
+}
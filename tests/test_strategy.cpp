@@ -0,0 +1,179 @@
+// tests/test_strategy.cpp
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include "../src/resolution/strategy.hpp"
+#include "../src/term/term_db.hpp"
+#include "test_helpers.hpp"
+
+using namespace theorem_prover;
+using namespace test_helpers;
+
+namespace {
+
+// p(a), p(x) -> q(x), q(x) | r(x), not q(a) (non-Horn, unsatisfiable)
+std::vector<ClausePtr> small_refutation() {
+    auto x = make_variable(0);
+    auto a = make_constant("a");
+    return {clause({Literal(atom("p", {a}), true)}),
+            clause({Literal(atom("p", {x}), false), Literal(atom("q", {x}), true), Literal(atom("r", {x}), true)}),
+            clause({Literal(atom("r", {x}), false), Literal(atom("q", {x}), true)}),
+            clause({Literal(atom("q", {a}), false)})};
+}
+
+// n + 1 pigeons in n holes, propositionally: hard for resolution
+std::vector<ClausePtr> pigeonhole(std::size_t holes) {
+    auto in = [](std::size_t p, std::size_t h) {
+        return make_constant("in_" + std::to_string(p) + "_" + std::to_string(h));
+    };
+    std::vector<ClausePtr> clauses;
+    for (std::size_t p = 0; p <= holes; ++p) {
+        std::vector<Literal> somewhere;
+        for (std::size_t h = 0; h < holes; ++h) {
+            somewhere.emplace_back(in(p, h), true);
+        }
+        clauses.push_back(clause(somewhere));
+    }
+    for (std::size_t h = 0; h < holes; ++h) {
+        for (std::size_t p = 0; p <= holes; ++p) {
+            for (std::size_t q = p + 1; q <= holes; ++q) {
+                clauses.push_back(clause({Literal(in(p, h), false), Literal(in(q, h), false)}));
+            }
+        }
+    }
+    return clauses;
+}
+
+ResolutionConfig auto_config() {
+    ResolutionConfig config;
+    config.use_auto_strategy = true;
+    config.max_time_ms = 10000.0;
+    config.clause_retention = ResolutionConfig::ClauseRetention::NONE;
+    return config;
+}
+
+} // namespace
+
+void test_problem_features() {
+    std::cout << "Testing problem features..." << std::endl;
+
+    auto x = make_variable(0);
+    auto a = make_constant("a");
+    auto b = make_constant("b");
+    auto f = make_function_application("f", {x});
+
+    // p(a), not p(x) | q(f(x)), a = b
+    auto features = ProblemFeatures::analyze({clause({Literal(atom("p", {a}), true)}),
+                                              clause({Literal(atom("p", {x}), false), Literal(atom("q", {f}), true)}),
+                                              clause({Literal(eq(a, b), true)})});
+    assert(features.clause_stats.total_clauses == 3);
+    assert(features.literals == 4);
+    assert(std::abs(features.equality_ratio - 0.25) < 1e-9 && features.has_equality());
+    assert(std::abs(features.ground_ratio - 2.0 / 3.0) < 1e-9);
+    assert(features.horn_ratio == 1.0);
+    assert(features.max_term_depth == 2);
+    assert(features.predicate_symbols == 2 && features.function_symbols == 1 && features.constant_symbols == 2);
+    assert(!features.datalog && !features.unit_equality);
+    std::cout << "  " << features.to_string() << std::endl;
+
+    assert(ProblemFeatures::analyze(non_abelian_group()).unit_equality);
+    assert(ProblemFeatures::analyze({clause({Literal(atom("p", {a}), true)})}).datalog);
+
+    std::cout << "Problem feature tests passed!" << std::endl;
+}
+
+void test_schedule_table() {
+    std::cout << "Testing the schedule table..." << std::endl;
+
+    StrategyScheduler scheduler(auto_config());
+    auto shares = [](const std::vector<Strategy> &strategies) {
+        double total = 0.0;
+        for (const auto &strategy : strategies) {
+            total += strategy.time_share;
+            assert(!strategy.config.use_auto_strategy);
+        }
+        return total;
+    };
+
+    auto a = make_constant("a");
+    auto datalog = scheduler.schedule(ProblemFeatures::analyze({clause({Literal(atom("p", {a}), true)})}));
+    assert(datalog.size() == 1 && datalog[0].name == "datalog" && datalog[0].complete);
+
+    auto equational = scheduler.schedule(ProblemFeatures::analyze(non_abelian_group()));
+    assert(equational.size() == 1 && equational[0].name == "completion");
+    assert(equational[0].config.use_paramodulation && equational[0].config.use_model_finder);
+
+    // Non-Horn without equality: resolution, opening with a model search
+    auto general = scheduler.schedule(ProblemFeatures::analyze(small_refutation()));
+    assert(general.size() > 1 && std::abs(shares(general) - 1.0) < 1e-9);
+    assert(general[0].config.use_model_finder && !general[0].config.use_paramodulation);
+    for (std::size_t i = 1; i < general.size(); ++i) {
+        assert(!general[i].config.use_model_finder);
+    }
+
+    // Ground without functions: the model search gets every size up to the constants
+    auto ground = scheduler.schedule(ProblemFeatures::analyze(pigeonhole(3)));
+    assert(ground[0].config.inference_rule == ResolutionConfig::InferenceRule::BINARY);
+    assert(ground[0].config.model_finder_max_domain == 1);
+
+    std::cout << "Schedule table tests passed!" << std::endl;
+}
+
+void test_sequential_schedule() {
+    std::cout << "Testing sequential time slicing..." << std::endl;
+
+    auto result = ResolutionProver(auto_config()).refute(small_refutation());
+    assert(result.is_proved());
+    assert(result.strategy == "binary_sos" || result.strategy == "binary");
+
+    // The unit equality schedule finds the countermodel
+    result = ResolutionProver(auto_config()).refute(non_abelian_group());
+    assert(result.is_disproved() && result.strategy == "completion");
+    assert(result.countermodel && result.countermodel->domain_size == 6);
+
+    // A hard problem uses the whole budget, spread over the strategies, and no more
+    auto config = auto_config();
+    config.max_time_ms = 600.0;
+    config.max_iterations = 1000000;
+    result = ResolutionProver(config).refute(pigeonhole(7));
+    assert(result.is_timeout());
+    assert(result.time_elapsed_ms < 1500.0);
+    std::cout << "  Pigeonhole: " << result.strategy << " after " << result.time_elapsed_ms << " ms" << std::endl;
+
+    std::cout << "Sequential time slicing tests passed!" << std::endl;
+}
+
+void test_parallel_schedule() {
+    std::cout << "Testing parallel strategies..." << std::endl;
+
+    auto config = auto_config();
+    config.auto_strategy_threads = 3;
+    auto result = ResolutionProver(config).refute(small_refutation());
+    assert(result.is_proved());
+
+    // The first answer stops the other strategies
+    config.max_time_ms = 600.0;
+    config.max_iterations = 1000000;
+    result = ResolutionProver(config).refute(pigeonhole(7));
+    assert(result.is_timeout() && result.time_elapsed_ms < 1500.0);
+
+    // Shared clauses are copied per strategy; the originals stay usable
+    auto clauses = small_refutation();
+    config.max_time_ms = 10000.0;
+    result = ResolutionProver(config).refute(clauses);
+    assert(result.is_proved() && clauses[0]->size() == 1);
+
+    std::cout << "Parallel strategy tests passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "===== Running Strategy Tests =====" << std::endl;
+
+    test_problem_features();
+    test_schedule_table();
+    test_sequential_schedule();
+    test_parallel_schedule();
+
+    std::cout << "\n===== All Strategy Tests Passed! =====" << std::endl;
+    return 0;
+}
@@ -136,6 +136,169 @@ void test_empty_clause_subsumption()
     std::cout << "  Empty clause subsumption working correctly" << std::endl;
 }
 
+void test_matching_not_unification()
+{
+    std::cout << "Testing that subsumption matches one way..." << std::endl;
+
+    auto x = make_variable(0);
+    auto y = make_variable(1);
+    auto z = make_variable(2);
+    auto less = [](TermDBPtr a, TermDBPtr b)
+    { return make_function_application("less", {a, b}); };
+
+    // ¬less(c1, c6) unifies with a literal of the transitivity clause
+    // ¬less(X, Y) ∨ ¬less(Y, Z) ∨ less(X, Z), but does not subsume it
+    auto unit = std::make_shared<Clause>(std::vector<Literal>{
+        Literal(less(make_constant("c1"), make_constant("c6")), false)});
+    auto transitivity = std::make_shared<Clause>(std::vector<Literal>{
+        Literal(less(x, y), false), Literal(less(y, z), false), Literal(less(x, z), true)});
+    assert(!Clause::subsumes(unit, transitivity));
+
+    // Variables of the subsumed clause are not instantiated: P(X, X) does
+    // not subsume P(Y, Z), while P(Y, Z) subsumes P(X, X)
+    auto p_xx = std::make_shared<Clause>(std::vector<Literal>{
+        Literal(make_function_application("P", {x, x}), true)});
+    auto p_yz = std::make_shared<Clause>(std::vector<Literal>{
+        Literal(make_function_application("P", {y, z}), true)});
+    assert(!Clause::subsumes(p_xx, p_yz));
+    assert(Clause::subsumes(p_yz, p_xx));
+
+    // Shared variable indices between the clauses do not interfere:
+    // P(X) ∨ Q(X) subsumes Q(f(X)) ∨ P(f(X))
+    auto f_x = make_function_application("f", {x});
+    auto pq = std::make_shared<Clause>(std::vector<Literal>{
+        Literal(make_function_application("P", {x}), true), Literal(make_function_application("Q", {x}), true)});
+    auto qp = std::make_shared<Clause>(std::vector<Literal>{
+        Literal(make_function_application("Q", {f_x}), true), Literal(make_function_application("P", {f_x}), true)});
+    assert(Clause::subsumes(pq, qp));
+
+    // The literal mapping is injective: P(X) ∨ P(Y) does not subsume P(a)
+    auto two = std::make_shared<Clause>(std::vector<Literal>{
+        Literal(make_function_application("P", {x}), true), Literal(make_function_application("P", {y}), true)});
+    auto one = std::make_shared<Clause>(std::vector<Literal>{
+        Literal(make_function_application("P", {make_constant("a")}), true)});
+    assert(!Clause::subsumes(two, one));
+
+    std::cout << "  One-way matching working correctly" << std::endl;
+}
+
+void test_long_clause_subsumption()
+{
+    std::cout << "Testing subsumption of long clauses..." << std::endl;
+
+    // Chain P(X0, X1) ∨ P(X1, X2) ∨ ... of 12 literals against a reversed
+    // ground chain of 24; in the broken chain every 6th link leads to a
+    // dead end, so no run of 12 links exists
+    const std::size_t k = 12;
+    std::vector<Literal> general, specific, broken;
+    auto a = [](std::size_t i)
+    { return make_constant("a" + std::to_string(i)); };
+    for (std::size_t i = 0; i < k; ++i)
+    {
+        general.emplace_back(make_function_application("P", {make_variable(i), make_variable(i + 1)}), true);
+    }
+    for (std::size_t i = 2 * k; i-- > 0;)
+    {
+        specific.emplace_back(make_function_application("P", {a(i), a(i + 1)}), true);
+        broken.emplace_back(make_function_application("P", {a(i), i % 6 == 5 ? make_constant("b") : a(i + 1)}), true);
+    }
+
+    auto c1 = std::make_shared<Clause>(general);
+    assert(Clause::subsumes(c1, std::make_shared<Clause>(specific)));
+    assert(!Clause::subsumes(c1, std::make_shared<Clause>(broken)));
+
+    std::cout << "  Long clause subsumption working correctly" << std::endl;
+}
+
+bool has_literal(const ClausePtr &clause, const Literal &literal)
+{
+    for (const auto &lit : clause->literals())
+    {
+        if (lit.equals(literal))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void test_subsumption_resolution()
+{
+    std::cout << "Testing subsumption resolution..." << std::endl;
+
+    auto x = make_variable(0);
+    auto a = make_constant("a");
+    auto b = make_constant("b");
+    auto p = [](TermDBPtr t)
+    { return make_function_application("P", {t}); };
+    auto q = [](TermDBPtr t)
+    { return make_function_application("Q", {t}); };
+
+    // P(X) ∨ Q(X) cuts ¬P(a) from ¬P(a) ∨ Q(a) ∨ R
+    auto simplifier = std::make_shared<Clause>(std::vector<Literal>{Literal(p(x), true), Literal(q(x), true)});
+    auto clause = std::make_shared<Clause>(std::vector<Literal>{
+        Literal(p(a), false), Literal(q(a), true), Literal(make_constant("R"), true)});
+    auto shortened = ResolutionInference::subsumption_resolution(clause, simplifier);
+    assert(shortened && shortened->size() == 2);
+    assert(!has_literal(shortened, Literal(p(a), false)));
+
+    // The rest of the simplifier must map into the rest of the clause
+    auto unrelated = std::make_shared<Clause>(std::vector<Literal>{Literal(p(a), false), Literal(q(b), true)});
+    assert(!ResolutionInference::subsumption_resolution(unrelated, simplifier));
+
+    // A unit clause performs unit deletion: P(X) removes ¬P(a)
+    auto unit = std::make_shared<Clause>(std::vector<Literal>{Literal(p(x), true)});
+    auto deleted = ResolutionInference::subsumption_resolution(unrelated, unit);
+    assert(deleted && deleted->size() == 1 && has_literal(deleted, Literal(q(b), true)));
+
+    // Only instances of the complement are cut: ¬P(a) does not remove P(X)
+    auto negative_unit = std::make_shared<Clause>(std::vector<Literal>{Literal(p(a), false)});
+    auto general = std::make_shared<Clause>(std::vector<Literal>{Literal(p(x), true), Literal(q(x), true)});
+    assert(!ResolutionInference::subsumption_resolution(general, negative_unit));
+
+    std::cout << "  Subsumption resolution working correctly" << std::endl;
+}
+
+void test_clause_signatures()
+{
+    std::cout << "Testing clause signatures..." << std::endl;
+
+    auto x = make_variable(0);
+    auto a = make_constant("a");
+    auto b = make_constant("b");
+    auto p = [](TermDBPtr t)
+    { return make_function_application("P", {t}); };
+    auto q = [](TermDBPtr t)
+    { return make_function_application("Q", {t}); };
+    auto signature = [](std::vector<Literal> literals)
+    { return Clause(literals).clause_signature(); };
+
+    // Subsumption implies the signature test, both ways round
+    auto general = signature({Literal(p(x), true)});
+    auto specific = signature({Literal(p(a), true), Literal(q(b), false)});
+    assert(Clause({Literal(p(x), true)}).subsumes(Clause({Literal(p(a), true), Literal(q(b), false)})));
+    assert(general.may_subsume(specific));
+    assert(!specific.may_subsume(general));
+
+    // Polarity, predicates and symbols each rule a clause out
+    assert(!signature({Literal(p(x), false)}).may_subsume(specific));
+    assert(!signature({Literal(q(x), true)}).may_subsume(specific));
+    assert(!signature({Literal(p(b), true)}).may_subsume(signature({Literal(p(a), true)})));
+
+    // The empty clause subsumes everything
+    assert(Clause().clause_signature().may_subsume(general));
+
+    // Subsumption resolution lets the resolved literal's predicate differ:
+    // P(X) ∨ Q(X) shortens ¬P(a) ∨ Q(a), but no clause without Q does
+    auto simplifier = signature({Literal(p(x), true), Literal(q(x), true)});
+    auto target = signature({Literal(p(a), false), Literal(q(a), true)});
+    assert(!simplifier.may_subsume(target));
+    assert(simplifier.may_shorten(target));
+    assert(!simplifier.may_shorten(signature({Literal(p(a), false)})));
+
+    std::cout << "  Clause signatures working correctly" << std::endl;
+}
+
 int main()
 {
     std::cout << "===== Running Subsumption Tests =====" << std::endl;
@@ -147,6 +310,10 @@ int main()
     test_consistent_substitution();
     test_multi_variable_subsumption();
     test_empty_clause_subsumption();
+    test_matching_not_unification();
+    test_long_clause_subsumption();
+    test_subsumption_resolution();
+    test_clause_signatures();
 
     std::cout << "\n===== All Subsumption Tests Passed! =====" << std::endl;
     return 0;
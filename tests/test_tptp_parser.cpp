@@ -0,0 +1,269 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../src/parser/tptp_parser.hpp"
+#include "../src/resolution/resolution_prover.hpp"
+
+using namespace theorem_prover;
+
+void test_fof_atoms_and_terms() {
+    std::cout << "Testing FOF atoms and terms..." << std::endl;
+
+    auto problem = TPTPParser::parse_string(
+        "fof(ax, axiom, p(f(a), 'Quoted name', 42)).\n"
+        "fof(eq, axiom, f(a) = b).\n"
+        "fof(neq, axiom, a != b).\n");
+
+    assert(problem.formulas.size() == 3);
+    assert(problem.formulas[0].name == "ax");
+    assert(problem.formulas[0].role == TPTPFormula::Role::AXIOM);
+
+    auto expected = make_function_application("p", {
+        make_function_application("f", {make_constant("a")}),
+        make_constant("Quoted name"),
+        make_constant("42")});
+    assert(problem.formulas[0].formula->equals(*expected));
+
+    auto eq = make_function_application("=", {
+        make_function_application("f", {make_constant("a")}), make_constant("b")});
+    assert(problem.formulas[1].formula->equals(*eq));
+
+    auto neq = make_not(make_function_application("=", {make_constant("a"), make_constant("b")}));
+    assert(problem.formulas[2].formula->equals(*neq));
+
+    std::cout << "FOF atom tests passed!" << std::endl;
+}
+
+void test_fof_quantifiers() {
+    std::cout << "Testing FOF quantifiers..." << std::endl;
+
+    // ! [X, Y] : ? [Z] : r(X, Y, Z) uses De Bruijn indices 2, 1, 0
+    auto problem = TPTPParser::parse_string(
+        "fof(q, axiom, ! [X, Y] : ? [Z] : r(X, Y, Z)).\n"
+        "fof(shadow, axiom, ! [X] : (p(X) & ! [X] : q(X))).\n");
+
+    auto r = make_function_application("r", {make_variable(2), make_variable(1), make_variable(0)});
+    auto expected = make_forall("X", make_forall("Y", make_exists("Z", r)));
+    assert(problem.formulas[0].formula->equals(*expected));
+
+    auto shadow = make_forall("X", make_and(
+        make_function_application("p", {make_variable(0)}),
+        make_forall("X", make_function_application("q", {make_variable(0)}))));
+    assert(problem.formulas[1].formula->equals(*shadow));
+
+    std::cout << "FOF quantifier tests passed!" << std::endl;
+}
+
+void test_fof_connectives() {
+    std::cout << "Testing FOF connectives..." << std::endl;
+
+    auto p = make_constant("p");
+    auto q = make_constant("q");
+    auto r = make_constant("r");
+
+    auto problem = TPTPParser::parse_string(
+        "fof(c1, axiom, p & q & r).\n"
+        "fof(c2, axiom, (p | q) => ~r).\n"
+        "fof(c3, axiom, p <= q).\n"
+        "fof(c4, axiom, p <=> q).\n"
+        "fof(c5, axiom, ~ (p ~| q)).\n");
+
+    assert(problem.formulas[0].formula->equals(*make_and(make_and(p, q), r)));
+    assert(problem.formulas[1].formula->equals(*make_implies(make_or(p, q), make_not(r))));
+    assert(problem.formulas[2].formula->equals(*make_implies(q, p)));
+    assert(problem.formulas[3].formula->equals(*make_and(make_implies(p, q), make_implies(q, p))));
+    assert(problem.formulas[4].formula->equals(*make_not(make_not(make_or(p, q)))));
+
+    std::cout << "FOF connective tests passed!" << std::endl;
+}
+
+void test_cnf_clauses() {
+    std::cout << "Testing CNF clauses..." << std::endl;
+
+    auto problem = TPTPParser::parse_string(
+        "cnf(c1, axiom, ~ less(X, Y) | ~ less(Y, Z) | less(X, Z)).\n"
+        "cnf(c2, negated_conjecture, (X != a | $false)).\n"
+        "cnf(c3, axiom, p | $true).\n");
+
+    auto c1 = problem.formulas[0].clause;
+    assert(c1 && c1->size() == 3);
+    assert(c1->literals()[0].is_negative());
+    auto first = make_function_application("less", {make_variable(0), make_variable(1)});
+    auto last = make_function_application("less", {make_variable(0), make_variable(2)});
+    assert(c1->literals()[0].atom()->equals(*first));
+    assert(c1->literals()[2].atom()->equals(*last));
+
+    auto c2 = problem.formulas[1].clause;
+    assert(problem.formulas[1].role == TPTPFormula::Role::NEGATED_CONJECTURE);
+    assert(c2->size() == 1 && c2->literals()[0].is_negative());
+
+    // Clauses containing $true are dropped from the refutation
+    assert(problem.formulas[2].clause == nullptr);
+    assert(problem.refutation_clauses().size() == 2);
+    assert(!problem.is_fof());
+
+    std::cout << "CNF clause tests passed!" << std::endl;
+}
+
+void test_comments_annotations_and_status() {
+    std::cout << "Testing comments, annotations and status header..." << std::endl;
+
+    auto problem = TPTPParser::parse_string(
+        "% Status   : Theorem\n"
+        "/* block\n comment */\n"
+        "fof(1, axiom, p, file('x.p', ax1), [useful(info)]).\n"
+        "fof(goal, conjecture, p). % trailing\n");
+
+    assert(problem.expected_status == "Theorem");
+    assert(problem.formulas.size() == 2);
+    assert(problem.formulas[0].name == "1");
+    assert(problem.conjecture()->equals(*make_constant("p")));
+    assert(problem.hypotheses().size() == 1);
+
+    std::cout << "Comment and annotation tests passed!" << std::endl;
+}
+
+void test_parse_errors() {
+    std::cout << "Testing parse errors..." << std::endl;
+
+    auto fails_at = [](const std::string &text, std::size_t line) {
+        try {
+            TPTPParser::parse_string(text);
+        } catch (const TPTPParseError &e) {
+            return e.line() == line;
+        }
+        return false;
+    };
+
+    assert(fails_at("fof(a, axiom, p(X)).", 1));                  // Unbound variable
+    assert(fails_at("fof(a, axiom, p).\nfof(b, axiom, p & q | r).", 2));
+    assert(fails_at("fof(a, axiom, p)", 1));                      // Missing '.'
+    assert(fails_at("\n\nfof(a, lemmma_typo, p).", 3));
+    assert(fails_at("include('Axioms/SET001-0.ax').", 1));   // Not found
+    assert(fails_at("thf(a, axiom, p).", 1));
+
+    std::cout << "Parse error tests passed!" << std::endl;
+}
+
+void test_includes() {
+    std::cout << "Testing include directives..." << std::endl;
+
+    char dir_template[] = "/tmp/tptp_test_XXXXXX";
+    std::string dir = mkdtemp(dir_template);
+    auto write = [&](const std::string &name, const std::string &text) {
+        std::ofstream(dir + "/" + name) << text;
+        return dir + "/" + name;
+    };
+
+    write("axioms.ax",
+          "fof(a1, axiom, p(a)).\n"
+          "fof(a2, axiom, q(a)).\n"
+          "fof(a3, axiom, r(a)).\n");
+    std::string main_file = write("problem.p",
+          "% Status   : Theorem\n"
+          "include('axioms.ax', [a1, a3]).\n"
+          "fof(goal, conjecture, p(a)).\n");
+
+    auto problem = TPTPParser::parse_file(main_file);
+    assert(problem.name == "problem");
+    assert(problem.expected_status == "Theorem");
+    assert(problem.formulas.size() == 3);
+    assert(problem.formulas[0].name == "a1");
+    assert(problem.formulas[1].name == "a3");
+    assert(problem.formulas[2].name == "goal");
+
+    // Streaming shares one node per constant across formulas
+    TPTPParser parser;
+    std::vector<TermDBPtr> formulas;
+    parser.stream_file(dir + "/axioms.ax", [&](TPTPFormula &&formula) {
+        formulas.push_back(formula.formula);
+    });
+    assert(formulas.size() == 3);
+    auto arg = [](const TermDBPtr &atom) {
+        return std::static_pointer_cast<FunctionApplicationDB>(atom)->arguments()[0];
+    };
+    assert(arg(formulas[0]) == arg(formulas[2]));
+    assert(parser.symbol_count() == 4);
+
+    // Include cycles and missing files are errors
+    std::string cycle = write("cycle.p", "include('cycle.p').\n");
+    bool threw = false;
+    try {
+        TPTPParser::parse_file(cycle);
+    } catch (const TPTPParseError &e) {
+        threw = std::string(e.what()).find("recursive include") != std::string::npos;
+    }
+    assert(threw);
+
+    // Also when the file includes itself under another path
+    mkdir((dir + "/sub").c_str(), 0700);
+    std::string loop = write("loop.p", "include('sub/../loop.p').\n");
+    threw = false;
+    try {
+        TPTPParser::parse_file(loop);
+    } catch (const TPTPParseError &e) {
+        threw = std::string(e.what()).find("recursive include") != std::string::npos;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        TPTPParser::parse_file(dir + "/missing.p");
+    } catch (const TPTPParseError &) {
+        threw = true;
+    }
+    assert(threw);
+
+    for (const char *name : {"axioms.ax", "problem.p", "cycle.p", "loop.p"}) {
+        std::remove((dir + "/" + name).c_str());
+    }
+    rmdir((dir + "/sub").c_str());
+    rmdir(dir.c_str());
+
+    std::cout << "Include tests passed!" << std::endl;
+}
+
+void test_parsed_problem_proves() {
+    std::cout << "Testing proof of a parsed problem..." << std::endl;
+
+    auto problem = TPTPParser::parse_string(
+        "fof(all_men_mortal, axiom, ! [X] : (man(X) => mortal(X))).\n"
+        "fof(socrates, axiom, man(socrates)).\n"
+        "fof(goal, conjecture, ? [Y] : mortal(Y)).\n");
+
+    ResolutionProver prover;
+    auto result = prover.prove(problem.conjecture(), problem.hypotheses());
+    assert(result.is_proved());
+
+    // The same problem through the clause interface
+    auto refutation = prover.refute(problem.refutation_clauses());
+    assert(refutation.is_proved());
+
+    // An existential hypothesis must not be treated as universal
+    auto unprovable = TPTPParser::parse_string(
+        "fof(some, axiom, ? [X] : p(X)).\n"
+        "fof(goal, conjecture, p(a)).\n");
+    result = prover.prove(unprovable.conjecture(), unprovable.hypotheses());
+    assert(!result.is_proved());
+
+    std::cout << "Parsed problem proof tests passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "===== Running TPTP Parser Tests =====" << std::endl;
+
+    test_fof_atoms_and_terms();
+    test_fof_quantifiers();
+    test_fof_connectives();
+    test_cnf_clauses();
+    test_comments_annotations_and_status();
+    test_parse_errors();
+    test_includes();
+    test_parsed_problem_proves();
+
+    std::cout << "\n===== All TPTP Parser Tests Passed! =====" << std::endl;
+    return 0;
+}
@@ -136,6 +136,24 @@ void test_occurs_check()
     result = Unifier::unify(var_x, g_f_x);
     assert(!result.success);
 
+    // Test 4: f(X, Y, X) with f(Y, Z, a) - later bindings must reach
+    // earlier ones: the unifier is {X -> a, Y -> a, Z -> a}
+    auto var_z = make_variable(2);
+    auto a = make_constant("a");
+    auto left = make_function_application("f", {var_x, var_y, var_x});
+    auto right = make_function_application("f", {var_y, var_z, a});
+    result = Unifier::unify(left, right);
+    assert(result.success);
+    auto unified = SubstitutionEngine::substitute(left, result.substitution);
+    assert(*unified == *SubstitutionEngine::substitute(right, result.substitution));
+    assert(*unified == *make_function_application("f", {a, a, a}));
+
+    // Test 5: f(X, Y, Y) with f(Y, g(X), Z) - X and Y would become cyclic
+    auto cyclic_left = make_function_application("f", {var_x, var_y, var_y});
+    auto cyclic_right = make_function_application("f", {var_y, make_function_application("g", {var_x}), var_z});
+    result = Unifier::unify(cyclic_left, cyclic_right);
+    assert(!result.success);
+
     std::cout << "Occurs check tests passed!" << std::endl;
 }
 
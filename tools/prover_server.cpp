@@ -0,0 +1,322 @@
+// Long-running prover server
+//
+// Answers proof requests over stdin/stdout, or from any number of clients
+// on a local Unix socket, keeping theories, interned terms, completed
+// rewrite systems and proved lemmas warm between requests (see
+// ProverServer for the protocol). Requests run on a thread pool, each
+// under its own time budget.
+//
+//   prover_server [options]
+//     --socket PATH      Listen on a Unix socket instead of stdin
+//     --threads N        Requests run at once (default: number of cores)
+//     --timeout MS       Budget of requests that set none (default: 10000)
+//     --max-timeout MS   Largest budget a request may ask for (default: 300000)
+//     --iterations N     Iteration limit of requests that set none
+//     --theory ID=FILE   Load a theory from a TPTP file at startup (repeatable)
+//     --kb-cache DIR     Also keep completed rewrite systems in DIR
+//     --lemmas FILE      Keep proved lemmas in FILE across restarts
+//
+// On stdin, "quit" or the end of the input stops the server once running
+// requests are answered; stdout carries only responses and diagnostics go
+// to stderr. A socket server runs until SIGINT or SIGTERM, which cancels
+// the requests in progress.
+//
+// Exit status: 0 on a clean stop, 1 if a theory or the socket cannot be
+// set up, 2 on usage errors.
+
+#include "../src/server/prover_server.hpp"
+
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <streambuf>
+
+using namespace theorem_prover;
+
+namespace
+{
+
+    struct Options
+    {
+        ProverServerConfig server;
+        std::string socket_path;
+        std::vector<std::pair<std::string, std::string>> theories; // Id and file
+    };
+
+    Options parse_options(int argc, char **argv)
+    {
+        Options options;
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            auto next = [&]() -> std::string
+            {
+                if (i + 1 >= argc)
+                {
+                    std::cerr << "Missing value for " << arg << std::endl;
+                    std::exit(2);
+                }
+                return argv[++i];
+            };
+
+            try
+            {
+                if (arg == "--socket")
+                    options.socket_path = next();
+                else if (arg == "--threads")
+                    options.server.threads = std::max<std::size_t>(1, std::stoul(next()));
+                else if (arg == "--timeout")
+                    options.server.default_time_ms = std::stod(next());
+                else if (arg == "--max-timeout")
+                    options.server.max_time_ms = std::stod(next());
+                else if (arg == "--iterations")
+                    options.server.default_iterations = std::stoul(next());
+                else if (arg == "--kb-cache")
+                    options.server.kb_cache_directory = next();
+                else if (arg == "--lemmas")
+                    options.server.lemma_file = next();
+                else if (arg == "--theory")
+                {
+                    std::string spec = next();
+                    auto separator = spec.find('=');
+                    if (separator == std::string::npos || separator == 0)
+                    {
+                        std::cerr << "Expected --theory ID=FILE, got " << spec << std::endl;
+                        std::exit(2);
+                    }
+                    options.theories.emplace_back(spec.substr(0, separator), spec.substr(separator + 1));
+                }
+                else
+                {
+                    std::cerr << "Unknown option: " << arg << std::endl;
+                    std::cerr << "Usage: " << argv[0] << " [--socket PATH] [--threads N] [--timeout MS] "
+                              << "[--theory ID=FILE]..." << std::endl;
+                    std::exit(2);
+                }
+            }
+            catch (const std::logic_error &)
+            {
+                std::cerr << "Invalid value for " << arg << std::endl;
+                std::exit(2);
+            }
+        }
+        return options;
+    }
+
+    /**
+     * Input stream buffer over a socket
+     */
+    class SocketBuffer : public std::streambuf
+    {
+    public:
+        explicit SocketBuffer(int fd) : fd_(fd) {}
+
+    protected:
+        int_type underflow() override
+        {
+            ssize_t count;
+            do
+            {
+                count = read(fd_, buffer_, sizeof(buffer_));
+            } while (count < 0 && errno == EINTR);
+            if (count <= 0)
+            {
+                return traits_type::eof();
+            }
+            setg(buffer_, buffer_, buffer_ + count);
+            return traits_type::to_int_type(buffer_[0]);
+        }
+
+    private:
+        int fd_;
+        char buffer_[64 * 1024];
+    };
+
+    void write_line(int fd, const std::string &line)
+    {
+        std::string data = line + "\n";
+        std::size_t written = 0;
+        while (written < data.size())
+        {
+            ssize_t count = send(fd, data.data() + written, data.size() - written, MSG_NOSIGNAL);
+            if (count < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (count <= 0)
+            {
+                return; // The client is gone; its requests still finish
+            }
+            written += static_cast<std::size_t>(count);
+        }
+    }
+
+    volatile sig_atomic_t stop_requested = 0;
+
+    void request_stop(int)
+    {
+        stop_requested = 1;
+    }
+
+    struct Client
+    {
+        int fd;
+        std::thread thread;
+        std::atomic<bool> done{false};
+    };
+
+    int serve_socket(ProverServer &server, const std::string &path, const sigset_t &wait_mask)
+    {
+        int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (listener < 0 || path.size() >= sizeof(address.sun_path))
+        {
+            std::cerr << "Cannot create socket " << path << std::endl;
+            return 1;
+        }
+        std::strcpy(address.sun_path, path.c_str());
+        unlink(path.c_str());
+        if (bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0 || listen(listener, 16) < 0)
+        {
+            std::cerr << "Cannot listen on " << path << ": " << std::strerror(errno) << std::endl;
+            close(listener);
+            return 1;
+        }
+        std::cerr << "Listening on " << path << std::endl;
+
+        std::list<std::unique_ptr<Client>> clients;
+        auto reap = [&clients](bool all)
+        {
+            for (auto it = clients.begin(); it != clients.end();)
+            {
+                if (all || (*it)->done)
+                {
+                    (*it)->thread.join();
+                    close((*it)->fd);
+                    it = clients.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        };
+
+        // Signals are blocked everywhere but here, while waiting
+        pollfd waiting{listener, POLLIN, 0};
+        while (!stop_requested)
+        {
+            int ready = ppoll(&waiting, 1, nullptr, &wait_mask);
+            reap(false);
+            if (ready <= 0)
+            {
+                continue;
+            }
+
+            int fd = accept(listener, nullptr, nullptr);
+            if (fd < 0)
+            {
+                continue;
+            }
+            auto client = std::make_unique<Client>();
+            client->fd = fd;
+            Client *raw = client.get();
+            client->thread = std::thread([&server, raw]()
+                                         {
+                                             SocketBuffer buffer(raw->fd);
+                                             std::istream in(&buffer);
+                                             server.serve(in, [raw](const std::string &line)
+                                                          { write_line(raw->fd, line); });
+
+                                             // The client sees the end; the descriptor is
+                                             // closed once the thread is joined
+                                             shutdown(raw->fd, SHUT_RDWR);
+                                             raw->done = true;
+                                         });
+            clients.push_back(std::move(client));
+        }
+
+        // Ending the input ends each session once its requests are answered
+        std::cerr << "Stopping" << std::endl;
+        close(listener);
+        unlink(path.c_str());
+        server.cancel_all();
+        for (const auto &client : clients)
+        {
+            shutdown(client->fd, SHUT_RD);
+        }
+        reap(true);
+        return 0;
+    }
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options = parse_options(argc, argv);
+
+    // Only the thread waiting for clients takes SIGINT and SIGTERM; every
+    // thread started from here on inherits the blocked mask
+    sigset_t blocked;
+    sigset_t wait_mask;
+    sigemptyset(&blocked);
+    sigaddset(&blocked, SIGINT);
+    sigaddset(&blocked, SIGTERM);
+    if (!options.socket_path.empty())
+    {
+        struct sigaction action{};
+        action.sa_handler = request_stop;
+        sigaction(SIGINT, &action, nullptr);
+        sigaction(SIGTERM, &action, nullptr);
+        pthread_sigmask(SIG_BLOCK, &blocked, &wait_mask);
+        sigdelset(&wait_mask, SIGINT);
+        sigdelset(&wait_mask, SIGTERM);
+    }
+
+    try
+    {
+        ProverServer server(options.server);
+        for (const auto &[id, path] : options.theories)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file)
+            {
+                std::cerr << "Cannot read theory file " << path << std::endl;
+                return 1;
+            }
+            std::stringstream text;
+            text << file.rdbuf();
+            std::cerr << server.add_theory(id, text.str(), path) << std::endl;
+        }
+
+        if (!options.socket_path.empty())
+        {
+            return serve_socket(server, options.socket_path, wait_mask);
+        }
+
+        // One call per line, so responses from different threads never
+        // interleave
+        server.serve(std::cin, [](const std::string &line)
+                     {
+                         std::fputs((line + "\n").c_str(), stdout);
+                         std::fflush(stdout);
+                     });
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}